@@ -1,11 +1,13 @@
 /* This program reads a sliced object in CLI format,
  * and create a triangle mesh containing all its slices
- * and support structures.
+ * and support structures. Layers are streamed in batches,
+ * so that the first ones are shown while the rest loads.
  *
  * Enjoy!
 */
 
 #include <QApplication>
+#include <QTimer>
 #include <cinolib/meshes/meshes.h>
 #include <cinolib/gui/qt/qt_gui_tools.h>
 #include <cinolib/drawable_sliced_object.h>
@@ -24,12 +26,24 @@ int main(int argc, char **argv)
     std::cout << "load " << s << std::endl;
     std::cout << "hatch is: " << hatch << std::endl;
 
-    DrawableSlicedObj<> obj(s.c_str(), hatch);
+    CLIReader reader(s.c_str());
+    DrawableSlicedObj<> obj(reader, 64, hatch);
 
     GLcanvas gui;
     gui.push_obj(&obj);
     gui.show();
 
+    // append the remaining layers while the GUI is running
+    QTimer timer;
+    QObject::connect(&timer, &QTimer::timeout, [&]()
+    {
+        bool done = (obj.append_slices(reader, 64)==0);
+        obj.updateGL(); // also uploads the final uvw update, done at end of file
+        gui.updateGL();
+        if(done) timer.stop();
+    });
+    timer.start(0);
+
     // CMD+1 to show visual controls.
     SurfaceMeshControlPanel<DrawableSlicedObj<>> panel(&obj, &gui);
     QApplication::connect(new QShortcut(QKeySequence(Qt::CTRL+Qt::Key_1), &gui), &QShortcut::activated, [&](){panel.show();});
@@ -0,0 +1,11 @@
+TEMPLATE        = app
+TARGET          = multigrid_scaling
+QT             -= core gui
+CONFIG         += c++11 release console
+CONFIG         -= app_bundle
+INCLUDEPATH    += $$PWD/../../external/eigen
+INCLUDEPATH    += $$PWD/../../include
+DATA_PATH       = \\\"$$PWD/../data/\\\"
+DEFINES        += DATA_PATH=$$DATA_PATH
+SOURCES        += main.cpp
+LIBS           += -pthread
@@ -0,0 +1,102 @@
+/* This sample program compares the scaling of direct and iterative solvers
+ * on heat flow problems (M - t * L) u = u0 defined on hexahedral meshes of
+ * increasing resolution. Meshes are obtained by repeatedly refining a coarse
+ * hexmesh with the hex_to_grid_2x2x2 schema, and the refinement maps are used
+ * to build a geometric multigrid preconditioner for CG. For comparison, the
+ * same systems are also solved with a sparse Cholesky factorization and with
+ * CG preconditioned by algebraic multigrid, which does not need the hierarchy.
+ * Sparse factorizations of volumetric meshes suffer from massive fill-in, and
+ * the direct solver is skipped for meshes with more than 100K vertices.
+ *
+ * Usage: ./multigrid_scaling [coarse_hexmesh] [refinement_levels]
+ *
+ * Enjoy!
+*/
+
+#include <cinolib/meshes/meshes.h>
+#include <cinolib/hex_subdivision.h>
+#include <cinolib/laplacian.h>
+#include <cinolib/vertex_mass.h>
+#include <cinolib/linear_solvers.h>
+#include <cinolib/iterative_solvers.h>
+#include <cinolib/profiler.h>
+#include <cstdio>
+
+int main(int argc, char **argv)
+{
+    using namespace cinolib;
+
+    std::string s = (argc>1) ? std::string(argv[1]) : std::string(DATA_PATH) + "/ellipsoid.mesh";
+    uint n_levels = (argc>2) ? atoi(argv[2]) : 2;
+
+    std::vector<Hexmesh<>>                   meshes(1, Hexmesh<>(s.c_str()));
+    std::vector<Eigen::SparseMatrix<double>> refinement_maps;
+    for(uint l=0; l<n_levels; ++l)
+    {
+        Hexmesh<> m;
+        Eigen::SparseMatrix<double> R;
+        hex_subdivision(meshes.back(), hex_to_grid_2x2x2, m, R);
+        meshes.push_back(m);
+        refinement_maps.push_back(R);
+    }
+
+    struct Row { uint nv; double llt = -1, amg = -1, gmg = -1; uint amg_it = 0, gmg_it = 0; };
+    std::vector<Row> table;
+    Profiler profiler;
+
+    for(uint l=0; l<meshes.size(); ++l)
+    {
+        const Hexmesh<> & m = meshes.at(l);
+        double t = m.edge_avg_length();
+        Eigen::SparseMatrix<double> A   = mass_matrix(m) - t * t * laplacian(m, UNIFORM);
+        Eigen::VectorXd             rhs = Eigen::VectorXd::Zero(m.num_verts());
+        rhs[0] = 1.0;
+
+        Row row;
+        row.nv = m.num_verts();
+
+        Eigen::VectorXd x_llt, x_amg, x_gmg;
+
+        if (row.nv <= 100000)
+        {
+            profiler.push("SIMPLICIAL_LLT (" + std::to_string(row.nv) + " verts)");
+            LinearSolver(A).solve(rhs, x_llt);
+            row.llt = profiler.pop();
+        }
+
+        profiler.push("CG + AMG (" + std::to_string(row.nv) + " verts)");
+        IterativeSolver amg(PRECOND_AMG);
+        amg.compute(A);
+        row.amg_it = amg.solve(rhs, x_amg).iterations;
+        row.amg = profiler.pop();
+
+        if (l > 0)
+        {
+            // refinement maps from the coarse mesh up to the current level
+            std::vector<Eigen::SparseMatrix<double>> maps(refinement_maps.begin(), refinement_maps.begin()+l);
+            profiler.push("CG + GMG (" + std::to_string(row.nv) + " verts)");
+            IterativeSolver gmg;
+            gmg.compute(A, maps);
+            row.gmg_it = gmg.solve(rhs, x_gmg).iterations;
+            row.gmg = profiler.pop();
+        }
+
+        table.push_back(row);
+    }
+
+    auto time_str = [](const double t)
+    {
+        char buf[32];
+        if (t < 0) snprintf(buf, 32, "%14s", "-"); else snprintf(buf, 32, "%14.3f", t);
+        return std::string(buf);
+    };
+
+    printf("\n%10s | %14s | %14s %6s | %14s %6s\n", "#verts", "LLT [s]", "CG+AMG [s]", "iters", "CG+GMG [s]", "iters");
+    for(const Row & r : table)
+    {
+        printf("%10u | %s | %s %6u | %s %6u\n", r.nv, time_str(r.llt).c_str(),
+                                                   time_str(r.amg).c_str(), r.amg_it,
+                                                   time_str(r.gmg).c_str(), r.gmg_it);
+    }
+    return 0;
+}
@@ -0,0 +1,164 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/ambient_occlusion.h>
+#include <cinolib/sphere_coverage.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/pi.h>
+#include <algorithm>
+#include <assert.h>
+
+namespace cinolib
+{
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+AmbientOcclusion::AmbientOcclusion(const AbstractPolygonMesh<M,V,E,P> & m,
+                                   const double                         max_dist)
+    : rc(m)
+    , verts(m.vector_verts())
+    , max_dist((max_dist > 0) ? max_dist : m.bbox().diag())
+    , offset(1e-4 * m.bbox().diag())
+{
+    normals.resize(m.num_verts());
+    for(uint vid=0; vid<m.num_verts(); ++vid) normals[vid] = m.vert_data(vid).normal;
+    reset();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void AmbientOcclusion::reset()
+{
+    visible_wgt.assign(verts.size(), 0.0);
+    total_wgt.assign(verts.size(), 0.0);
+    n_samples = 0;
+    n_passes  = 0;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+float AmbientOcclusion::AO(const uint vid) const
+{
+    return (total_wgt.at(vid) > 0) ? float(visible_wgt.at(vid) / total_wgt.at(vid)) : 1.f;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void AmbientOcclusion::refine(const uint n)
+{
+    if (n == 0) return;
+
+    // hemisphere directions in local coordinates (y being the normal)
+    std::vector<vec3d> sphere, dirs;
+    sphere_coverage(2*n, sphere);
+    for(const vec3d & d : sphere) if (d.y() > 0) dirs.push_back(d);
+
+    uint pass = n_passes;
+    PARALLEL_FOR(0, verts.size(), 64, [&](const uint vid)
+    {
+        vec3d nrm = normals[vid];
+        if (nrm.length() == 0) return; // isolated or degenerate vertex
+
+        // local frame, randomly rotated about the normal (decorrelates the
+        // lattice between nearby vertices and successive passes)
+        vec3d  u     = (std::fabs(nrm.x()) < 0.9) ? vec3d(1,0,0) : vec3d(0,1,0);
+        vec3d  t     = nrm.cross(u); t.normalize();
+        vec3d  b     = nrm.cross(t);
+        uint   h     = (vid + 1) * 2654435761u ^ (pass + 1) * 40503u;
+        double angle = 2.0 * M_PI * double(h % 65536) / 65536.0;
+        vec3d  tt    = t*cos(angle) + b*sin(angle);
+        vec3d  bb    = nrm.cross(tt);
+        vec3d  orig  = verts[vid] + nrm * offset;
+
+        double visible = 0, total = 0;
+        for(uint i=0; i<dirs.size(); i+=RAY_PACKET_SIZE)
+        {
+            RayPacket rays;
+            double    wgt[RAY_PACKET_SIZE];
+            for(uint j=0; j<RAY_PACKET_SIZE; ++j)
+            {
+                // incomplete packets are filled with copies of the last ray (with zero weight)
+                uint  k = std::min(i+j, uint(dirs.size()-1));
+                vec3d d = tt*dirs[k].x() + nrm*dirs[k].y() + bb*dirs[k].z();
+                wgt[j]  = (i+j < dirs.size()) ? dirs[k].y() : 0.0; // cosine weight
+                ray_packet_set(rays, j, orig, d, 0.0, max_dist);
+            }
+            uint hits = rc.any_hit(rays);
+            for(uint j=0; j<RAY_PACKET_SIZE; ++j)
+            {
+                total += wgt[j];
+                if (!(hits & (1u << j))) visible += wgt[j];
+            }
+        }
+        visible_wgt[vid] += visible;
+        total_wgt[vid]   += total;
+    });
+
+    n_samples += dirs.size();
+    ++n_passes;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AmbientOcclusion::copy_to_mesh(AbstractPolygonMesh<M,V,E,P> & m) const
+{
+    assert(m.num_verts() == verts.size());
+    for(uint vid=0; vid<m.num_verts(); ++vid) m.vert_data(vid).AO = AO(vid);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void bake_ambient_occlusion(AbstractPolygonMesh<M,V,E,P> & m,
+                            const uint                     n_samples,
+                            const double                   max_dist,
+                            const uint                     pass_size)
+{
+    assert(pass_size > 0);
+    AmbientOcclusion ao(m, max_dist);
+    while(ao.samples_per_vert() < n_samples)
+    {
+        ao.refine(std::min(pass_size, n_samples - ao.samples_per_vert()));
+    }
+    ao.copy_to_mesh(m);
+}
+
+}
@@ -0,0 +1,115 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_AMBIENT_OCCLUSION_H
+#define CINO_AMBIENT_OCCLUSION_H
+
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/ray_caster.h>
+#include <cinolib/meshes/abstract_polygonmesh.h>
+
+namespace cinolib
+{
+
+/* Object space ambient occlusion, baked per vertex. For each vertex, rays
+ * are cast along directions of the hemisphere centered at the vertex normal
+ * (taken from a spherical Fibonacci lattice, see sphere_coverage, randomly
+ * rotated about the normal for each vertex and pass), and the cosine weighted
+ * fraction of rays that do not hit the mesh within max_dist is accumulated.
+ * Rays are traced in packets against a BVH (see RayCaster), and vertices
+ * are processed in parallel.
+ *
+ * Refinement is progressive: each call to refine() casts more rays, and the
+ * estimate improves as the number of samples grows. Results can be copied
+ * into vert_data().AO at any time, and rendered by drawable meshes at no
+ * additional per frame cost (see show_AO).
+*/
+
+class AmbientOcclusion
+{
+    public:
+
+        template<class M, class V, class E, class P>
+        explicit AmbientOcclusion(const AbstractPolygonMesh<M,V,E,P> & m,
+                                  const double                         max_dist = 0.0); // zero = bbox diagonal
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void refine(const uint n_samples); // casts n_samples more rays per vertex
+        void reset();
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        uint  samples_per_vert() const { return n_samples; }
+        float AO(const uint vid) const;
+
+        template<class M, class V, class E, class P>
+        void copy_to_mesh(AbstractPolygonMesh<M,V,E,P> & m) const;
+
+    protected:
+
+        RayCaster           rc;
+        std::vector<vec3d>  verts;
+        std::vector<vec3d>  normals;
+        std::vector<double> visible_wgt; // cosine weighted visible rays
+        std::vector<double> total_wgt;   // cosine weighted cast rays
+        double              max_dist;
+        double              offset;      // ray origins are offset along the normal to avoid self hits
+        uint                n_samples = 0;
+        uint                n_passes  = 0;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// One shot baking: refines the estimate in passes of pass_size samples
+// until n_samples rays per vertex have been cast, and stores the result
+// in vert_data().AO
+//
+template<class M, class V, class E, class P>
+CINO_INLINE
+void bake_ambient_occlusion(AbstractPolygonMesh<M,V,E,P> & m,
+                            const uint                     n_samples = 128,
+                            const double                   max_dist  = 0.0,
+                            const uint                     pass_size = 32);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "ambient_occlusion.cpp"
+#endif
+
+#endif // CINO_AMBIENT_OCCLUSION_H
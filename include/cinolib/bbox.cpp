@@ -151,4 +151,86 @@ std::vector<vec3d> Bbox::corners(const double scaling_factor) const
     return c;
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Bbox::add(const vec3d & p)
+{
+    min = min.min(p);
+    max = max.max(p);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Bbox::add(const Bbox & bb)
+{
+    min = min.min(bb.min);
+    max = max.max(bb.max);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Bbox::contains(const vec3d & p) const
+{
+    return p.x() >= min.x() && p.y() >= min.y() && p.z() >= min.z() &&
+           p.x() <= max.x() && p.y() <= max.y() && p.z() <= max.z();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Bbox::intersects(const Bbox & bb) const
+{
+    return min.x() <= bb.max.x() && min.y() <= bb.max.y() && min.z() <= bb.max.z() &&
+           max.x() >= bb.min.x() && max.y() >= bb.min.y() && max.z() >= bb.min.z();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double Bbox::dist_sqrd(const vec3d & p) const
+{
+    double d = 0.0;
+    for(uint i=0; i<3; ++i)
+    {
+             if (p[i] < min[i]) d += (min[i] - p[i]) * (min[i] - p[i]);
+        else if (p[i] > max[i]) d += (p[i] - max[i]) * (p[i] - max[i]);
+    }
+    return d;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint Bbox::longest_axis() const
+{
+    vec3d d = delta();
+    if (d.x() >= d.y() && d.x() >= d.z()) return 0;
+    if (d.y() >= d.z()) return 1;
+    return 2;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Bbox::intersects_ray(const vec3d  & orig,
+                          const vec3d  & inv_dir,
+                                double & t_min,
+                                double & t_max) const
+{
+    for(uint i=0; i<3; ++i)
+    {
+        double t0 = (min[i] - orig[i]) * inv_dir[i];
+        double t1 = (max[i] - orig[i]) * inv_dir[i];
+        if (t0 > t1) std::swap(t0,t1);
+        // written such that NaNs (0*inf, ray parallel to a slab) are ignored
+        t_min = (t0 > t_min) ? t0 : t_min;
+        t_max = (t1 < t_max) ? t1 : t_max;
+        if (t_min > t_max) return false;
+    }
+    return true;
+}
+
 }
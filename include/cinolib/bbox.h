@@ -64,6 +64,23 @@ class Bbox
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+        void               add(const vec3d & p);
+        void               add(const Bbox & bb);
+        bool               contains(const vec3d & p) const;
+        bool               intersects(const Bbox & bb) const;
+        double             dist_sqrd(const vec3d & p) const; // zero if p is inside
+        uint               longest_axis() const;
+
+        // slab test. Clips the ray parameter range [t_min,t_max] to the box
+        // and returns false if the clipped range is empty. inv_dir is the
+        // component wise inverse of the ray direction (inf values are fine)
+        bool               intersects_ray(const vec3d  & orig,
+                                          const vec3d  & inv_dir,
+                                                double & t_min,
+                                                double & t_max) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
         vec3d min, max;
 };
 
@@ -0,0 +1,254 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/bvh.h>
+#include <algorithm>
+#include <assert.h>
+
+namespace cinolib
+{
+
+CINO_INLINE
+BVH::BVH(const std::vector<Bbox> & item_boxes, const uint max_items_per_leaf)
+{
+    build(item_boxes, max_items_per_leaf);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::clear()
+{
+    nodes.clear();
+    items.clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::build(const std::vector<Bbox> & item_boxes, const uint max_items_per_leaf)
+{
+    assert(max_items_per_leaf > 0);
+
+    clear();
+    if (item_boxes.empty()) return;
+
+    std::vector<vec3d> centroids(item_boxes.size());
+    items.resize(item_boxes.size());
+    for(uint i=0; i<item_boxes.size(); ++i)
+    {
+        centroids[i] = item_boxes[i].center();
+        items[i]     = i;
+    }
+
+    // a binary tree with n leaves has 2n-1 nodes
+    nodes.reserve(2*(item_boxes.size()/max_items_per_leaf + 1));
+
+    BVHNode root;
+    root.beg = 0;
+    root.end = items.size();
+    nodes.push_back(root);
+
+    std::vector<uint> stack(1,0);
+    while(!stack.empty())
+    {
+        uint nid = stack.back();
+        stack.pop_back();
+
+        uint beg = nodes[nid].beg;
+        uint end = nodes[nid].end;
+
+        Bbox bb, centroids_bb;
+        for(uint i=beg; i<end; ++i)
+        {
+            bb.add(item_boxes[items[i]]);
+            centroids_bb.add(centroids[items[i]]);
+        }
+        nodes[nid].bbox    = bb;
+        nodes[nid].is_leaf = (end-beg <= max_items_per_leaf) || (centroids_bb.diag() == 0.0);
+
+        if (nodes[nid].is_leaf) continue;
+
+        uint axis = centroids_bb.longest_axis();
+        uint mid  = beg + (end-beg)/2;
+        std::nth_element(items.begin()+beg, items.begin()+mid, items.begin()+end,
+                         [&](const uint a, const uint b) { return centroids[a][axis] < centroids[b][axis]; });
+
+        BVHNode left, right;
+        left.beg  = beg; left.end  = mid;
+        right.beg = mid; right.end = end;
+
+        nodes[nid].children[0] = nodes.size(); nodes.push_back(left);
+        nodes[nid].children[1] = nodes.size(); nodes.push_back(right);
+
+        stack.push_back(nodes[nid].children[0]);
+        stack.push_back(nodes[nid].children[1]);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint BVH::depth() const
+{
+    if (nodes.empty()) return 0;
+
+    uint max_depth = 0;
+    std::vector<std::pair<uint,uint>> stack(1, std::make_pair(0,1));
+    while(!stack.empty())
+    {
+        uint nid   = stack.back().first;
+        uint depth = stack.back().second;
+        stack.pop_back();
+
+        max_depth = std::max(max_depth, depth);
+        if (!nodes[nid].is_leaf)
+        {
+            stack.push_back(std::make_pair(nodes[nid].children[0], depth+1));
+            stack.push_back(std::make_pair(nodes[nid].children[1], depth+1));
+        }
+    }
+    return max_depth;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::items_containing(const vec3d & p, std::vector<uint> & res) const
+{
+    res.clear();
+    if (nodes.empty()) return;
+
+    std::vector<uint> stack(1,0);
+    while(!stack.empty())
+    {
+        const BVHNode & n = nodes[stack.back()];
+        stack.pop_back();
+
+        if (!n.bbox.contains(p)) continue;
+
+        if (n.is_leaf)
+        {
+            for(uint i=n.beg; i<n.end; ++i) res.push_back(items[i]);
+        }
+        else
+        {
+            stack.push_back(n.children[0]);
+            stack.push_back(n.children[1]);
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::items_intersecting(const Bbox & bb, std::vector<uint> & res) const
+{
+    res.clear();
+    if (nodes.empty()) return;
+
+    std::vector<uint> stack(1,0);
+    while(!stack.empty())
+    {
+        const BVHNode & n = nodes[stack.back()];
+        stack.pop_back();
+
+        if (!n.bbox.intersects(bb)) continue;
+
+        if (n.is_leaf)
+        {
+            for(uint i=n.beg; i<n.end; ++i) res.push_back(items[i]);
+        }
+        else
+        {
+            stack.push_back(n.children[0]);
+            stack.push_back(n.children[1]);
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class DistFunc>
+CINO_INLINE
+bool BVH::closest_item(const vec3d    & p,
+                       const DistFunc & item_dist_sqrd,
+                             uint     & id,
+                             double   & dist_sqrd,
+                       const double     max_dist_sqrd) const
+{
+    bool found = false;
+    dist_sqrd  = max_dist_sqrd;
+    if (nodes.empty()) return false;
+
+    std::vector<uint> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+
+    while(!stack.empty())
+    {
+        const BVHNode & n = nodes[stack.back()];
+        stack.pop_back();
+
+        if (n.bbox.dist_sqrd(p) >= dist_sqrd) continue;
+
+        if (n.is_leaf)
+        {
+            for(uint i=n.beg; i<n.end; ++i)
+            {
+                double d = item_dist_sqrd(items[i]);
+                if (d < dist_sqrd)
+                {
+                    dist_sqrd = d;
+                    id        = items[i];
+                    found     = true;
+                }
+            }
+        }
+        else
+        {
+            uint   c0 = n.children[0];
+            uint   c1 = n.children[1];
+            double d0 = nodes[c0].bbox.dist_sqrd(p);
+            double d1 = nodes[c1].bbox.dist_sqrd(p);
+            if (d0 < d1) std::swap(c0,c1); // push the farthest first
+            stack.push_back(c0);
+            stack.push_back(c1);
+        }
+    }
+    return found;
+}
+
+}
@@ -0,0 +1,125 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_BVH_H
+#define CINO_BVH_H
+
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/bbox.h>
+
+namespace cinolib
+{
+
+/* Bounding Volume Hierarchy (binary tree of axis aligned bounding boxes)
+ * built on top of a generic list of items (e.g. the triangles of a mesh),
+ * each represented by its bounding box. The tree is stored as a flat array
+ * of nodes (the root being node 0), and items are reordered so that each
+ * node covers a contiguous range [beg,end) of the sorted list of items.
+ * Algorithms that need per item data (e.g. triangle coordinates) can store
+ * it following the same order to get a cache friendly memory layout.
+ *
+ * The hierarchy is built top down, splitting nodes along the longest axis
+ * of the box enclosing the item centroids, at the median item.
+*/
+
+typedef struct
+{
+    Bbox bbox;
+    uint children[2]; // valid for internal nodes only
+    uint beg;         // range of (sorted) items contained in the node
+    uint end;
+    bool is_leaf;
+}
+BVHNode;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class BVH
+{
+    protected:
+
+        std::vector<BVHNode> nodes;
+        std::vector<uint>    items; // item ids, sorted according to the tree
+
+    public:
+
+        explicit BVH() {}
+        explicit BVH(const std::vector<Bbox> & item_boxes, const uint max_items_per_leaf = 4);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void build(const std::vector<Bbox> & item_boxes, const uint max_items_per_leaf = 4);
+        void clear();
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        uint            num_nodes()             const { return nodes.size();  }
+        uint            num_items()             const { return items.size();  }
+        const BVHNode & node(const uint nid)    const { return nodes[nid];    }
+        uint            item(const uint pos)    const { return items[pos];    }
+        const Bbox    & bbox()                  const { return nodes.front().bbox; }
+        bool            empty()                 const { return nodes.empty(); }
+        uint            depth()                 const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // ids of the items stored in the leaves whose bbox contains p (resp.
+        // intersects bb). This is a superset of the items actually containing
+        // p (resp. intersecting bb), and should be filtered by the caller
+        void items_containing  (const vec3d & p,  std::vector<uint> & res) const;
+        void items_intersecting(const Bbox  & bb, std::vector<uint> & res) const;
+
+        // Item closest to p. The squared distance between p and an item is
+        // evaluated by the callback item_dist_sqrd(item_id). Only items closer
+        // than sqrt(max_dist_sqrd) are considered. Returns false if there are
+        // no such items. Subtrees farther than the closest item found so far
+        // are pruned, and the closest child of each node is visited first
+        template<class DistFunc>
+        bool closest_item(const vec3d    & p,
+                          const DistFunc & item_dist_sqrd,
+                                uint     & id,
+                                double   & dist_sqrd,
+                          const double     max_dist_sqrd = inf_double) const;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "bvh.cpp"
+#endif
+
+#endif // CINO_BVH_H
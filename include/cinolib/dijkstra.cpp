@@ -34,104 +34,104 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/dijkstra.h>
-#include <cinolib/min_max_inf.h>
-#include <cinolib/stl_container_utilities.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
 
 namespace cinolib
 {
 
-//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
-
-// LITTLE NOTE ON MY DIJKSTRA IMPLEMENTATIONS: why std::set and not
-// std::unordered_set or std::priority_queue?
-//
-// The reason why I am using std::set is that Dijkstra requires priority
-// update, which is supported by none of the STL containers. Options are:
-//
-//  1) remove an element and re-add it with updated priority. In this
-//     case std::set has the best remove performances
-//
-//  2) leave "dead" copies of an element in the container, and just add a
-//     new copy each time its priority needs an update. Regardless the waste
-//     of memory, which is an issue by itself, in this case at each iteration
-//     you need a mechanism that allows you to discard the current element
-//     if it is not the one with the most recent priority...
-//
-// I therefore decided to go for (1).
-// See also:
-// https://stackoverflow.com/questions/649640/how-to-do-an-efficient-priority-update-in-stl-priority-queue
+template<class M, class V, class E, class P>
+CINO_INLINE
+DijkstraGraph dijkstra_graph(const AbstractMesh<M,V,E,P> & m)
+{
+    DijkstraGraph g;
+    g.pos = m.vector_verts();
+    g.offset.resize(m.num_verts()+1);
+    g.offset.front() = 0;
+    for(uint vid=0; vid<m.num_verts(); ++vid)
+    {
+        g.offset.at(vid+1) = g.offset.at(vid) + m.adj_v2v(vid).size();
+    }
+    g.nbrs.resize(g.offset.back());
+    g.weights.resize(g.offset.back());
+    PARALLEL_FOR(0, m.num_verts(), 1000, [&](const uint vid)
+    {
+        uint j = g.offset[vid];
+        for(uint nbr : m.adj_v2v(vid))
+        {
+            g.nbrs[j]    = nbr;
+            g.weights[j] = g.pos[vid].dist(g.pos[nbr]);
+            ++j;
+        }
+    });
+    return g;
+}
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 template<class M, class V, class E, class P>
 CINO_INLINE
-void dijkstra_exhaustive(const AbstractMesh<M,V,E,P> & m,
-                         const uint                    source,
-                               std::vector<double>   & distances)
+DijkstraGraph dijkstra_dual_graph(const AbstractMesh<M,V,E,P> & m)
 {
-    distances = std::vector<double>(m.num_verts(), inf_double);
-    distances.at(source) = 0.0;
-
-    std::set<std::pair<double,uint>> active_set;
-    active_set.insert(std::make_pair(0.0,source));
-
-    while(!active_set.empty())
+    DijkstraGraph g;
+    g.pos.resize(m.num_polys());
+    g.offset.resize(m.num_polys()+1);
+    g.offset.front() = 0;
+    for(uint pid=0; pid<m.num_polys(); ++pid)
     {
-        uint vid = active_set.begin()->second;
-        active_set.erase(active_set.begin());
-
-        for(uint nbr : m.adj_v2v(vid))
+        g.offset.at(pid+1) = g.offset.at(pid) + m.adj_p2p(pid).size();
+    }
+    g.nbrs.resize(g.offset.back());
+    g.weights.resize(g.offset.back());
+    PARALLEL_FOR(0, m.num_polys(), 1000, [&](const uint pid)
+    {
+        g.pos[pid] = m.poly_centroid(pid);
+    });
+    PARALLEL_FOR(0, m.num_polys(), 1000, [&](const uint pid)
+    {
+        uint j = g.offset[pid];
+        for(uint nbr : m.adj_p2p(pid))
         {
-            double new_dist = distances.at(vid) + m.vert(vid).dist(m.vert(nbr));
-
-            if (distances.at(nbr) > new_dist)
-            {
-                if (distances.at(nbr) < inf_double) // otherwise it won't be found
-                {
-                    auto it = active_set.find(std::make_pair(distances.at(nbr),nbr));
-                    assert(it!=active_set.end());
-                    active_set.erase(it);
-                }
-                distances.at(nbr) = new_dist;
-                active_set.insert(std::make_pair(new_dist,nbr));
-            }
+            g.nbrs[j]    = nbr;
+            g.weights[j] = g.pos[pid].dist(g.pos[nbr]);
+            ++j;
         }
-    }
+    });
+    return g;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-template<class M, class V, class E, class P>
 CINO_INLINE
-void dijkstra_exhaustive(const AbstractMesh<M,V,E,P> & m,
+void dijkstra_exhaustive(const DijkstraGraph         & g,
                          const std::vector<uint>     & sources,
-                               std::vector<double>   & distances)
+                               std::vector<double>   & distances,
+                         const double                  max_dist,
+                               IndexedHeap<double>   * heap)
 {
-    distances = std::vector<double>(m.num_verts(), inf_double);
-    for(uint vid : sources) distances.at(vid) = 0.0;
+    IndexedHeap<double> local_heap;
+    if(heap==nullptr) heap = &local_heap;
+    if(heap->max_id() < g.num_nodes()) heap->resize(g.num_nodes());
+    heap->clear();
 
-    std::set<std::pair<double,uint>> active_set;
-    for(uint vid : sources) active_set.insert(std::make_pair(0.0,vid));
-
-    while(!active_set.empty())
+    distances.assign(g.num_nodes(), inf_double);
+    for(uint id : sources)
     {
-        uint vid = active_set.begin()->second;
-        active_set.erase(active_set.begin());
+        distances.at(id) = 0.0;
+        heap->push_or_decrease(id, 0.0);
+    }
 
-        for(uint nbr : m.adj_v2v(vid))
+    while(!heap->empty())
+    {
+        uint id = heap->pop();
+        for(uint j=g.offset[id]; j<g.offset[id+1]; ++j)
         {
-            double new_dist = distances.at(vid) + m.vert(vid).dist(m.vert(nbr));
-
-            if (distances.at(nbr) > new_dist)
+            uint   nbr      = g.nbrs[j];
+            double new_dist = distances[id] + g.weights[j];
+            if(new_dist < distances[nbr] && new_dist <= max_dist)
             {
-                if (distances.at(nbr) < inf_double) // otherwise it won't be found
-                {
-                    auto it = active_set.find(std::make_pair(distances.at(nbr),nbr));
-                    assert(it!=active_set.end());
-                    active_set.erase(it);
-                }
-                distances.at(nbr) = new_dist;
-                active_set.insert(std::make_pair(new_dist,nbr));
+                distances[nbr] = new_dist;
+                heap->push_or_decrease(nbr, new_dist);
             }
         }
     }
@@ -139,256 +139,321 @@ void dijkstra_exhaustive(const AbstractMesh<M,V,E,P> & m,
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-template<class M, class V, class E, class P>
 CINO_INLINE
-void dijkstra(const AbstractMesh<M,V,E,P> & m,
-              const uint                    source,
-              const uint                    dest,
-                    std::vector<uint>     & path)
+void dijkstra_exhaustive_batch(const DijkstraGraph                    & g,
+                               const std::vector<uint>                & sources,
+                                     std::vector<std::vector<double>> & distances,
+                               const double                             max_dist)
 {
-    path.clear();
+    distances.resize(sources.size());
+    // one heap per chunk, reused for all the sources in the chunk
+    PARALLEL_FOR_CHUNKS(0, sources.size(), 0, [&](const uint beg, const uint end, const uint)
+    {
+        IndexedHeap<double> heap(g.num_nodes());
+        for(uint i=beg; i<end; ++i)
+        {
+            dijkstra_exhaustive(g, {sources.at(i)}, distances.at(i), max_dist, &heap);
+        }
+    });
+}
 
-    std::vector<int> prev(m.num_verts(), -1);
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    std::vector<double> dist(m.num_verts(), inf_double);
+CINO_INLINE
+double dijkstra(const DijkstraGraph       & g,
+                const uint                  source,
+                const std::vector<bool>   & is_dest,
+                const std::vector<bool>   & mask,
+                      std::vector<uint>   & path)
+{
+    path.clear();
+    assert(is_dest.size() == g.num_nodes());
+    assert(mask.empty() || mask.size() == g.num_nodes());
+
+    std::vector<int>    prev(g.num_nodes(), -1);
+    std::vector<double> dist(g.num_nodes(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> active_set;
-    active_set.insert(std::make_pair(0.0,source));
+    IndexedHeap<double> heap(g.num_nodes());
+    heap.push(source, 0.0);
 
-    while(!active_set.empty())
+    while(!heap.empty())
     {
-        uint vid = active_set.begin()->second;
-        active_set.erase(active_set.begin());
+        uint id = heap.pop();
 
-        if (vid==dest)
+        if(is_dest.at(id))
         {
-            int tmp = vid;
+            int tmp = id;
             do { path.push_back(tmp); tmp = prev.at(tmp); } while (tmp != -1);
             std::reverse(path.begin(), path.end());
-            return;
+            return dist.at(id);
         }
 
-        for(uint nbr : m.adj_v2v(vid))
+        for(uint j=g.offset[id]; j<g.offset[id+1]; ++j)
         {
-            double new_dist = dist.at(vid) + m.vert(vid).dist(m.vert(nbr));
+            uint nbr = g.nbrs[j];
+            if(!mask.empty() && mask[nbr]) continue;
 
-            if (dist.at(nbr) > new_dist)
+            double new_dist = dist[id] + g.weights[j];
+            if(new_dist < dist[nbr])
             {
-                if (dist.at(nbr) < inf_double) // otherwise it won't be found
-                {
-                    auto it = active_set.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=active_set.end());
-                    active_set.erase(it);
-                }
-                dist.at(nbr) = new_dist;
-                prev.at(nbr) = vid;
-                active_set.insert(std::make_pair(new_dist,nbr));
+                dist[nbr] = new_dist;
+                prev[nbr] = id;
+                heap.push_or_decrease(nbr, new_dist);
             }
         }
     }
-    assert(false && "Dijkstra did not converge!");
+    return inf_double;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-// Shortest path (with barriers). The path cannot
-// pass throuh vertices for which mask[v] = true
-//
-template<class M, class V, class E, class P>
 CINO_INLINE
-void dijkstra(const AbstractMesh<M,V,E,P> & m,
-              const uint                    source,
-              const uint                    dest,
-              const std::vector<bool>     & mask,
-                    std::vector<uint>     & path)
+double dijkstra_astar(const DijkstraGraph       & g,
+                      const uint                  source,
+                      const uint                  dest,
+                      const std::vector<bool>   & mask,
+                            std::vector<uint>   & path)
 {
     path.clear();
-    assert(mask.size() == m.num_verts());
+    assert(mask.empty() || mask.size() == g.num_nodes());
 
-    std::vector<int> prev(m.num_verts(), -1);
-
-    std::vector<double> dist(m.num_verts(), inf_double);
+    std::vector<int>    prev(g.num_nodes(), -1);
+    std::vector<double> dist(g.num_nodes(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> active_set;
-    active_set.insert(std::make_pair(0.0,source));
+    // nodes are sorted by dist + estimated distance from dest
+    const vec3d & target = g.pos.at(dest);
+    IndexedHeap<double> heap(g.num_nodes());
+    heap.push(source, g.pos.at(source).dist(target));
 
-    while(!active_set.empty())
+    while(!heap.empty())
     {
-        uint vid = active_set.begin()->second;
-        active_set.erase(active_set.begin());
+        uint id = heap.pop();
 
-        if (vid==dest)
+        if(id==dest)
         {
-            int tmp = vid;
+            int tmp = id;
             do { path.push_back(tmp); tmp = prev.at(tmp); } while (tmp != -1);
             std::reverse(path.begin(), path.end());
-            return;
+            return dist.at(id);
         }
 
-        for(uint nbr : m.adj_v2v(vid))
+        for(uint j=g.offset[id]; j<g.offset[id+1]; ++j)
         {
-            if (mask.at(nbr)) continue;
+            uint nbr = g.nbrs[j];
+            if(!mask.empty() && mask[nbr]) continue;
 
-            double new_dist = dist.at(vid) + m.vert(vid).dist(m.vert(nbr));
-
-            if (dist.at(nbr) > new_dist)
+            double new_dist = dist[id] + g.weights[j];
+            if(new_dist < dist[nbr])
             {
-                if (dist.at(nbr) < inf_double) // otherwise it won't be found
-                {
-                    auto it = active_set.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=active_set.end());
-                    active_set.erase(it);
-                }
-                dist.at(nbr) = new_dist;
-                prev.at(nbr) = vid;
-                active_set.insert(std::make_pair(new_dist,nbr));
+                dist[nbr] = new_dist;
+                prev[nbr] = id;
+                heap.push_or_decrease(nbr, new_dist + g.pos[nbr].dist(target));
             }
         }
     }
-    assert(false && "Dijkstra did not converge!");
+    return inf_double;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-// Shortest path (with barriers and multiple destinations). The path
-// cannot pass throuh vertices for which mask[v] = true. The algorithm
-// stops as soon as it reaches one of the destinations
-//
-template<class M, class V, class E, class P>
 CINO_INLINE
-void dijkstra(const AbstractMesh<M,V,E,P> & m,
-              const uint                    source,
-              const std::set<uint>        & dest,
-              const std::vector<bool>     & mask,
-                    std::vector<uint>     & path)
+double dijkstra_bidirectional(const DijkstraGraph       & g,
+                              const uint                  source,
+                              const uint                  dest,
+                              const std::vector<bool>   & mask,
+                                    std::vector<uint>   & path)
 {
     path.clear();
-    assert(mask.size() == m.num_verts());
+    assert(mask.empty() || mask.size() == g.num_nodes());
 
-    std::vector<int> prev(m.num_verts(), -1);
+    if(source==dest)
+    {
+        path.push_back(source);
+        return 0.0;
+    }
+    // as in the other variants, the source can be masked, the destination cannot
+    if(!mask.empty() && mask.at(dest)) return inf_double;
 
-    std::vector<double> dist(m.num_verts(), inf_double);
-    dist.at(source) = 0.0;
+    // search 0 grows from the source, search 1 grows from the destination
+    uint n = g.num_nodes();
+    std::vector<int>    prev[2] = { std::vector<int>(n,-1),           std::vector<int>(n,-1)           };
+    std::vector<double> dist[2] = { std::vector<double>(n,inf_double), std::vector<double>(n,inf_double) };
+    IndexedHeap<double> heap[2] = { IndexedHeap<double>(n),           IndexedHeap<double>(n)           };
+    dist[0].at(source) = 0.0; heap[0].push(source, 0.0);
+    dist[1].at(dest)   = 0.0; heap[1].push(dest,   0.0);
 
-    std::set<std::pair<double,uint>> active_set;
-    active_set.insert(std::make_pair(0.0,source));
+    double best = inf_double;
+    int    meet = -1;
 
-    while(!active_set.empty())
+    while(!heap[0].empty() && !heap[1].empty())
     {
-        uint vid = active_set.begin()->second;
-        active_set.erase(active_set.begin());
+        // no path through unsettled nodes can be shorter than the best one
+        if(heap[0].top_key() + heap[1].top_key() >= best) break;
 
-        if (CONTAINS(dest,vid))
-        {
-            int tmp = vid;
-            do { path.push_back(tmp); tmp = prev.at(tmp); } while (tmp != -1);
-            std::reverse(path.begin(), path.end());
-            return;
-        }
+        // expand the smallest frontier
+        uint s  = (heap[0].size() <= heap[1].size()) ? 0 : 1;
+        uint id = heap[s].pop();
 
-        for(uint nbr : m.adj_v2v(vid))
+        for(uint j=g.offset[id]; j<g.offset[id+1]; ++j)
         {
-            if (mask.at(nbr)) continue;
-
-            double new_dist = dist.at(vid) + m.vert(vid).dist(m.vert(nbr));
+            uint nbr = g.nbrs[j];
+            if(!mask.empty() && mask[nbr] && !(s==1 && nbr==source)) continue;
 
-            if (dist.at(nbr) > new_dist)
+            double new_dist = dist[s][id] + g.weights[j];
+            if(new_dist < dist[s][nbr])
+            {
+                dist[s][nbr] = new_dist;
+                prev[s][nbr] = id;
+                heap[s].push_or_decrease(nbr, new_dist);
+            }
+            if(dist[1-s][nbr] < inf_double && dist[s][nbr] + dist[1-s][nbr] < best)
             {
-                if (dist.at(nbr) < inf_double) // otherwise it won't be found
-                {
-                    auto it = active_set.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=active_set.end());
-                    active_set.erase(it);
-                }
-                dist.at(nbr) = new_dist;
-                prev.at(nbr) = vid;
-                active_set.insert(std::make_pair(new_dist,nbr));
+                best = dist[s][nbr] + dist[1-s][nbr];
+                meet = nbr;
             }
         }
     }
-    assert(false && "Dijkstra did not converge!");
+
+    if(meet==-1) return inf_double;
+
+    int tmp = meet;
+    do { path.push_back(tmp); tmp = prev[0].at(tmp); } while (tmp != -1);
+    std::reverse(path.begin(), path.end());
+    tmp = prev[1].at(meet);
+    while(tmp != -1) { path.push_back(tmp); tmp = prev[1].at(tmp); }
+    return best;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 template<class M, class V, class E, class P>
 CINO_INLINE
-void dijkstra_exhaustive_on_dual(const AbstractMesh<M,V,E,P> & m,
-                                 const uint                    source,
-                                       std::vector<double>   & distances)
+void dijkstra_exhaustive(const AbstractMesh<M,V,E,P> & m,
+                         const uint                    source,
+                               std::vector<double>   & distances,
+                         const DijkstraGraph         * g)
 {
-    distances = std::vector<double>(m.num_polys(), inf_double);
-    distances.at(source) = 0.0;
+    DijkstraGraph tmp;
+    const DijkstraGraph & G = (g!=nullptr) ? *g : (tmp = dijkstra_graph(m));
+    assert(G.num_nodes() == m.num_verts());
+    dijkstra_exhaustive(G, std::vector<uint>(1,source), distances);
+}
 
-    std::set<std::pair<double,uint>> active_set;
-    active_set.insert(std::make_pair(0.0,source));
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    while(!active_set.empty())
-    {
-        uint vid = active_set.begin()->second;
-        active_set.erase(active_set.begin());
+template<class M, class V, class E, class P>
+CINO_INLINE
+void dijkstra_exhaustive(const AbstractMesh<M,V,E,P> & m,
+                         const std::vector<uint>     & sources,
+                               std::vector<double>   & distances,
+                         const DijkstraGraph         * g)
+{
+    DijkstraGraph tmp;
+    const DijkstraGraph & G = (g!=nullptr) ? *g : (tmp = dijkstra_graph(m));
+    assert(G.num_nodes() == m.num_verts());
+    dijkstra_exhaustive(G, sources, distances);
+}
 
-        for(uint nbr : m.adj_p2p(vid))
-        {
-            double new_dist = distances.at(vid) + m.poly_centroid(vid).dist(m.poly_centroid(nbr));
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-            if (distances.at(nbr) > new_dist)
-            {
-                if (distances.at(nbr) < inf_double) // otherwise it won't be found
-                {
-                    auto it = active_set.find(std::make_pair(distances.at(nbr),nbr));
-                    assert(it!=active_set.end());
-                    active_set.erase(it);
-                }
-                distances.at(nbr) = new_dist;
-                active_set.insert(std::make_pair(new_dist,nbr));
-            }
-        }
+template<class M, class V, class E, class P>
+CINO_INLINE
+void dijkstra(const AbstractMesh<M,V,E,P> & m,
+              const uint                    source,
+              const uint                    dest,
+                    std::vector<uint>     & path,
+              const DijkstraGraph         * g)
+{
+    DijkstraGraph tmp;
+    const DijkstraGraph & G = (g!=nullptr) ? *g : (tmp = dijkstra_graph(m));
+    assert(G.num_nodes() == m.num_verts());
+    if(dijkstra_astar(G, source, dest, std::vector<bool>(), path) == inf_double)
+    {
+        assert(false && "Dijkstra did not converge!");
     }
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// Shortest path (with barriers). The path cannot
+// pass throuh vertices for which mask[v] = true
+//
 template<class M, class V, class E, class P>
 CINO_INLINE
-void dijkstra_exhaustive_on_dual(const AbstractMesh<M,V,E,P> & m,
-                                 const std::vector<uint>     & sources,
-                                       std::vector<double>   & distances)
+void dijkstra(const AbstractMesh<M,V,E,P> & m,
+              const uint                    source,
+              const uint                    dest,
+              const std::vector<bool>     & mask,
+                    std::vector<uint>     & path,
+              const DijkstraGraph         * g)
 {
-    distances = std::vector<double>(m.num_polys(), inf_double);
+    DijkstraGraph tmp;
+    const DijkstraGraph & G = (g!=nullptr) ? *g : (tmp = dijkstra_graph(m));
+    assert(G.num_nodes() == m.num_verts());
+    assert(mask.size() == m.num_verts());
+    if(dijkstra_astar(G, source, dest, mask, path) == inf_double)
+    {
+        assert(false && "Dijkstra did not converge!");
+    }
+}
 
-    std::set<std::pair<double,uint>> active_set;
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    for(uint s : sources)
+// Shortest path (with barriers and multiple destinations). The path
+// cannot pass throuh vertices for which mask[v] = true. The algorithm
+// stops as soon as it reaches one of the destinations
+//
+template<class M, class V, class E, class P>
+CINO_INLINE
+void dijkstra(const AbstractMesh<M,V,E,P> & m,
+              const uint                    source,
+              const std::set<uint>        & dest,
+              const std::vector<bool>     & mask,
+                    std::vector<uint>     & path,
+              const DijkstraGraph         * g)
+{
+    DijkstraGraph tmp;
+    const DijkstraGraph & G = (g!=nullptr) ? *g : (tmp = dijkstra_graph(m));
+    assert(G.num_nodes() == m.num_verts());
+    assert(mask.size() == m.num_verts());
+    std::vector<bool> is_dest(m.num_verts(), false);
+    for(uint vid : dest) is_dest.at(vid) = true;
+    if(dijkstra(G, source, is_dest, mask, path) == inf_double)
     {
-        distances.at(s) = 0.0;
-        active_set.insert(std::make_pair(0.0,s));
+        assert(false && "Dijkstra did not converge!");
     }
+}
 
-    while(!active_set.empty())
-    {
-        uint vid = active_set.begin()->second;
-        active_set.erase(active_set.begin());
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        for(uint nbr : m.adj_p2p(vid))
-        {
-            double new_dist = distances.at(vid) + m.poly_centroid(vid).dist(m.poly_centroid(nbr));
+template<class M, class V, class E, class P>
+CINO_INLINE
+void dijkstra_exhaustive_on_dual(const AbstractMesh<M,V,E,P> & m,
+                                 const uint                    source,
+                                       std::vector<double>   & distances,
+                                 const DijkstraGraph         * g)
+{
+    DijkstraGraph tmp;
+    const DijkstraGraph & G = (g!=nullptr) ? *g : (tmp = dijkstra_dual_graph(m));
+    assert(G.num_nodes() == m.num_polys());
+    dijkstra_exhaustive(G, std::vector<uint>(1,source), distances);
+}
 
-            if (distances.at(nbr) > new_dist)
-            {
-                if (distances.at(nbr) < inf_double) // otherwise it won't be found
-                {
-                    auto it = active_set.find(std::make_pair(distances.at(nbr),nbr));
-                    assert(it!=active_set.end());
-                    active_set.erase(it);
-                }
-                distances.at(nbr) = new_dist;
-                active_set.insert(std::make_pair(new_dist,nbr));
-            }
-        }
-    }
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void dijkstra_exhaustive_on_dual(const AbstractMesh<M,V,E,P> & m,
+                                 const std::vector<uint>     & sources,
+                                       std::vector<double>   & distances,
+                                 const DijkstraGraph         * g)
+{
+    DijkstraGraph tmp;
+    const DijkstraGraph & G = (g!=nullptr) ? *g : (tmp = dijkstra_dual_graph(m));
+    assert(G.num_nodes() == m.num_polys());
+    dijkstra_exhaustive(G, sources, distances);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -398,50 +463,16 @@ CINO_INLINE
 void dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
                       const uint                    source,
                       const uint                    dest,
-                            std::vector<uint>     & path)
+                            std::vector<uint>     & path,
+                      const DijkstraGraph         * g)
 {
-    path.clear();
-
-    std::vector<int> prev(m.num_polys(), -1);
-
-    std::vector<double> dist(m.num_polys(), inf_double);
-    dist.at(source) = 0.0;
-
-    std::set<std::pair<double,uint>> active_set;
-    active_set.insert(std::make_pair(0.0,source));
-
-    while(!active_set.empty())
+    DijkstraGraph tmp;
+    const DijkstraGraph & G = (g!=nullptr) ? *g : (tmp = dijkstra_dual_graph(m));
+    assert(G.num_nodes() == m.num_polys());
+    if(dijkstra_astar(G, source, dest, std::vector<bool>(), path) == inf_double)
     {
-        uint vid = active_set.begin()->second;
-        active_set.erase(active_set.begin());
-
-        if (vid==dest)
-        {
-            int tmp = vid;
-            do { path.push_back(tmp); tmp = prev.at(tmp); } while (tmp != -1);
-            std::reverse(path.begin(), path.end());
-            return;
-        }
-
-        for(uint nbr : m.adj_p2p(vid))
-        {
-            double new_dist = dist.at(vid) + m.poly_centroid(vid).dist(m.poly_centroid(nbr));
-
-            if (dist.at(nbr) > new_dist)
-            {
-                if (dist.at(nbr) < inf_double) // otherwise it won't be found
-                {
-                    auto it = active_set.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=active_set.end());
-                    active_set.erase(it);
-                }
-                dist.at(nbr) = new_dist;
-                prev.at(nbr) = vid;
-                active_set.insert(std::make_pair(new_dist,nbr));
-            }
-        }
+        assert(false && "Dijkstra did not converge!");
     }
-    assert(false && "Dijkstra did not converge!");
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -452,52 +483,16 @@ void dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
                       const uint                    source,
                       const uint                    dest,
                       const std::vector<bool>     & mask,
-                            std::vector<uint>     & path)
+                            std::vector<uint>     & path,
+                      const DijkstraGraph         * g)
 {
-    path.clear();
-
-    std::vector<int> prev(m.num_polys(), -1);
-
-    std::vector<double> dist(m.num_polys(), inf_double);
-    dist.at(source) = 0.0;
-
-    std::set<std::pair<double,uint>> active_set;
-    active_set.insert(std::make_pair(0.0,source));
-
-    while(!active_set.empty())
+    DijkstraGraph tmp;
+    const DijkstraGraph & G = (g!=nullptr) ? *g : (tmp = dijkstra_dual_graph(m));
+    assert(G.num_nodes() == m.num_polys());
+    if(dijkstra_astar(G, source, dest, mask, path) == inf_double)
     {
-        uint vid = active_set.begin()->second;
-        active_set.erase(active_set.begin());
-
-        if (vid==dest)
-        {
-            int tmp = vid;
-            do { path.push_back(tmp); tmp = prev.at(tmp); } while (tmp != -1);
-            std::reverse(path.begin(), path.end());
-            return;
-        }
-
-        for(uint nbr : m.adj_p2p(vid))
-        {
-            if (mask.at(nbr)) continue;
-
-            double new_dist = dist.at(vid) + m.poly_centroid(vid).dist(m.poly_centroid(nbr));
-
-            if (dist.at(nbr) > new_dist)
-            {
-                if (dist.at(nbr) < inf_double) // otherwise it won't be found
-                {
-                    auto it = active_set.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=active_set.end());
-                    active_set.erase(it);
-                }
-                dist.at(nbr) = new_dist;
-                prev.at(nbr) = vid;
-                active_set.insert(std::make_pair(new_dist,nbr));
-            }
-        }
+        assert(false && "Dijkstra did not converge!");
     }
-    assert(false && "Dijkstra did not converge!");
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -508,52 +503,18 @@ void dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
                       const uint                    source,
                       const std::set<uint>        & dest,
                       const std::vector<bool>     & mask,
-                            std::vector<uint>     & path)
+                            std::vector<uint>     & path,
+                      const DijkstraGraph         * g)
 {
-    path.clear();
-
-    std::vector<int> prev(m.num_polys(), -1);
-
-    std::vector<double> dist(m.num_polys(), inf_double);
-    dist.at(source) = 0.0;
-
-    std::set<std::pair<double,uint>> active_set;
-    active_set.insert(std::make_pair(0.0,source));
-
-    while(!active_set.empty())
+    DijkstraGraph tmp;
+    const DijkstraGraph & G = (g!=nullptr) ? *g : (tmp = dijkstra_dual_graph(m));
+    assert(G.num_nodes() == m.num_polys());
+    std::vector<bool> is_dest(m.num_polys(), false);
+    for(uint pid : dest) is_dest.at(pid) = true;
+    if(dijkstra(G, source, is_dest, mask, path) == inf_double)
     {
-        uint vid = active_set.begin()->second;
-        active_set.erase(active_set.begin());
-
-        if (CONTAINS(dest,vid))
-        {
-            int tmp = vid;
-            do { path.push_back(tmp); tmp = prev.at(tmp); } while (tmp != -1);
-            std::reverse(path.begin(), path.end());
-            return;
-        }
-
-        for(uint nbr : m.adj_p2p(vid))
-        {
-            if (mask.at(nbr)) continue;
-
-            double new_dist = dist.at(vid) + m.poly_centroid(vid).dist(m.poly_centroid(nbr));
-
-            if (dist.at(nbr) > new_dist)
-            {
-                if (dist.at(nbr) < inf_double) // otherwise it won't be found
-                {
-                    auto it = active_set.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=active_set.end());
-                    active_set.erase(it);
-                }
-                dist.at(nbr) = new_dist;
-                prev.at(nbr) = vid;
-                active_set.insert(std::make_pair(new_dist,nbr));
-            }
-        }
+        assert(false && "Dijkstra did not converge!");
     }
-    assert(false && "Dijkstra did not converge!");
 }
 
 }
@@ -40,11 +40,115 @@
 #include <sys/types.h>
 #include <vector>
 #include <cinolib/cino_inline.h>
+#include <cinolib/min_max_inf.h>
+#include <cinolib/indexed_heap.h>
 #include <cinolib/meshes/abstract_mesh.h>
 
 namespace cinolib
 {
 
+/* All the Dijkstra variants below run on a weighted graph stored in
+ * compressed (CSR) form: the neighbors of node i are nbrs[offset[i]] ...
+ * nbrs[offset[i+1]-1], and weights[j] is the length of the arc towards
+ * nbrs[j]. Arc lengths are computed once, when the graph is built, and
+ * a graph can be reused for any number of queries. The active set is an
+ * indexed d-ary heap with true decrease key (see indexed_heap.h).
+ *
+ * The mesh based functions (primal and dual) are kept for convenience:
+ * they call their graph based counterpart on the graph g, if provided, or
+ * build a temporary one otherwise. If many queries are needed, build the
+ * graph once with dijkstra_graph() (or dijkstra_dual_graph()) and pass it
+ * to the mesh based functions, or use the graph based functions directly.
+ * A graph passed to a mesh based function must be rebuilt whenever the
+ * mesh connectivity or geometry changes.
+*/
+
+struct DijkstraGraph
+{
+    std::vector<uint>   offset;  // size: num_nodes+1
+    std::vector<uint>   nbrs;
+    std::vector<double> weights;
+    std::vector<vec3d>  pos;     // node positions (used by the A* heuristic)
+
+    uint num_nodes() const { return pos.size(); }
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// vertices + edges, weighted by edge length
+template<class M, class V, class E, class P>
+CINO_INLINE
+DijkstraGraph dijkstra_graph(const AbstractMesh<M,V,E,P> & m);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// polys + adjacencies, weighted by distance between poly centroids
+template<class M, class V, class E, class P>
+CINO_INLINE
+DijkstraGraph dijkstra_dual_graph(const AbstractMesh<M,V,E,P> & m);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::: DIJKSTRAs ON GRAPHS ::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Distances from the closest source. The search stops at nodes farther than
+// max_dist (their distance remains inf_double). If a heap is provided it is
+// used as active set (it is handy to reuse the same heap for many queries)
+CINO_INLINE
+void dijkstra_exhaustive(const DijkstraGraph         & g,
+                         const std::vector<uint>     & sources,
+                               std::vector<double>   & distances,
+                         const double                  max_dist = inf_double,
+                               IndexedHeap<double>   * heap     = nullptr);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Same as above, for many independent sources: distances[i] contains the
+// distances from sources[i]. Sources are processed in parallel
+CINO_INLINE
+void dijkstra_exhaustive_batch(const DijkstraGraph                    & g,
+                               const std::vector<uint>                & sources,
+                                     std::vector<std::vector<double>> & distances,
+                               const double                             max_dist = inf_double);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Shortest path from source to the closest node for which is_dest[i] = true.
+// The path cannot pass through nodes for which mask[i] = true (an empty mask
+// means no barriers). The search stops as soon as a destination is reached.
+// Returns the path length (inf_double if no destination could be reached)
+CINO_INLINE
+double dijkstra(const DijkstraGraph       & g,
+                const uint                  source,
+                const std::vector<bool>   & is_dest,
+                const std::vector<bool>   & mask,
+                      std::vector<uint>   & path);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Point to point shortest path with A*, using the Euclidean distance between
+// node positions as heuristic. The heuristic is admissible only if arc weights
+// are not shorter than the distance between their endpoints, which is always
+// the case for graphs built with dijkstra_graph() and dijkstra_dual_graph()
+CINO_INLINE
+double dijkstra_astar(const DijkstraGraph       & g,
+                      const uint                  source,
+                      const uint                  dest,
+                      const std::vector<bool>   & mask, // if mask[i] = true, path cannot pass through it
+                            std::vector<uint>   & path);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Point to point shortest path with bidirectional Dijkstra: two searches
+// grow from source and dest, and stop as soon as they meet along a path that
+// cannot be further improved. Arcs must be symmetric (as for mesh graphs)
+CINO_INLINE
+double dijkstra_bidirectional(const DijkstraGraph       & g,
+                              const uint                  source,
+                              const uint                  dest,
+                              const std::vector<bool>   & mask, // if mask[i] = true, path cannot pass through it
+                                    std::vector<uint>   & path);
+
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 //:::::::::::::::: DIJKSTRAs ON PRIMAL GRAPH (VERTICES) ::::::::::::::::::
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -53,7 +157,8 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void dijkstra_exhaustive(const AbstractMesh<M,V,E,P> & m,
                          const uint                    source,
-                               std::vector<double>   & distances);
+                               std::vector<double>   & distances,
+                         const DijkstraGraph         * g = nullptr);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -61,7 +166,8 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void dijkstra_exhaustive(const AbstractMesh<M,V,E,P> & m,
                          const std::vector<uint>     & sources,
-                               std::vector<double>   & distances);
+                               std::vector<double>   & distances,
+                         const DijkstraGraph         * g = nullptr);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -70,7 +176,8 @@ CINO_INLINE
 void dijkstra(const AbstractMesh<M,V,E,P> & m,
               const uint                    source,
               const uint                    dest,
-                    std::vector<uint>     & path);
+                    std::vector<uint>     & path,
+              const DijkstraGraph         * g = nullptr);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -80,7 +187,8 @@ void dijkstra(const AbstractMesh<M,V,E,P> & m,
               const uint                    source,
               const uint                    dest,
               const std::vector<bool>     & mask, // if mask[v] = true, path cannot pass through it
-                    std::vector<uint>     & path);
+                    std::vector<uint>     & path,
+              const DijkstraGraph         * g = nullptr);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -90,7 +198,8 @@ void dijkstra(const AbstractMesh<M,V,E,P> & m,
               const uint                    source,
               const std::set<uint>        & dest,
               const std::vector<bool>     & mask, // if mask[v] = true, path cannot pass through it
-                    std::vector<uint>     & path);
+                    std::vector<uint>     & path,
+              const DijkstraGraph         * g = nullptr);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 //::::::::::::: DIJKSTRAs ON DUAL GRAPH (POLYGONS/POLYHEDRA) :::::::::::::
@@ -100,7 +209,8 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void dijkstra_exhaustive_on_dual(const AbstractMesh<M,V,E,P> & m,
                                  const uint                    source,
-                                       std::vector<double>   & distances);
+                                       std::vector<double>   & distances,
+                                 const DijkstraGraph         * g = nullptr);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -108,7 +218,8 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void dijkstra_exhaustive_on_dual(const AbstractMesh<M,V,E,P> & m,
                                  const std::vector<uint>     & sources,
-                                       std::vector<double>   & distances);
+                                       std::vector<double>   & distances,
+                                 const DijkstraGraph         * g = nullptr);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -117,7 +228,8 @@ CINO_INLINE
 void dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
                       const uint                    source,
                       const uint                    dest,
-                            std::vector<uint>     & path);
+                            std::vector<uint>     & path,
+                      const DijkstraGraph         * g = nullptr);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -127,7 +239,8 @@ void dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
                       const uint                    source,
                       const uint                    dest,
                       const std::vector<bool>     & mask, // if mask[p] = true, path cannot pass through it
-                            std::vector<uint>     & path);
+                            std::vector<uint>     & path,
+                      const DijkstraGraph         * g = nullptr);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -137,7 +250,8 @@ void dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
                       const uint                    source,
                       const std::set<uint>        & dest,
                       const std::vector<bool>     & mask, // if mask[p] = true, path cannot pass through it
-                            std::vector<uint>     & path);
+                            std::vector<uint>     & path,
+                      const DijkstraGraph         * g = nullptr);
 
 }
 
@@ -85,6 +85,19 @@ class DrawableSlicedObj : public AbstractDrawablePolygonMesh<SlicedObj<M,V,E,P>>
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+        // first max_layers layers only: call append_slices() and updateGL() to add the others
+        explicit DrawableSlicedObj(CLIReader & reader, const uint max_layers, const double hatch_size = 0.01)
+        : SlicedObj<M,V,E,P>(reader, max_layers, hatch_size)
+        {
+            this->init_drawable_stuff();
+            this->show_marked_edge_color(Color::BLACK());
+            this->show_marked_edge_width(3.0);
+            this->show_wireframe(false);
+            this->updateGL();
+        }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
         ObjectType object_type() const { return DRAWABLE_SLICED_OBJ; }
 };
 
@@ -0,0 +1,302 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/exact_geodesics.h>
+#include <queue>
+
+namespace cinolib
+{
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void ExactGeodesics::init(const AbstractPolygonMesh<M,V,E,P> & m)
+{
+    verts = m.vector_verts();
+
+    tris.clear();
+    tris.reserve(3*m.num_polys());
+    for(uint pid=0; pid<m.num_polys(); ++pid)
+    {
+        assert(m.verts_per_poly(pid)==3 && "exact geodesics require a triangle mesh");
+        for(uint vid : m.adj_p2v(pid)) tris.push_back(vid);
+    }
+
+    tri_adj.assign(tris.size(), -1);
+    for(uint pid=0; pid<m.num_polys(); ++pid)
+    for(uint k=0; k<3; ++k)
+    {
+        int eid = m.edge_id(tris.at(3*pid+k), tris.at(3*pid+(k+1)%3));
+        assert(eid>=0);
+        for(uint nbr : m.adj_e2p(eid)) if(nbr!=pid) tri_adj.at(3*pid+k) = nbr;
+    }
+
+    v2t_off.assign(m.num_verts()+1, 0);
+    for(uint vid=0; vid<m.num_verts(); ++vid) v2t_off.at(vid+1) = v2t_off.at(vid) + m.adj_v2p(vid).size();
+    v2t.resize(v2t_off.back());
+    for(uint vid=0; vid<m.num_verts(); ++vid)
+    {
+        std::copy(m.adj_v2p(vid).begin(), m.adj_v2p(vid).end(), v2t.begin() + v2t_off.at(vid));
+    }
+
+    // geodesics can bend only at saddle and boundary vertices
+    pseudo.assign(m.num_verts(), false);
+    for(uint vid=0; vid<m.num_verts(); ++vid)
+    {
+        double angle_sum = 0;
+        for(uint pid : m.adj_v2p(vid)) angle_sum += m.poly_angle_at_vert(pid, vid, RAD);
+        pseudo.at(vid) = (angle_sum > 2*M_PI + 1e-6) || m.vert_is_boundary(vid);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double ExactGeodesics::edge_length(const uint f, const uint k) const
+{
+    return verts.at(tris.at(3*f+k)).dist(verts.at(tris.at(3*f+(k+1)%3)));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+vec2d ExactGeodesics::opposite_vert(const uint f, const uint k) const
+{
+    const vec3d & A = verts.at(tris.at(3*f+k));
+    const vec3d & B = verts.at(tris.at(3*f+(k+1)%3));
+    const vec3d & C = verts.at(tris.at(3*f+(k+2)%3));
+    double L = A.dist(B);
+    double a = A.dist(C);
+    double b = B.dist(C);
+    double x = (a*a - b*b + L*L) / (2*L);
+    return vec2d(x, std::sqrt(std::max(0.0, a*a - x*x)));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double ExactGeodesics::window_min_dist(const Window & w) const
+{
+    if(w.src.x() >= w.b0 && w.src.x() <= w.b1) return w.sigma + std::fabs(w.src.y());
+    return w.sigma + std::min(w.src.dist(vec2d(w.b0,0)), w.src.dist(vec2d(w.b1,0)));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void ExactGeodesics::compute(const std::vector<uint>   & sources,
+                                   std::vector<double> & distances,
+                             const double                max_dist) const
+{
+    const double eps = 1e-10;
+
+    distances.assign(verts.size(), inf_double);
+
+    // events: windows (id >= 0) and pseudo sources (id = -vid-1)
+    typedef std::pair<double,int> Event;
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> queue;
+    std::vector<Window> pool;
+    std::vector<int>    free_slots;
+
+    auto update_vert = [&](const uint vid, const double d)
+    {
+        if(d < distances.at(vid))
+        {
+            distances.at(vid) = d;
+            if(pseudo.at(vid)) queue.push(std::make_pair(d, -(int)vid-1));
+        }
+    };
+
+    // a window can be useful only if it improves the distance of the edge
+    // endpoints for some point of its interval (see Xin and Wang, Sec. 4)
+    auto is_useful = [&](const Window & w) -> bool
+    {
+        double L = edge_length(w.f, w.k);
+        double dA = distances.at(tris.at(3*w.f+w.k));
+        double dB = distances.at(tris.at(3*w.f+(w.k+1)%3));
+        double d1 = w.sigma + w.src.dist(vec2d(w.b1,0));
+        double d0 = w.sigma + w.src.dist(vec2d(w.b0,0));
+        if(d1 > dA + w.b1       + eps*d1) return false;
+        if(d0 > dB + (L - w.b0) + eps*d0) return false;
+        return true;
+    };
+
+    // intersection between the ray from src through P and segment Q0-Q1
+    auto hit = [](const vec2d & src, const vec2d & P, const vec2d & Q0, const vec2d & Q1) -> vec2d
+    {
+        vec2d  d = P - src;
+        vec2d  e = Q1 - Q0;
+        vec2d  w = src - Q0;
+        double den = e.x()*d.y() - e.y()*d.x();
+        if(std::fabs(den) < 1e-15) return (P.dist(Q0) < P.dist(Q1)) ? Q0 : Q1;
+        double t = (w.x()*d.y() - w.y()*d.x()) / den;
+        t = std::min(1.0, std::max(0.0, t));
+        return Q0 + e*t;
+    };
+
+    // the interval [X0,X1] of edge k of face f (whose endpoints are at S0
+    // and S1 in the current 2D frame) becomes a window in the adjacent face
+    auto emit = [&](const uint f, const uint k, const vec2d & X0, const vec2d & X1,
+                    const vec2d & S0, const vec2d & S1, const vec2d & src, const double sigma)
+    {
+        uint   va = tris.at(3*f+k);
+        uint   vb = tris.at(3*f+(k+1)%3);
+        double L  = S0.dist(S1);
+        vec2d  u  = (S1 - S0) / L;
+        double t0 = std::max(0.0, std::min((X0-S0).dot(u), (X1-S0).dot(u)));
+        double t1 = std::min(L,   std::max((X0-S0).dot(u), (X1-S0).dot(u)));
+
+        if(t0 <= eps*L)     update_vert(va, sigma + src.dist(S0));
+        if(t1 >= L*(1-eps)) update_vert(vb, sigma + src.dist(S1));
+        if(t1 - t0 <= eps*L) return;
+
+        int g = tri_adj.at(3*f+k);
+        if(g<0) return;
+
+        Window w;
+        w.f     = g;
+        w.sigma = sigma;
+        for(w.k=0; w.k<3; ++w.k)
+        {
+            uint a = tris.at(3*g+w.k);
+            uint b = tris.at(3*g+(w.k+1)%3);
+            if((a==va && b==vb) || (a==vb && b==va)) break;
+        }
+        assert(w.k<3);
+
+        // express the window in the frame of the new edge
+        bool  same_dir = (tris.at(3*g+w.k) == va);
+        vec2d O        = same_dir ? S0 : S1;
+        vec2d dir      = same_dir ? u  : -u;
+        vec2d s        = src - O;
+        w.b0  = same_dir ? t0 : L - t1;
+        w.b1  = same_dir ? t1 : L - t0;
+        w.src = vec2d(s.dot(dir), -std::fabs(dir.x()*s.y() - dir.y()*s.x()));
+
+        if(!is_useful(w)) return;
+
+        int id;
+        if(free_slots.empty())
+        {
+            id = pool.size();
+            pool.push_back(w);
+        }
+        else
+        {
+            id = free_slots.back();
+            free_slots.pop_back();
+            pool.at(id) = w;
+        }
+        queue.push(std::make_pair(window_min_dist(w), id));
+    };
+
+    for(uint vid : sources)
+    {
+        distances.at(vid) = 0.0;
+        queue.push(std::make_pair(0.0, -(int)vid-1));
+    }
+
+    while(!queue.empty())
+    {
+        Event e = queue.top();
+        queue.pop();
+        if(e.first > max_dist) break;
+
+        if(e.second < 0) // pseudo source: windows on all the edges opposite to it
+        {
+            uint vid = -e.second-1;
+            if(e.first > distances.at(vid)) continue; // outdated
+
+            for(uint i=v2t_off.at(vid); i<v2t_off.at(vid+1); ++i)
+            {
+                uint f = v2t.at(i);
+                uint k = 0;
+                while(tris.at(3*f+(k+2)%3) != vid) ++k;
+                vec2d A(0,0);
+                vec2d B(edge_length(f,k),0);
+                emit(f, k, A, B, A, B, opposite_vert(f,k), distances.at(vid));
+            }
+            continue;
+        }
+
+        Window w = pool.at(e.second);
+        free_slots.push_back(e.second);
+        if(!is_useful(w)) continue;
+
+        uint   vC = tris.at(3*w.f+(w.k+2)%3);
+        double L  = edge_length(w.f, w.k);
+        vec2d  A(0,0);
+        vec2d  B(L,0);
+        vec2d  C  = opposite_vert(w.f, w.k);
+        vec2d  P0(w.b0,0);
+        vec2d  P1(w.b1,0);
+
+        // where the ray from the source through C crosses the edge
+        double xC = w.src.x() + (C.x() - w.src.x()) * (-w.src.y()) / (C.y() - w.src.y());
+        double dC = w.sigma + w.src.dist(C);
+        if(xC >= w.b0 && xC <= w.b1) update_vert(vC, dC);
+
+        bool left  = xC > w.b0; // part of the window crossing edge A-C
+        bool right = xC < w.b1; // part of the window crossing edge C-B
+
+        if(left)
+        {
+            vec2d X0 = hit(w.src, P0, A, C);
+            vec2d X1 = right ? C : hit(w.src, P1, A, C);
+            emit(w.f, (w.k+2)%3, X0, X1, C, A, w.src, w.sigma);
+        }
+        if(right)
+        {
+            vec2d X0 = left ? C : hit(w.src, P0, C, B);
+            vec2d X1 = hit(w.src, P1, C, B);
+            emit(w.f, (w.k+1)%3, X0, X1, B, C, w.src, w.sigma);
+        }
+    }
+
+    for(double & d : distances) if(d > max_dist) d = inf_double;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void exact_geodesics(const AbstractPolygonMesh<M,V,E,P> & m,
+                     const std::vector<uint>            & sources,
+                           std::vector<double>          & distances,
+                     const double                         max_dist)
+{
+    ExactGeodesics(m).compute(sources, distances, max_dist);
+}
+
+}
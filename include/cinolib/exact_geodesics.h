@@ -0,0 +1,138 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_EXACT_GEODESICS_H
+#define CINO_EXACT_GEODESICS_H
+
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/min_max_inf.h>
+#include <cinolib/geometry/vec2.h>
+#include <cinolib/geometry/vec3.h>
+#include <cinolib/meshes/abstract_polygonmesh.h>
+
+namespace cinolib
+{
+
+/* Exact polyhedral geodesic distances on triangle meshes, computed with the
+ * window propagation scheme described in
+ *
+ * Shortest Paths on a Polyhedron
+ * J. CHEN and Y. HAN
+ * Symposium on Computational Geometry, 1990
+ *
+ * with the window filtering and priority driven propagation described in
+ *
+ * Improving Chen and Han's Algorithm on the Discrete Geodesic Problem
+ * S.Q. XIN and G.J. WANG
+ * ACM Transactions on Graphics, 2009
+ *
+ * A window is an interval of an edge, together with the unfolded position of
+ * the (pseudo) source that sees it through a straight path. Windows are
+ * propagated face by face, in order of distance. Saddle and boundary vertices
+ * act as pseudo sources. A window is discarded only if, at every point of
+ * its interval, one of the endpoints of its edge already provides a shorter
+ * path (Xin and Wang, Sec. 4). The "one angle, one split" rule of Chen and
+ * Han is not used, as it is not compatible with the priority driven order.
+ *
+ * Only windows still to be propagated are kept in memory, and no global
+ * system is solved. The engine stores a compact copy of the mesh connectivity,
+ * and compute() is const, so many queries can run concurrently. Propagation
+ * stops at max_dist: vertices farther than that are left at inf_double.
+*/
+
+class ExactGeodesics
+{
+    public:
+
+        explicit ExactGeodesics() {}
+
+        template<class M, class V, class E, class P>
+        explicit ExactGeodesics(const AbstractPolygonMesh<M,V,E,P> & m) { init(m); }
+
+        template<class M, class V, class E, class P>
+        void init(const AbstractPolygonMesh<M,V,E,P> & m); // m must be a triangle mesh
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void compute(const std::vector<uint>   & sources,
+                           std::vector<double> & distances,
+                     const double                max_dist = inf_double) const;
+
+        uint num_verts() const { return verts.size(); }
+
+    protected:
+
+        // A window lies on edge k of triangle f, and propagates inside f.
+        // Coordinates are in the edge frame: the first vertex of the edge is
+        // at the origin, the second at (len,0), and f is on the y>0 side.
+        // The pseudo source, at distance sigma from the actual source, is at
+        // src (with src.y() <= 0), and sees the interval [b0,b1] of the edge
+        struct Window
+        {
+            uint   f, k;
+            double b0, b1;
+            vec2d  src;
+            double sigma;
+        };
+
+        std::vector<vec3d>  verts;
+        std::vector<uint>   tris;    // three vertices per triangle
+        std::vector<int>    tri_adj; // triangle across edge (i,i+1), -1 if boundary
+        std::vector<uint>   v2t;     // triangles incident to each vertex (CSR)
+        std::vector<uint>   v2t_off;
+        std::vector<bool>   pseudo;  // saddle or boundary vertices
+
+        double edge_length(const uint f, const uint k) const;
+        double window_min_dist(const Window & w) const;
+        vec2d  opposite_vert(const uint f, const uint k) const; // 2D position of the third vertex in the edge frame
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void exact_geodesics(const AbstractPolygonMesh<M,V,E,P> & m,
+                     const std::vector<uint>            & sources,
+                           std::vector<double>          & distances,
+                     const double                         max_dist = inf_double);
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "exact_geodesics.cpp"
+#endif
+
+#endif // CINO_EXACT_GEODESICS_H
@@ -0,0 +1,168 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/fast_marching.h>
+#include <cinolib/indexed_heap.h>
+#include <Eigen/Dense>
+
+namespace cinolib
+{
+
+template<class Mesh>
+CINO_INLINE
+void fast_marching(const Mesh                & m,
+                   const std::vector<uint>   & sources,
+                         std::vector<double> & distances,
+                   const double                max_dist)
+{
+    distances.assign(m.num_verts(), inf_double);
+    std::vector<bool> accepted(m.num_verts(), false);
+
+    IndexedHeap<double> front(m.num_verts());
+    for(uint vid : sources)
+    {
+        distances.at(vid) = 0.0;
+        front.push_or_decrease(vid, 0.0);
+    }
+
+    std::vector<vec3d>  known;
+    std::vector<double> T;
+    while(!front.empty() && front.top_key() <= max_dist)
+    {
+        uint vid = front.pop();
+        accepted.at(vid) = true;
+
+        for(uint pid : m.adj_v2p(vid))
+        {
+            for(uint nbr : m.adj_p2v(pid))
+            {
+                if(accepted.at(nbr)) continue;
+
+                known.clear();
+                T.clear();
+                for(uint v : m.adj_p2v(pid))
+                {
+                    if(v!=nbr && accepted.at(v))
+                    {
+                        known.push_back(m.vert(v));
+                        T.push_back(distances.at(v));
+                    }
+                }
+
+                double d = fast_marching_update(m.vert(nbr), known, T);
+                if(d < distances.at(nbr))
+                {
+                    distances.at(nbr) = d;
+                    front.push_or_decrease(nbr, d);
+                }
+            }
+        }
+    }
+
+    // vertices still in the front are beyond max_dist
+    for(uint vid=0; vid<m.num_verts(); ++vid)
+    {
+        if(!accepted.at(vid)) distances.at(vid) = inf_double;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double fast_marching_update(const vec3d               & x,
+                            const std::vector<vec3d>  & known,
+                            const std::vector<double> & T)
+{
+    assert(known.size()==T.size() && known.size()<=3);
+
+    double best = inf_double;
+    uint   k    = known.size();
+
+    // try the simplex and all its faces (edges always give a valid update).
+    // Matrices have at most 3 columns, and are allocated on the stack
+    typedef Eigen::Matrix<double,3,Eigen::Dynamic,0,3,3>              Mat3X;
+    typedef Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,0,3,3> MatX;
+    typedef Eigen::Matrix<double,Eigen::Dynamic,1,0,3,1>              VecX;
+    for(uint mask=1; mask<(1u<<k); ++mask)
+    {
+        uint ids[3];
+        uint s = 0;
+        for(uint i=0; i<k; ++i) if(mask & (1u<<i)) ids[s++] = i;
+
+        if(s==1)
+        {
+            best = std::min(best, T.at(ids[0]) + x.dist(known.at(ids[0])));
+            continue;
+        }
+
+        // the gradient g of the (linear) distance function satisfies
+        // V^T g = t - T0, |g| = 1, where the columns of V are the edges
+        // from x to the known vertices. Writing g = V w and Q = (V^T V)^-1
+        // gives a quadratic equation in T0
+        Mat3X V(3,s);
+        VecX  t(s);
+        for(uint i=0; i<s; ++i)
+        {
+            vec3d e = known.at(ids[i]) - x;
+            V(0,i) = e.x();
+            V(1,i) = e.y();
+            V(2,i) = e.z();
+            t[i]   = T.at(ids[i]);
+        }
+        MatX G = V.transpose() * V;
+        if(std::fabs(G.determinant()) < 1e-12 * std::pow(G.trace(),(int)s)) continue; // degenerate
+        MatX Q   = G.inverse();
+        VecX one = VecX::Ones(s);
+
+        double a    = one.dot(Q*one);
+        double b    = one.dot(Q*t);
+        double c    = t.dot(Q*t) - 1.0;
+        double disc = b*b - a*c;
+        if(disc<0) continue;
+
+        double T0 = (b + std::sqrt(disc)) / a;
+        if(T0 < t.maxCoeff()) continue;
+
+        // causality: the characteristic reaching x must cross the simplex,
+        // that is -g must be a positive combination of the edges
+        VecX w = Q * (t - T0*one);
+        if(w.maxCoeff() > 1e-12) continue;
+
+        best = std::min(best, T0);
+    }
+    return best;
+}
+
+}
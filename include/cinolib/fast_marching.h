@@ -0,0 +1,89 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_FAST_MARCHING_H
+#define CINO_FAST_MARCHING_H
+
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/min_max_inf.h>
+#include <cinolib/geometry/vec3.h>
+
+namespace cinolib
+{
+
+/* Geodesic distances with the Fast Marching Method on simplicial meshes
+ * (triangle and tetrahedral meshes), as described in
+ *
+ * Computing Geodesic Paths on Manifolds
+ * R. KIMMEL and J.A. SETHIAN
+ * Proceedings of the National Academy of Sciences, 1998
+ *
+ * The front is a narrow band stored in an indexed heap. Each time a vertex
+ * is accepted, its neighbors are updated solving the eikonal equation in
+ * each simplex that contains them, using the already accepted vertices of
+ * the simplex. If the solution does not come from within the simplex (i.e.
+ * it does not satisfy causality, as it may happen with obtuse elements) the
+ * update falls back to the faces and edges of the simplex.
+ *
+ * Differently from the heat method, no global system is solved, and memory
+ * is O(n). The march stops as soon as the front reaches max_dist: vertices
+ * farther than that are left at inf_double.
+*/
+
+template<class Mesh>
+CINO_INLINE
+void fast_marching(const Mesh                & m,
+                   const std::vector<uint>   & sources,
+                         std::vector<double> & distances,
+                   const double                max_dist = inf_double);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Distance at x given the distances T at the vertices of a simplex (1 to 3
+// points). The best valid update among the simplex and all its faces is
+// returned (inf_double if none is valid)
+CINO_INLINE
+double fast_marching_update(const vec3d               & x,
+                            const std::vector<vec3d>  & known,
+                            const std::vector<double> & T);
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "fast_marching.cpp"
+#endif
+
+#endif // CINO_FAST_MARCHING_H
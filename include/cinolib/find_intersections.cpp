@@ -0,0 +1,236 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/find_intersections.h>
+#include <cinolib/bvh.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/Shewchuk_predicates.h>
+#include <cinolib/geometry/triangle.h>
+#include <algorithm>
+
+namespace cinolib
+{
+
+// flat list of triangles (tessellated polygons), with the poly they come from
+template<class M, class V, class E, class P>
+CINO_INLINE
+void serialize_tris(const AbstractPolygonMesh<M,V,E,P> & m,
+                          std::vector<uint>            & tris,
+                          std::vector<uint>            & tri2poly,
+                          std::vector<Bbox>            & boxes)
+{
+    tris.clear();
+    tri2poly.clear();
+    boxes.clear();
+    for(uint pid=0; pid<m.num_polys(); ++pid)
+    {
+        const std::vector<uint> & tess = m.poly_tessellation(pid);
+        for(uint i=0; i<tess.size(); i+=3)
+        {
+            Bbox bb;
+            for(uint j=0; j<3; ++j)
+            {
+                tris.push_back(tess[i+j]);
+                bb.add(m.vert(tess[i+j]));
+            }
+            tri2poly.push_back(pid);
+            boxes.push_back(bb);
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void find_self_intersections(AbstractPolygonMesh<M,V,E,P> & m,
+                             std::vector<ipair>           & intersections,
+                             const bool                     mark)
+{
+    exactinit();
+
+    std::vector<uint> tris, tri2poly;
+    std::vector<Bbox> boxes;
+    serialize_tris(m, tris, tri2poly, boxes);
+
+    BVH bvh(boxes);
+
+    // triangles sharing vertices always touch each other, hence the full test
+    // cannot tell them apart from intersecting ones. They are tested with a
+    // reduced predicate that ignores the shared elements: two triangles with
+    // a common vertex intersect elsewhere iff the edge opposite to it in one
+    // of them hits the other triangle; two triangles with a common edge
+    // intersect elsewhere iff they are coplanar and lie on the same side of it
+    auto tris_intersect = [&](const uint tid0, const uint tid1)
+    {
+        const uint * t0 = &tris[3*tid0];
+        const uint * t1 = &tris[3*tid1];
+        int  pos[3]   = { -1, -1, -1 }; // position of each vert of t0 in t1 (if any)
+        uint n_shared = 0;
+        for(uint i=0; i<3; ++i)
+        for(uint j=0; j<3; ++j)
+        {
+            if (t0[i]==t1[j]) { pos[i] = j; ++n_shared; }
+        }
+
+        switch (n_shared)
+        {
+            case 0: return triangle_triangle_intersect(m.vert(t0[0]), m.vert(t0[1]), m.vert(t0[2]),
+                                                       m.vert(t1[0]), m.vert(t1[1]), m.vert(t1[2]));
+            case 1:
+            {
+                uint i = (pos[0]>=0) ? 0 : ((pos[1]>=0) ? 1 : 2);
+                uint j = pos[i];
+                return segment_triangle_intersect(m.vert(t0[(i+1)%3]), m.vert(t0[(i+2)%3]),
+                                                  m.vert(t1[0]), m.vert(t1[1]), m.vert(t1[2])) ||
+                       segment_triangle_intersect(m.vert(t1[(j+1)%3]), m.vert(t1[(j+2)%3]),
+                                                  m.vert(t0[0]), m.vert(t0[1]), m.vert(t0[2]));
+            }
+            case 2:
+            {
+                uint i = (pos[0]<0) ? 0 : ((pos[1]<0) ? 1 : 2); // vert of t0 not in t1
+                uint j = 3 - pos[(i+1)%3] - pos[(i+2)%3];       // vert of t1 not in t0
+                const vec3d & a = m.vert(t0[(i+1)%3]);
+                const vec3d & b = m.vert(t0[(i+2)%3]);
+                const vec3d & c = m.vert(t0[i]);
+                const vec3d & d = m.vert(t1[j]);
+                if (orient3d(a,b,c,d) != 0) return false;
+                uint   axis = triangle_projection_axis(a,b,c);
+                double o0   = orient2d(drop_coord(a,axis), drop_coord(b,axis), drop_coord(c,axis));
+                double o1   = orient2d(drop_coord(a,axis), drop_coord(b,axis), drop_coord(d,axis));
+                return (o0>0 && o1>0) || (o0<0 && o1<0);
+            }
+            default: return true; // duplicated triangles
+        }
+    };
+
+    uint n_tris   = tri2poly.size();
+    uint n_chunks = 4*n_threads();
+    std::vector<std::vector<ipair>> chunk_res(n_chunks);
+    PARALLEL_FOR_CHUNKS(0, n_tris, n_chunks, [&](const uint beg, const uint end, const uint cid)
+    {
+        std::vector<uint> cand;
+        for(uint tid=beg; tid<end; ++tid)
+        {
+            cand.clear();
+            bvh.items_intersecting(boxes.at(tid), cand);
+            for(uint tid2 : cand)
+            {
+                if (tid2 <= tid) continue; // test each pair only once
+                uint pid  = tri2poly.at(tid);
+                uint pid2 = tri2poly.at(tid2);
+                if (!boxes.at(tid).intersects(boxes.at(tid2))) continue;
+                if (pid == pid2) continue; // a polygon and its own tessellation
+                if (tris_intersect(tid, tid2))
+                {
+                    chunk_res.at(cid).push_back(std::make_pair(std::min(pid,pid2), std::max(pid,pid2)));
+                }
+            }
+        }
+    });
+
+    intersections.clear();
+    for(const auto & res : chunk_res) intersections.insert(intersections.end(), res.begin(), res.end());
+    std::sort(intersections.begin(), intersections.end());
+    intersections.erase(std::unique(intersections.begin(), intersections.end()), intersections.end());
+
+    if (mark)
+    {
+        for(const ipair & p : intersections)
+        {
+            m.poly_data(p.first ).marked = true;
+            m.poly_data(p.second).marked = true;
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M0, class V0, class E0, class P0,
+         class M1, class V1, class E1, class P1>
+CINO_INLINE
+void find_intersections(AbstractPolygonMesh<M0,V0,E0,P0> & m0,
+                        AbstractPolygonMesh<M1,V1,E1,P1> & m1,
+                        std::vector<ipair>               & intersections,
+                        const bool                         mark)
+{
+    exactinit();
+
+    std::vector<uint> tris0, tri2poly0, tris1, tri2poly1;
+    std::vector<Bbox> boxes0, boxes1;
+    serialize_tris(m0, tris0, tri2poly0, boxes0);
+    serialize_tris(m1, tris1, tri2poly1, boxes1);
+
+    // build the tree on m1 and query it with the triangles of m0
+    BVH bvh(boxes1);
+
+    uint n_tris   = tri2poly0.size();
+    uint n_chunks = 4*n_threads();
+    std::vector<std::vector<ipair>> chunk_res(n_chunks);
+    PARALLEL_FOR_CHUNKS(0, n_tris, n_chunks, [&](const uint beg, const uint end, const uint cid)
+    {
+        std::vector<uint> cand;
+        for(uint tid=beg; tid<end; ++tid)
+        {
+            cand.clear();
+            bvh.items_intersecting(boxes0.at(tid), cand);
+            for(uint tid2 : cand)
+            {
+                if (!boxes0.at(tid).intersects(boxes1.at(tid2))) continue;
+                if (triangle_triangle_intersect(m0.vert(tris0[3*tid ]), m0.vert(tris0[3*tid +1]), m0.vert(tris0[3*tid +2]),
+                                                m1.vert(tris1[3*tid2]), m1.vert(tris1[3*tid2+1]), m1.vert(tris1[3*tid2+2])))
+                {
+                    chunk_res.at(cid).push_back(std::make_pair(tri2poly0.at(tid), tri2poly1.at(tid2)));
+                }
+            }
+        }
+    });
+
+    intersections.clear();
+    for(const auto & res : chunk_res) intersections.insert(intersections.end(), res.begin(), res.end());
+    std::sort(intersections.begin(), intersections.end());
+    intersections.erase(std::unique(intersections.begin(), intersections.end()), intersections.end());
+
+    if (mark)
+    {
+        for(const ipair & p : intersections)
+        {
+            m0.poly_data(p.first ).marked = true;
+            m1.poly_data(p.second).marked = true;
+        }
+    }
+}
+
+}
@@ -0,0 +1,89 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_FIND_INTERSECTIONS_H
+#define CINO_FIND_INTERSECTIONS_H
+
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/ipair.h>
+#include <cinolib/meshes/abstract_polygonmesh.h>
+
+namespace cinolib
+{
+
+/* Self intersection and mesh vs mesh intersection detection for surface
+ * meshes. Polygons are triangulated (see poly_tessellation), candidate pairs
+ * are found by querying a BVH with the bounding box of each triangle, and
+ * candidates are validated with exact tests based on Shewchuk's predicates
+ * (see triangle_triangle_intersect). Queries run in parallel.
+ *
+ * Detected pairs are returned as (sorted, unique) pairs of poly ids; in the
+ * self intersection case the first id is always the smallest one. If mark
+ * is true, intersecting polygons are also flagged with poly_data().marked
+ * (previous marks are NOT cleared).
+ *
+ * In self intersection mode, pairs of polygons sharing a vertex or an edge
+ * always touch each other: for them, only contacts away from the shared
+ * elements are reported (e.g. an edge crossing the other polygon, or two
+ * coplanar polygons folded onto each other along their common edge).
+ * Triangles coming from the tessellation of the same polygon are skipped.
+*/
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void find_self_intersections(AbstractPolygonMesh<M,V,E,P> & m,
+                             std::vector<ipair>           & intersections,
+                             const bool                     mark = false);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// first ids refer to polys of m0, second ids to polys of m1
+template<class M0, class V0, class E0, class P0,
+         class M1, class V1, class E1, class P1>
+CINO_INLINE
+void find_intersections(AbstractPolygonMesh<M0,V0,E0,P0> & m0,
+                        AbstractPolygonMesh<M1,V1,E1,P1> & m1,
+                        std::vector<ipair>               & intersections,
+                        const bool                         mark = false);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "find_intersections.cpp"
+#endif
+
+#endif // CINO_FIND_INTERSECTIONS_H
@@ -39,6 +39,7 @@
 #include <cinolib/laplacian.h>
 #include <cinolib/vertex_mass.h>
 #include <cinolib/linear_solvers.h>
+#include <cinolib/parallel_for.h>
 
 namespace cinolib
 {
@@ -49,7 +50,8 @@ ScalarField compute_geodesics(      Mesh              & m,
                               const std::vector<uint> & heat_charges,
                               const int                 laplacian_mode,
                               const float               time_scalar,
-                              const bool                hard_constrain_charges)
+                              const bool                hard_constrain_charges,
+                              const int                 solver)
 {
     // optimize position and scale to get better numerical precision
     double d = m.bbox().diag();
@@ -70,12 +72,13 @@ ScalarField compute_geodesics(      Mesh              & m,
     for(uint vid : heat_charges) rhs[vid] = 1.0;
 
     ScalarField heat(m.num_verts());
-    solve_square_system(MM - time * L, rhs, heat);
+    solve_square_system(MM - time * L, rhs, heat, solver);
 
     VectorField grad = G * heat;
     grad.normalize();
 
     ScalarField geodesics(m.num_verts());
+    int poisson_solver = (solver == SIMPLICIAL_LLT) ? SIMPLICIAL_LDLT : solver;
 
     // this is of course not supported in the amortized version,
     // as the matrix changes every time
@@ -83,11 +86,11 @@ ScalarField compute_geodesics(      Mesh              & m,
     {
         std::map<uint,double> bcs;
         for(uint vid : heat_charges) bcs[vid] = 1.0;
-        solve_square_system_with_bc(-L, G.transpose() * grad, geodesics, bcs, SIMPLICIAL_LDLT);
+        solve_square_system_with_bc(-L, G.transpose() * grad, geodesics, bcs, poisson_solver);
     }
     else
     {
-        solve_square_system(-L, G.transpose() * grad, geodesics, SIMPLICIAL_LDLT);
+        solve_square_system(-L, G.transpose() * grad, geodesics, poisson_solver);
     }
 
     // restore original scale and position
@@ -102,68 +105,180 @@ ScalarField compute_geodesics(      Mesh              & m,
 
 template<class Mesh>
 CINO_INLINE
-ScalarField compute_geodesics_amortized(      Mesh              & m,
-                                              GeodesicsCache    & cache,
-                                        const std::vector<uint> & heat_charges,
-                                        const int                 laplacian_mode,
-                                        const float               time_scalar)
+GeodesicsEngine::GeodesicsEngine(      Mesh  & m,
+                                 const int     laplacian_mode,
+                                 const float   time_scalar,
+                                 const int     solver)
+{
+    init(m, laplacian_mode, time_scalar, solver);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+bool GeodesicsEngine::init(      Mesh  & m,
+                           const int     laplacian_mode,
+                           const float   time_scalar,
+                           const int     solver)
+{
+    initialized = false;
+    nv          = m.num_verts();
+
+    // work on a mesh with unit average edge length. This gives better numerical
+    // precision and keeps element areas far from the clamping threshold used in
+    // the computation of the gradient matrix
+    unit    = m.edge_avg_length();
+    vec3d c = m.bbox().center();
+    m.translate(-c);
+    m.scale(1.0/unit);
+
+    // use the squared avg edge length (i.e. one) as time step, as suggested in the original paper
+    double time = time_scalar;
+
+    Eigen::SparseMatrix<double> L  = laplacian(m, laplacian_mode);
+    Eigen::SparseMatrix<double> MM = mass_matrix(m);
+    G = gradient_matrix(m);
+    W.resize(3*m.num_polys());
+    for(uint pid=0; pid<m.num_polys(); ++pid)
+    {
+        W[3*pid+0] = W[3*pid+1] = W[3*pid+2] = m.poly_mass(pid);
+    }
+    Eigen::SparseMatrix<double> K = G.transpose() * W.asDiagonal() * G;
+
+    // restore original scale and position
+    m.scale(unit);
+    m.translate(c);
+
+    // the Poisson matrix is only semi definite: use LDLT in place of LLT
+    heat_solver.set_solver(solver);
+    poisson_solver.set_solver((solver == SIMPLICIAL_LLT) ? SIMPLICIAL_LDLT : solver);
+
+    if(!heat_solver.compute(MM - time * L) || !poisson_solver.compute(K))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : GeodesicsEngine::init() : couldn't factorize matrices" << std::endl;
+        return false;
+    }
+    initialized = true;
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+ScalarField GeodesicsEngine::distances(const std::vector<uint> & sources) const
+{
+    Eigen::MatrixXd dist;
+    solve(std::vector<std::vector<uint>>(1, sources), dist);
+    return ScalarField(dist.col(0));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Eigen::MatrixXd GeodesicsEngine::distances_batch(const std::vector<uint> & sources,
+                                                 const uint                block_size) const
+{
+    assert(block_size>0);
+    uint n_blocks = (sources.size() + block_size - 1) / block_size;
+
+    Eigen::MatrixXd dist(nv, sources.size());
+    // BiCGSTAB cannot solve concurrently
+    uint serial_if_less_than = (heat_solver.solver_type() == BiCGSTAB) ? n_blocks+1 : 2;
+    PARALLEL_FOR(0, n_blocks, serial_if_less_than, [&](const uint bid)
+    {
+        uint beg = bid * block_size;
+        uint end = std::min((uint)sources.size(), beg + block_size);
+        std::vector<std::vector<uint>> block;
+        for(uint i=beg; i<end; ++i) block.push_back({sources.at(i)});
+
+        Eigen::MatrixXd block_dist;
+        solve(block, block_dist);
+        dist.middleCols(beg, end-beg) = block_dist;
+    });
+    return dist;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Eigen::MatrixXd GeodesicsEngine::distance_table(const std::vector<uint> & landmarks) const
 {
-    // first call, heavy solve (matrix factorization + gradient matrix)
-    if (cache.heat_flow_cache == NULL)
+    Eigen::MatrixXd dist = distances_batch(landmarks);
+    Eigen::MatrixXd table(landmarks.size(), landmarks.size());
+    for(uint i=0; i<landmarks.size(); ++i)
+    for(uint j=0; j<landmarks.size(); ++j)
     {
-        // optimize position and scale to get better numerical precision
-        double d = m.bbox().diag();
-        vec3d  c = m.bbox().center();
-        m.translate(-c);
-        m.scale(1.0/d);
-
-        // use the squared avg edge length as time step, as suggested in the original paper
-        double time = m.edge_avg_length();
-        time *= time;
-        time *= time_scalar;
-
-        Eigen::SparseMatrix<double> L   = laplacian(m, laplacian_mode);
-        Eigen::SparseMatrix<double> MM  = mass_matrix(m);
-        Eigen::VectorXd             rhs = Eigen::VectorXd::Zero(m.num_verts());
-
-        for(uint vid : heat_charges) rhs[vid] = 1.0;
-
-        ScalarField heat(m.num_verts());
-        cache.heat_flow_cache = new Eigen::SimplicialLLT<Eigen::SparseMatrix<double>>(MM - time * L);
-        assert(cache.heat_flow_cache->info() == Eigen::Success);
-        heat = cache.heat_flow_cache->solve(rhs).eval();
-
-        cache.gradient_matrix = gradient_matrix(m);
-        VectorField grad = cache.gradient_matrix * heat;
-        grad.normalize();
-
-        ScalarField geodesics(m.num_verts());
-        cache.integration_cache = new Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>(-L);
-        assert(cache.integration_cache->info() == Eigen::Success);
-        geodesics = cache.integration_cache->solve(cache.gradient_matrix.transpose() * grad).eval();
-        geodesics.normalize_in_01();
-
-        // restore original scale and position
-        m.scale(d);
-        m.translate(c);
-        return geodesics;
+        table(i,j) = dist(landmarks.at(i), j);
     }
-    else // solve by back-substitution using pre-factored matrices
+    // the heat method is not exactly symmetric
+    return 0.5 * (table + table.transpose());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void GeodesicsEngine::solve(const std::vector<std::vector<uint>> & sources,
+                                  Eigen::MatrixXd                & dist) const
+{
+    assert(initialized);
+    uint n_rhs = sources.size();
+
+    Eigen::MatrixXd rhs = Eigen::MatrixXd::Zero(nv, n_rhs);
+    for(uint i=0; i<n_rhs; ++i)
+    for(uint vid : sources.at(i))
     {
-        Eigen::VectorXd rhs = Eigen::VectorXd::Zero(m.num_verts());
-        for(uint vid : heat_charges) rhs[vid] = 1.0;
-        ScalarField heat = cache.heat_flow_cache->solve(rhs).eval();
+        assert(vid<nv);
+        rhs(vid,i) = 1.0;
+    }
 
-        VectorField grad = cache.gradient_matrix * heat;
-        grad.normalize();
+    Eigen::MatrixXd heat;
+    heat_solver.solve(rhs, heat);
 
-        ScalarField geodesics(m.num_verts());
-        geodesics = cache.integration_cache->solve(cache.gradient_matrix.transpose() * grad).eval();
-        geodesics.normalize_in_01();
+    // normalized (and reversed) heat gradient, integrated with area weights
+    for(uint i=0; i<n_rhs; ++i)
+    {
+        Eigen::VectorXd X = G * heat.col(i);
+        for(int j=0; j<X.rows(); j+=3)
+        {
+            double len = X.segment<3>(j).norm();
+            if(len>0) X.segment<3>(j) *= -W[j]/len;
+        }
+        rhs.col(i) = G.transpose() * X;
+    }
+
+    poisson_solver.solve(rhs, dist);
 
-        return geodesics;
+    // distances are defined up to a constant: shift them to have zero
+    // at the (closest) source, and bring them back to the mesh scale
+    for(uint i=0; i<n_rhs; ++i)
+    {
+        double min = std::numeric_limits<double>::max();
+        for(uint vid : sources.at(i)) min = std::min(min, dist(vid,i));
+        if(sources.at(i).empty()) min = 0;
+        dist.col(i) = (dist.col(i).array() - min) * unit;
     }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+ScalarField compute_geodesics_amortized(      Mesh              & m,
+                                              GeodesicsCache    & cache,
+                                        const std::vector<uint> & heat_charges,
+                                        const int                 laplacian_mode,
+                                        const float               time_scalar)
+{
+    // first call, heavy solve (matrix factorization + gradient matrix).
+    // Following calls are solved by back-substitution using pre-factored matrices
+    if(!cache.is_init()) cache.init(m, laplacian_mode, time_scalar);
 
+    // same convention of compute_geodesics: 1 at the sources, 0 at the farthest point
+    ScalarField geodesics = cache.distances(heat_charges);
+    geodesics.normalize_in_01();
+    for(uint vid=0; vid<geodesics.size(); ++vid) geodesics[vid] = 1.0 - geodesics[vid];
+    return geodesics;
 }
 
 }
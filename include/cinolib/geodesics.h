@@ -41,6 +41,7 @@
 #include <cinolib/cino_inline.h>
 #include <cinolib/scalar_field.h>
 #include <cinolib/symbols.h>
+#include <cinolib/linear_solvers.h>
 #include <Eigen/Sparse>
 
 namespace cinolib
@@ -67,6 +68,12 @@ namespace cinolib
  *              L phy = grad^T * ( grad(u)/|grad(u)| )
  *
  * phy is the scalar field encoding the geodesic distances.
+ *
+ * With the default solver the heat flow is solved with LLT and the Poisson
+ * problem (which is only semi definite) with LDLT. Any other solver (e.g. CG
+ * for large meshes) is used for both steps. Note that with short time steps
+ * heat values far from the sources are well below the tolerance of iterative
+ * solvers: use a larger time_scalar (e.g. 100) with CG.
 */
 
 template<class Mesh>
@@ -75,20 +82,84 @@ ScalarField compute_geodesics(      Mesh              & m,
                               const std::vector<uint> & heat_charges,
                               const int                 laplacian_mode = COTANGENT,
                               const float               time_scalar = 1.0,
-                              const bool                hard_constrain_charges = false);
+                              const bool                hard_constrain_charges = false,
+                              const int                 solver = SIMPLICIAL_LLT);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-typedef struct
+/* Reusable engine for the heat method. The heat flow and Poisson matrices are
+ * factorized once (at construction, or with init()), and any number of
+ * queries can then be answered with back-substitutions only. Queries:
+ *
+ *  - distances()       : distance from a set of sources (one field)
+ *  - distances_batch() : distances from many sources, one column per source.
+ *                        Sources are processed as blocks of right hand sides,
+ *                        and blocks are processed in parallel
+ *  - distance_table()  : pairwise (symmetrized) distances between landmarks
+ *
+ * Differently from compute_geodesics(), distances are not normalized: they are
+ * expressed in the units of the mesh, and are zero at the sources. The vector
+ * field is integrated in the least squares sense, solving G^T A G phi = G^T A X,
+ * where G is the per element gradient, A the element areas (or volumes), and X
+ * the normalized heat gradient.
+ *
+ * All queries are const and can be called concurrently from multiple threads,
+ * with the only exception of the BiCGSTAB solver (see LinearSolver). The engine
+ * owns all its data, and releases it on destruction.
+*/
+
+class GeodesicsEngine
 {
-    Eigen::SimplicialLLT<Eigen::SparseMatrix<double>>  *heat_flow_cache   = NULL;
-    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> *integration_cache = NULL;
-    Eigen::SparseMatrix<double>                         gradient_matrix;
-}
-GeodesicsCache;
+    public:
+
+        explicit GeodesicsEngine() {}
+
+        template<class Mesh>
+        explicit GeodesicsEngine(      Mesh  & m,
+                                 const int     laplacian_mode = COTANGENT,
+                                 const float   time_scalar    = 1.0,
+                                 const int     solver         = SIMPLICIAL_LLT);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // NOTE: the mesh is temporarily translated and scaled for numerical
+        // precision, and restored on exit
+        template<class Mesh>
+        bool init(      Mesh  & m,
+                  const int     laplacian_mode = COTANGENT,
+                  const float   time_scalar    = 1.0,
+                  const int     solver         = SIMPLICIAL_LLT);
+
+        bool is_init() const { return initialized; }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        ScalarField     distances      (const std::vector<uint> & sources)   const;
+        Eigen::MatrixXd distances_batch(const std::vector<uint> & sources,
+                                        const uint                block_size = 32) const;
+        Eigen::MatrixXd distance_table (const std::vector<uint> & landmarks) const;
+
+    protected:
+
+        bool                        initialized = false;
+        uint                        nv          = 0;
+        double                      unit        = 1.0; // mesh scale (distances are computed on a normalized mesh)
+        Eigen::SparseMatrix<double> G;                 // per element gradient
+        Eigen::VectorXd             W;                 // per element mass (repeated for x,y,z)
+        LinearSolver                heat_solver;
+        LinearSolver                poisson_solver;
+
+        // distances from each set of sources (one per column)
+        void solve(const std::vector<std::vector<uint>> & sources, Eigen::MatrixXd & dist) const;
+};
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// amortized version of compute_geodesics (normalized in [0,1], with 1 at the
+// sources as compute_geodesics). On first call the cache is initialized, and
+// the mesh must not change in between calls
+typedef GeodesicsEngine GeodesicsCache;
+
 template<class Mesh>
 CINO_INLINE
 ScalarField compute_geodesics_amortized(      Mesh              & m,
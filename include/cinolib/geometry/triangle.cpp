@@ -35,8 +35,10 @@
 *********************************************************************************/
 #include <cinolib/geometry/triangle.h>
 #include <cinolib/standard_elements_tables.h>
+#include <cinolib/geometry/vec2.h>
 #include <cinolib/geometry/vec3.h>
 #include <cinolib/geometry/plane.h>
+#include <cinolib/Shewchuk_predicates.h>
 #include <set>
 
 namespace cinolib
@@ -197,5 +199,214 @@ bool triangle_bary_is_edge(const std::vector<double> & bary,
     return false;
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+vec3d triangle_closest_point(const vec3d & P,
+                             const vec3d & A,
+                             const vec3d & B,
+                             const vec3d & C)
+{
+    vec3d  AB = B - A;
+    vec3d  AC = C - A;
+    vec3d  AP = P - A;
+    double d1 = AB.dot(AP);
+    double d2 = AC.dot(AP);
+    if (d1<=0 && d2<=0) return A; // vertex region A
+
+    vec3d  BP = P - B;
+    double d3 = AB.dot(BP);
+    double d4 = AC.dot(BP);
+    if (d3>=0 && d4<=d3) return B; // vertex region B
+
+    double vc = d1*d4 - d3*d2;
+    if (vc<=0 && d1>=0 && d3<=0) return A + AB * (d1/(d1-d3)); // edge region AB
+
+    vec3d  CP = P - C;
+    double d5 = AB.dot(CP);
+    double d6 = AC.dot(CP);
+    if (d6>=0 && d5<=d6) return C; // vertex region C
+
+    double vb = d5*d2 - d1*d6;
+    if (vb<=0 && d2>=0 && d6<=0) return A + AC * (d2/(d2-d6)); // edge region AC
+
+    double va = d3*d6 - d5*d4;
+    if (va<=0 && (d4-d3)>=0 && (d5-d6)>=0) return B + (C-B) * ((d4-d3)/((d4-d3)+(d5-d6))); // edge region BC
+
+    // face region
+    double den = 1.0/(va+vb+vc);
+    double v   = vb*den;
+    double w   = vc*den;
+    return A + AB*v + AC*w;
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// drops the coordinate along which the triangle normal is dominant
+CINO_INLINE
+uint triangle_projection_axis(const vec3d & A,
+                              const vec3d & B,
+                              const vec3d & C)
+{
+    vec3d n = (B-A).cross(C-A);
+    n = vec3d(std::fabs(n.x()), std::fabs(n.y()), std::fabs(n.z()));
+    if (n.x() >= n.y() && n.x() >= n.z()) return 0;
+    if (n.y() >= n.z()) return 1;
+    return 2;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+vec2d drop_coord(const vec3d & p,
+                 const uint    axis)
+{
+    switch (axis)
+    {
+        case 0 : return vec2d(p.y(), p.z());
+        case 1 : return vec2d(p.z(), p.x());
+        default: return vec2d(p.x(), p.y());
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// closed 2D segments, exact
+CINO_INLINE
+bool segment_segment_intersect_2d(const vec2d & s0,
+                                  const vec2d & s1,
+                                  const vec2d & t0,
+                                  const vec2d & t1)
+{
+    double o0 = orient2d(t0, t1, s0);
+    double o1 = orient2d(t0, t1, s1);
+    double o2 = orient2d(s0, s1, t0);
+    double o3 = orient2d(s0, s1, t1);
+
+    auto on_segment = [](const vec2d & a, const vec2d & b, const vec2d & p) // p collinear with a,b
+    {
+        return std::min(a.x(),b.x()) <= p.x() && p.x() <= std::max(a.x(),b.x()) &&
+               std::min(a.y(),b.y()) <= p.y() && p.y() <= std::max(a.y(),b.y());
+    };
+
+    if (((o0>0 && o1<0) || (o0<0 && o1>0)) &&
+        ((o2>0 && o3<0) || (o2<0 && o3>0))) return true;
+
+    if (o0==0 && on_segment(t0,t1,s0)) return true;
+    if (o1==0 && on_segment(t0,t1,s1)) return true;
+    if (o2==0 && on_segment(s0,s1,t0)) return true;
+    if (o3==0 && on_segment(s0,s1,t1)) return true;
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// closed 2D triangle, exact
+CINO_INLINE
+bool point_in_triangle_2d(const vec2d & p,
+                          const vec2d & A,
+                          const vec2d & B,
+                          const vec2d & C)
+{
+    double o0 = orient2d(A, B, p);
+    double o1 = orient2d(B, C, p);
+    double o2 = orient2d(C, A, p);
+    bool has_neg = (o0<0) || (o1<0) || (o2<0);
+    bool has_pos = (o0>0) || (o1>0) || (o2>0);
+    return !(has_neg && has_pos);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool segment_triangle_intersect_coplanar(const vec3d & s0,
+                                         const vec3d & s1,
+                                         const vec3d & A,
+                                         const vec3d & B,
+                                         const vec3d & C)
+{
+    uint  axis = triangle_projection_axis(A,B,C);
+    vec2d a    = drop_coord(A,  axis);
+    vec2d b    = drop_coord(B,  axis);
+    vec2d c    = drop_coord(C,  axis);
+    vec2d p    = drop_coord(s0, axis);
+    vec2d q    = drop_coord(s1, axis);
+
+    return point_in_triangle_2d(p, a, b, c)          ||
+           point_in_triangle_2d(q, a, b, c)          ||
+           segment_segment_intersect_2d(p, q, a, b)  ||
+           segment_segment_intersect_2d(p, q, b, c)  ||
+           segment_segment_intersect_2d(p, q, c, a);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool segment_triangle_intersect(const vec3d & s0,
+                                const vec3d & s1,
+                                const vec3d & A,
+                                const vec3d & B,
+                                const vec3d & C)
+{
+    double o0 = orient3d(A, B, C, s0);
+    double o1 = orient3d(A, B, C, s1);
+
+    if (o0==0 && o1==0) return segment_triangle_intersect_coplanar(s0, s1, A, B, C);
+    if ((o0>0 && o1>0) || (o0<0 && o1<0)) return false;
+
+    // the segment crosses (or touches) the supporting plane of the triangle:
+    // check on which side of the triangle edges its supporting line passes
+    double e0 = orient3d(s0, s1, A, B);
+    double e1 = orient3d(s0, s1, B, C);
+    double e2 = orient3d(s0, s1, C, A);
+    bool has_neg = (e0<0) || (e1<0) || (e2<0);
+    bool has_pos = (e0>0) || (e1>0) || (e2>0);
+    return !(has_neg && has_pos);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool triangle_triangle_intersect(const vec3d & A0,
+                                 const vec3d & B0,
+                                 const vec3d & C0,
+                                 const vec3d & A1,
+                                 const vec3d & B1,
+                                 const vec3d & C1)
+{
+    // early rejection: one triangle strictly on one side of the other's plane
+    double a1 = orient3d(A0, B0, C0, A1);
+    double b1 = orient3d(A0, B0, C0, B1);
+    double c1 = orient3d(A0, B0, C0, C1);
+    if ((a1>0 && b1>0 && c1>0) || (a1<0 && b1<0 && c1<0)) return false;
+
+    if (a1==0 && b1==0 && c1==0)
+    {
+        uint  axis = triangle_projection_axis(A0,B0,C0);
+        vec2d t0[3] = { drop_coord(A0,axis), drop_coord(B0,axis), drop_coord(C0,axis) };
+        vec2d t1[3] = { drop_coord(A1,axis), drop_coord(B1,axis), drop_coord(C1,axis) };
+        for(uint i=0; i<3; ++i)
+        for(uint j=0; j<3; ++j)
+        {
+            if (segment_segment_intersect_2d(t0[i], t0[(i+1)%3], t1[j], t1[(j+1)%3])) return true;
+        }
+        return point_in_triangle_2d(t0[0], t1[0], t1[1], t1[2]) ||
+               point_in_triangle_2d(t1[0], t0[0], t0[1], t0[2]);
+    }
+
+    double a0 = orient3d(A1, B1, C1, A0);
+    double b0 = orient3d(A1, B1, C1, B0);
+    double c0 = orient3d(A1, B1, C1, C0);
+    if ((a0>0 && b0>0 && c0>0) || (a0<0 && b0<0 && c0<0)) return false;
+
+    // non coplanar triangles intersect along a segment whose endpoints lie
+    // on the boundary of either triangle: test each edge against the other
+    return segment_triangle_intersect(A0, B0, A1, B1, C1) ||
+           segment_triangle_intersect(B0, C0, A1, B1, C1) ||
+           segment_triangle_intersect(C0, A0, A1, B1, C1) ||
+           segment_triangle_intersect(A1, B1, A0, B0, C0) ||
+           segment_triangle_intersect(B1, C1, A0, B0, C0) ||
+           segment_triangle_intersect(C1, A1, A0, B0, C0);
+}
+
+}
@@ -39,6 +39,7 @@
 #include <vector>
 #include <sys/types.h>
 #include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec2.h>
 #include <cinolib/geometry/vec3.h>
 
 namespace cinolib
@@ -110,6 +111,72 @@ CINO_INLINE
 bool triangle_bary_is_edge(const std::vector<double> & bary,
                            uint                      & eid, // 0,1,2 (see TRI_EDGES)
                            const double              tol = 1e-10);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Point of triangle t(A,B,C) closest to P. Reference:
+//
+//     Real-Time Collision Detection (Section 5.1.5)
+//     C. Ericson
+//     Morgan Kaufmann, 2005
+//
+CINO_INLINE
+vec3d triangle_closest_point(const vec3d & P,
+                             const vec3d & A,
+                             const vec3d & B,
+                             const vec3d & C);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Exact intersection tests, based on Shewchuk's orient2d/orient3d predicates.
+// Triangles and segments are closed sets, hence touching elements (e.g. two
+// triangles sharing a vertex) are reported as intersecting. Coplanar
+// configurations are handled by projecting on the plane that best preserves
+// the triangle. NOTE: exactinit() must be called once before using them
+//
+CINO_INLINE
+bool segment_triangle_intersect(const vec3d & s0,
+                                const vec3d & s1,
+                                const vec3d & A,
+                                const vec3d & B,
+                                const vec3d & C);
+
+CINO_INLINE
+bool triangle_triangle_intersect(const vec3d & A0,
+                                 const vec3d & B0,
+                                 const vec3d & C0,
+                                 const vec3d & A1,
+                                 const vec3d & B1,
+                                 const vec3d & C1);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Helpers for the coplanar cases of the tests above. Triangles are projected
+// on the coordinate plane orthogonal to the dominant component of their
+// normal (triangle_projection_axis), dropping that coordinate (drop_coord).
+// 2D segments and triangles are closed sets. NOTE: the 2D tests are exact,
+// hence exactinit() must be called once before using them
+//
+CINO_INLINE
+uint triangle_projection_axis(const vec3d & A,
+                              const vec3d & B,
+                              const vec3d & C); // 0,1,2 => X,Y,Z
+
+CINO_INLINE
+vec2d drop_coord(const vec3d & p,
+                 const uint    axis);
+
+CINO_INLINE
+bool segment_segment_intersect_2d(const vec2d & s0,
+                                  const vec2d & s1,
+                                  const vec2d & t0,
+                                  const vec2d & t1);
+
+CINO_INLINE
+bool point_in_triangle_2d(const vec2d & p,
+                          const vec2d & A,
+                          const vec2d & B,
+                          const vec2d & C);
 }
 
 #ifndef  CINO_STATIC_LIB
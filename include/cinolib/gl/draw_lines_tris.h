@@ -68,6 +68,7 @@ enum
     DRAW_TRI_TEXTURE1D        = 0x00000080,
     DRAW_TRI_TEXTURE2D        = 0x00000100,
     DRAW_SEGS                 = 0x00000200,
+    DRAW_TRI_AO               = 0x00000400, // modulate vertex colors with per vertex ambient occlusion
 };
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
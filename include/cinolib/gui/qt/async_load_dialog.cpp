@@ -0,0 +1,81 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/gui/qt/async_load_dialog.h>
+#include <memory>
+#include <algorithm>
+#include <QProgressDialog>
+#include <QTimer>
+
+namespace cinolib
+{
+
+template<class Mesh>
+CINO_INLINE
+void load_with_progress_dialog(const std::string                 & filename,
+                                     QWidget                     * parent,
+                               const std::function<void(Mesh &)> & on_loaded)
+{
+    std::shared_ptr<AsyncLoad<Mesh>> loader = std::make_shared<AsyncLoad<Mesh>>(filename.c_str());
+
+    QProgressDialog *dialog = new QProgressDialog("Loading " + QString::fromStdString(filename), "Cancel", 0, 100, parent);
+    dialog->setWindowModality(Qt::WindowModal);
+    dialog->setMinimumDuration(500); // small meshes load without flashing the dialog
+    dialog->setAutoReset(false);
+    dialog->setAutoClose(false);
+    QObject::connect(dialog, &QProgressDialog::canceled, [loader]() { loader->cancel(); });
+
+    // the loader is polled from the GUI thread, hence on_loaded is called from there too
+    QTimer *timer = new QTimer(dialog);
+    QObject::connect(timer, &QTimer::timeout, [loader,dialog,timer,on_loaded]()
+    {
+        if(!loader->is_ready())
+        {
+            // parsing and connectivity build weigh half each
+            LoadProgress p = loader->progress();
+            double percent = 0;
+            if(p.bytes_total>0) percent += 50.0 * p.bytes_parsed / p.bytes_total;
+            if(p.elems_total>0) percent += 50.0 * p.elems_built  / p.elems_total;
+            dialog->setValue(std::min(99, static_cast<int>(percent)));
+            return;
+        }
+        timer->stop();
+        if(loader->succeeded()) on_loaded(loader->get());
+        dialog->deleteLater(); // the timer goes with it, and so does the loader
+    });
+    timer->start(50);
+}
+
+}
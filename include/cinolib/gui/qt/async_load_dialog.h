@@ -0,0 +1,70 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_ASYNC_LOAD_DIALOG_H
+#define CINO_ASYNC_LOAD_DIALOG_H
+
+#ifdef CINOLIB_USES_QT
+
+#include <string>
+#include <functional>
+#include <cinolib/io/async_load.h>
+#include <QWidget>
+
+namespace cinolib
+{
+
+/* Loads a mesh in background (see AsyncLoad), showing a progress dialog
+ * with a cancel button. The function returns immediately, and the GUI stays
+ * responsive while loading. Once the mesh is ready, on_loaded(mesh) is called
+ * from the GUI thread (it is not called if the loading is cancelled). Drawable
+ * meshes must be updateGL()ed by on_loaded before they are rendered.
+*/
+
+template<class Mesh>
+CINO_INLINE
+void load_with_progress_dialog(const std::string                 & filename,
+                                     QWidget                     * parent,
+                               const std::function<void(Mesh &)> & on_loaded);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "async_load_dialog.cpp"
+#endif
+
+#endif // #ifdef CINOLIB_USES_QT
+
+#endif // CINO_ASYNC_LOAD_DIALOG_H
@@ -519,12 +519,16 @@ void SurfaceMeshControlPanel<Mesh>::connect()
 {
     QPushButton::connect(but_load, &QPushButton::clicked, [&]()
     {
-        std::string filename = QFileDialog::getOpenFileName(NULL, "Load mesh", ".", "3D Meshes (*.off *.obj *.iv);; OBJ(*.obj);; OFF(*.off);; IV(*.iv)").toStdString();
+        std::string filename = QFileDialog::getOpenFileName(NULL, "Load mesh", ".", "3D Meshes (*.off *.obj *.iv *.ply *.stl *.msh *.cino);; OBJ(*.obj);; OFF(*.off);; IV(*.iv);; PLY(*.ply);; STL(*.stl);; MSH(*.msh);; CINO(*.cino)").toStdString();
         if (!filename.empty())
         {
-            *m = Mesh(filename.c_str());
-            canvas->push_obj(m);
-            set_title();
+            load_with_progress_dialog<Mesh>(filename, widget, [this](Mesh & mesh)
+            {
+                *m = mesh;
+                m->updateGL();
+                canvas->push_obj(m);
+                set_title();
+            });
         }
     });
 
@@ -533,7 +537,7 @@ void SurfaceMeshControlPanel<Mesh>::connect()
     QPushButton::connect(but_save, &QPushButton::clicked, [&]()
     {
         if (m == NULL) return;
-        std::string filename = QFileDialog::getSaveFileName(NULL, "Save mesh", ".", "3D Meshes (*.off *.obj *.iv);; OBJ(*.obj);; OFF(*.off);; IV(*.iv)").toStdString();
+        std::string filename = QFileDialog::getSaveFileName(NULL, "Save mesh", ".", "3D Meshes (*.off *.obj *.iv *.ply *.stl *.msh *.cino);; OBJ(*.obj);; OFF(*.off);; IV(*.iv);; PLY(*.ply);; STL(*.stl);; MSH(*.msh);; CINO(*.cino)").toStdString();
         if (!filename.empty()) m->save(filename.c_str());
     });
 
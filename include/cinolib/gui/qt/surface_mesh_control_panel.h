@@ -42,6 +42,7 @@
 #include <cinolib/drawable_isocontour.h>
 #include <cinolib/drawable_vector_field.h>
 #include <cinolib/gui/qt/glcanvas.h>
+#include <cinolib/gui/qt/async_load_dialog.h>
 
 #include <iostream>
 #include <QWidget>
@@ -690,12 +690,16 @@ void VolumeMeshControlPanel<Mesh>::connect()
 {
     QPushButton::connect(but_load, &QPushButton::clicked, [&]()
     {
-        std::string filename = QFileDialog::getOpenFileName(NULL, "Load mesh", ".", "3D Meshes (*.MESH *.HEDRA *.VTU *.VTK)").toStdString();
+        std::string filename = QFileDialog::getOpenFileName(NULL, "Load mesh", ".", "3D Meshes (*.MESH *.HEDRA *.VTU *.VTK *.MSH *.CINO)").toStdString();
         if (!filename.empty())
         {
-            *m = Mesh(filename.c_str());
-            canvas->push_obj(m);
-            set_title();
+            load_with_progress_dialog<Mesh>(filename, widget, [this](Mesh & mesh)
+            {
+                *m = mesh;
+                m->updateGL();
+                canvas->push_obj(m);
+                set_title();
+            });
         }
     });
 
@@ -704,7 +708,7 @@ void VolumeMeshControlPanel<Mesh>::connect()
     QPushButton::connect(but_save, &QPushButton::clicked, [&]()
     {
         if (m == NULL) return;
-        std::string filename = QFileDialog::getSaveFileName(NULL, "Save mesh", ".", "3D Meshes (*.MESH *.TET *.HEDRA *.VTU *.VTK)").toStdString();
+        std::string filename = QFileDialog::getSaveFileName(NULL, "Save mesh", ".", "3D Meshes (*.MESH *.TET *.HEDRA *.VTU *.VTK *.MSH *.CINO)").toStdString();
         if (!filename.empty()) m->save(filename.c_str());
     });
 
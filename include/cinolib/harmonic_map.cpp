@@ -35,6 +35,7 @@
 *********************************************************************************/
 #include <cinolib/harmonic_map.h>
 #include <cinolib/laplacian.h>
+#include <cinolib/parallel_for.h>
 #include <Eigen/Sparse>
 
 namespace cinolib
@@ -51,18 +52,28 @@ ScalarField harmonic_map(const AbstractMesh<M,V,E,P> & m,
     assert(n > 0);
     assert(bc.size() > 0);
     assert(laplacian_mode == COTANGENT || laplacian_mode == UNIFORM);
-    assert(solver == SIMPLICIAL_LLT || solver == SIMPLICIAL_LDLT || solver == SparseLU || solver == BiCGSTAB);
+    assert(solver == SIMPLICIAL_LLT || solver == SIMPLICIAL_LDLT || solver == SparseLU || solver == BiCGSTAB || solver == CG);
 
-    ScalarField f(m.num_verts());
+    // the mixed form of polyharmonic problems is not symmetric
+    int  ls = (n == 1) ? solver : ((solver == BiCGSTAB || solver == CG) ? BiCGSTAB : SparseLU);
+    uint nv = m.num_verts();
 
-    Eigen::SparseMatrix<double> L   = laplacian(m, laplacian_mode);
-    Eigen::SparseMatrix<double> Ln = -L;
-    Eigen::VectorXd             rhs = Eigen::VectorXd::Zero(m.num_verts());
+    std::vector<uint> bc_ids;
+    Eigen::VectorXd   bc_val(bc.size());
+    for(auto obj : bc)
+    {
+        bc_val[bc_ids.size()] = obj.second;
+        bc_ids.push_back(obj.first);
+    }
 
-    for(uint i=1; i<n; ++i) Ln  = Ln * (-L); // keep it PSD
+    Eigen::SparseMatrix<double> A   = polyharmonic_matrix(laplacian(m, laplacian_mode), n);
+    Eigen::VectorXd             rhs = Eigen::VectorXd::Zero(n*nv);
+    Eigen::VectorXd             x;
 
-    solve_square_system_with_bc(Ln, rhs, f, bc, solver);
+    DirichletSolver(A, bc_ids, ls).solve(rhs, bc_val, x);
 
+    ScalarField f(nv);
+    for(uint vid=0; vid<nv; ++vid) f[vid] = x[vid];
     return f;
 }
 
@@ -80,37 +91,85 @@ std::vector<vec3d> harmonic_map_3d(const AbstractMesh<M,V,E,P> & m,
     assert(n > 0);
     assert(bc.size() > 0);
     assert(laplacian_mode == COTANGENT || laplacian_mode == UNIFORM);
-    assert(solver == SIMPLICIAL_LLT || solver == SIMPLICIAL_LDLT || solver == SparseLU || solver == BiCGSTAB);
+    assert(solver == SIMPLICIAL_LLT || solver == SIMPLICIAL_LDLT || solver == SparseLU || solver == BiCGSTAB || solver == CG);
 
-    ScalarField f(3*m.num_verts());
+    // the mixed form of polyharmonic problems is not symmetric
+    int  ls = (n == 1) ? solver : ((solver == BiCGSTAB || solver == CG) ? BiCGSTAB : SparseLU);
+    uint nv = m.num_verts();
 
-    Eigen::SparseMatrix<double> L   = laplacian_3d(m, laplacian_mode);
-    Eigen::SparseMatrix<double> Ln = -L;
-    Eigen::VectorXd             rhs = Eigen::VectorXd::Zero(3*m.num_verts());
-
-    for(uint i=1; i<n; ++i) Ln  = Ln * (-L); // keep it PSD
-
-    uint y_off = m.num_verts();
-    uint z_off = m.num_verts() + y_off;
-    std::map<uint,double> bc_1d;
+    std::vector<uint> bc_ids;
+    Eigen::MatrixXd   bc_val(bc.size(),3);
     for(auto obj : bc)
     {
-        uint  vid = obj.first;
-        vec3d pos = obj.second;
-        bc_1d[      vid] = pos.x();
-        bc_1d[y_off+vid] = pos.y();
-        bc_1d[z_off+vid] = pos.z();
+        bc_val.row(bc_ids.size()) << obj.second.x(), obj.second.y(), obj.second.z();
+        bc_ids.push_back(obj.first);
     }
 
-    solve_square_system_with_bc(Ln, rhs, f, bc_1d, solver);
+    // one N x N (or nN x nN) factorization, shared by the three coordinates
+    Eigen::SparseMatrix<double> A = polyharmonic_matrix(laplacian(m, laplacian_mode), n);
+    DirichletSolver             ds(A, bc_ids, ls);
+
+    std::vector<Eigen::VectorXd> xyz(3);
+    auto solve_coord = [&](const uint i)
+    {
+        ds.solve(Eigen::VectorXd::Zero(n*nv), Eigen::VectorXd(bc_val.col(i)), xyz[i]);
+    };
+
+    // iterative solvers are not safe to use concurrently
+    if (ls == BiCGSTAB) for(uint i=0; i<3; ++i) solve_coord(i);
+    else PARALLEL_FOR(0, 3, 0, solve_coord);
 
-    std::vector<vec3d> res(m.num_verts());
-    for(uint vid=0; vid<m.num_verts(); ++vid)
+    std::vector<vec3d> res(nv);
+    for(uint vid=0; vid<nv; ++vid)
     {
-        res.at(vid) = vec3d(f[vid], f[y_off+vid], f[z_off+vid]);
+        res.at(vid) = vec3d(xyz[0][vid], xyz[1][vid], xyz[2][vid]);
     }
 
     return res;
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Eigen::SparseMatrix<double> polyharmonic_matrix(const Eigen::SparseMatrix<double> & L,
+                                                const uint                          n)
+{
+    assert(n > 0);
+    assert(L.rows() == L.cols());
+
+    if (n == 1) return -L; // keep it PSD
+
+    uint N = L.rows();
+    std::vector<Eigen::Triplet<double>> entries;
+    entries.reserve(n*L.nonZeros() + (n-1)*N);
+
+    for (int i=0; i<L.outerSize(); ++i)
+    {
+        for (Eigen::SparseMatrix<double>::InnerIterator it(L,i); it; ++it)
+        {
+            uint row = it.row();
+            uint col = it.col();
+            double val = it.value();
+
+            // first block row: A u_{n-1} = 0
+            entries.push_back(Eigen::Triplet<double>(row, (n-1)*N + col, -val));
+
+            // block rows 1..n-1: u_k - A u_{k-1} = 0
+            for(uint k=1; k<n; ++k)
+            {
+                entries.push_back(Eigen::Triplet<double>(k*N + row, (k-1)*N + col, val));
+            }
+        }
+    }
+    for(uint k=1; k<n; ++k)
+    for(uint i=0; i<N; ++i)
+    {
+        entries.push_back(Eigen::Triplet<double>(k*N + i, k*N + i, 1.0));
+    }
+
+    Eigen::SparseMatrix<double> A(n*N, n*N);
+    A.setFromTriplets(entries.begin(), entries.end());
+    return A;
+}
+
 }
@@ -57,6 +57,14 @@ namespace cinolib
  * n = 2  | biharmonic  | C^1 at boundary conditions, C^2 everywhere else
  * n = 3  | triharmonic | C^2 at boundary conditions, C^3 everywhere else
  * ...
+ *
+ * For n > 1 the problem is solved in mixed form (see polyharmonic_matrix)
+ * rather than by explicitly computing L^n, which has much denser rows. The
+ * mixed system is not symmetric, hence SIMPLICIAL_LLT and SIMPLICIAL_LDLT
+ * are replaced with SparseLU in this case (and CG with BiCGSTAB).
+ *
+ * harmonic_map_3d factorizes the system only once, and solves for the x, y
+ * and z coordinates as three right hand sides, in parallel.
 */
 
 template<class M, class V, class E, class P>
@@ -76,6 +84,31 @@ std::vector<vec3d> harmonic_map_3d(const AbstractMesh<M,V,E,P> & m,
                                    const uint                    n = 1,
                                    const int                     laplacian_mode = COTANGENT,
                                    const int                     solver = SIMPLICIAL_LLT);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Mixed formulation of the (n)-harmonic operator. Given the N x N matrix
+ * A = -L, the problem is rewritten in terms of n unknown vectors
+ *
+ *     u_0 = phi,   u_k = A u_{k-1}   (k = 1, ..., n-1)
+ *
+ * and the (n*N) x (n*N) matrix of the system
+ *
+ *     | 0                 A |   | u_0     |   | 0 |
+ *     | -A  I               |   | u_1     |   | 0 |
+ *     |     -A  I           | * | ...     | = | 0 |
+ *     |          ...        |   |         |   |   |
+ *     |             -A   I  |   | u_{n-1} |   | 0 |
+ *
+ * is returned. The first block of rows reads A^n phi = 0, hence imposing
+ * Dirichlet conditions on (the first N entries of) the unknowns gives the
+ * same solution as the system A^n phi = 0, avoiding the fill-in of matrix
+ * powers. For n = 1 the function simply returns A.
+*/
+
+CINO_INLINE
+Eigen::SparseMatrix<double> polyharmonic_matrix(const Eigen::SparseMatrix<double> & L,
+                                                const uint                          n);
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -48,7 +48,8 @@ ScalarField heat_flow(const AbstractMesh<M,V,E,P> & m,
                       const std::vector<uint>     & heat_charges,
                       const double                  time,
                       const int                     laplacian_mode,
-                      const bool                    hard_contraint_bcs)
+                      const bool                    hard_contraint_bcs,
+                      const int                     solver)
 {
     assert(heat_charges.size() > 0);
 
@@ -62,12 +63,12 @@ ScalarField heat_flow(const AbstractMesh<M,V,E,P> & m,
     {
         std::map<uint,double> bcs;
         for(uint vid: heat_charges) bcs[vid] = 1.0;
-        solve_square_system_with_bc(MM - time * L, rhs, heat, bcs);
+        solve_square_system_with_bc(MM - time * L, rhs, heat, bcs, solver);
     }
     else // heat flow as a diffusion problem (charges lose heat)
     {
         for(uint vid : heat_charges) rhs[vid] = 1.0;
-        solve_square_system(MM - time * L, rhs, heat);
+        solve_square_system(MM - time * L, rhs, heat, solver);
     }
 
 
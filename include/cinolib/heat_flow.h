@@ -42,12 +42,14 @@
 #include <cinolib/scalar_field.h>
 #include <cinolib/meshes/abstract_mesh.h>
 #include <cinolib/symbols.h>
+#include <cinolib/linear_solvers.h>
 
 namespace cinolib
 {
 
 /* Solve the heat flow problem  (M - t * L) u = u0,
- * subject to certain Dirichlet boundary conditions
+ * subject to certain Dirichlet boundary conditions.
+ * For large meshes, use CG (preconditioned conjugate gradient) as solver.
 */
 
 template<class M, class V, class E, class P>
@@ -56,7 +58,8 @@ ScalarField heat_flow(const AbstractMesh<M,V,E,P> & m,
                       const std::vector<uint>     & heat_charges,
                       const double                  time = 1.0,
                       const int                     laplacian_mode = COTANGENT,
-                      const bool                    hard_contraint_bcs = false);
+                      const bool                    hard_contraint_bcs = false,
+                      const int                     solver = SIMPLICIAL_LLT);
 }
 
 #ifndef  CINO_STATIC_LIB
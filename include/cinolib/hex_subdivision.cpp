@@ -0,0 +1,131 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/hex_subdivision.h>
+#include <algorithm>
+#include <map>
+
+namespace cinolib
+{
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void hex_subdivision(const AbstractPolyhedralMesh<M,V,E,F,P>                 & m_in,
+                     const std::vector<std::vector<std::vector<uint>>>       & schema,
+                           AbstractPolyhedralMesh<M,V,E,F,P>                 & m_out)
+{
+    Eigen::SparseMatrix<double> R;
+    hex_subdivision(m_in, schema, m_out, R);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void hex_subdivision(const AbstractPolyhedralMesh<M,V,E,F,P>                 & m_in,
+                     const std::vector<std::vector<std::vector<uint>>>       & schema,
+                           AbstractPolyhedralMesh<M,V,E,F,P>                 & m_out,
+                           Eigen::SparseMatrix<double>                       & refinement_map)
+{
+    assert(m_in.mesh_type() == HEXMESH);
+
+    // each new vertex is identified by the (reduced) multiset of input vertices it is made of,
+    // encoded as a sorted list of (vid, multiplicity) pairs
+    typedef std::vector<std::pair<uint,uint>> Combination;
+    std::map<Combination,uint>          v_map;
+    std::vector<vec3d>                  verts;
+    std::vector<uint>                   hexas;
+    std::vector<Eigen::Triplet<double>> entries;
+
+    for(uint pid=0; pid<m_in.num_polys(); ++pid)
+    {
+        for(const auto & sub_hex : schema)
+        {
+            assert(sub_hex.size() == 8);
+            for(const auto & point : sub_hex)
+            {
+                std::vector<uint> ids;
+                for(uint off : point) ids.push_back(m_in.poly_vert_id(pid,off));
+                std::sort(ids.begin(), ids.end());
+
+                Combination c;
+                for(uint vid : ids)
+                {
+                    if (!c.empty() && c.back().first == vid) ++c.back().second;
+                    else c.push_back(std::make_pair(vid,1));
+                }
+                uint gcd = c.front().second;
+                for(auto & item : c)
+                {
+                    uint a = gcd, b = item.second;
+                    while(b != 0) { uint t = a % b; a = b; b = t; }
+                    gcd = a;
+                }
+                uint sum = 0;
+                for(auto & item : c)
+                {
+                    item.second /= gcd;
+                    sum += item.second;
+                }
+
+                auto query = v_map.find(c);
+                if (query != v_map.end())
+                {
+                    hexas.push_back(query->second);
+                    continue;
+                }
+
+                uint  fresh_vid = verts.size();
+                vec3d pos(0,0,0);
+                for(const auto & item : c)
+                {
+                    double w = static_cast<double>(item.second)/static_cast<double>(sum);
+                    pos += w * m_in.vert(item.first);
+                    entries.push_back(Eigen::Triplet<double>(fresh_vid, item.first, w));
+                }
+                v_map[c] = fresh_vid;
+                verts.push_back(pos);
+                hexas.push_back(fresh_vid);
+            }
+        }
+    }
+
+    m_out = Hexmesh<M,V,E,F,P>(verts, hexas);
+
+    refinement_map.resize(verts.size(), m_in.num_verts());
+    refinement_map.setFromTriplets(entries.begin(), entries.end());
+}
+
+}
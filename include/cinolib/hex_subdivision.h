@@ -0,0 +1,77 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_HEX_SUBDIVISION_H
+#define CINO_HEX_SUBDIVISION_H
+
+#include <cinolib/meshes/meshes.h>
+#include <cinolib/subdivision_schemas.h>
+#include <Eigen/Sparse>
+
+namespace cinolib
+{
+
+/* Regular refinement of a hexahedral mesh. Each hexahedron is split as
+ * prescribed by a subdivision schema (e.g. hex_to_grid_2x2x2, see
+ * subdivision_schemas.h), and vertices shared by adjacent elements are
+ * merged (two new vertices are the same if they are the same combination
+ * of input vertices).
+ *
+ * The second version also outputs the refinement map, that is, the sparse
+ * matrix R such that the vertices of m_out are R * (vertices of m_in). The
+ * same matrix interpolates any per vertex field from m_in to m_out, and can
+ * be used as prolongation operator for geometric multigrid (see multigrid.h)
+*/
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void hex_subdivision(const AbstractPolyhedralMesh<M,V,E,F,P>                 & m_in,
+                     const std::vector<std::vector<std::vector<uint>>>       & schema,
+                           AbstractPolyhedralMesh<M,V,E,F,P>                 & m_out);
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void hex_subdivision(const AbstractPolyhedralMesh<M,V,E,F,P>                 & m_in,
+                     const std::vector<std::vector<std::vector<uint>>>       & schema,
+                           AbstractPolyhedralMesh<M,V,E,F,P>                 & m_out,
+                           Eigen::SparseMatrix<double>                       & refinement_map);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "hex_subdivision.cpp"
+#endif
+
+#endif // CINO_HEX_SUBDIVISION_H
@@ -0,0 +1,176 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/indexed_heap.h>
+#include <algorithm>
+#include <assert.h>
+
+namespace cinolib
+{
+
+template<typename T, uint D>
+const uint IndexedHeap<T,D>::NOT_IN_HEAP;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T, uint D>
+CINO_INLINE
+void IndexedHeap<T,D>::resize(const uint max_id)
+{
+    heap.clear();
+    pos.assign(max_id, NOT_IN_HEAP);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T, uint D>
+CINO_INLINE
+void IndexedHeap<T,D>::clear()
+{
+    for(const auto & item : heap) pos[item.second] = NOT_IN_HEAP;
+    heap.clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T, uint D>
+CINO_INLINE
+void IndexedHeap<T,D>::push(const uint id, const T & key)
+{
+    assert(!contains(id));
+    pos[id] = heap.size();
+    heap.push_back(std::make_pair(key,id));
+    sift_up(heap.size()-1);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T, uint D>
+CINO_INLINE
+void IndexedHeap<T,D>::decrease_key(const uint id, const T & key)
+{
+    assert(contains(id));
+    uint i = pos[id];
+    assert(!(heap[i].first < key));
+    heap[i].first = key;
+    sift_up(i);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T, uint D>
+CINO_INLINE
+bool IndexedHeap<T,D>::push_or_decrease(const uint id, const T & key)
+{
+    if(!contains(id))
+    {
+        push(id,key);
+        return true;
+    }
+    if(key < heap[pos[id]].first)
+    {
+        decrease_key(id,key);
+        return true;
+    }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T, uint D>
+CINO_INLINE
+uint IndexedHeap<T,D>::pop()
+{
+    assert(!empty());
+    uint id = heap.front().second;
+    pos[id] = NOT_IN_HEAP;
+    if(heap.size()>1)
+    {
+        heap.front() = heap.back();
+        pos[heap.front().second] = 0;
+        heap.pop_back();
+        sift_down(0);
+    }
+    else heap.pop_back();
+    return id;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T, uint D>
+CINO_INLINE
+void IndexedHeap<T,D>::sift_up(uint i)
+{
+    std::pair<T,uint> item = heap[i];
+    while(i>0)
+    {
+        uint parent = (i-1)/D;
+        if(!(item.first < heap[parent].first)) break;
+        heap[i] = heap[parent];
+        pos[heap[i].second] = i;
+        i = parent;
+    }
+    heap[i] = item;
+    pos[item.second] = i;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T, uint D>
+CINO_INLINE
+void IndexedHeap<T,D>::sift_down(uint i)
+{
+    std::pair<T,uint> item = heap[i];
+    uint n = heap.size();
+    while(true)
+    {
+        uint first = D*i+1;
+        if(first>=n) break;
+        uint last  = std::min(first+D, n);
+        uint best  = first;
+        for(uint c=first+1; c<last; ++c)
+        {
+            if(heap[c].first < heap[best].first) best = c;
+        }
+        if(!(heap[best].first < item.first)) break;
+        heap[i] = heap[best];
+        pos[heap[i].second] = i;
+        i = best;
+    }
+    heap[i] = item;
+    pos[item.second] = i;
+}
+
+}
@@ -0,0 +1,102 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_INDEXED_HEAP_H
+#define CINO_INDEXED_HEAP_H
+
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+
+namespace cinolib
+{
+
+/* Indexed d-ary min heap for items with ids in [0,max_id). Besides the
+ * usual push/pop, it supports decrease key in O(log_d n), which is what
+ * Dijkstra-like algorithms need. Each id can be in the heap at most once.
+ *
+ * The heap can be reused for multiple queries: clear() only resets the
+ * items that are still in the heap, hence its cost does not depend on
+ * max_id. With D=4 the heap is shallower than a binary heap, and the
+ * children of a node are likely to share the same cache line.
+*/
+
+template<typename T = double, uint D = 4>
+class IndexedHeap
+{
+    public:
+
+        explicit IndexedHeap(const uint max_id = 0) { resize(max_id); }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void resize(const uint max_id); // also clears the heap
+        void clear();
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        bool empty()                   const { return heap.empty();    }
+        uint size()                    const { return heap.size();     }
+        uint max_id()                  const { return pos.size();      }
+        bool contains(const uint id)   const { return pos.at(id) != NOT_IN_HEAP; }
+        T    key     (const uint id)   const { return heap.at(pos.at(id)).first; }
+        uint top()                     const { return heap.front().second; }
+        T    top_key()                 const { return heap.front().first;  }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void push        (const uint id, const T & key); // id must not be in the heap
+        void decrease_key(const uint id, const T & key); // key must not be greater than the current one
+        bool push_or_decrease(const uint id, const T & key); // returns true if the heap changed
+        uint pop();
+
+    protected:
+
+        static const uint NOT_IN_HEAP = 0xFFFFFFFF;
+
+        std::vector<std::pair<T,uint>> heap; // (key,id)
+        std::vector<uint>              pos;  // position of each id in the heap
+
+        void sift_up  (uint i);
+        void sift_down(uint i);
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "indexed_heap.cpp"
+#endif
+
+#endif // CINO_INDEXED_HEAP_H
@@ -0,0 +1,125 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/async_load.h>
+#include <stdio.h>
+#include <chrono>
+#include <iostream>
+
+namespace cinolib
+{
+
+template<class Mesh>
+CINO_INLINE
+AsyncLoad<Mesh>::AsyncLoad(const char * filename, const std::function<void(const LoadProgress &)> & callback)
+: filename(filename)
+, monitor(callback)
+{
+    // readers exit() if the file cannot be opened: check it
+    // here, so that a missing file does not kill the application
+    FILE *f = fopen(filename, "rb");
+    if(!f)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : AsyncLoad() : couldn't open input file " << filename << std::endl;
+        return;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+
+    // the total is set on the loading thread, so that the callback
+    // is never called from the thread that constructs the loader
+    result = std::async(std::launch::async, [this,size]()
+    {
+        ScopedLoadMonitor scope(&monitor);
+        if(size>0) monitor.set_bytes_total(size);
+        mesh.load(this->filename.c_str());
+        loaded = !monitor.is_cancelled();
+        if(!loaded) mesh.clear();
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+AsyncLoad<Mesh>::~AsyncLoad()
+{
+    if(result.valid() && !is_ready())
+    {
+        monitor.cancel();
+        result.wait();
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+bool AsyncLoad<Mesh>::is_ready() const
+{
+    return wait_for(0);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+bool AsyncLoad<Mesh>::wait_for(const double seconds) const
+{
+    if(!result.valid()) return true;
+    return result.wait_for(std::chrono::duration<double>(seconds)) == std::future_status::ready;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void AsyncLoad<Mesh>::wait() const
+{
+    if(result.valid()) result.wait();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+bool AsyncLoad<Mesh>::succeeded() const
+{
+    wait();
+    return loaded;
+}
+
+}
@@ -0,0 +1,108 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_ASYNC_LOAD_H
+#define CINO_ASYNC_LOAD_H
+
+#include <future>
+#include <memory>
+#include <string>
+#include <cinolib/cino_inline.h>
+#include <cinolib/io/load_monitor.h>
+
+namespace cinolib
+{
+
+/* Loads a mesh in background. The reader and the connectivity build run on
+ * a worker thread (which in turn uses as many threads as PARALLEL_FOR does),
+ * while the caller polls for completion and progress, or waits. Progress
+ * (bytes parsed and elements built) is also pushed through the optional
+ * callback, which is called from the loading threads (see LoadMonitor).
+ * Cancellation is cooperative, and a cancelled mesh is left empty.
+ *
+ * Mesh can be any mesh type that can be default constructed and then
+ * load()ed (e.g. Trimesh<>, Tetmesh<>, ...). Drawable meshes can be
+ * loaded as well, but their GPU buffers are not updated: call updateGL()
+ * from the GUI thread once the mesh is ready. Typical usage:
+ *
+ *     AsyncLoad<DrawableTrimesh<>> loader("bunny.obj");
+ *     while(!loader.is_ready()) { ...redraw the GUI, show loader.progress()... }
+ *     if(loader.succeeded()) { *m = loader.get(); m->updateGL(); }
+ *
+ * Destroying a loader cancels the loading (if still running) and waits for
+ * the worker to return.
+*/
+
+template<class Mesh>
+class AsyncLoad
+{
+    public:
+
+        explicit AsyncLoad(const char * filename, const std::function<void(const LoadProgress &)> & callback = nullptr);
+        ~AsyncLoad();
+
+        AsyncLoad(const AsyncLoad &) = delete;
+        AsyncLoad & operator=(const AsyncLoad &) = delete;
+
+        bool is_ready() const;                       // never blocks
+        bool wait_for(const double seconds) const;   // true if ready
+        void wait() const;
+
+        void cancel()             { monitor.cancel();         }
+        bool is_cancelled() const { return monitor.is_cancelled(); }
+        bool succeeded()    const; // waits. False if cancelled or if the file could not be opened
+
+        LoadProgress progress() const { return monitor.progress(); }
+
+        // wait for the loading to complete
+              Mesh & get()       { wait(); return mesh; }
+        const Mesh & get() const { wait(); return mesh; }
+
+    protected:
+
+        std::string       filename;
+        Mesh              mesh;
+        LoadMonitor       monitor;
+        bool              loaded = false; // set by the worker
+        std::future<void> result;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "async_load.cpp"
+#endif
+
+#endif // CINO_ASYNC_LOAD_H
@@ -0,0 +1,161 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/cino_format.h>
+#include <cstring>
+#include <algorithm>
+
+namespace cinolib
+{
+
+CINO_INLINE
+bool host_is_little_endian()
+{
+    const uint32_t x = 1;
+    unsigned char c;
+    memcpy(&c, &x, 1);
+    return c==1;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void swap_byte_order(void * data, const size_t scalar_size, const size_t n)
+{
+    if(scalar_size<2) return;
+    unsigned char * ptr = static_cast<unsigned char*>(data);
+    for(size_t i=0; i<n; ++i, ptr+=scalar_size)
+    {
+        std::reverse(ptr, ptr+scalar_size);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint64_t xxhash64(const void * data, const size_t n_bytes, const uint64_t seed)
+{
+    static const uint64_t P1 = 11400714785074694791ull;
+    static const uint64_t P2 = 14029467366897019727ull;
+    static const uint64_t P3 =  1609587929392839161ull;
+    static const uint64_t P4 =  9650029242287828579ull;
+    static const uint64_t P5 =  2870177450012600261ull;
+
+    const bool little_endian = host_is_little_endian();
+
+    auto rotl   = [](const uint64_t x, const int r) { return (x << r) | (x >> (64-r)); };
+    auto read64 = [&](const unsigned char * p)
+    {
+        uint64_t x;
+        memcpy(&x, p, 8);
+        if(!little_endian) swap_byte_order(&x, 8, 1);
+        return x;
+    };
+    auto read32 = [&](const unsigned char * p)
+    {
+        uint32_t x;
+        memcpy(&x, p, 4);
+        if(!little_endian) swap_byte_order(&x, 4, 1);
+        return (uint64_t)x;
+    };
+    auto round = [&](uint64_t acc, const uint64_t input)
+    {
+        acc += input * P2;
+        acc  = rotl(acc, 31);
+        return acc * P1;
+    };
+    auto merge = [&](uint64_t acc, const uint64_t val)
+    {
+        acc ^= round(0, val);
+        return acc * P1 + P4;
+    };
+
+    const unsigned char * p   = static_cast<const unsigned char*>(data);
+    const unsigned char * end = p + n_bytes;
+    uint64_t h;
+
+    if(n_bytes>=32)
+    {
+        uint64_t v1 = seed + P1 + P2;
+        uint64_t v2 = seed + P2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - P1;
+        const unsigned char * limit = end - 32;
+        do
+        {
+            v1 = round(v1, read64(p   ));
+            v2 = round(v2, read64(p+ 8));
+            v3 = round(v3, read64(p+16));
+            v4 = round(v4, read64(p+24));
+            p += 32;
+        }
+        while(p<=limit);
+
+        h = rotl(v1,1) + rotl(v2,7) + rotl(v3,12) + rotl(v4,18);
+        h = merge(h, v1);
+        h = merge(h, v2);
+        h = merge(h, v3);
+        h = merge(h, v4);
+    }
+    else h = seed + P5;
+
+    h += (uint64_t)n_bytes;
+
+    for(; p+8<=end; p+=8)
+    {
+        h ^= round(0, read64(p));
+        h  = rotl(h,27) * P1 + P4;
+    }
+    if(p+4<=end)
+    {
+        h ^= read32(p) * P1;
+        h  = rotl(h,23) * P2 + P3;
+        p += 4;
+    }
+    for(; p<end; ++p)
+    {
+        h ^= (*p) * P5;
+        h  = rotl(h,11) * P1;
+    }
+
+    h ^= h >> 33;
+    h *= P2;
+    h ^= h >> 29;
+    h *= P3;
+    h ^= h >> 32;
+    return h;
+}
+
+}
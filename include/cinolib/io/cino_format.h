@@ -0,0 +1,153 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_CINO_FORMAT_H
+#define CINO_CINO_FORMAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <cinolib/cino_inline.h>
+
+namespace cinolib
+{
+
+/* Native binary container for cinolib meshes (*.cino). Layout:
+ *
+ *   [0,64)       header    : magic, format version, byte order mark, mesh type,
+ *                            number of sections, mesh hash, directory checksum
+ *   [64,...)     directory : one CinoSectionEntry per section
+ *   [...)        sections  : raw arrays, each starting at a 64 bytes boundary
+ *
+ * Arrays are stored in the byte order of the machine that wrote the file.
+ * Readers running on a machine with opposite endianness detect it from the
+ * byte order mark and swap each scalar (whose size is stored in the entry).
+ * Variable length lists (polygons, faces, adjacency relations) are stored in
+ * CSR form, as two sections: offsets (uint64_t, one per list plus one) with
+ * the id of the relation, and packed uint32_t ids with id + CINO_CSR_IDS.
+ * Every section is protected by a 64 bit xxHash checksum of its bytes.
+*/
+
+static const char     CINO_MAGIC[8]    = { 'C','I','N','O','M','E','S','H' };
+static const uint32_t CINO_VERSION     = 1;
+static const uint32_t CINO_BYTE_ORDER  = 0x01020304;
+static const uint64_t CINO_ALIGNMENT   = 64;
+static const uint32_t CINO_CSR_IDS     = 0x1000;
+
+enum
+{
+    // geometry and connectivity
+    CINO_VERTS         = 1,  // double x3
+    CINO_POLYS         = 2,  // CSR : polygon => verts, polyhedron => faces
+    CINO_FACES         = 3,  // CSR : face => verts (polyhedral meshes only)
+    CINO_POLY_WINDING  = 4,  // uint8_t, one per entry of CINO_POLYS (polyhedral meshes only)
+    CINO_EDGES         = 5,  // uint32_t x2
+    // adjacency
+    CINO_V2V           = 10, // CSR
+    CINO_V2E           = 11, // CSR
+    CINO_V2F           = 12, // CSR
+    CINO_V2P           = 13, // CSR
+    CINO_E2F           = 14, // CSR
+    CINO_E2P           = 15, // CSR
+    CINO_F2E           = 16, // CSR
+    CINO_F2F           = 17, // CSR
+    CINO_F2P           = 18, // CSR
+    CINO_P2V           = 19, // CSR
+    CINO_P2E           = 20, // CSR
+    CINO_P2P           = 21, // CSR
+    CINO_POLY_TRIS     = 22, // CSR : polygon tessellation (polygon meshes only)
+    CINO_FACE_TRIS     = 23, // CSR : face tessellation (polyhedral meshes only)
+    // attributes
+    CINO_VERT_UVW      = 40, // double x3
+    CINO_VERT_LABELS   = 41, // int32_t
+    CINO_POLY_LABELS   = 42, // int32_t
+    CINO_POLY_COLORS   = 43, // float x4 (rgba)
+    CINO_POLY_QUALITY  = 44, // float
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct CinoHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t mesh_type;
+    uint32_t num_sections;
+    uint64_t mesh_hash;          // see mesh_hash.h
+    uint64_t directory_checksum;
+    uint8_t  reserved[24];
+};
+
+struct CinoSectionEntry
+{
+    uint32_t id;
+    uint32_t scalar_size; // bytes per scalar (1,4 or 8)
+    uint64_t count;       // number of scalars
+    uint64_t offset;      // from the beginning of the file
+    uint64_t checksum;
+};
+
+static_assert(sizeof(CinoHeader)       == 64, "unexpected CinoHeader size");
+static_assert(sizeof(CinoSectionEntry) == 32, "unexpected CinoSectionEntry size");
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* xxHash64 (Y. Collet). Bytes are read in little endian order regardless of
+ * the host, so that the checksum of a section does not depend on the machine
+ * that computes it.
+*/
+
+CINO_INLINE
+uint64_t xxhash64(const void * data, const size_t n_bytes, const uint64_t seed = 0);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool host_is_little_endian();
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// reverses the byte order of n scalars of scalar_size bytes each
+//
+CINO_INLINE
+void swap_byte_order(void * data, const size_t scalar_size, const size_t n);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "cino_format.cpp"
+#endif
+
+#endif // CINO_CINO_FORMAT_H
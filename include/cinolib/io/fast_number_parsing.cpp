@@ -0,0 +1,207 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/fast_number_parsing.h>
+#include <stdint.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+#include <locale.h>
+#include <sstream>
+#include <locale>
+
+namespace cinolib
+{
+
+CINO_INLINE
+bool is_space(const char c)
+{
+    return c==' ' || c=='\t' || c=='\n' || c=='\r' || c=='\v' || c=='\f';
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+const char * skip_spaces(const char * s, const char * end)
+{
+    while(s<end && is_space(*s)) ++s;
+    return s;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool parse_int(const char * & s, const char * end, int & val)
+{
+    const char *p = skip_spaces(s, end);
+    bool neg = false;
+    if(p<end && (*p=='-' || *p=='+')) neg = (*p++ == '-');
+    if(p>=end || *p<'0' || *p>'9') return false;
+
+    int64_t v = 0;
+    while(p<end && *p>='0' && *p<='9')
+    {
+        if(v < ((int64_t)1<<40)) v = 10*v + (*p - '0');
+        ++p;
+    }
+    if(v>INT_MAX) v = INT_MAX;
+    val = (int)(neg ? -v : v);
+    s = p;
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool parse_double(const char * & s, const char * end, double & val)
+{
+    const char *p = skip_spaces(s, end);
+    const char *beg = p;
+
+    bool neg = false;
+    if(p<end && (*p=='-' || *p=='+')) neg = (*p++ == '-');
+
+    // mantissa (as integer) and decimal exponent
+    uint64_t m       = 0;
+    int      n_sig   = 0; // significant digits
+    int      exp10   = 0;
+    bool     digits  = false;
+    while(p<end && *p>='0' && *p<='9')
+    {
+        digits = true;
+        if(n_sig>0 || *p!='0') { if(n_sig<19) m = 10*m + (*p-'0'); else ++exp10; ++n_sig; }
+        ++p;
+    }
+    if(p<end && *p=='.')
+    {
+        ++p;
+        while(p<end && *p>='0' && *p<='9')
+        {
+            digits = true;
+            if(n_sig>0 || *p!='0') { if(n_sig<19) { m = 10*m + (*p-'0'); --exp10; } ++n_sig; }
+            else --exp10;
+            ++p;
+        }
+    }
+    if(digits && p<end && (*p=='e' || *p=='E'))
+    {
+        const char *q = p+1;
+        int e;
+        if(q<end && !is_space(*q) && parse_int(q, end, e))
+        {
+            exp10 += e;
+            p = q;
+        }
+    }
+
+    bool fast = digits && n_sig<=19 && exp10>=-27 && exp10<=27 && (p>=end || (*p!='x' && *p!='X'));
+#if LDBL_MANT_DIG >= 64
+    if(fast)
+    {
+        // 10^|exp10| and m are exact in extended precision, hence r is
+        // correctly rounded. Rounding r to double is correct as well,
+        // unless r is (close to) the midpoint between two doubles
+        static const long double pow10[] =
+        {
+            1e0L,  1e1L,  1e2L,  1e3L,  1e4L,  1e5L,  1e6L,  1e7L,  1e8L,  1e9L,
+            1e10L, 1e11L, 1e12L, 1e13L, 1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L,
+            1e20L, 1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L
+        };
+        long double r = (exp10<0) ? (long double)m / pow10[-exp10] : (long double)m * pow10[exp10];
+        if(m==0)
+        {
+            val = neg ? -0.0 : 0.0;
+            s = p;
+            return true;
+        }
+        int ex;
+        uint64_t bits = (uint64_t)ldexpl(frexpl(r,&ex), 64);
+        uint     low  = bits & 0x7FF;
+        if(low<0x3FF || low>0x401)
+        {
+            val = (double)(neg ? -r : r);
+            s = p;
+            return true;
+        }
+    }
+#else
+    if(fast && n_sig<=15 && m < ((uint64_t)1<<53) && exp10>=-22 && exp10<=22)
+    {
+        // Clinger's fast path: both m and 10^|exp10| are exact doubles
+        static const double pow10[] =
+        {
+            1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        double r = (exp10<0) ? (double)m / pow10[-exp10] : (double)m * pow10[exp10];
+        val = neg ? -r : r;
+        s = p;
+        return true;
+    }
+#endif
+
+    // slow path: strtod on a null terminated copy of the token. If the
+    // current locale does not use the dot as decimal separator, use the
+    // "C" locale through a string stream instead
+    char buf[128];
+    size_t n = 0;
+    for(const char *q=beg; q<end && !is_space(*q) && n<sizeof(buf)-1; ++q) buf[n++] = *q;
+    buf[n] = '\0';
+    if(n==0) return false;
+
+    char *stop;
+    const char *dp = localeconv()->decimal_point;
+    if(dp[0]=='.' && dp[1]=='\0')
+    {
+        double r = strtod(buf, &stop);
+        if(stop==buf) return false;
+        val = r;
+        s = beg + (stop-buf);
+        return true;
+    }
+
+    std::istringstream ss(buf);
+    ss.imbue(std::locale::classic());
+    double r;
+    if(!(ss >> r)) return false;
+    std::streamoff consumed = ss.eof() ? (std::streamoff)n : (std::streamoff)ss.tellg();
+    val = r;
+    s = beg + consumed;
+    return true;
+}
+
+}
@@ -0,0 +1,83 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_FAST_NUMBER_PARSING_H
+#define CINO_FAST_NUMBER_PARSING_H
+
+#include <cinolib/cino_inline.h>
+
+namespace cinolib
+{
+
+/* Locale independent parsing of numbers from a (non null terminated) range
+ * of characters, to be used in place of sscanf/strtod in file readers. Both
+ * functions skip leading white spaces (as %d and %lf do), and on success move
+ * s past the number and return true. On failure s is left unchanged.
+ *
+ * parse_double() returns exactly the same (correctly rounded) value of strtod.
+ * Decimal numbers with up to 19 significant digits and small exponents (i.e.
+ * anything written with printf, up to %.17g) are converted with a single
+ * extended precision operation. If the result might be off by one ulp (i.e.
+ * it is too close to the midpoint between two doubles), and for anything more
+ * exotic (long mantissas, large exponents, inf, nan, hex floats), the number
+ * is converted with strtod.
+*/
+
+CINO_INLINE
+bool parse_int(const char * & s, const char * end, int & val);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool parse_double(const char * & s, const char * end, double & val);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// same white spaces of isspace() in the "C" locale
+CINO_INLINE
+bool is_space(const char c);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+const char * skip_spaces(const char * s, const char * end);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "fast_number_parsing.cpp"
+#endif
+
+#endif // CINO_FAST_NUMBER_PARSING_H
@@ -0,0 +1,493 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/field_file.h>
+#include <cinolib/io/cino_format.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <cstring>
+
+namespace cinolib
+{
+
+CINO_INLINE
+uint64_t field_double_bits(const double d)
+{
+    uint64_t u;
+    memcpy(&u, &d, 8);
+    return u;
+}
+
+CINO_INLINE
+double field_bits_double(const uint64_t u)
+{
+    double d;
+    memcpy(&d, &u, 8);
+    return d;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// control byte c < 128 : c+1 literal bytes follow
+// control byte c >=128 : the next byte is repeated c-125 times (3..130)
+CINO_INLINE
+void field_rle_encode(const std::vector<uint8_t> & in, std::vector<uint8_t> & out)
+{
+    size_t i = 0, lit_beg = 0;
+    auto flush_literals = [&](const size_t end)
+    {
+        while(lit_beg<end)
+        {
+            size_t n = std::min<size_t>(128, end-lit_beg);
+            out.push_back(static_cast<uint8_t>(n-1));
+            out.insert(out.end(), in.begin()+lit_beg, in.begin()+lit_beg+n);
+            lit_beg += n;
+        }
+    };
+    while(i<in.size())
+    {
+        size_t run = 1;
+        while(i+run<in.size() && run<130 && in[i+run]==in[i]) ++run;
+        if(run>=3)
+        {
+            flush_literals(i);
+            out.push_back(static_cast<uint8_t>(run+125));
+            out.push_back(in[i]);
+            i += run;
+            lit_beg = i;
+        }
+        else i += run;
+    }
+    flush_literals(in.size());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool field_rle_decode(const uint8_t * in, const size_t in_size, uint8_t * out, const size_t out_size)
+{
+    size_t i = 0, o = 0;
+    while(i<in_size)
+    {
+        uint c = in[i++];
+        if(c<128)
+        {
+            size_t n = c+1;
+            if(i+n>in_size || o+n>out_size) return false;
+            memcpy(out+o, in+i, n);
+            i += n;
+            o += n;
+        }
+        else
+        {
+            size_t n = c-125;
+            if(i>=in_size || o+n>out_size) return false;
+            memset(out+o, in[i++], n);
+            o += n;
+        }
+    }
+    return o==out_size;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void field_put_uint64_le(uint8_t * p, const uint64_t v)
+{
+    for(uint k=0; k<8; ++k) p[k] = static_cast<uint8_t>(v>>(8*k));
+}
+
+CINO_INLINE
+uint64_t field_get_uint64_le(const uint8_t * p)
+{
+    uint64_t v = 0;
+    for(uint k=0; k<8; ++k) v |= static_cast<uint64_t>(p[k])<<(8*k);
+    return v;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void field_compress(const double          * data,
+                    const size_t            n,
+                    const uint              components,
+                    const uint              block_size,
+                    std::vector<uint8_t>  & out)
+{
+    assert(components>0 && block_size>0);
+    uint n_blocks = (n + block_size - 1) / block_size;
+    std::vector<std::vector<uint8_t>> blocks(n_blocks);
+
+    PARALLEL_FOR(0, n_blocks, 2, [&](const uint bid)
+    {
+        size_t beg = static_cast<size_t>(bid)*block_size;
+        size_t nb  = std::min<size_t>(block_size, n-beg);
+
+        // delta (XOR with the previous value of the same component) + byte shuffle
+        std::vector<uint8_t> shuffled(8*nb);
+        for(size_t i=0; i<nb; ++i)
+        {
+            uint64_t u = field_double_bits(data[beg+i]);
+            if(i>=components) u ^= field_double_bits(data[beg+i-components]);
+            for(uint k=0; k<8; ++k) shuffled[(7-k)*nb+i] = static_cast<uint8_t>(u>>(8*k));
+        }
+        field_rle_encode(shuffled, blocks[bid]);
+    });
+
+    size_t size = 8*static_cast<size_t>(n_blocks);
+    for(const auto & b : blocks) size += b.size();
+    out.resize(size);
+
+    uint64_t end = 0;
+    uint8_t * p  = out.data() + 8*static_cast<size_t>(n_blocks);
+    for(uint bid=0; bid<n_blocks; ++bid)
+    {
+        if(!blocks[bid].empty()) memcpy(p+end, blocks[bid].data(), blocks[bid].size());
+        end += blocks[bid].size();
+        field_put_uint64_le(out.data()+8*bid, end);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool field_decompress(const uint8_t * in,
+                      const size_t    in_size,
+                      const size_t    n,
+                      const uint      components,
+                      const uint      block_size,
+                      double        * data)
+{
+    if(components==0 || block_size==0) return false;
+    uint n_blocks = (n + block_size - 1) / block_size;
+    if(in_size < 8*static_cast<size_t>(n_blocks)) return false;
+
+    const uint8_t * blocks_data = in + 8*static_cast<size_t>(n_blocks);
+    size_t          blocks_size = in_size - 8*static_cast<size_t>(n_blocks);
+
+    std::vector<char> ok(n_blocks, 0);
+    PARALLEL_FOR(0, n_blocks, 2, [&](const uint bid)
+    {
+        uint64_t beg = (bid>0) ? field_get_uint64_le(in+8*(bid-1)) : 0;
+        uint64_t end = field_get_uint64_le(in+8*bid);
+        if(beg>end || end>blocks_size) return;
+
+        size_t first = static_cast<size_t>(bid)*block_size;
+        size_t nb    = std::min<size_t>(block_size, n-first);
+        std::vector<uint8_t> shuffled(8*nb);
+        if(!field_rle_decode(blocks_data+beg, end-beg, shuffled.data(), shuffled.size())) return;
+
+        for(size_t i=0; i<nb; ++i)
+        {
+            uint64_t u = 0;
+            for(uint k=0; k<8; ++k) u |= static_cast<uint64_t>(shuffled[(7-k)*nb+i])<<(8*k);
+            if(i>=components) u ^= field_double_bits(data[first+i-components]);
+            data[first+i] = field_bits_double(u);
+        }
+        ok[bid] = 1;
+    });
+    return std::find(ok.begin(), ok.end(), 0)==ok.end();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+FieldFileWriter::FieldFileWriter(const char * filename, const uint components, const bool append)
+    : components(components)
+{
+    assert(components>0);
+
+    if(append && (fp = fopen(filename, "r+b")))
+    {
+        FieldFileHeader h;
+        if(fread(&h, sizeof(FieldFileHeader), 1, fp)!=1 ||
+           memcmp(h.magic, FIELD_MAGIC, 8)!=0           ||
+           h.byte_order!=FIELD_BYTE_ORDER               ||
+           h.version>FIELD_VERSION                      ||
+           h.components!=components)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : FieldFileWriter() : cannot append to " << filename << " (not a field file, different byte order or different number of components)" << std::endl;
+            fclose(fp);
+            fp = nullptr;
+            return;
+        }
+
+        // skip complete frames. Incomplete ones (if any) will be overwritten
+        fseek(fp, 0, SEEK_END);
+        long size = ftell(fp);
+        long pos  = sizeof(FieldFileHeader);
+        FieldFrameHeader f;
+        while(fseek(fp, pos, SEEK_SET)==0 && fread(&f, sizeof(FieldFrameHeader), 1, fp)==1)
+        {
+            if(f.magic!=FIELD_FRAME_MAGIC) break;
+            uint64_t payload = (f.stored_size + FIELD_ALIGNMENT - 1) / FIELD_ALIGNMENT * FIELD_ALIGNMENT;
+            if(payload > static_cast<uint64_t>(size - pos) - sizeof(FieldFrameHeader)) break;
+            pos += sizeof(FieldFrameHeader) + payload;
+        }
+        fseek(fp, pos, SEEK_SET);
+        return;
+    }
+
+    fp = fopen(filename, "wb");
+    if(!fp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : FieldFileWriter() : couldn't write output file " << filename << std::endl;
+        return;
+    }
+
+    FieldFileHeader h;
+    memset(&h, 0, sizeof(FieldFileHeader));
+    memcpy(h.magic, FIELD_MAGIC, 8);
+    h.version    = FIELD_VERSION;
+    h.byte_order = FIELD_BYTE_ORDER;
+    h.components = components;
+    fwrite(&h, sizeof(FieldFileHeader), 1, fp);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+FieldFileWriter::~FieldFileWriter()
+{
+    close();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool FieldFileWriter::write(const double * data, const size_t num_values, const double time, const bool compress)
+{
+    if(!fp) return false;
+    assert(num_values%components==0);
+
+    FieldFrameHeader f;
+    memset(&f, 0, sizeof(FieldFrameHeader));
+    f.magic       = FIELD_FRAME_MAGIC;
+    f.encoding    = FIELD_RAW;
+    f.num_values  = num_values;
+    f.time        = time;
+    f.stored_size = num_values*sizeof(double);
+    f.block_size  = FIELD_BLOCK_SIZE;
+
+    std::vector<uint8_t> buf;
+    const void * payload = data;
+    if(compress && num_values>0)
+    {
+        field_compress(data, num_values, components, FIELD_BLOCK_SIZE, buf);
+        if(buf.size() < f.stored_size)
+        {
+            f.encoding    = FIELD_SHUFFLE_DELTA;
+            f.stored_size = buf.size();
+            payload       = buf.data();
+        }
+    }
+    f.checksum = xxhash64(payload, f.stored_size);
+
+    static const char zeros[FIELD_ALIGNMENT] = {};
+    size_t pad = (FIELD_ALIGNMENT - f.stored_size%FIELD_ALIGNMENT) % FIELD_ALIGNMENT;
+    bool   ok  = fwrite(&f, sizeof(FieldFrameHeader), 1, fp)==1 &&
+                 fwrite(payload, 1, f.stored_size, fp)==f.stored_size &&
+                 fwrite(zeros, 1, pad, fp)==pad &&
+                 fflush(fp)==0;
+    if(!ok)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : FieldFileWriter::write() : write failed" << std::endl;
+    }
+    return ok;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool FieldFileWriter::write(const std::vector<double> & data, const double time, const bool compress)
+{
+    return write(data.data(), data.size(), time, compress);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool FieldFileWriter::close()
+{
+    if(!fp) return false;
+    bool ok = (fclose(fp)==0);
+    fp = nullptr;
+    return ok;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+FieldFileReader::FieldFileReader(const char * filename, const bool verify_checksums)
+    : file(filename)
+    , verify(verify_checksums)
+{
+    memset(&header, 0, sizeof(FieldFileHeader));
+
+    if(!file.is_open())
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : FieldFileReader() : couldn't open input file " << filename << std::endl;
+        return;
+    }
+
+    if(file.size()<sizeof(FieldFileHeader) || memcmp(file.data(), FIELD_MAGIC, 8)!=0)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : FieldFileReader() : " << filename << " is not a field file" << std::endl;
+        return;
+    }
+
+    memcpy(&header, file.data(), sizeof(FieldFileHeader));
+    if(header.byte_order!=FIELD_BYTE_ORDER)
+    {
+        swap_byte_order(&header.version,    4, 1);
+        swap_byte_order(&header.byte_order, 4, 1);
+        swap_byte_order(&header.components, 4, 1);
+        swap = true;
+    }
+    if(header.byte_order!=FIELD_BYTE_ORDER || header.version>FIELD_VERSION || header.components==0)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : FieldFileReader() : unsupported version or byte order" << std::endl;
+        return;
+    }
+
+    size_t pos = sizeof(FieldFileHeader);
+    while(file.size()-pos >= sizeof(FieldFrameHeader))
+    {
+        FieldFrameHeader f;
+        memcpy(&f, file.data()+pos, sizeof(FieldFrameHeader));
+        if(swap)
+        {
+            swap_byte_order(&f.magic,       4, 1);
+            swap_byte_order(&f.encoding,    4, 1);
+            swap_byte_order(&f.num_values,  8, 1);
+            swap_byte_order(&f.time,        8, 1);
+            swap_byte_order(&f.stored_size, 8, 1);
+            swap_byte_order(&f.block_size,  4, 1);
+            swap_byte_order(&f.checksum,    8, 1);
+        }
+        size_t avail = file.size() - pos - sizeof(FieldFrameHeader);
+        if(f.magic!=FIELD_FRAME_MAGIC || f.stored_size>avail) break; // incomplete frame
+        if(f.encoding>FIELD_SHUFFLE_DELTA ||
+          (f.encoding==FIELD_RAW && f.stored_size!=f.num_values*sizeof(double)))
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : FieldFileReader() : corrupted frame " << frames.size() << std::endl;
+            break;
+        }
+        frames.push_back(f);
+        offsets.push_back(pos + sizeof(FieldFrameHeader));
+        pos += sizeof(FieldFrameHeader) + (f.stored_size + FIELD_ALIGNMENT - 1) / FIELD_ALIGNMENT * FIELD_ALIGNMENT;
+        if(pos>file.size()) break;
+    }
+
+    checked.resize(frames.size(), !verify);
+    open = true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool FieldFileReader::check(const uint fid) const
+{
+    if(checked.at(fid)) return true;
+    const FieldFrameHeader & f = frames.at(fid);
+    if(xxhash64(file.data()+offsets.at(fid), f.stored_size)!=f.checksum)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : FieldFileReader() : checksum mismatch in frame " << fid << std::endl;
+        return false;
+    }
+    checked.at(fid) = 1;
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+const double * FieldFileReader::view(const uint fid) const
+{
+    if(fid>=frames.size() || frames[fid].encoding!=FIELD_RAW || swap || !check(fid)) return nullptr;
+    return reinterpret_cast<const double*>(file.data()+offsets[fid]);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool FieldFileReader::read(const uint fid, double * data) const
+{
+    if(fid>=frames.size() || !check(fid)) return false;
+    const FieldFrameHeader & f = frames[fid];
+    const uint8_t * payload = reinterpret_cast<const uint8_t*>(file.data()+offsets[fid]);
+
+    if(f.encoding==FIELD_RAW)
+    {
+        if(f.stored_size>0) memcpy(data, payload, f.stored_size);
+        if(swap) swap_byte_order(data, 8, f.num_values);
+        return true;
+    }
+    if(!field_decompress(payload, f.stored_size, f.num_values, header.components, f.block_size, data))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : FieldFileReader::read() : corrupted frame " << fid << std::endl;
+        return false;
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool FieldFileReader::read(const uint fid, std::vector<double> & data) const
+{
+    if(fid>=frames.size()) return false;
+    data.resize(frames[fid].num_values);
+    return read(fid, data.data());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool is_field_file(const char * filename)
+{
+    FILE * f = fopen(filename, "rb");
+    if(!f) return false;
+    char magic[8];
+    bool ok = fread(magic, 1, 8, f)==8 && memcmp(magic, FIELD_MAGIC, 8)==0;
+    fclose(f);
+    return ok;
+}
+
+}
@@ -0,0 +1,209 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_FIELD_FILE_H
+#define CINO_FIELD_FILE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/io/mapped_file.h>
+
+namespace cinolib
+{
+
+/* Binary container for per-element scalar/vector fields (e.g. one frame
+ * per simulation timestep). The file starts with a 64 bytes header and is
+ * followed by any number of frames, which are only ever appended:
+ *
+ *   FieldFileHeader
+ *   frame 0 : FieldFrameHeader | payload | padding up to a multiple of 64 bytes
+ *   frame 1 : ...
+ *
+ * Frames store num_values doubles (i.e. components doubles per element)
+ * and a time stamp. Frame payloads are either raw doubles (in the byte
+ * order of the writer, see FieldFileHeader::byte_order) or compressed
+ * with a lossless, dependency-free scheme that works well for smooth
+ * fields: values are split in blocks of block_size doubles, and in each
+ * block every value is XORed with the previous value of the same component
+ * (so that sign, exponent and leading mantissa bits become zeros), bytes
+ * are shuffled (all most significant bytes first, then the second ones, and
+ * so forth) and the resulting byte stream is run-length encoded. Blocks are
+ * independent, so they are compressed and decompressed in parallel. The
+ * compressed stream is byte order independent.
+ *
+ * Raw frames are 64 bytes aligned and can be accessed without copies from
+ * the memory mapped file (see FieldFileReader::view). A frame that was not
+ * completely written (e.g. a simulation that crashed while appending) is
+ * ignored by the reader, together with anything that follows it.
+*/
+
+static const char     FIELD_MAGIC[8]       = { 'C','I','N','O','F','L','D','S' };
+static const uint32_t FIELD_FRAME_MAGIC    = 0x4D415246; // "FRAM"
+static const uint32_t FIELD_VERSION        = 1;
+static const uint32_t FIELD_BYTE_ORDER     = 0x01020304;
+static const uint64_t FIELD_ALIGNMENT      = 64;
+static const uint32_t FIELD_BLOCK_SIZE     = 1<<16;
+
+enum
+{
+    FIELD_RAW           = 0,
+    FIELD_SHUFFLE_DELTA = 1,
+};
+
+struct FieldFileHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t components;
+    uint8_t  reserved[44];
+};
+
+struct FieldFrameHeader
+{
+    uint32_t magic;
+    uint32_t encoding;
+    uint64_t num_values;
+    double   time;
+    uint64_t stored_size; // payload bytes
+    uint32_t block_size;  // values per compressed block
+    uint32_t reserved0;
+    uint64_t checksum;    // xxhash64 of the payload
+    uint8_t  reserved[16];
+};
+
+static_assert(sizeof(FieldFileHeader)  == 64, "FieldFileHeader must be 64 bytes");
+static_assert(sizeof(FieldFrameHeader) == 64, "FieldFrameHeader must be 64 bytes");
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// compressed payload: one uint64 offset per block (end of the block in the
+// data area that follows the offsets), then the compressed blocks
+CINO_INLINE
+void field_compress(const double          * data,
+                    const size_t            n,
+                    const uint              components,
+                    const uint              block_size,
+                    std::vector<uint8_t>  & out);
+
+CINO_INLINE
+bool field_decompress(const uint8_t * in,
+                      const size_t    in_size,
+                      const size_t    n,
+                      const uint      components,
+                      const uint      block_size,
+                      double        * data);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class FieldFileWriter
+{
+    public:
+
+        // if append is true and the file exists, frames are appended to it
+        explicit FieldFileWriter(const char * filename, const uint components, const bool append = false);
+        ~FieldFileWriter();
+
+        FieldFileWriter(const FieldFileWriter &) = delete;
+        FieldFileWriter & operator=(const FieldFileWriter &) = delete;
+
+        bool is_open() const { return fp!=nullptr; }
+
+        // compressed frames that would be bigger than the raw data are stored raw
+        bool write(const double * data, const size_t num_values, const double time = 0, const bool compress = true);
+        bool write(const std::vector<double> & data, const double time = 0, const bool compress = true);
+
+        bool close();
+
+    protected:
+
+        FILE * fp = nullptr;
+        uint   components;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class FieldFileReader
+{
+    public:
+
+        explicit FieldFileReader(const char * filename, const bool verify_checksums = true);
+
+        FieldFileReader(const FieldFileReader &) = delete;
+        FieldFileReader & operator=(const FieldFileReader &) = delete;
+
+        bool   is_open()                      const { return open;       }
+        uint   components()                   const { return header.components; }
+        uint   num_frames()                   const { return frames.size();     }
+        size_t frame_size(const uint fid)     const { return frames.at(fid).num_values; }
+        double frame_time(const uint fid)     const { return frames.at(fid).time;       }
+        bool   frame_is_raw(const uint fid)   const { return frames.at(fid).encoding==FIELD_RAW; }
+
+        // zero copy access to raw frames written with the host byte order (nullptr otherwise)
+        const double * view(const uint fid) const;
+
+        bool read(const uint fid, double * data) const; // data must hold frame_size(fid) values
+        bool read(const uint fid, std::vector<double> & data) const;
+
+    protected:
+
+        bool check(const uint fid) const;
+
+        MappedFile                    file;
+        bool                          open = false;
+        bool                          swap = false;
+        bool                          verify;
+        FieldFileHeader               header;
+        std::vector<FieldFrameHeader> frames;
+        std::vector<size_t>           offsets; // payload offsets
+        mutable std::vector<char>     checked; // per frame: checksum already verified
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// true if filename starts with FIELD_MAGIC
+CINO_INLINE
+bool is_field_file(const char * filename);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "field_file.cpp"
+#endif
+
+#endif // CINO_FIELD_FILE_H
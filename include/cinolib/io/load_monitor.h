@@ -0,0 +1,146 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_LOAD_MONITOR_H
+#define CINO_LOAD_MONITOR_H
+
+#include <atomic>
+#include <mutex>
+#include <functional>
+#include <stddef.h>
+#include <cinolib/cino_inline.h>
+
+namespace cinolib
+{
+
+/* Progress reporting and cancellation for mesh loading (see AsyncLoad).
+ * A LoadMonitor is attached to the thread that executes Mesh::load() by
+ * means of a ScopedLoadMonitor. Readers and connectivity builders running
+ * on that thread fetch it with current_load_monitor(), and report the bytes
+ * they parsed and the elements they built. Counters are atomic, so worker
+ * threads spawned by the loader can report to the same monitor. With no
+ * monitor attached current_load_monitor() returns nullptr, and loading
+ * costs nothing more than it did before.
+ *
+ * Cancellation is cooperative: readers and builders poll is_cancelled()
+ * every few thousand elements, and bail out returning empty data. Readers
+ * that do not report bytes are handled by marking the whole file as parsed
+ * as soon as the connectivity build starts.
+ *
+ * The callback is called from the loading threads (one call at a time),
+ * hence it should be quick, and must not touch GUI objects directly.
+*/
+
+struct LoadProgress
+{
+    size_t bytes_parsed = 0;
+    size_t bytes_total  = 0;
+    size_t elems_built  = 0;
+    size_t elems_total  = 0;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class LoadMonitor
+{
+    public:
+
+        explicit LoadMonitor(const std::function<void(const LoadProgress &)> & callback = nullptr) : callback(callback) {}
+
+        LoadMonitor(const LoadMonitor &) = delete;
+        LoadMonitor & operator=(const LoadMonitor &) = delete;
+
+        void set_bytes_total(const size_t n);
+        void add_bytes      (const size_t n);
+        void set_bytes      (const size_t n); // absolute position, for sequential readers
+        void add_elems_total(const size_t n);
+        void add_elems      (const size_t n);
+
+        void cancel()             { cancelled = true; }
+        bool is_cancelled() const { return cancelled;  }
+
+        LoadProgress progress() const;
+
+    protected:
+
+        void notify();
+
+        std::atomic<size_t> bytes_parsed = {0};
+        std::atomic<size_t> bytes_total  = {0};
+        std::atomic<size_t> elems_built  = {0};
+        std::atomic<size_t> elems_total  = {0};
+        std::atomic<bool>   cancelled    = {false};
+
+        std::function<void(const LoadProgress &)> callback;
+        std::mutex                                callback_mutex;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// monitor attached to the calling thread (nullptr if none)
+CINO_INLINE
+LoadMonitor *& current_load_monitor();
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// true if the loading running on the calling thread has been cancelled
+CINO_INLINE
+bool load_cancelled();
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// attaches a monitor to the calling thread for the lifetime of the object
+class ScopedLoadMonitor
+{
+    public:
+
+        explicit ScopedLoadMonitor(LoadMonitor * m) : prev(current_load_monitor()) { current_load_monitor() = m; }
+        ~ScopedLoadMonitor() { current_load_monitor() = prev; }
+
+        ScopedLoadMonitor(const ScopedLoadMonitor &) = delete;
+        ScopedLoadMonitor & operator=(const ScopedLoadMonitor &) = delete;
+
+    protected:
+
+        LoadMonitor * prev;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "load_monitor.cpp"
+#endif
+
+#endif // CINO_LOAD_MONITOR_H
@@ -0,0 +1,103 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/mapped_file.h>
+#include <stdio.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CINO_HAS_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace cinolib
+{
+
+CINO_INLINE
+MappedFile::MappedFile(const char * filename)
+{
+#ifdef CINO_HAS_MMAP
+    int fd = ::open(filename, O_RDONLY);
+    if(fd<0) return;
+    struct stat st;
+    if(fstat(fd, &st)==0)
+    {
+        len = st.st_size;
+        if(len>0)
+        {
+            void *addr = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(addr!=MAP_FAILED)
+            {
+                madvise(addr, len, MADV_SEQUENTIAL);
+                ptr    = static_cast<const char*>(addr);
+                mapped = true;
+                open   = true;
+            }
+        }
+        else open = true; // empty file
+    }
+    ::close(fd);
+    if(open) return;
+    len = 0;
+#endif
+    // fallback: read the whole file
+    FILE *f = fopen(filename, "rb");
+    if(!f) return;
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if(n>=0)
+    {
+        buffer.resize(n);
+        open = (fread(buffer.data(), 1, n, f) == (size_t)n);
+        ptr  = buffer.data();
+        len  = buffer.size();
+    }
+    fclose(f);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+MappedFile::~MappedFile()
+{
+#ifdef CINO_HAS_MMAP
+    if(mapped) munmap(const_cast<char*>(ptr), len);
+#endif
+}
+
+}
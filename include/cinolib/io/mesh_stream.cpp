@@ -0,0 +1,455 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/mesh_stream.h>
+#include <cinolib/io/fast_number_parsing.h>
+#include <cinolib/io/text_buffer.h>
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+#include <string>
+
+namespace cinolib
+{
+
+CINO_INLINE
+MeshStreamReader::MeshStreamReader(const char * filename, const uint chunk_size)
+    : csize(std::max(chunk_size, 1u))
+{
+    std::string str(filename);
+    std::string filetype = (str.size()>4) ? str.substr(str.size()-4,4) : "";
+
+    if (filetype.compare("mesh") == 0 ||
+        filetype.compare("MESH") == 0)
+    {
+        open = open_MESH(filename);
+    }
+    else if (str.size()>5 && (str.substr(str.size()-5,5).compare(".cino") == 0 ||
+                              str.substr(str.size()-5,5).compare(".CINO") == 0))
+    {
+        open = open_CINO(filename);
+    }
+    else
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : MeshStreamReader() : file format not supported yet " << std::endl;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+MeshStreamReader::~MeshStreamReader()
+{
+    if(fv) fclose(fv);
+    if(fp) fclose(fp);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool MeshStreamReader::open_MESH(const char * filename)
+{
+    fv = fopen(filename, "r");
+    fp = fopen(filename, "r");
+    if(!fv || !fp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : MeshStreamReader() : couldn't open input file " << filename << std::endl;
+        return false;
+    }
+
+    // reads the element count, which is either on the keyword line or on the next one
+    auto read_count = [&](const char * s, uint & count)
+    {
+        int n;
+        if(!parse_int(s, line+strlen(line), n))
+        {
+            if(!fgets(line, 1024, fv)) return false;
+            s = line;
+            if(!parse_int(s, line+strlen(line), n)) return false;
+        }
+        count = std::max(n,0);
+        return true;
+    };
+
+    bool has_verts = false;
+    while(fgets(line, 1024, fv))
+    {
+        const char * s = skip_spaces(line, line+strlen(line));
+
+        if(strncmp(s, "Vertices", 8)==0)
+        {
+            if(!read_count(s+8, nv)) break;
+            vert_index.reserve(nv/1024+1);
+            for(uint vid=0; vid<nv; ++vid)
+            {
+                if(vid%1024==0)
+                {
+                    vert_index.push_back(fpos_t());
+                    fgetpos(fv, &vert_index.back());
+                }
+                if(!fgets(line, 1024, fv)) { nv = 0; break; }
+            }
+            has_verts = (nv>0);
+            fv_vid    = nv;
+        }
+        else if(strncmp(s, "Tetrahedra", 10)==0 || strncmp(s, "Hexahedra", 9)==0)
+        {
+            bool tets = (s[0]=='T');
+            if(!has_verts || !read_count(s + (tets ? 10 : 9), np)) break;
+            type = tets ? TETMESH : HEXMESH;
+            vpp  = tets ? 4 : 8;
+            fgetpos(fv, &poly_pos);
+            fsetpos(fp, &poly_pos);
+            return true;
+        }
+    }
+
+    std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : MeshStreamReader() : couldn't find vertices and tetrahedra/hexahedra in " << filename << std::endl;
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool MeshStreamReader::open_CINO(const char * filename)
+{
+    cino.reset(new CinoReader(filename));
+    if(!cino->is_open()) return false;
+
+    type = static_cast<MeshType>(cino->mesh_type());
+    if(type!=TETMESH && type!=HEXMESH)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : MeshStreamReader() : only tetrahedral and hexahedral meshes can be streamed" << std::endl;
+        return false;
+    }
+    vpp = (type==TETMESH) ? 4 : 8;
+
+    size_t n_xyz, n_offsets, n_ids, n_vl, n_pl;
+    xyz         = cino->view<double>  (CINO_VERTS, n_xyz);
+    p2v_offsets = cino->view<uint64_t>(CINO_P2V, n_offsets);
+    p2v_ids     = cino->view<uint32_t>(CINO_P2V+CINO_CSR_IDS, n_ids);
+    vert_labels = cino->view<int32_t> (CINO_VERT_LABELS, n_vl);
+    poly_labels = cino->view<int32_t> (CINO_POLY_LABELS, n_pl);
+
+    if(xyz==nullptr || p2v_offsets==nullptr || n_offsets==0 || n_ids!=(n_offsets-1)*vpp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : MeshStreamReader() : missing vertices or elements in " << filename << std::endl;
+        return false;
+    }
+    nv = n_xyz/3;
+    np = n_offsets-1;
+    if(n_vl!=nv) vert_labels = nullptr;
+    if(n_pl!=np) poly_labels = nullptr;
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void MeshStreamReader::rewind()
+{
+    next = 0;
+    if(fp) fsetpos(fp, &poly_pos);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool MeshStreamReader::next_chunk(MeshChunk & chunk)
+{
+    if(!open || next>=np) return false;
+
+    uint n = std::min(csize, np-next);
+    chunk.first_poly     = next;
+    chunk.verts_per_poly = vpp;
+    chunk.polys.resize(n*vpp);
+    chunk.poly_labels.resize(n);
+
+    for(uint i=0; i<n; ++i)
+    {
+        uint * p = chunk.polys.data() + i*vpp;
+        if(cino)
+        {
+            uint pid = next+i;
+            if(p2v_offsets[pid]!=(uint64_t)pid*vpp) return false; // not a pure tet/hex mesh
+            for(uint j=0; j<vpp; ++j)
+            {
+                p[j] = p2v_ids[p2v_offsets[pid]+j];
+                if(p[j]>=nv) return false;
+            }
+            chunk.poly_labels[i] = (poly_labels) ? poly_labels[pid] : 0;
+        }
+        else
+        {
+            if(!fgets(line, 1024, fp)) return false;
+            const char * s   = line;
+            const char * end = line+strlen(line);
+            for(uint j=0; j<vpp; ++j)
+            {
+                int vid;
+                if(!parse_int(s, end, vid) || vid<1 || (uint)vid>nv) return false;
+                p[j] = vid-1;
+            }
+            int label;
+            chunk.poly_labels[i] = parse_int(s, end, label) ? label : 0;
+        }
+    }
+    next += n;
+
+    // global => local vertex ids
+    chunk.vids = chunk.polys;
+    std::sort(chunk.vids.begin(), chunk.vids.end());
+    chunk.vids.erase(std::unique(chunk.vids.begin(), chunk.vids.end()), chunk.vids.end());
+    for(uint & vid : chunk.polys)
+    {
+        vid = std::lower_bound(chunk.vids.begin(), chunk.vids.end(), vid) - chunk.vids.begin();
+    }
+    return read_verts(chunk.vids, chunk.verts);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool MeshStreamReader::seek_vert(const uint vid)
+{
+    if(vid>=nv) return false;
+    uint block = vid/1024;
+    if(vid<fv_vid || block*1024>fv_vid)
+    {
+        fsetpos(fv, &vert_index[block]);
+        fv_vid = block*1024;
+    }
+    for(; fv_vid<vid; ++fv_vid)
+    {
+        if(!fgets(line, 1024, fv)) return false;
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool MeshStreamReader::parse_vert(vec3d & p, int & label)
+{
+    if(!fgets(line, 1024, fv)) return false;
+    ++fv_vid;
+    const char * s   = line;
+    const char * end = line+strlen(line);
+    if(!parse_double(s, end, p[0]) ||
+       !parse_double(s, end, p[1]) ||
+       !parse_double(s, end, p[2])) return false;
+    if(!parse_int(s, end, label)) label = 0;
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool MeshStreamReader::read_verts(const uint begin, const uint end, std::vector<vec3d> & verts, std::vector<int> * labels)
+{
+    if(!open || begin>end || end>nv) return false;
+    verts.resize(end-begin);
+    if(labels) labels->resize(end-begin);
+
+    if(cino)
+    {
+        for(uint vid=begin; vid<end; ++vid)
+        {
+            verts[vid-begin] = vec3d(xyz[3*vid], xyz[3*vid+1], xyz[3*vid+2]);
+            if(labels) labels->at(vid-begin) = (vert_labels) ? vert_labels[vid] : 0;
+        }
+        return true;
+    }
+
+    if(begin==end) return true;
+    if(!seek_vert(begin)) return false;
+    for(uint vid=begin; vid<end; ++vid)
+    {
+        int l;
+        if(!parse_vert(verts[vid-begin], l)) return false;
+        if(labels) labels->at(vid-begin) = l;
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool MeshStreamReader::read_verts(const std::vector<uint> & vids, std::vector<vec3d> & verts, std::vector<int> * labels)
+{
+    if(!open) return false;
+    verts.resize(vids.size());
+    if(labels) labels->resize(vids.size());
+
+    for(uint i=0; i<vids.size(); ++i)
+    {
+        uint vid = vids[i];
+        if(vid>=nv) return false;
+        if(cino)
+        {
+            verts[i] = vec3d(xyz[3*vid], xyz[3*vid+1], xyz[3*vid+2]);
+            if(labels) labels->at(i) = (vert_labels) ? vert_labels[vid] : 0;
+        }
+        else
+        {
+            int l;
+            if(!seek_vert(vid) || !parse_vert(verts[i], l)) return false;
+            if(labels) labels->at(i) = l;
+        }
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+MeshStreamWriter::MeshStreamWriter(const char * filename, const MeshType type)
+    : type(type)
+{
+    assert(type==TETMESH || type==HEXMESH);
+
+    fp = fopen(filename, "w");
+    if(!fp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : MeshStreamWriter() : couldn't write output file " << filename << std::endl;
+        return;
+    }
+
+    // element counts are unknown until close(): reserve room for them
+    fprintf(fp, "MeshVersionFormatted 1\n" );
+    fprintf(fp, "Dimension 3\n" );
+    fprintf(fp, "Vertices\n" );
+    fgetpos(fp, &nv_pos);
+    fprintf(fp, "%20u\n", 0u);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+MeshStreamWriter::~MeshStreamWriter()
+{
+    close();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void MeshStreamWriter::write_verts(const std::vector<vec3d> & verts, const std::vector<int> & labels)
+{
+    if(!fp) return;
+    assert(!writing_polys);
+    assert(labels.empty() || labels.size()==verts.size());
+
+    write_parallel(fp, verts.size(), [&](const size_t i, TextBuffer & b)
+    {
+        b.put_double(verts[i].x()); b.put(' ');
+        b.put_double(verts[i].y()); b.put(' ');
+        b.put_double(verts[i].z()); b.put(' ');
+        b.put_int(labels.empty() ? 0 : labels[i]);
+        b.put('\n');
+    });
+    nv += verts.size();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void MeshStreamWriter::write_polys(const MeshChunk & chunk)
+{
+    if(!fp) return;
+    assert(chunk.verts_per_poly==((type==TETMESH) ? 4u : 8u));
+
+    std::vector<uint> polys(chunk.polys.size());
+    for(size_t i=0; i<polys.size(); ++i) polys[i] = chunk.vids[chunk.polys[i]];
+    write_polys(polys, chunk.poly_labels);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void MeshStreamWriter::write_polys(const std::vector<uint> & polys, const std::vector<int> & labels)
+{
+    if(!fp) return;
+    uint vpp = (type==TETMESH) ? 4 : 8;
+    uint n   = polys.size()/vpp;
+    assert(polys.size()%vpp==0);
+    assert(labels.empty() || labels.size()==n);
+
+    if(!writing_polys)
+    {
+        writing_polys = true;
+        fprintf(fp, (type==TETMESH) ? "Tetrahedra\n" : "Hexahedra\n");
+        fgetpos(fp, &np_pos);
+        fprintf(fp, "%20u\n", 0u);
+    }
+
+    write_parallel(fp, n, [&](const size_t pid, TextBuffer & b)
+    {
+        for(uint off=0; off<vpp; ++off) { b.put_int(polys[pid*vpp+off]+1); b.put(' '); }
+        b.put_int(labels.empty() ? 0 : labels[pid]);
+        b.put('\n');
+    });
+    np += n;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void MeshStreamWriter::patch_count(const fpos_t & pos, const uint count)
+{
+    fpos_t end;
+    fgetpos(fp, &end);
+    fsetpos(fp, &pos);
+    fprintf(fp, "%20u", count);
+    fsetpos(fp, &end);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool MeshStreamWriter::close()
+{
+    if(!fp) return false;
+    if(!writing_polys) write_polys(std::vector<uint>());
+    fprintf(fp, "End\n\n");
+    patch_count(nv_pos, nv);
+    patch_count(np_pos, np);
+    bool ok = (fclose(fp)==0);
+    fp = nullptr;
+    return ok;
+}
+
+}
@@ -0,0 +1,186 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_MESH_STREAM_H
+#define CINO_MESH_STREAM_H
+
+#include <stdio.h>
+#include <memory>
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec3.h>
+#include <cinolib/meshes/abstract_mesh.h>
+#include <cinolib/io/read_CINO.h>
+
+namespace cinolib
+{
+
+/* Chunked (out-of-core) access to tetrahedral and hexahedral meshes that
+ * do not fit in memory. Elements are streamed in chunks of a fixed number
+ * of polyhedra. Each chunk carries a copy of the vertices it references,
+ * sorted by global id, and its connectivity refers to them with local ids
+ * (i.e. offsets in MeshChunk::vids). Memory usage is therefore bounded by
+ * the chunk size, regardless of the size of the mesh.
+ *
+ * Supported inputs are MESH files (only the first Tetrahedra/Hexahedra
+ * section is read) and *.cino files written by Tetmesh/Hexmesh. For MESH
+ * files the reader builds a sparse index of the vertex block at opening
+ * (one file position every 1024 vertices), so that vertex id ranges can be
+ * fetched without keeping the vertices in memory. Meshes whose elements
+ * are sorted along with their vertices (as is the case for meshes coming
+ * from voxel grids, or after a spatial reordering) touch narrow id ranges
+ * per chunk and are read almost sequentially.
+ *
+ * MeshStreamWriter writes MESH files incrementally: all vertices first,
+ * then all elements. Element counts are patched into the header on close().
+*/
+
+struct MeshChunk
+{
+    uint               first_poly     = 0; // global id of the first poly in the chunk
+    uint               verts_per_poly = 0; // 4 (tets) or 8 (hexes)
+    std::vector<uint>  vids;               // global ids of the referenced vertices (sorted)
+    std::vector<vec3d> verts;              // coordinates of the referenced vertices
+    std::vector<uint>  polys;              // verts_per_poly local vertex ids per poly
+    std::vector<int>   poly_labels;
+
+    uint          num_polys   ()                                const { return polys.size()/verts_per_poly;             }
+    uint          poly_vert_id(const uint pid, const uint off) const { return vids[polys[pid*verts_per_poly+off]];  }
+    const vec3d & poly_vert   (const uint pid, const uint off) const { return verts[polys[pid*verts_per_poly+off]]; }
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class MeshStreamReader
+{
+    public:
+
+        explicit MeshStreamReader(const char * filename, const uint chunk_size = 1<<20);
+        ~MeshStreamReader();
+
+        MeshStreamReader(const MeshStreamReader &) = delete;
+        MeshStreamReader & operator=(const MeshStreamReader &) = delete;
+
+        bool     is_open()        const { return open;  }
+        MeshType mesh_type()      const { return type;  }
+        uint     num_verts()      const { return nv;    }
+        uint     num_polys()      const { return np;    }
+        uint     verts_per_poly() const { return vpp;   }
+        uint     chunk_size()     const { return csize; }
+
+        void rewind();
+        bool next_chunk(MeshChunk & chunk);
+
+        // vertices [begin,end) and, optionally, their labels
+        bool read_verts(const uint begin, const uint end, std::vector<vec3d> & verts, std::vector<int> * labels = nullptr);
+
+        // vertices with the given ids (which must be sorted)
+        bool read_verts(const std::vector<uint> & vids, std::vector<vec3d> & verts, std::vector<int> * labels = nullptr);
+
+    protected:
+
+        bool open_MESH(const char * filename);
+        bool open_CINO(const char * filename);
+        bool seek_vert(const uint vid);
+        bool parse_vert(vec3d & p, int & label);
+
+        bool     open  = false;
+        MeshType type  = TETMESH;
+        uint     nv    = 0;
+        uint     np    = 0;
+        uint     vpp   = 0;
+        uint     csize = 0;
+        uint     next  = 0; // next poly to be streamed
+
+        // MESH backend
+        FILE               * fv = nullptr; // positioned in the vertex block
+        FILE               * fp = nullptr; // positioned in the element block
+        uint                 fv_vid = 0;   // id of the vertex that fv points to
+        fpos_t               poly_pos;
+        std::vector<fpos_t>  vert_index;   // position of vertices 0, 1024, 2048, ...
+        char                 line[1024];
+
+        // CINO backend
+        std::unique_ptr<CinoReader> cino;
+        const double   * xyz         = nullptr;
+        const int32_t  * vert_labels = nullptr;
+        const int32_t  * poly_labels = nullptr;
+        const uint64_t * p2v_offsets = nullptr;
+        const uint32_t * p2v_ids     = nullptr;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class MeshStreamWriter
+{
+    public:
+
+        explicit MeshStreamWriter(const char * filename, const MeshType type);
+        ~MeshStreamWriter();
+
+        MeshStreamWriter(const MeshStreamWriter &) = delete;
+        MeshStreamWriter & operator=(const MeshStreamWriter &) = delete;
+
+        bool is_open() const { return fp!=nullptr; }
+
+        // vertices are appended in order, and must all be written before the first element
+        void write_verts(const std::vector<vec3d> & verts, const std::vector<int> & labels = std::vector<int>());
+
+        void write_polys(const MeshChunk & chunk);
+        void write_polys(const std::vector<uint> & polys, const std::vector<int> & labels = std::vector<int>()); // global ids
+
+        bool close();
+
+    protected:
+
+        void patch_count(const fpos_t & pos, const uint count);
+
+        FILE     * fp = nullptr;
+        MeshType   type;
+        uint       nv = 0;
+        uint       np = 0;
+        bool       writing_polys = false;
+        fpos_t     nv_pos;
+        fpos_t     np_pos;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "mesh_stream.cpp"
+#endif
+
+#endif // CINO_MESH_STREAM_H
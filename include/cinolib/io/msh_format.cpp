@@ -0,0 +1,307 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/msh_format.h>
+#include <cinolib/standard_elements_tables.h>
+#include <algorithm>
+#include <climits>
+
+namespace cinolib
+{
+
+CINO_INLINE
+uint msh_element_verts(const int type)
+{
+    switch(type)
+    {
+        case MSH_TRIANGLE    : return 3;
+        case MSH_QUADRANGLE  : return 4;
+        case MSH_TETRAHEDRON : return 4;
+        case MSH_HEXAHEDRON  : return 8;
+        case MSH_PRISM       : return 6;
+        case MSH_PYRAMID     : return 5;
+        default              : return 0;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint msh_element_nodes(const int type)
+{
+    // Gmsh element types 1..31 (see GmshDefines.h)
+    static const uint n_nodes[32] =
+    {
+        0,                              //
+        2, 3, 4, 4, 8, 6, 5,            // linear elements
+        3, 6, 9, 10, 27, 18, 14,        // second order elements
+        1,                              // point
+        8, 20, 15, 13,                  // second order incomplete elements
+        9, 10, 12, 15, 15, 21,          // high order triangles
+        4, 5, 6,                        // high order lines
+        20, 35, 56                      // high order tets
+    };
+    return (type>0 && type<32) ? n_nodes[type] : 0;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+int msh_element_dim(const int type)
+{
+    static const int dim[32] =
+    {
+        -1,
+        1, 2, 2, 3, 3, 3, 3,
+        1, 2, 2, 3, 3, 3, 3,
+        0,
+        2, 3, 3, 3,
+        2, 2, 2, 2, 2, 2,
+        1, 1, 1,
+        3, 3, 3
+    };
+    return (type>0 && type<32) ? dim[type] : -1;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+const std::vector<std::vector<uint>> & msh_element_faces(const int type)
+{
+    static const std::vector<std::vector<uint>> tet =
+    {
+        { TET_FACES[0][0], TET_FACES[0][1], TET_FACES[0][2] },
+        { TET_FACES[1][0], TET_FACES[1][1], TET_FACES[1][2] },
+        { TET_FACES[2][0], TET_FACES[2][1], TET_FACES[2][2] },
+        { TET_FACES[3][0], TET_FACES[3][1], TET_FACES[3][2] },
+    };
+    static const std::vector<std::vector<uint>> hex =
+    {
+        { HEXA_FACES[0][0], HEXA_FACES[0][1], HEXA_FACES[0][2], HEXA_FACES[0][3] },
+        { HEXA_FACES[1][0], HEXA_FACES[1][1], HEXA_FACES[1][2], HEXA_FACES[1][3] },
+        { HEXA_FACES[2][0], HEXA_FACES[2][1], HEXA_FACES[2][2], HEXA_FACES[2][3] },
+        { HEXA_FACES[3][0], HEXA_FACES[3][1], HEXA_FACES[3][2], HEXA_FACES[3][3] },
+        { HEXA_FACES[4][0], HEXA_FACES[4][1], HEXA_FACES[4][2], HEXA_FACES[4][3] },
+        { HEXA_FACES[5][0], HEXA_FACES[5][1], HEXA_FACES[5][2], HEXA_FACES[5][3] },
+    };
+    static const std::vector<std::vector<uint>> prism =
+    {
+        { 0, 2, 1 }, { 3, 4, 5 }, { 0, 1, 4, 3 }, { 1, 2, 5, 4 }, { 2, 0, 3, 5 }
+    };
+    static const std::vector<std::vector<uint>> pyramid =
+    {
+        { 0, 3, 2, 1 }, { 0, 1, 4 }, { 1, 2, 4 }, { 2, 3, 4 }, { 3, 0, 4 }
+    };
+    static const std::vector<std::vector<uint>> none;
+
+    switch(type)
+    {
+        case MSH_TETRAHEDRON : return tet;
+        case MSH_HEXAHEDRON  : return hex;
+        case MSH_PRISM       : return prism;
+        case MSH_PYRAMID     : return pyramid;
+        default              : return none;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+int msh_element_type(const uint n_verts, const int dim)
+{
+    if(dim==2)
+    {
+        if(n_verts==3) return MSH_TRIANGLE;
+        if(n_verts==4) return MSH_QUADRANGLE;
+    }
+    else if(dim==3)
+    {
+        if(n_verts==4) return MSH_TETRAHEDRON;
+        if(n_verts==8) return MSH_HEXAHEDRON;
+        if(n_verts==6) return MSH_PRISM;
+        if(n_verts==5) return MSH_PYRAMID;
+    }
+    return -1;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void msh_elements_to_polyhedra(const std::vector<std::vector<uint>> & elems,
+                               const std::vector<int>               & elem_types,
+                                     std::vector<std::vector<uint>> & faces,
+                                     std::vector<std::vector<uint>> & polys,
+                                     std::vector<std::vector<bool>> & polys_face_winding,
+                                     std::vector<uint>              * kept)
+{
+    faces.clear();
+    polys.clear();
+    polys_face_winding.clear();
+    if(kept) kept->clear();
+
+    uint nv = 0;
+    for(const auto & e : elems) for(uint vid : e) nv = std::max(nv, vid+1);
+
+    // shared faces are found looking at the faces incident to their biggest
+    // vertex (no global map, which would be way slower on large meshes)
+    std::vector<std::vector<uint>> sorted_faces;
+    std::vector<std::vector<uint>> faces_by_vert(nv);
+
+    for(uint eid=0; eid<elems.size(); ++eid)
+    {
+        const std::vector<uint> & e = elems.at(eid);
+        const std::vector<std::vector<uint>> & e_faces = msh_element_faces(elem_types.at(eid));
+        if(e_faces.empty() || e.size()!=msh_element_verts(elem_types.at(eid))) continue;
+
+        std::vector<uint> p;
+        std::vector<bool> w;
+        for(const auto & lf : e_faces)
+        {
+            std::vector<uint> f(lf.size());
+            for(uint i=0; i<lf.size(); ++i) f[i] = e[lf[i]];
+            std::vector<uint> key = f;
+            std::sort(key.begin(), key.end());
+
+            int fid = -1;
+            for(uint cand : faces_by_vert.at(key.back()))
+            {
+                if(sorted_faces.at(cand)==key) { fid = cand; break; }
+            }
+            if(fid==-1)
+            {
+                fid = faces.size();
+                faces.push_back(f);
+                sorted_faces.push_back(key);
+                faces_by_vert.at(key.back()).push_back(fid);
+                w.push_back(true);
+            }
+            else
+            {
+                // same orientation <=> same successor of the first vertex
+                const std::vector<uint> & g = faces.at(fid);
+                size_t i = std::find(f.begin(), f.end(), g.front()) - f.begin();
+                w.push_back(f.at((i+1)%f.size()) == g.at(1));
+            }
+            p.push_back(fid);
+        }
+        polys.push_back(p);
+        polys_face_winding.push_back(w);
+        if(kept) kept->push_back(eid);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool msh_elements_from_polyhedra(const std::vector<std::vector<uint>> & faces,
+                                 const std::vector<std::vector<uint>> & polys,
+                                 const std::vector<std::vector<bool>> & polys_face_winding,
+                                       std::vector<std::vector<uint>> & elems,
+                                       std::vector<int>               & elem_types)
+{
+    elems.clear();
+    elem_types.clear();
+    elems.reserve(polys.size());
+    elem_types.reserve(polys.size());
+
+    for(uint pid=0; pid<polys.size(); ++pid)
+    {
+        // faces, oriented outwards
+        std::vector<std::vector<uint>> pf;
+        uint n_tris = 0, n_quads = 0;
+        for(uint i=0; i<polys.at(pid).size(); ++i)
+        {
+            std::vector<uint> f = faces.at(polys.at(pid).at(i));
+            if(!polys_face_winding.at(pid).at(i)) std::reverse(f.begin(), f.end());
+            if(f.size()==3) ++n_tris; else
+            if(f.size()==4) ++n_quads;
+            pf.push_back(f);
+        }
+
+        int type = -1;
+        if(n_tris==4 && n_quads==0) type = MSH_TETRAHEDRON; else
+        if(n_tris==0 && n_quads==6) type = MSH_HEXAHEDRON;  else
+        if(n_tris==2 && n_quads==3) type = MSH_PRISM;       else
+        if(n_tris==4 && n_quads==1) type = MSH_PYRAMID;
+        if(type==-1 || pf.size()!=n_tris+n_quads) return false;
+
+        // the base is a triangle for tets and prisms, a quad otherwise. In
+        // Gmsh the base is listed in the order that makes it point inwards
+        uint base_size = (type==MSH_TETRAHEDRON || type==MSH_PRISM) ? 3 : 4;
+        const std::vector<uint> & base = *std::find_if(pf.begin(), pf.end(), [&](const std::vector<uint> & f) { return f.size()==base_size; });
+        std::vector<uint> e(base_size);
+        for(uint i=0; i<base_size; ++i) e[i] = base[(base_size-i)%base_size];
+
+        if(type==MSH_TETRAHEDRON || type==MSH_PYRAMID)
+        {
+            // apex: the only vertex not in the base
+            for(const auto & f : pf) for(uint vid : f)
+            {
+                if(e.size()==base_size && std::find(e.begin(), e.end(), vid)==e.end()) e.push_back(vid);
+            }
+        }
+        else
+        {
+            // top vertices: in each quad, the vertex next to a base vertex
+            // that is not in the base itself
+            std::vector<uint> top(base_size, UINT_MAX);
+            for(const auto & f : pf)
+            {
+                if(f.size()!=4 || &f==&base) continue;
+                for(uint i=0; i<4; ++i)
+                {
+                    auto it = std::find(e.begin(), e.end(), f[i]);
+                    if(it==e.end()) continue;
+                    uint prev = f[(i+3)%4];
+                    uint next = f[(i+1)%4];
+                    if(std::find(e.begin(), e.end(), prev)==e.end()) top[it-e.begin()] = prev; else
+                    if(std::find(e.begin(), e.end(), next)==e.end()) top[it-e.begin()] = next;
+                }
+            }
+            for(uint vid : top)
+            {
+                if(vid==UINT_MAX) return false;
+                e.push_back(vid);
+            }
+        }
+        if(e.size()!=msh_element_verts(type)) return false;
+
+        elems.push_back(e);
+        elem_types.push_back(type);
+    }
+    return true;
+}
+
+}
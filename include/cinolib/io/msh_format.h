@@ -0,0 +1,132 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_MSH_FORMAT_H
+#define CINO_MSH_FORMAT_H
+
+#include <sys/types.h>
+#include <string>
+#include <vector>
+#include <cinolib/cino_inline.h>
+
+namespace cinolib
+{
+
+/* Shared bits of the native reader/writer for Gmsh meshes (.msh, version
+ * 4.1, both ASCII and binary). Elements are stored as lists of vertex ids,
+ * with the Gmsh node ordering (which, for tets and hexes, is the same used
+ * by Tetmesh and Hexmesh). Type ids are the Gmsh ones. Only first order
+ * elements are supported.
+*/
+
+enum
+{
+    MSH_TRIANGLE    = 2,
+    MSH_QUADRANGLE  = 3,
+    MSH_TETRAHEDRON = 4,
+    MSH_HEXAHEDRON  = 5,
+    MSH_PRISM       = 6,
+    MSH_PYRAMID     = 7,
+};
+
+// name of a physical group (the tag of the group is the label of its elements)
+struct MSHPhysicalName
+{
+    int         dim = 0;
+    int         tag = 0;
+    std::string name;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// number of vertices of the supported element types (0 for any other type)
+CINO_INLINE
+uint msh_element_verts(const int type);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// number of nodes of any (known) Gmsh element type, including high order
+// ones, so that readers can skip them. Returns 0 for unknown types
+CINO_INLINE
+uint msh_element_nodes(const int type);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+int msh_element_dim(const int type);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// faces of volume elements (local vertex ids, CCW when seen from outside)
+CINO_INLINE
+const std::vector<std::vector<uint>> & msh_element_faces(const int type);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// element type from the number of vertices, for surface (dim=2) or volume
+// (dim=3) elements. Returns -1 if there is no such element
+CINO_INLINE
+int msh_element_type(const uint n_verts, const int dim);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// volume elements => general polyhedra (shared faces are stored once).
+// kept (if not null) receives the ids of the elements that were converted
+CINO_INLINE
+void msh_elements_to_polyhedra(const std::vector<std::vector<uint>> & elems,
+                               const std::vector<int>               & elem_types,
+                                     std::vector<std::vector<uint>> & faces,
+                                     std::vector<std::vector<uint>> & polys,
+                                     std::vector<std::vector<bool>> & polys_face_winding,
+                                     std::vector<uint>              * kept = nullptr);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// general polyhedra => volume elements. Fails (returning false) if there are
+// polyhedra other than tets, hexes, prisms and pyramids
+CINO_INLINE
+bool msh_elements_from_polyhedra(const std::vector<std::vector<uint>> & faces,
+                                 const std::vector<std::vector<uint>> & polys,
+                                 const std::vector<std::vector<bool>> & polys_face_winding,
+                                       std::vector<std::vector<uint>> & elems,
+                                       std::vector<int>               & elem_types);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "msh_format.cpp"
+#endif
+
+#endif // CINO_MSH_FORMAT_H
@@ -0,0 +1,100 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/ply_format.h>
+#include <cinolib/io/cino_format.h>
+#include <cstring>
+
+namespace cinolib
+{
+
+CINO_INLINE
+int ply_type(const std::string & name)
+{
+    if(name=="char"   || name=="int8"   ) return PLY_INT8;
+    if(name=="uchar"  || name=="uint8"  ) return PLY_UINT8;
+    if(name=="short"  || name=="int16"  ) return PLY_INT16;
+    if(name=="ushort" || name=="uint16" ) return PLY_UINT16;
+    if(name=="int"    || name=="int32"  ) return PLY_INT32;
+    if(name=="uint"   || name=="uint32" ) return PLY_UINT32;
+    if(name=="float"  || name=="float32") return PLY_FLOAT32;
+    if(name=="double" || name=="float64") return PLY_FLOAT64;
+    return PLY_INVALID_TYPE;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint ply_type_size(const int type)
+{
+    switch(type)
+    {
+        case PLY_INT8    :
+        case PLY_UINT8   : return 1;
+        case PLY_INT16   :
+        case PLY_UINT16  : return 2;
+        case PLY_INT32   :
+        case PLY_UINT32  :
+        case PLY_FLOAT32 : return 4;
+        case PLY_FLOAT64 : return 8;
+        default          : return 0;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double ply_value(const char * p, const int type, const bool swap)
+{
+    char b[8];
+    uint size = ply_type_size(type);
+    memcpy(b, p, size);
+    if(swap) swap_byte_order(b, size, 1);
+
+    switch(type)
+    {
+        case PLY_INT8    : { int8_t   v; memcpy(&v, b, 1); return v; }
+        case PLY_UINT8   : { uint8_t  v; memcpy(&v, b, 1); return v; }
+        case PLY_INT16   : { int16_t  v; memcpy(&v, b, 2); return v; }
+        case PLY_UINT16  : { uint16_t v; memcpy(&v, b, 2); return v; }
+        case PLY_INT32   : { int32_t  v; memcpy(&v, b, 4); return v; }
+        case PLY_UINT32  : { uint32_t v; memcpy(&v, b, 4); return v; }
+        case PLY_FLOAT32 : { float    v; memcpy(&v, b, 4); return v; }
+        case PLY_FLOAT64 : { double   v; memcpy(&v, b, 8); return v; }
+        default          : return 0;
+    }
+}
+
+}
@@ -0,0 +1,134 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_PLY_FORMAT_H
+#define CINO_PLY_FORMAT_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+
+namespace cinolib
+{
+
+/* Shared definitions for the PLY reader and writer (read_PLY.h, write_PLY.h).
+ * PLY files start with an ASCII header listing elements (e.g. vertex, face)
+ * and their properties, followed by the element records, which are either
+ * ASCII (one record per line) or binary (little or big endian).
+ *
+ * Vertex and face properties with well known names are mapped onto mesh
+ * attributes (see Vert_std_attributes and Polygon_std_attributes):
+ *
+ *   vertex : x y z | nx ny nz | red green blue alpha | u v (also s t,
+ *            texture_u texture_v) | label | quality
+ *   face   : vertex_indices (or vertex_index) | red green blue alpha |
+ *            label | quality
+ *
+ * Any other element or property is parsed and skipped. Integer colors are
+ * scaled to [0,1] according to their type (e.g. uchar colors are divided by
+ * 255). The PLY_* flags tell which attributes were found in (or have to be
+ * written to) a file.
+*/
+
+enum
+{
+    PLY_NORMALS = 0x01,
+    PLY_COLORS  = 0x02,
+    PLY_UVW     = 0x04,
+    PLY_LABELS  = 0x08,
+    PLY_QUALITY = 0x10,
+};
+
+enum
+{
+    PLY_INT8,
+    PLY_UINT8,
+    PLY_INT16,
+    PLY_UINT16,
+    PLY_INT32,
+    PLY_UINT32,
+    PLY_FLOAT32,
+    PLY_FLOAT64,
+    PLY_INVALID_TYPE,
+};
+
+enum
+{
+    PLY_ASCII,
+    PLY_BINARY_LITTLE_ENDIAN,
+    PLY_BINARY_BIG_ENDIAN,
+};
+
+struct PLYProperty
+{
+    std::string name;
+    int         type       = PLY_INVALID_TYPE;
+    int         count_type = PLY_INVALID_TYPE; // lists only
+    bool        is_list    = false;
+};
+
+struct PLYElement
+{
+    std::string              name;
+    uint64_t                 count = 0;
+    std::vector<PLYProperty> props;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// accepts both the original (e.g. uchar, float) and the sized (e.g. uint8, float32) names
+CINO_INLINE
+int ply_type(const std::string & name);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint ply_type_size(const int type);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// binary value of the given type, converted to double
+CINO_INLINE
+double ply_value(const char * p, const int type, const bool swap);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "ply_format.cpp"
+#endif
+
+#endif // CINO_PLY_FORMAT_H
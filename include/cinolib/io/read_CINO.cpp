@@ -0,0 +1,220 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/read_CINO.h>
+#include <cinolib/parallel_for.h>
+#include <iostream>
+#include <cstring>
+
+namespace cinolib
+{
+
+CINO_INLINE
+CinoReader::CinoReader(const char * filename, const bool verify_checksums)
+    : file(filename)
+    , verify(verify_checksums)
+{
+    memset(&header, 0, sizeof(CinoHeader));
+
+    if(!file.is_open())
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_CINO() : couldn't open input file " << filename << std::endl;
+        return;
+    }
+
+    if(file.size()<sizeof(CinoHeader) || memcmp(file.data(), CINO_MAGIC, 8)!=0)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_CINO() : " << filename << " is not a CINO file" << std::endl;
+        return;
+    }
+
+    memcpy(&header, file.data(), sizeof(CinoHeader));
+    if(header.byte_order!=CINO_BYTE_ORDER)
+    {
+        swap_byte_order(&header.version,      4, 1);
+        swap_byte_order(&header.byte_order,   4, 1);
+        swap_byte_order(&header.mesh_type,    4, 1);
+        swap_byte_order(&header.num_sections, 4, 1);
+        swap_byte_order(&header.mesh_hash,    8, 1);
+        swap_byte_order(&header.directory_checksum, 8, 1);
+        swap = true;
+    }
+    if(header.byte_order!=CINO_BYTE_ORDER || header.version>CINO_VERSION)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_CINO() : unsupported CINO version or byte order" << std::endl;
+        return;
+    }
+
+    uint64_t dir_bytes = (uint64_t)header.num_sections*sizeof(CinoSectionEntry);
+    if(file.size() < sizeof(CinoHeader) + dir_bytes ||
+       xxhash64(file.data()+sizeof(CinoHeader), dir_bytes) != header.directory_checksum)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_CINO() : corrupted section directory" << std::endl;
+        return;
+    }
+
+    dir.resize(header.num_sections);
+    if(!dir.empty()) memcpy(dir.data(), file.data()+sizeof(CinoHeader), dir_bytes);
+    for(CinoSectionEntry & e : dir)
+    {
+        if(swap)
+        {
+            swap_byte_order(&e.id,          4, 1);
+            swap_byte_order(&e.scalar_size, 4, 1);
+            swap_byte_order(&e.count,       8, 1);
+            swap_byte_order(&e.offset,      8, 1);
+            swap_byte_order(&e.checksum,    8, 1);
+        }
+        if(e.scalar_size==0 || e.scalar_size>8 || e.offset%CINO_ALIGNMENT!=0 ||
+           e.offset > file.size() || e.count > (file.size()-e.offset)/e.scalar_size)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_CINO() : truncated or corrupted file" << std::endl;
+            dir.clear();
+            return;
+        }
+    }
+
+    checked.resize(dir.size(), !verify);
+    swapped.resize(dir.size());
+    open = true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool CinoReader::has(const uint32_t id) const
+{
+    return section(id)>=0;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+int CinoReader::section(const uint32_t id) const
+{
+    for(uint i=0; i<dir.size(); ++i) if(dir[i].id==id) return i;
+    return -1;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+const void * CinoReader::section_data(const int i) const
+{
+    const CinoSectionEntry & e = dir[i];
+    const char * ptr = file.data() + e.offset;
+
+    if(!checked[i])
+    {
+        if(xxhash64(ptr, e.count*e.scalar_size) != e.checksum)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_CINO() : checksum mismatch in section " << e.id << std::endl;
+            return nullptr;
+        }
+        checked[i] = true;
+    }
+
+    if(swap && e.scalar_size>1 && e.count>0)
+    {
+        if(swapped[i].empty())
+        {
+            swapped[i].resize((e.count*e.scalar_size+7)/8);
+            memcpy(swapped[i].data(), ptr, e.count*e.scalar_size);
+            swap_byte_order(swapped[i].data(), e.scalar_size, e.count);
+        }
+        return swapped[i].data();
+    }
+    return ptr;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+const T * CinoReader::view(const uint32_t id, size_t & count) const
+{
+    count = 0;
+    int i = section(id);
+    if(i<0) return nullptr;
+    if(dir[i].scalar_size!=sizeof(T))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_CINO() : unexpected scalar type in section " << id << std::endl;
+        return nullptr;
+    }
+    const T * ptr = static_cast<const T*>(section_data(i));
+    if(ptr!=nullptr) count = dir[i].count;
+    return ptr;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+bool CinoReader::read(const uint32_t id, std::vector<T> & data) const
+{
+    size_t n;
+    const T * ptr = view<T>(id, n);
+    if(ptr==nullptr) return false;
+    data.assign(ptr, ptr+n);
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool CinoReader::read_csr(const uint32_t id, std::vector<std::vector<uint>> & lists, const uint64_t max_id) const
+{
+    size_t n_offsets, n_ids;
+    const uint64_t * offsets = view<uint64_t>(id, n_offsets);
+    const uint32_t * ids     = view<uint32_t>(id+CINO_CSR_IDS, n_ids);
+    if(offsets==nullptr || n_offsets==0 || (ids==nullptr && n_ids>0) || offsets[n_offsets-1]!=n_ids) return false;
+    for(size_t i=0; i+1<n_offsets; ++i)
+    {
+        if(offsets[i]>offsets[i+1]) return false;
+    }
+    for(size_t i=0; i<n_ids; ++i)
+    {
+        if(ids[i]>=max_id) return false;
+    }
+
+    lists.resize(n_offsets-1);
+    PARALLEL_FOR(0, lists.size(), 10000, [&](const size_t i)
+    {
+        lists[i].assign(ids+offsets[i], ids+offsets[i+1]);
+    });
+    return true;
+}
+
+}
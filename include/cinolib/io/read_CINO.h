@@ -0,0 +1,102 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_READ_CINO_H
+#define CINO_READ_CINO_H
+
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/io/cino_format.h>
+#include <cinolib/io/mapped_file.h>
+
+namespace cinolib
+{
+
+/* Read access to a *.cino file (see cino_format.h). The file is memory
+ * mapped and nothing is parsed: view() returns a pointer to the section
+ * as it is stored on disk (zero copy), so that large arrays can be handed
+ * to algorithms that work on flat buffers without ever being copied. Only
+ * if the file was written on a machine with opposite endianness sections
+ * are copied once, into byte swapped buffers owned by the reader. Section
+ * checksums are verified the first time a section is accessed (this reads
+ * the whole section, so it can be disabled for large partial queries).
+*/
+
+class CinoReader
+{
+    public:
+
+        explicit CinoReader(const char * filename, const bool verify_checksums = true);
+
+        CinoReader(const CinoReader &) = delete;
+        CinoReader & operator=(const CinoReader &) = delete;
+
+        bool     is_open()   const { return open; }
+        uint32_t mesh_type() const { return header.mesh_type; }
+        uint64_t mesh_hash() const { return header.mesh_hash; }
+        bool     has(const uint32_t id) const;
+
+        template<typename T>
+        const T * view(const uint32_t id, size_t & count) const;
+
+        template<typename T>
+        bool read(const uint32_t id, std::vector<T> & data) const;
+
+        // fails if the section is malformed or any id is not smaller than max_id
+        bool read_csr(const uint32_t id, std::vector<std::vector<uint>> & lists, const uint64_t max_id = UINT64_MAX) const;
+
+    protected:
+
+        int          section(const uint32_t id) const;
+        const void * section_data(const int i) const;
+
+        MappedFile                     file;
+        bool                           open = false;
+        bool                           swap = false;
+        bool                           verify;
+        CinoHeader                     header;
+        std::vector<CinoSectionEntry>  dir;
+        mutable std::vector<char>      checked;  // per section: checksum already verified
+        mutable std::vector<std::vector<uint64_t>> swapped; // byte swapped copies (foreign files only)
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "read_CINO.cpp"
+#endif
+
+#endif // CINO_READ_CINO_H
@@ -37,6 +37,9 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <stdio.h>
 
 namespace cinolib
 {
@@ -91,53 +94,103 @@ void read_CLI(const char                                   * filename,
               std::vector<std::vector<std::vector<vec3d>>> & open_polylines,     // support structures
               std::vector<std::vector<std::vector<vec3d>>> & hatches)            // supports/infills
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
     internal_polylines.clear();
     external_polylines.clear();
     open_polylines.clear();
     hatches.clear();
 
-    std::ifstream f(filename);
-    std::string   line;
-    uint          n_layers, type;
-    int           layer = -1;
-    double        z;
+    CLIReader reader(filename);
 
-    if(!f.is_open())
+    if(!reader.is_open())
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_CLI() : couldn't open input file " << filename << std::endl;
         exit(-1);
     }
 
+    internal_polylines.reserve(reader.num_layers());
+    external_polylines.reserve(reader.num_layers());
+    open_polylines.reserve(reader.num_layers());
+    hatches.reserve(reader.num_layers());
+
+    CLILayer layer;
+    while(reader.next_layer(layer))
+    {
+        internal_polylines.push_back(std::move(layer.internal_polylines));
+        external_polylines.push_back(std::move(layer.external_polylines));
+        open_polylines.push_back(std::move(layer.open_polylines));
+        hatches.push_back(std::move(layer.hatches));
+    }
+
+    // as many entries as the layers declared in the header (possibly empty)
+    if(internal_polylines.size() < reader.num_layers())
+    {
+        internal_polylines.resize(reader.num_layers());
+        external_polylines.resize(reader.num_layers());
+        open_polylines.resize(reader.num_layers());
+        hatches.resize(reader.num_layers());
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+CLIReader::CLIReader(const char * filename) : f(filename)
+{
+    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+
+    // header: read up to the first layer
+    double z;
     while(getline(f, line, '\n'))
     {
-        if(sscanf(line.c_str(), "$$LAYERS/%d", &n_layers) == 1)
+        if(sscanf(line.c_str(), "$$LAYERS/%d", &n_layers) == 1) continue;
+        if(sscanf(line.c_str(), "$$LAYER/%lf", &z) == 1)
         {
-            internal_polylines.resize(n_layers);
-            external_polylines.resize(n_layers);
-            open_polylines.resize(n_layers);
-            hatches.resize(n_layers);
+            line_pending = true;
+            break;
         }
-        else if(sscanf(line.c_str(), "$$LAYER/%lf", &z) == 1)
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool CLIReader::next_layer(CLILayer & layer)
+{
+    layer = CLILayer();
+
+    bool   found = false;
+    uint   type;
+    double z;
+
+    while(line_pending || getline(f, line, '\n'))
+    {
+        line_pending = false;
+
+        if(sscanf(line.c_str(), "$$LAYER/%lf", &z) == 1)
         {
-            ++layer;
+            if(found)
+            {
+                line_pending = true; // beginning of the next layer
+                return true;
+            }
+            found   = true;
+            layer.z = z;
         }
-        else if(sscanf(line.c_str(), "$$POLYLINE/%*d,%d,%*d,%*s", &type) == 1)
+        else if(found && sscanf(line.c_str(), "$$POLYLINE/%*d,%d,%*d,%*s", &type) == 1)
         {
             // NOTE: for INTERNAL and EXTERNAL, the last point is a duplication of the first one
-            std::vector<vec3d> pl = read_polyline(line, z);
+            std::vector<vec3d> pl = read_polyline(line, layer.z);
 
             switch(type)
             {
-                case EXTERNAL : pl.pop_back(); external_polylines.at(layer).push_back(pl); break;
-                case INTERNAL : pl.pop_back(); internal_polylines.at(layer).push_back(pl); break;
-                case OPEN     : open_polylines.at(layer).push_back(pl); break;
+                case EXTERNAL : pl.pop_back(); layer.external_polylines.push_back(pl); break;
+                case INTERNAL : pl.pop_back(); layer.internal_polylines.push_back(pl); break;
+                case OPEN     : layer.open_polylines.push_back(pl); break;
                 default       : std::cerr << "WARNING! Unknown polyline type: discarded." << std::endl;
-            }            
+            }
         }
     }
-    f.close();
+    return found;
 }
 
 }
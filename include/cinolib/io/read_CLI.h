@@ -37,6 +37,9 @@
 #define CINO_READ_CLI_H
 
 #include <vector>
+#include <string>
+#include <fstream>
+#include <sys/types.h>
 #include <cinolib/cino_inline.h>
 #include <cinolib/geometry/vec3.h>
 
@@ -58,6 +61,46 @@ void read_CLI(const char                                   * filename,
               std::vector<std::vector<std::vector<vec3d>>> & external_polylines, // inner holes
               std::vector<std::vector<std::vector<vec3d>>> & open_polylines,     // support structures
               std::vector<std::vector<std::vector<vec3d>>> & hatches);           // supports/infills
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct CLILayer
+{
+    double                          z = 0;
+    std::vector<std::vector<vec3d>> internal_polylines; // inner holes
+    std::vector<std::vector<vec3d>> external_polylines; // outer slice boundary
+    std::vector<std::vector<vec3d>> open_polylines;     // support structures
+    std::vector<std::vector<vec3d>> hatches;            // supports/infills
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Layer by layer reading of CLI files. Only the current layer is kept in
+ * memory, hence print jobs with many thousands of layers can be processed
+ * (or displayed) while the rest of the file is still being read. read_CLI
+ * is implemented on top of it.
+*/
+
+class CLIReader
+{
+    public:
+
+        explicit CLIReader(const char * filename);
+
+        bool is_open()    const { return f.is_open(); }
+        uint num_layers() const { return n_layers;    } // as declared in the header (0 if missing)
+
+        // false when there are no more layers
+        bool next_layer(CLILayer & layer);
+
+    protected:
+
+        std::ifstream f;
+        std::string   line;
+        bool          line_pending = false; // first line of the next layer, already read
+        uint          n_layers     = 0;
+};
+
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -35,6 +35,7 @@
 *********************************************************************************/
 #include <cinolib/io/read_MESH.h>
 #include <cinolib/vector_serialization.h>
+#include <cinolib/io/load_monitor.h>
 #include <iostream>
 #include <set>
 
@@ -69,7 +70,16 @@ void read_MESH(const char                     * filename,
     std::set<int> v_unique_labels;
     std::set<int> p_unique_labels;
 
-    while(fgets(line, 1024, f))
+    // reports progress every 4096 entries, and checks for cancellation
+    LoadMonitor *monitor = current_load_monitor();
+    auto cancelled = [&](const uint i)
+    {
+        if(monitor==nullptr || (i & 4095)!=0) return false;
+        monitor->set_bytes(ftell(f));
+        return monitor->is_cancelled();
+    };
+
+    while(!load_cancelled() && fgets(line, 1024, f))
     {
         // read vertices
         //
@@ -82,6 +92,7 @@ void read_MESH(const char                     * filename,
             sscanf(line, "%d", &nverts);
             for(uint i=0; i<nverts; ++i)
             {
+                if(cancelled(i)) break;
                 // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
                 //
                 fgets(line, 1024, f);
@@ -101,6 +112,7 @@ void read_MESH(const char                     * filename,
             sscanf(line, "%d", &ntets);
             for(uint i=0; i<ntets; ++i)
             {
+                if(cancelled(i)) break;
                 int l;
                 std::vector<uint> tet(4);
                 fgets(line,1024,f);
@@ -121,6 +133,7 @@ void read_MESH(const char                     * filename,
             sscanf(line, "%d", &nhexa);
             for(uint i=0; i<nhexa; ++i)
             {
+                if(cancelled(i)) break;
                 int l;
                 std::vector<uint> hex(8);
                 fgets(line,1024,f);
@@ -138,6 +151,14 @@ void read_MESH(const char                     * filename,
     if(p_unique_labels.size()<2) poly_labels.clear();
 
     fclose(f);
+
+    if(load_cancelled())
+    {
+        verts.clear();
+        polys.clear();
+        vert_labels.clear();
+        poly_labels.clear();
+    }
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -0,0 +1,567 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/read_MSH.h>
+#include <cinolib/io/mapped_file.h>
+#include <cinolib/io/fast_number_parsing.h>
+#include <cinolib/io/cino_format.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+
+namespace cinolib
+{
+
+// how numbers are stored in the section being parsed
+struct MSHEncoding
+{
+    bool binary     = false;
+    bool swap       = false; // binary data written with the other byte order
+    uint size_bytes = 8;     // sizeof(size_t) on the machine that wrote the file
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// rest of the current line (p is moved to the beginning of the next one)
+CINO_INLINE
+std::string msh_line(const char * & p, const char * end)
+{
+    const char *beg = p;
+    while(p<end && *p!='\n') ++p;
+    std::string line(beg, p);
+    if(p<end) ++p;
+    if(!line.empty() && line.back()=='\r') line.pop_back();
+    return line;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+T msh_raw_at(const char * data, const size_t i, const bool swap)
+{
+    T v;
+    memcpy(&v, data + i*sizeof(T), sizeof(T));
+    if(swap) swap_byte_order(&v, sizeof(T), 1);
+    return v;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// i-th size_t of a binary block
+CINO_INLINE
+size_t msh_size_at(const char * data, const size_t i, const MSHEncoding & enc)
+{
+    if(enc.size_bytes==4) return msh_raw_at<uint32_t>(data, i, enc.swap);
+    return msh_raw_at<uint64_t>(data, i, enc.swap);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// next value, either as text or as raw bytes (binary sections)
+CINO_INLINE
+bool msh_get(const char * & p, const char * end, const MSHEncoding & enc, int & v)
+{
+    if(!enc.binary) return parse_int(p, end, v);
+    if(end-p < 4) return false;
+    v = msh_raw_at<int32_t>(p, 0, enc.swap);
+    p += 4;
+    return true;
+}
+
+CINO_INLINE
+bool msh_get(const char * & p, const char * end, const MSHEncoding & enc, double & v)
+{
+    if(!enc.binary) return parse_double(p, end, v);
+    if(end-p < 8) return false;
+    v = msh_raw_at<double>(p, 0, enc.swap);
+    p += 8;
+    return true;
+}
+
+CINO_INLINE
+bool msh_get(const char * & p, const char * end, const MSHEncoding & enc, size_t & v)
+{
+    if(enc.binary)
+    {
+        if(static_cast<size_t>(end-p) < enc.size_bytes) return false;
+        v = msh_size_at(p, 0, enc);
+        p += enc.size_bytes;
+        return true;
+    }
+    const char *q = skip_spaces(p, end);
+    const char *beg = q;
+    size_t x = 0;
+    while(q<end && *q>='0' && *q<='9') x = 10*x + (*q++ - '0');
+    if(q==beg) return false;
+    v = x;
+    p = q;
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// moves p to the line that follows $End<section>
+CINO_INLINE
+bool msh_skip_section(const char * & p, const char * end, const std::string & section)
+{
+    std::string tag = "$End" + section;
+    const char *q = std::search(p, end, tag.begin(), tag.end());
+    if(q==end) return false;
+    p = q + tag.size();
+    msh_line(p, end);
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// (always ASCII)
+CINO_INLINE
+bool msh_read_physical_names(const char                   * & p,
+                             const char                   *   end,
+                             std::vector<MSHPhysicalName> &   names)
+{
+    MSHEncoding ascii;
+    size_t n;
+    if(!msh_get(p, end, ascii, n)) return false;
+    for(size_t i=0; i<n; ++i)
+    {
+        MSHPhysicalName pn;
+        if(!msh_get(p, end, ascii, pn.dim) || !msh_get(p, end, ascii, pn.tag)) return false;
+        p = skip_spaces(p, end);
+        if(p==end || *p!='"') return false;
+        const char *beg = ++p;
+        while(p<end && *p!='"') ++p;
+        if(p==end) return false;
+        pn.name = std::string(beg, p++);
+        names.push_back(pn);
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// maps each entity (dim,tag) to its first physical tag (if any)
+CINO_INLINE
+bool msh_read_entities(const char                        * & p,
+                       const char                        *   end,
+                       const MSHEncoding                 &   enc,
+                       std::map<std::pair<int,int>,int>  &   physical)
+{
+    size_t n[4];
+    for(int d=0; d<4; ++d) if(!msh_get(p, end, enc, n[d])) return false;
+    for(int d=0; d<4; ++d)
+    for(size_t i=0; i<n[d]; ++i)
+    {
+        int    tag, t;
+        double x;
+        size_t n_phys, n_bound;
+        if(!msh_get(p, end, enc, tag)) return false;
+        for(int j=0; j<(d==0 ? 3 : 6); ++j) if(!msh_get(p, end, enc, x)) return false; // point or bbox
+        if(!msh_get(p, end, enc, n_phys)) return false;
+        for(size_t j=0; j<n_phys; ++j)
+        {
+            if(!msh_get(p, end, enc, t)) return false;
+            if(j==0) physical[std::make_pair(d,tag)] = t;
+        }
+        if(d==0) continue;
+        if(!msh_get(p, end, enc, n_bound)) return false;
+        for(size_t j=0; j<n_bound; ++j) if(!msh_get(p, end, enc, t)) return false;
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool msh_read_nodes(const char          * & p,
+                    const char          *   end,
+                    const MSHEncoding   &   enc,
+                    std::vector<vec3d>  &   verts,
+                    std::vector<size_t> &   tags)
+{
+    size_t n_blocks, n_nodes, min_tag, max_tag;
+    if(!msh_get(p, end, enc, n_blocks) || !msh_get(p, end, enc, n_nodes) ||
+       !msh_get(p, end, enc, min_tag)  || !msh_get(p, end, enc, max_tag)) return false;
+    verts.reserve(verts.size()+n_nodes);
+    tags.reserve(tags.size()+n_nodes);
+
+    for(size_t b=0; b<n_blocks; ++b)
+    {
+        int    dim, entity, parametric;
+        size_t n;
+        if(!msh_get(p, end, enc, dim) || !msh_get(p, end, enc, entity) ||
+           !msh_get(p, end, enc, parametric) || !msh_get(p, end, enc, n)) return false;
+
+        // parametric nodes store their (u,v,w) coordinates after (x,y,z)
+        size_t n_coords = 3 + ((parametric && dim>0) ? dim : 0);
+        size_t base     = verts.size();
+        verts.resize(base+n);
+        tags.resize(base+n);
+
+        if(enc.binary)
+        {
+            size_t n_bytes = n*enc.size_bytes + n*n_coords*sizeof(double);
+            if(static_cast<size_t>(end-p) < n_bytes) return false;
+            const char *t = p;
+            const char *c = p + n*enc.size_bytes;
+            PARALLEL_FOR(0, n, 10000, [&](const uint i)
+            {
+                tags[base+i]  = msh_size_at(t, i, enc);
+                verts[base+i] = vec3d(msh_raw_at<double>(c, n_coords*i  , enc.swap),
+                                      msh_raw_at<double>(c, n_coords*i+1, enc.swap),
+                                      msh_raw_at<double>(c, n_coords*i+2, enc.swap));
+            });
+            p += n_bytes;
+        }
+        else
+        {
+            for(size_t i=0; i<n; ++i) if(!msh_get(p, end, enc, tags[base+i])) return false;
+            for(size_t i=0; i<n; ++i)
+            {
+                double x[6];
+                for(size_t j=0; j<n_coords; ++j) if(!msh_get(p, end, enc, x[j])) return false;
+                verts[base+i] = vec3d(x[0], x[1], x[2]);
+            }
+        }
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// node_id maps node tags to vertex ids (UINT_MAX for unknown tags)
+template<typename Func>
+CINO_INLINE
+bool msh_read_elements(const char                             * & p,
+                       const char                             *   end,
+                       const MSHEncoding                      &   enc,
+                       const Func                             &   node_id,
+                       const std::map<std::pair<int,int>,int> &   physical,
+                       std::vector<std::vector<uint>>         &   elems,
+                       std::vector<int>                       &   elem_types,
+                       std::vector<int>                       &   elem_labels)
+{
+    size_t n_blocks, n_elems, min_tag, max_tag;
+    if(!msh_get(p, end, enc, n_blocks) || !msh_get(p, end, enc, n_elems) ||
+       !msh_get(p, end, enc, min_tag)  || !msh_get(p, end, enc, max_tag)) return false;
+    elems.reserve(elems.size()+n_elems);
+    elem_types.reserve(elem_types.size()+n_elems);
+    elem_labels.reserve(elem_labels.size()+n_elems);
+
+    for(size_t b=0; b<n_blocks; ++b)
+    {
+        int    dim, entity, type;
+        size_t n;
+        if(!msh_get(p, end, enc, dim) || !msh_get(p, end, enc, entity) ||
+           !msh_get(p, end, enc, type) || !msh_get(p, end, enc, n)) return false;
+
+        uint n_nodes = msh_element_nodes(type);
+        uint n_verts = msh_element_verts(type); // zero if the type is not supported
+        auto it      = physical.find(std::make_pair(dim,entity));
+        int  label   = (it!=physical.end()) ? it->second : -1;
+
+        if(n_nodes==0)
+        {
+            // unknown type: ASCII blocks can still be skipped (one element per line)
+            if(enc.binary) return false;
+            msh_line(p, end);
+            for(size_t i=0; i<n; ++i) msh_line(p, end);
+            continue;
+        }
+
+        size_t base = elems.size();
+        if(n_verts>0)
+        {
+            elems.resize(base+n, std::vector<uint>(n_verts));
+            elem_types.resize(base+n, type);
+            elem_labels.resize(base+n, label);
+        }
+
+        if(enc.binary)
+        {
+            size_t stride  = 1 + n_nodes; // element tag + node tags
+            size_t n_bytes = n*stride*enc.size_bytes;
+            if(static_cast<size_t>(end-p) < n_bytes) return false;
+            if(n_verts>0)
+            {
+                std::atomic<bool> bad(false);
+                PARALLEL_FOR(0, n, 1000, [&](const uint i)
+                {
+                    std::vector<uint> & e = elems[base+i];
+                    for(uint j=0; j<n_verts; ++j)
+                    {
+                        e[j] = node_id(msh_size_at(p, i*stride+1+j, enc));
+                        if(e[j]==UINT_MAX) bad = true;
+                    }
+                });
+                if(bad) return false;
+            }
+            p += n_bytes;
+        }
+        else
+        {
+            size_t tag;
+            for(size_t i=0; i<n; ++i)
+            {
+                if(!msh_get(p, end, enc, tag)) return false;
+                for(uint j=0; j<n_nodes; ++j)
+                {
+                    if(!msh_get(p, end, enc, tag)) return false;
+                    if(j>=n_verts) continue;
+                    uint vid = node_id(tag);
+                    if(vid==UINT_MAX) return false;
+                    elems[base+i][j] = vid;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void read_MSH(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & elems,
+              std::vector<int>               & elem_types,
+              std::vector<int>               & elem_labels,
+              std::vector<MSHPhysicalName>   & physical_names)
+{
+    verts.clear();
+    elems.clear();
+    elem_types.clear();
+    elem_labels.clear();
+    physical_names.clear();
+
+    MappedFile f(filename);
+    if(!f.is_open())
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_MSH() : couldn't open input file " << filename << std::endl;
+        exit(-1);
+    }
+
+    const char *p   = f.data();
+    const char *end = p + f.size();
+
+    auto fail = [&](const std::string & msg)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_MSH() : " << msg << " (" << filename << ")" << std::endl;
+        verts.clear();
+        elems.clear();
+        elem_types.clear();
+        elem_labels.clear();
+        physical_names.clear();
+    };
+
+    MSHEncoding                      enc;
+    bool                             has_format = false;
+    bool                             has_nodes  = false;
+    std::map<std::pair<int,int>,int> physical;
+    std::vector<size_t>              tags;
+    std::vector<uint>                dense;  // node tag - min_tag => vertex id (for compact tags)
+    std::unordered_map<size_t,uint>  sparse; // node tag => vertex id (for sparse tags)
+    size_t                           min_tag = 0;
+
+    auto node_id = [&](const size_t tag) -> uint
+    {
+        if(!dense.empty())
+        {
+            return (tag>=min_tag && tag-min_tag<dense.size()) ? dense[tag-min_tag] : UINT_MAX;
+        }
+        auto it = sparse.find(tag);
+        return (it!=sparse.end()) ? it->second : UINT_MAX;
+    };
+
+    while(true)
+    {
+        p = skip_spaces(p, end);
+        if(p==end) break;
+        std::string line = msh_line(p, end);
+        if(line.empty() || line[0]!='$') continue;
+        std::string section = line.substr(1, line.find_first_of(" \t")-1);
+
+        if(section=="MeshFormat")
+        {
+            double version;
+            int    file_type, data_size;
+            if(!parse_double(p, end, version) || !parse_int(p, end, file_type) || !parse_int(p, end, data_size)) { fail("bad MeshFormat"); return; }
+            if(version<4.1 || version>=5.0) { fail("unsupported version " + std::to_string(version) + " (only 4.1 is supported)"); return; }
+            if(data_size!=4 && data_size!=8) { fail("unsupported data size"); return; }
+            msh_line(p, end);
+            enc.binary     = (file_type==1);
+            enc.size_bytes = data_size;
+            if(enc.binary)
+            {
+                // the integer 1, in the byte order of the machine that wrote the file
+                if(end-p < 4) { fail("bad MeshFormat"); return; }
+                enc.swap = (msh_raw_at<int32_t>(p, 0, false)!=1);
+                if(msh_raw_at<int32_t>(p, 0, enc.swap)!=1) { fail("bad MeshFormat"); return; }
+                p += 4;
+            }
+            has_format = true;
+        }
+        else if(!has_format)
+        {
+            fail("missing MeshFormat");
+            return;
+        }
+        else if(section=="PhysicalNames")
+        {
+            if(!msh_read_physical_names(p, end, physical_names)) { fail("bad PhysicalNames"); return; }
+        }
+        else if(section=="Entities")
+        {
+            if(!msh_read_entities(p, end, enc, physical)) { fail("bad Entities"); return; }
+        }
+        else if(section=="Nodes")
+        {
+            if(!msh_read_nodes(p, end, enc, verts, tags)) { fail("bad Nodes"); return; }
+            has_nodes = true;
+
+            size_t max_tag = 0;
+            min_tag = tags.empty() ? 0 : tags.front();
+            for(size_t t : tags) { min_tag = std::min(min_tag, t); max_tag = std::max(max_tag, t); }
+            dense.clear();
+            sparse.clear();
+            if(!tags.empty() && max_tag-min_tag < 2*tags.size()+1024)
+            {
+                dense.assign(max_tag-min_tag+1, UINT_MAX);
+                for(size_t vid=0; vid<tags.size(); ++vid) dense[tags[vid]-min_tag] = vid;
+            }
+            else for(size_t vid=0; vid<tags.size(); ++vid) sparse[tags[vid]] = vid;
+        }
+        else if(section=="Elements")
+        {
+            if(!has_nodes) { fail("Elements come before Nodes"); return; }
+            if(!msh_read_elements(p, end, enc, node_id, physical, elems, elem_types, elem_labels)) { fail("bad Elements"); return; }
+        }
+        // any other section (e.g. PartitionedEntities, NodeData) is skipped
+
+        if(!msh_skip_section(p, end, section)) { fail("missing $End" + section); return; }
+    }
+
+    if(!has_format) fail("not a Gmsh file");
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// keeps only the elements listed in kept, and the vertices they reference
+CINO_INLINE
+void msh_keep_elements(const std::vector<uint>              & kept,
+                             std::vector<vec3d>             & verts,
+                             std::vector<std::vector<uint>> & elems,
+                             std::vector<int>               & elem_types,
+                             std::vector<int>               & elem_labels)
+{
+    std::vector<std::vector<uint>> tmp_elems(kept.size());
+    std::vector<int>               tmp_types(kept.size()), tmp_labels(kept.size());
+    for(size_t i=0; i<kept.size(); ++i)
+    {
+        tmp_elems[i]  = std::move(elems.at(kept[i]));
+        tmp_types[i]  = elem_types.at(kept[i]);
+        tmp_labels[i] = elem_labels.at(kept[i]);
+    }
+    elems       = std::move(tmp_elems);
+    elem_types  = std::move(tmp_types);
+    elem_labels = std::move(tmp_labels);
+
+    std::vector<uint> new_id(verts.size(), UINT_MAX);
+    for(const auto & e : elems) for(uint vid : e) new_id[vid] = 0;
+    uint nv = 0;
+    for(uint & id : new_id) if(id==0) id = nv++;
+    if(nv==verts.size()) return; // all vertices are referenced
+
+    std::vector<vec3d> tmp_verts(nv);
+    for(uint vid=0; vid<verts.size(); ++vid) if(new_id[vid]!=UINT_MAX) tmp_verts[new_id[vid]] = verts[vid];
+    verts = std::move(tmp_verts);
+    for(auto & e : elems) for(uint & vid : e) vid = new_id[vid];
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void read_MSH(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & polys,
+              std::vector<int>               & poly_labels,
+              const std::vector<int>         & types)
+{
+    std::vector<int>             elem_types;
+    std::vector<MSHPhysicalName> names;
+    read_MSH(filename, verts, polys, elem_types, poly_labels, names);
+
+    std::vector<uint> kept;
+    for(uint eid=0; eid<polys.size(); ++eid)
+    {
+        if(std::find(types.begin(), types.end(), elem_types[eid])!=types.end()) kept.push_back(eid);
+    }
+    msh_keep_elements(kept, verts, polys, elem_types, poly_labels);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void read_MSH(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & faces,
+              std::vector<std::vector<uint>> & polys,
+              std::vector<std::vector<bool>> & polys_face_winding,
+              std::vector<int>               & poly_labels)
+{
+    std::vector<std::vector<uint>> elems;
+    std::vector<int>               elem_types;
+    std::vector<MSHPhysicalName>   names;
+    read_MSH(filename, verts, elems, elem_types, poly_labels, names);
+
+    std::vector<uint> kept;
+    for(uint eid=0; eid<elems.size(); ++eid)
+    {
+        if(msh_element_dim(elem_types[eid])==3) kept.push_back(eid);
+    }
+    msh_keep_elements(kept, verts, elems, elem_types, poly_labels);
+    msh_elements_to_polyhedra(elems, elem_types, faces, polys, polys_face_winding);
+}
+
+}
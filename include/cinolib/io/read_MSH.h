@@ -0,0 +1,94 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_READ_MSH_H
+#define CINO_READ_MSH_H
+
+#include <sys/types.h>
+#include <vector>
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec3.h>
+#include <cinolib/io/msh_format.h>
+
+namespace cinolib
+{
+
+/* Native reader for Gmsh meshes (.msh, version 4.1), both ASCII and binary
+ * (with either byte order). The file is memory mapped and binary blocks of
+ * nodes and elements are decoded in parallel. Node tags can be arbitrary
+ * (also sparse): vertices are numbered in the order they appear in the file.
+ * Elements are returned as explained in msh_format.h, in file order, and
+ * their label is the first physical tag of the entity they belong to (-1 if
+ * the entity is not in any physical group). Elements of other types (points,
+ * lines, high order elements) are skipped. Physical names are returned too.
+*/
+
+CINO_INLINE
+void read_MSH(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & elems,
+              std::vector<int>               & elem_types,
+              std::vector<int>               & elem_labels,
+              std::vector<MSHPhysicalName>   & physical_names);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// keeps the elements of the given types only (e.g. {MSH_TRIANGLE,MSH_QUADRANGLE}
+// for a surface mesh), and the vertices they reference
+CINO_INLINE
+void read_MSH(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & polys,
+              std::vector<int>               & poly_labels,
+              const std::vector<int>         & types);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// volume elements (tets, hexes, prisms, pyramids) as general polyhedra
+CINO_INLINE
+void read_MSH(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & faces,
+              std::vector<std::vector<uint>> & polys,
+              std::vector<std::vector<bool>> & polys_face_winding,
+              std::vector<int>               & poly_labels);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "read_MSH.cpp"
+#endif
+
+#endif // CINO_READ_MSH
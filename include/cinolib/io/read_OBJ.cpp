@@ -34,9 +34,14 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_OBJ.h>
+#include <cinolib/io/mapped_file.h>
+#include <cinolib/io/fast_number_parsing.h>
+#include <cinolib/io/load_monitor.h>
 #include <cinolib/cut_along_seams.h>
 #include <cinolib/string_utilities.h>
-#include <sstream>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <iterator>
 #include <string.h>
 #include <iostream>
 #include <assert.h>
@@ -46,20 +51,6 @@ namespace cinolib
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-// https://stackoverflow.com/questions/9310327/sscanf-optional-column
-//
-CINO_INLINE
-void read_point_id(char * s, int & v, int & vt, int & vn)
-{
-    v = vt = vn = -1;
-         if(sscanf(s, "%d/%d/%d", &v, &vt, &vn) == 3) { --v; --vt; --vn; }
-    else if(sscanf(s, "%d/%d",    &v, &vt     ) == 2) { --v; --vt;       }
-    else if(sscanf(s, "%d//%d",   &v, &vn     ) == 2) { --v; --vn;       }
-    else if(sscanf(s, "%d",       &v          ) == 1) { --v;             }
-}
-
-//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
-
 CINO_INLINE
 void read_OBJ(const char                     * filename,
               std::vector<vec3d>             & verts,
@@ -102,8 +93,6 @@ void read_OBJ(const char                     * filename,
               std::vector<std::vector<uint>> & poly_nor,    // polygons with references to nor
               std::vector<Color>             & poly_col)    // per polygon colors
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
     pos.clear();
     tex.clear();
     nor.clear();
@@ -112,90 +101,197 @@ void read_OBJ(const char                     * filename,
     poly_nor.clear();
     poly_col.clear();
 
-    FILE *f = fopen(filename, "r");
+    MappedFile f(filename);
 
-    if(!f)
+    if(!f.is_open())
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_OBJ() : couldn't open input file " << filename << std::endl;
         exit(-1);
     }
 
-    std::map<std::string,Color> color_map;
-    Color curr_color = Color::WHITE();     // set WHITE as default color
-    bool has_per_face_color = false;       // true if a mtllib is found. If "has_per_face_color" stays
-                                           // false the "poly_color" vector will be emptied before returning.
-    char line[1024];    
-    while(fgets(line, 1024, f))
+    // split the file in chunks made of whole lines, and parse them in parallel.
+    // Vertex references are absolute, hence chunks can be parsed independently.
+    // Materials are the only state: their changes are recorded, and applied in
+    // order when the chunks are concatenated
+    const char *data = f.data();
+    const char *end  = data + f.size();
+    uint n_chunks = (f.size() < (1<<20)) ? 1 : 8*n_threads();
+    std::vector<const char*> chunk_beg(n_chunks+1, end);
+    chunk_beg.front() = data;
+    for(uint i=1; i<n_chunks; ++i)
     {
-        switch(line[0])
+        const char *p = std::max(chunk_beg.at(i-1), data + f.size()*i/n_chunks);
+        if(p>data && p<end && *(p-1)!='\n')
         {
-            case 'v':
-            {
-                // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-                //
-                double a, b, c;
-                     if(sscanf(line, "v  %lf %lf %lf", &a, &b, &c) == 3) pos.push_back(vec3d(a,b,c));
-                else if(sscanf(line, "vt %lf %lf %lf", &a, &b, &c) == 3) tex.push_back(vec3d(a,b,c));
-                else if(sscanf(line, "vt %lf %lf %lf", &a, &b, &c) == 2) tex.push_back(vec3d(a,b,0));
-                else if(sscanf(line, "vn %lf %lf %lf", &a, &b, &c) == 3) nor.push_back(vec3d(a,b,c));
-                break;
-            }
+            p = static_cast<const char*>(memchr(p, '\n', end-p));
+            p = (p==nullptr) ? end : p+1;
+        }
+        chunk_beg.at(i) = p;
+    }
+
+    struct MaterialEvent
+    {
+        uint        poly;   // index (in the chunk) of the first poly affected
+        bool        is_lib; // mtllib or usemtl
+        std::string name;
+    };
+    struct Chunk
+    {
+        std::vector<vec3d>             pos, tex, nor;
+        std::vector<std::vector<uint>> poly_pos, poly_tex, poly_nor;
+        std::vector<MaterialEvent>     materials;
+    };
+    std::vector<Chunk> chunks(n_chunks);
 
-            case 'f':
+    LoadMonitor *monitor = current_load_monitor();
+    PARALLEL_FOR(0, n_chunks, 2, [&](const uint cid)
+    {
+        if(monitor && monitor->is_cancelled()) return;
+        Chunk & c = chunks.at(cid);
+        const char *line = chunk_beg.at(cid);
+        const char *stop = chunk_beg.at(cid+1);
+        while(line<stop)
+        {
+            const char *eol = static_cast<const char*>(memchr(line, '\n', stop-line));
+            if(eol==nullptr) eol = stop;
+            const char *p = line;
+            line = (eol<stop) ? eol+1 : stop;
+
+            switch(*p)
             {
-                std::string s(line);
-                s = s.substr(1,s.size()-1); // discard the 'f' letter
-                std::istringstream ss(s);
-                std::vector<uint> p_pos, p_tex, p_nor;
-                for(std::string sub_str; ss >> sub_str;)
-                {
-                    int v_pos, v_tex, v_nor;
-                    read_point_id(strdup(sub_str.c_str()), v_pos, v_tex, v_nor);
-                    if (v_pos >= 0) p_pos.push_back(v_pos);
-                    if (v_tex >= 0) p_tex.push_back(v_tex);
-                    if (v_nor >= 0) p_nor.push_back(v_nor);
-                }
-                if (!p_tex.empty()) poly_tex.push_back(p_tex);
-                if (!p_nor.empty()) poly_nor.push_back(p_nor);
-                if (!p_pos.empty())
+                case 'v':
                 {
-                    poly_pos.push_back(p_pos);
-                    poly_col.push_back(curr_color);
+                    double x[3];
+                    const char *q = p+1;
+                    if(parse_double(q,eol,x[0]) && parse_double(q,eol,x[1]) && parse_double(q,eol,x[2]))
+                    {
+                        c.pos.push_back(vec3d(x[0],x[1],x[2]));
+                    }
+                    else if(eol-p>1 && (p[1]=='t' || p[1]=='n'))
+                    {
+                        q = p+2;
+                        uint n = 0;
+                        while(n<3 && parse_double(q,eol,x[n])) ++n;
+                             if(p[1]=='t' && n==3) c.tex.push_back(vec3d(x[0],x[1],x[2]));
+                        else if(p[1]=='t' && n==2) c.tex.push_back(vec3d(x[0],x[1],0));
+                        else if(p[1]=='n' && n==3) c.nor.push_back(vec3d(x[0],x[1],x[2]));
+                    }
+                    break;
                 }
-                break;
-            }
 
-            case 'u':
-            {
-                char mat_c[1024];
-                if (sscanf(line, "usemtl %s", mat_c) == 1)
+                case 'f':
                 {
-                    auto query = color_map.find(std::string(mat_c));
-                    if (query != color_map.end())
+                    // corners are either v, v/vt, v//vn or v/vt/vn (1-based)
+                    std::vector<uint> p_pos, p_tex, p_nor;
+                    const char *q = p+1;
+                    while(true)
                     {
-                        curr_color = query->second;
+                        q = skip_spaces(q, eol);
+                        if(q>=eol) break;
+                        const char *next = q;
+                        while(next<eol && !is_space(*next)) ++next;
+
+                        int v_pos = 0, v_tex = 0, v_nor = 0;
+                        if(parse_int(q,next,v_pos) && q<next && *q=='/')
+                        {
+                            ++q;
+                            if(q<next && *q=='/')
+                            {
+                                ++q;
+                                if(!(q<next && !is_space(*q) && parse_int(q,next,v_nor))) v_nor = 0;
+                            }
+                            else if(q<next && !is_space(*q) && parse_int(q,next,v_tex) && q<next && *q=='/')
+                            {
+                                ++q;
+                                if(!(q<next && !is_space(*q) && parse_int(q,next,v_nor))) v_nor = 0;
+                            }
+                        }
+                        if(v_pos>0) p_pos.push_back(v_pos-1);
+                        if(v_tex>0) p_tex.push_back(v_tex-1);
+                        if(v_nor>0) p_nor.push_back(v_nor-1);
+                        q = next;
                     }
-                    else std::cerr << "WARNING: could not find material: " << mat_c << std::endl;
+                    if(!p_tex.empty()) c.poly_tex.push_back(p_tex);
+                    if(!p_nor.empty()) c.poly_nor.push_back(p_nor);
+                    if(!p_pos.empty()) c.poly_pos.push_back(p_pos);
+                    break;
+                }
+
+                case 'u':
+                case 'm':
+                {
+                    bool is_lib = (*p=='m');
+                    const char *key = is_lib ? "mtllib" : "usemtl";
+                    if(eol-p<6 || strncmp(p,key,6)!=0) break;
+                    const char *q = skip_spaces(p+6, eol);
+                    const char *e = eol;
+                    if(!is_lib) { e = q; while(e<eol && !is_space(*e)) ++e; }
+                    if(e>q) c.materials.push_back({(uint)c.poly_pos.size(), is_lib, std::string(q,e)});
+                    break;
                 }
-                break;
             }
+        }
+        if(monitor) monitor->add_bytes(stop-chunk_beg.at(cid));
+    });
+    if(load_cancelled()) return;
 
-            case 'm':
+    // concatenate chunks
+    size_t n_pos = 0, n_tex = 0, n_nor = 0, n_poly_pos = 0, n_poly_tex = 0, n_poly_nor = 0;
+    for(const Chunk & c : chunks)
+    {
+        n_pos      += c.pos.size();
+        n_tex      += c.tex.size();
+        n_nor      += c.nor.size();
+        n_poly_pos += c.poly_pos.size();
+        n_poly_tex += c.poly_tex.size();
+        n_poly_nor += c.poly_nor.size();
+    }
+    pos.reserve(n_pos);
+    tex.reserve(n_tex);
+    nor.reserve(n_nor);
+    poly_pos.reserve(n_poly_pos);
+    poly_tex.reserve(n_poly_tex);
+    poly_nor.reserve(n_poly_nor);
+    poly_col.reserve(n_poly_pos);
+
+    std::map<std::string,Color> color_map;
+    Color curr_color = Color::WHITE();     // set WHITE as default color
+    bool has_per_face_color = false;       // true if a mtllib is found. If "has_per_face_color" stays
+                                           // false the "poly_color" vector will be emptied before returning.
+    for(Chunk & c : chunks)
+    {
+        pos.insert(pos.end(), c.pos.begin(), c.pos.end());
+        tex.insert(tex.end(), c.tex.begin(), c.tex.end());
+        nor.insert(nor.end(), c.nor.begin(), c.nor.end());
+        std::move(c.poly_pos.begin(), c.poly_pos.end(), std::back_inserter(poly_pos));
+        std::move(c.poly_tex.begin(), c.poly_tex.end(), std::back_inserter(poly_tex));
+        std::move(c.poly_nor.begin(), c.poly_nor.end(), std::back_inserter(poly_nor));
+
+        // chunk poly ids are offset by the number of polys already read
+        size_t offset = poly_col.size();
+        for(const MaterialEvent & e : c.materials)
+        {
+            poly_col.resize(offset + e.poly, curr_color);
+            if(e.is_lib)
+            {
+                std::string s0(filename);
+                std::string s2 = get_file_path(s0) + get_file_name(e.name);
+                read_MTU(s2.c_str(), color_map);
+                has_per_face_color = true;
+            }
+            else
             {
-                char mtu_c[1024];
-                if (sscanf(line, "mtllib %[^\n]s", mtu_c) == 1)
+                auto query = color_map.find(e.name);
+                if (query != color_map.end())
                 {
-                    std::string s0(filename);
-                    std::string s1(mtu_c);
-                    std::string s2 = get_file_path(s0) + get_file_name(s1);
-                    read_MTU(s2.c_str(), color_map);
-                    has_per_face_color = true;
+                    curr_color = query->second;
                 }
-                break;
+                else std::cerr << "WARNING: could not find material: " << e.name << std::endl;
             }
         }
+        poly_col.resize(poly_pos.size(), curr_color);
+        c = Chunk(); // release memory early
     }
-    fclose(f);
     if (!has_per_face_color) poly_col.clear();
 }
 
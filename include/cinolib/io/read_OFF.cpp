@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_OFF.h>
+#include <cinolib/io/load_monitor.h>
 #include <string>
 #include <sstream>
 #include <fstream>
@@ -70,9 +71,23 @@ void read_OFF(const char                     * filename,
     do getline(f, line, '\n'); while(line.find("OFF")==std::string::npos);
     do getline(f, line, '\n'); while(sscanf(line.c_str(), "%d %d %d\n", &nv, &np, &ne)!=3);
 
+    // reports progress every 4096 entries, and checks for cancellation
+    LoadMonitor *monitor = current_load_monitor();
+    auto cancelled = [&](const uint i)
+    {
+        if(monitor==nullptr || (i & 4095)!=0) return false;
+        monitor->set_bytes(f.tellg());
+        if(!monitor->is_cancelled()) return false;
+        verts.clear();
+        polys.clear();
+        poly_colors.clear();
+        return true;
+    };
+
     // read verts
     for(uint i=0; i<nv; ++i)
     {
+        if(cancelled(i)) return;
         getline(f, line, '\n');
         std::stringstream ss(line);
 
@@ -87,6 +102,7 @@ void read_OFF(const char                     * filename,
     // read polys
     for(uint i=0; i<np; ++i)
     {
+        if(cancelled(i)) return;
         getline(f, line, '\n');
         std::stringstream ss(line);
 
@@ -0,0 +1,410 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/read_PLY.h>
+#include <cinolib/io/mapped_file.h>
+#include <cinolib/io/fast_number_parsing.h>
+#include <cinolib/io/cino_format.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/min_max_inf.h>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+namespace cinolib
+{
+
+// mesh attributes that PLY properties are mapped to
+enum
+{
+    PLY_ROLE_X, PLY_ROLE_Y, PLY_ROLE_Z,
+    PLY_ROLE_NX, PLY_ROLE_NY, PLY_ROLE_NZ,
+    PLY_ROLE_R, PLY_ROLE_G, PLY_ROLE_B, PLY_ROLE_A,
+    PLY_ROLE_U, PLY_ROLE_V,
+    PLY_ROLE_LABEL,
+    PLY_ROLE_QUALITY,
+    PLY_NUM_ROLES
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+int ply_role(const std::string & name, const bool vertex)
+{
+    if(name=="red"   || name=="diffuse_red"  ) return PLY_ROLE_R;
+    if(name=="green" || name=="diffuse_green") return PLY_ROLE_G;
+    if(name=="blue"  || name=="diffuse_blue" ) return PLY_ROLE_B;
+    if(name=="alpha" || name=="diffuse_alpha") return PLY_ROLE_A;
+    if(name=="label"  ) return PLY_ROLE_LABEL;
+    if(name=="quality") return PLY_ROLE_QUALITY;
+    if(!vertex) return -1;
+    if(name=="x" ) return PLY_ROLE_X;
+    if(name=="y" ) return PLY_ROLE_Y;
+    if(name=="z" ) return PLY_ROLE_Z;
+    if(name=="nx") return PLY_ROLE_NX;
+    if(name=="ny") return PLY_ROLE_NY;
+    if(name=="nz") return PLY_ROLE_NZ;
+    if(name=="u" || name=="s" || name=="texture_u" || name=="texture_s") return PLY_ROLE_U;
+    if(name=="v" || name=="t" || name=="texture_v" || name=="texture_t") return PLY_ROLE_V;
+    return -1;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool ply_read_scalar(const char * & p, const char * end, const int format, const int type, double & val)
+{
+    if(format==PLY_ASCII) return parse_double(p, end, val);
+    uint size = ply_type_size(type);
+    if(p+size>end) return false;
+    val = ply_value(p, type, format!=(host_is_little_endian() ? PLY_BINARY_LITTLE_ENDIAN : PLY_BINARY_BIG_ENDIAN));
+    p  += size;
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// decodes one record. Mapped scalar properties are stored in vals (by role),
+// and the list property with index list_prop (if any) is copied into list
+CINO_INLINE
+bool ply_read_record(const char       * & p,
+                     const char       *   end,
+                     const int            format,
+                     const PLYElement   & e,
+                     const std::vector<int> & roles,
+                     const int            list_prop,
+                     double             * vals,
+                     std::vector<uint>  * list)
+{
+    for(uint i=0; i<e.props.size(); ++i)
+    {
+        const PLYProperty & prop = e.props[i];
+        double v;
+        if(prop.is_list)
+        {
+            if(!ply_read_scalar(p, end, format, prop.count_type, v) || v<0) return false;
+            uint n = static_cast<uint>(v);
+            if((int)i==list_prop) list->resize(n);
+            for(uint j=0; j<n; ++j)
+            {
+                if(!ply_read_scalar(p, end, format, prop.type, v)) return false;
+                if((int)i==list_prop)
+                {
+                    if(v<0) return false;
+                    list->at(j) = static_cast<uint>(v);
+                }
+            }
+        }
+        else
+        {
+            if(!ply_read_scalar(p, end, format, prop.type, v)) return false;
+            if(roles[i]>=0) vals[roles[i]] = v;
+        }
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// moves p past one binary record without decoding it: only list counts are
+// read, list items are skipped altogether
+CINO_INLINE
+bool ply_skip_binary_record(const char * & p, const char * end, const int format, const PLYElement & e)
+{
+    for(const PLYProperty & prop : e.props)
+    {
+        uint64_t size = ply_type_size(prop.type);
+        if(prop.is_list)
+        {
+            double n;
+            if(!ply_read_scalar(p, end, format, prop.count_type, n) || n<0) return false;
+            size *= static_cast<uint64_t>(n);
+        }
+        if(size > static_cast<uint64_t>(end-p)) return false;
+        p += size;
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void read_PLY(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & polys)
+{
+    std::vector<Vert_std_attributes>    vert_attr;
+    std::vector<Polygon_std_attributes> poly_attr;
+    int vert_props, poly_props;
+    read_PLY(filename, verts, polys, vert_attr, poly_attr, vert_props, poly_props);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void read_PLY(const char                          * filename,
+              std::vector<vec3d>                  & verts,
+              std::vector<std::vector<uint>>      & polys,
+              std::vector<Vert_std_attributes>    & vert_attr,
+              std::vector<Polygon_std_attributes> & poly_attr,
+              int                                 & vert_props,
+              int                                 & poly_props)
+{
+    verts.clear();
+    polys.clear();
+    vert_attr.clear();
+    poly_attr.clear();
+    vert_props = 0;
+    poly_props = 0;
+
+    MappedFile f(filename);
+
+    if(!f.is_open())
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_PLY() : couldn't open input file " << filename << std::endl;
+        exit(-1);
+    }
+
+    const char *data = f.data();
+    const char *end  = data + f.size();
+
+    // header
+    int format = -1;
+    std::vector<PLYElement> elements;
+    const char *p = data;
+    bool header_ok = false;
+    bool first     = true;
+    while(p<end)
+    {
+        const char *eol = static_cast<const char*>(memchr(p, '\n', end-p));
+        if(eol==nullptr) break;
+        std::istringstream line(std::string(p, eol));
+        p = eol+1;
+
+        std::string key;
+        line >> key;
+        if(first)
+        {
+            if(key!="ply") break;
+            first = false;
+        }
+        else if(key=="format")
+        {
+            std::string s;
+            line >> s;
+            if(s=="ascii"               ) format = PLY_ASCII;
+            if(s=="binary_little_endian") format = PLY_BINARY_LITTLE_ENDIAN;
+            if(s=="binary_big_endian"   ) format = PLY_BINARY_BIG_ENDIAN;
+        }
+        else if(key=="element")
+        {
+            PLYElement e;
+            line >> e.name >> e.count;
+            elements.push_back(e);
+        }
+        else if(key=="property" && !elements.empty())
+        {
+            PLYProperty prop;
+            std::string type;
+            line >> type;
+            if(type=="list")
+            {
+                std::string count_type;
+                line >> count_type >> type;
+                prop.is_list    = true;
+                prop.count_type = ply_type(count_type);
+                if(prop.count_type==PLY_INVALID_TYPE) break;
+            }
+            prop.type = ply_type(type);
+            line >> prop.name;
+            if(prop.type==PLY_INVALID_TYPE) break;
+            elements.back().props.push_back(prop);
+        }
+        else if(key=="end_header")
+        {
+            header_ok = true;
+            break;
+        }
+    }
+
+    if(!header_ok || format<0)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_PLY() : invalid header in " << filename << std::endl;
+        return;
+    }
+
+    std::atomic<bool> ok(true);
+    for(const PLYElement & e : elements)
+    {
+        if(e.count>max_uint)
+        {
+            ok = false;
+            break;
+        }
+        uint n = static_cast<uint>(e.count);
+
+        // locate records: fixed size binary records are addressed directly,
+        // otherwise the beginning of each record is found with a serial scan
+        uint stride = 0;
+        for(const PLYProperty & prop : e.props)
+        {
+            if(prop.is_list) { stride = 0; break; }
+            stride += ply_type_size(prop.type);
+        }
+        std::vector<const char*> rec;
+        if(format!=PLY_ASCII && stride>0)
+        {
+            if(static_cast<uint64_t>(end-p) < static_cast<uint64_t>(n)*stride) { ok = false; break; }
+        }
+        else
+        {
+            rec.resize(n+1);
+            for(uint i=0; i<n && ok; ++i)
+            {
+                if(format==PLY_ASCII)
+                {
+                    while(p<end && is_space(*p)) ++p;
+                    rec[i] = p;
+                    const char *eol = static_cast<const char*>(memchr(p, '\n', end-p));
+                    p = (eol==nullptr) ? end : eol+1;
+                    if(rec[i]==end) ok = false;
+                }
+                else
+                {
+                    rec[i] = p;
+                    if(!ply_skip_binary_record(p, end, format, e)) ok = false;
+                }
+            }
+            rec[n] = p;
+        }
+        if(!ok) break;
+        const char *beg = p;
+        auto record = [&](const uint i) { return rec.empty() ? beg + static_cast<size_t>(i)*stride : rec[i]; };
+        auto record_end = [&](const uint i) { return rec.empty() ? end : rec[i+1]; };
+
+        if(e.name=="vertex" || e.name=="face")
+        {
+            bool vertex    = (e.name=="vertex");
+            int  list_prop = -1;
+            std::vector<int>    roles(e.props.size(), -1);
+            std::vector<double> color_scale(PLY_NUM_ROLES, 1.0);
+            int  found = 0;
+            for(uint i=0; i<e.props.size(); ++i)
+            {
+                const PLYProperty & prop = e.props[i];
+                if(prop.is_list)
+                {
+                    if(!vertex && (prop.name=="vertex_indices" || prop.name=="vertex_index")) list_prop = i;
+                    continue;
+                }
+                roles[i] = ply_role(prop.name, vertex);
+                if(roles[i]<0) continue;
+                found |= 1<<roles[i];
+                if(prop.type==PLY_UINT16) color_scale[roles[i]] = 1.0/65535.0; else
+                if(prop.type!=PLY_FLOAT32 && prop.type!=PLY_FLOAT64) color_scale[roles[i]] = 1.0/255.0;
+            }
+            auto has = [&](const int role) { return (found & (1<<role)) != 0; };
+            int props = 0;
+            if(has(PLY_ROLE_NX) && has(PLY_ROLE_NY) && has(PLY_ROLE_NZ)) props |= PLY_NORMALS;
+            if(has(PLY_ROLE_R)  && has(PLY_ROLE_G)  && has(PLY_ROLE_B) ) props |= PLY_COLORS;
+            if(has(PLY_ROLE_U)  && has(PLY_ROLE_V)                ) props |= PLY_UVW;
+            if(has(PLY_ROLE_LABEL)  ) props |= PLY_LABELS;
+            if(has(PLY_ROLE_QUALITY)) props |= PLY_QUALITY;
+
+            auto color = [&](const double * vals)
+            {
+                return Color(vals[PLY_ROLE_R]*color_scale[PLY_ROLE_R],
+                             vals[PLY_ROLE_G]*color_scale[PLY_ROLE_G],
+                             vals[PLY_ROLE_B]*color_scale[PLY_ROLE_B],
+                             has(PLY_ROLE_A) ? vals[PLY_ROLE_A]*color_scale[PLY_ROLE_A] : 1.0);
+            };
+
+            if(vertex)
+            {
+                vert_props = props;
+                verts.resize(n);
+                vert_attr.resize(n);
+                PARALLEL_FOR(0, n, 1000, [&](const uint i)
+                {
+                    double vals[PLY_NUM_ROLES] = {};
+                    const char *q = record(i);
+                    if(!ply_read_record(q, record_end(i), format, e, roles, -1, vals, nullptr)) { ok = false; return; }
+                    verts[i] = vec3d(vals[PLY_ROLE_X], vals[PLY_ROLE_Y], vals[PLY_ROLE_Z]);
+                    Vert_std_attributes & a = vert_attr[i];
+                    if(props & PLY_NORMALS) a.normal  = vec3d(vals[PLY_ROLE_NX], vals[PLY_ROLE_NY], vals[PLY_ROLE_NZ]);
+                    if(props & PLY_COLORS ) a.color   = color(vals);
+                    if(props & PLY_UVW    ) a.uvw     = vec3d(vals[PLY_ROLE_U], vals[PLY_ROLE_V], 0);
+                    if(props & PLY_LABELS ) a.label   = static_cast<int>(vals[PLY_ROLE_LABEL]);
+                    if(props & PLY_QUALITY) a.quality = static_cast<float>(vals[PLY_ROLE_QUALITY]);
+                });
+            }
+            else
+            {
+                poly_props = props;
+                polys.resize(n);
+                poly_attr.resize(n);
+                PARALLEL_FOR(0, n, 1000, [&](const uint i)
+                {
+                    double vals[PLY_NUM_ROLES] = {};
+                    const char *q = record(i);
+                    if(!ply_read_record(q, record_end(i), format, e, roles, list_prop, vals, &polys[i])) { ok = false; return; }
+                    Polygon_std_attributes & a = poly_attr[i];
+                    if(props & PLY_COLORS ) a.color   = color(vals);
+                    if(props & PLY_LABELS ) a.label   = static_cast<int>(vals[PLY_ROLE_LABEL]);
+                    if(props & PLY_QUALITY) a.quality = static_cast<float>(vals[PLY_ROLE_QUALITY]);
+                });
+            }
+        }
+        if(rec.empty()) p = beg + static_cast<size_t>(n)*stride;
+        if(!ok) break;
+    }
+
+    for(const auto & poly : polys)
+    for(uint vid : poly) if(vid>=verts.size()) ok = false;
+
+    if(!ok)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_PLY() : truncated or corrupted file " << filename << std::endl;
+        verts.clear();
+        polys.clear();
+        vert_attr.clear();
+        poly_attr.clear();
+        vert_props = 0;
+        poly_props = 0;
+    }
+}
+
+}
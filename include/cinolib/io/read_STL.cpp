@@ -0,0 +1,183 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/read_STL.h>
+#include <cinolib/io/mapped_file.h>
+#include <cinolib/io/fast_number_parsing.h>
+#include <cinolib/io/cino_format.h>
+#include <cinolib/parallel_for.h>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+namespace cinolib
+{
+
+struct STLVertexKey
+{
+    uint64_t bits[3];
+    bool operator==(const STLVertexKey & k) const
+    {
+        return bits[0]==k.bits[0] && bits[1]==k.bits[1] && bits[2]==k.bits[2];
+    }
+};
+
+struct STLVertexHash
+{
+    size_t operator()(const STLVertexKey & k) const
+    {
+        uint64_t h = k.bits[0]*0x9E3779B185EBCA87ull;
+        h = (h ^ (h>>29) ^ k.bits[1])*0xC2B2AE3D27D4EB4Full;
+        h = (h ^ (h>>32) ^ k.bits[2])*0x165667B19E3779F9ull;
+        return static_cast<size_t>(h ^ (h>>31));
+    }
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void read_STL(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & polys)
+{
+    verts.clear();
+    polys.clear();
+
+    MappedFile f(filename);
+
+    if(!f.is_open())
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_STL() : couldn't open input file " << filename << std::endl;
+        exit(-1);
+    }
+
+    const char *data = f.data();
+    const char *end  = data + f.size();
+
+    // triangle soup (three corners per triangle)
+    std::vector<vec3d> corners;
+    std::atomic<bool> ok(true);
+
+    uint32_t n_tris = 0;
+    if(f.size()>=84)
+    {
+        memcpy(&n_tris, data+80, 4);
+        if(!host_is_little_endian()) swap_byte_order(&n_tris, 4, 1);
+    }
+    bool binary = (f.size()>=84 && 84+50*static_cast<uint64_t>(n_tris)==f.size()) ||
+                  (f.size()>=5  && memcmp(data, "solid", 5)!=0);
+
+    if(binary)
+    {
+        if(f.size()<84 || 84+50*static_cast<uint64_t>(n_tris)>f.size())
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_STL() : truncated file " << filename << std::endl;
+            return;
+        }
+        corners.resize(3*static_cast<size_t>(n_tris));
+        PARALLEL_FOR(0, n_tris, 1000, [&](const uint tid)
+        {
+            // 12 floats (normal + 3 vertices) + uint16 attribute count
+            float v[12];
+            memcpy(v, data + 84 + 50*static_cast<size_t>(tid), 48);
+            if(!host_is_little_endian()) swap_byte_order(v, 4, 12);
+            for(uint i=0; i<3; ++i) corners[3*tid+i] = vec3d(v[3+3*i], v[4+3*i], v[5+3*i]);
+        });
+    }
+    else
+    {
+        // locate the "vertex" keywords, then parse coordinates in parallel.
+        // Only lines starting with "vertex" inside an "outer loop" block are
+        // accepted, so that names in the "solid" line are never mistaken for
+        // vertices
+        std::vector<const char*> pos;
+        const char *p = static_cast<const char*>(memchr(data, '\n', end-data)); // skip the header
+        bool in_loop = false;
+        while(p!=nullptr && p<end)
+        {
+            while(p<end && is_space(*p)) ++p;
+            const char *eol = static_cast<const char*>(memchr(p, '\n', end-p));
+            if(eol==nullptr) eol = end;
+            size_t len = eol-p;
+            if     (len>=5 && memcmp(p, "outer",   5)==0) in_loop = true;
+            else if(len>=7 && memcmp(p, "endloop", 7)==0) in_loop = false;
+            else if(len>=6 && memcmp(p, "vertex",  6)==0 && in_loop && (len==6 || is_space(p[6])))
+            {
+                pos.push_back(p+6);
+            }
+            p = eol;
+        }
+        if(pos.size()%3!=0) ok = false;
+        corners.resize(pos.size());
+        PARALLEL_FOR(0, pos.size(), 1000, [&](const uint i)
+        {
+            const char *s = pos[i];
+            double x, y, z;
+            if(!parse_double(s, end, x) || !parse_double(s, end, y) || !parse_double(s, end, z)) ok = false;
+            else corners[i] = vec3d(x,y,z);
+        });
+    }
+
+    if(!ok)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_STL() : corrupted file " << filename << std::endl;
+        return;
+    }
+
+    // weld coincident vertices (triangles that collapse are discarded)
+    std::unordered_map<STLVertexKey,uint,STLVertexHash> vmap;
+    vmap.reserve(corners.size()/4);
+    polys.reserve(corners.size()/3);
+    for(size_t i=0; i<corners.size(); i+=3)
+    {
+        std::vector<uint> t(3);
+        for(uint off=0; off<3; ++off)
+        {
+            STLVertexKey key;
+            for(uint j=0; j<3; ++j)
+            {
+                double c = corners[i+off][j] + 0.0; // -0 => +0
+                memcpy(&key.bits[j], &c, 8);
+            }
+            auto it = vmap.insert(std::make_pair(key, static_cast<uint>(verts.size())));
+            if(it.second) verts.push_back(corners[i+off]);
+            t[off] = it.first->second;
+        }
+        if(t[0]!=t[1] && t[1]!=t[2] && t[2]!=t[0]) polys.push_back(t);
+    }
+}
+
+}
@@ -34,161 +34,377 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_VTK.h>
-
-#ifdef CINOLIB_USES_VTK
-#include <vtkGenericDataObjectReader.h>
-#include <vtkSmartPointer.h>
-#include <vtkPolyData.h>
+#include <cinolib/io/mapped_file.h>
+#include <cinolib/io/fast_number_parsing.h>
+#include <cinolib/io/cino_format.h>
+#include <cinolib/min_max_inf.h>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
 #include <string>
-#endif
 
 namespace cinolib
 {
 
-#ifdef CINOLIB_USES_VTK
-
+// next white space separated word (empty at the end of the file)
 CINO_INLINE
-void read_VTK(const char                      * filename,
-               std::vector<vec3d>             & verts,
-               std::vector<std::vector<uint>> & poly)
+std::string vtk_legacy_token(const char * & p, const char * end)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    p = skip_spaces(p, end);
+    const char *beg = p;
+    while(p<end && !is_space(*p)) ++p;
+    return std::string(beg, p);
+}
 
-    vtkSmartPointer<vtkGenericDataObjectReader> reader = vtkSmartPointer<vtkGenericDataObjectReader>::New();
-    reader->SetFileName(filename);
-    reader->Update();
-    vtkSmartPointer<vtkUnstructuredGrid> grid(reader->GetUnstructuredGridOutput());
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    for(uint i=0; i<grid->GetNumberOfPoints(); ++i)
-    {
-        double pnt[3];
-        grid->GetPoint(i, pnt);
+// rest of the current line (p is moved to the beginning of the next one)
+CINO_INLINE
+std::string vtk_legacy_line(const char * & p, const char * end)
+{
+    const char *beg = p;
+    while(p<end && *p!='\n') ++p;
+    std::string line(beg, p);
+    if(p<end) ++p;
+    if(!line.empty() && line.back()=='\r') line.pop_back();
+    return line;
+}
 
-        verts.push_back(vec3d(pnt[0],pnt[1],pnt[2]));
-    }
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    for(uint i=0; i<grid->GetNumberOfCells(); ++i)
-    {
-        vtkCell *c = grid->GetCell(i);
+CINO_INLINE
+bool vtk_legacy_count(const char * & p, const char * end, size_t & n)
+{
+    std::string t = vtk_legacy_token(p, end);
+    if(t.empty() || t.find_first_not_of("0123456789")!=std::string::npos) return false;
+    n = std::strtoull(t.c_str(), nullptr, 10);
+    return true;
+}
 
-        std::vector<uint> polyhedron;
-        switch (c->GetCellType())
-        {
-            case VTK_TETRA:      for(uint j=0; j<4; ++j) polyhedron.push_back(c->GetPointId(j)); break;
-            case VTK_HEXAHEDRON: for(uint j=0; j<8; ++j) polyhedron.push_back(c->GetPointId(j)); break;
-        }
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        if(!polyhedron.empty()) poly.push_back(polyhedron);
+// reads n values. Binary data starts at the beginning of the line that
+// follows the keyword, and is always big endian
+CINO_INLINE
+bool vtk_legacy_read(const char          * & p,
+                     const char          *   end,
+                     const bool              binary,
+                     const int               type,
+                     const size_t            n,
+                     std::vector<double>   & values)
+{
+    if(type==VTK_VALUE_INVALID) return false;
+    if(binary)
+    {
+        vtk_legacy_line(p, end);
+        size_t n_bytes = n * vtk_value_size(type);
+        if(static_cast<size_t>(end-p) < n_bytes) return false;
+        vtk_decode(p, type, n, host_is_little_endian(), values);
+        p += n_bytes;
+        return true;
     }
+    values.resize(n);
+    for(size_t i=0; i<n; ++i) if(!parse_double(p, end, values[i])) return false;
+    return true;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// skips the METADATA blocks written by recent versions of VTK (they end
+// with an empty line)
 CINO_INLINE
-void read_VTK(const char                      * filename,
-               std::vector<double>            & xyz,
-               std::vector<std::vector<uint>> & poly)
+void vtk_legacy_skip_metadata(const char * & p, const char * end)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
-    vtkSmartPointer<vtkGenericDataObjectReader> reader = vtkSmartPointer<vtkGenericDataObjectReader>::New();
-    reader->SetFileName(filename);
-    reader->Update();
-    vtkSmartPointer<vtkUnstructuredGrid> grid(reader->GetUnstructuredGridOutput());
-
-    for(uint i=0; i<grid->GetNumberOfPoints(); ++i)
+    const char *q = p;
+    if(vtk_legacy_token(q, end)!="METADATA") return;
+    p = q;
+    vtk_legacy_line(p, end);
+    while(p<end)
     {
-        double pnt[3];
-        grid->GetPoint(i, pnt);
-
-        xyz.push_back(pnt[0]);
-        xyz.push_back(pnt[1]);
-        xyz.push_back(pnt[2]);
+        std::string line = vtk_legacy_line(p, end);
+        if(line.find_first_not_of(" \t")==std::string::npos) break;
     }
+}
 
-    for(uint i=0; i<grid->GetNumberOfCells(); ++i)
-    {
-        vtkCell *c = grid->GetCell(i);
-
-        std::vector<uint> polyhedron;
-        switch (c->GetCellType())
-        {
-            case VTK_TETRA:      for(uint j=0; j<4; ++j) polyhedron.push_back(c->GetPointId(j)); break;
-            case VTK_HEXAHEDRON: for(uint j=0; j<8; ++j) polyhedron.push_back(c->GetPointId(j)); break;
-        }
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        if(!polyhedron.empty()) poly.push_back(polyhedron);
-    }
+CINO_INLINE
+bool vtk_is_integer_type(const int type)
+{
+    return type!=VTK_VALUE_FLOAT32 && type!=VTK_VALUE_FLOAT64;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_VTK(const char          * filename,
-               std::vector<double> & xyz,
-               std::vector<uint>  & tets,
-               std::vector<uint>  & hexa)
+void read_VTK(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & cells,
+              std::vector<uint>              & cell_types,
+              std::vector<VTKDataArray>      & point_data,
+              std::vector<VTKDataArray>      & cell_data)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    verts.clear();
+    cells.clear();
+    cell_types.clear();
+    point_data.clear();
+    cell_data.clear();
+
+    MappedFile f(filename);
+    if(!f.is_open())
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_VTK() : couldn't open input file " << filename << std::endl;
+        exit(-1);
+    }
 
-    vtkSmartPointer<vtkGenericDataObjectReader> reader = vtkSmartPointer<vtkGenericDataObjectReader>::New();
-    reader->SetFileName(filename);
-    reader->Update();
-    vtkSmartPointer<vtkUnstructuredGrid> grid(reader->GetUnstructuredGridOutput());
+    const char *p   = f.data();
+    const char *end = p + f.size();
 
-    for(uint i=0; i<grid->GetNumberOfPoints(); ++i)
+    auto fail = [&](const std::string & msg)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_VTK() : " << msg << " (" << filename << ")" << std::endl;
+        verts.clear();
+        cells.clear();
+        cell_types.clear();
+        point_data.clear();
+        cell_data.clear();
+    };
+
+    if(vtk_legacy_line(p, end).compare(0, 5, "# vtk")!=0) { fail("not a legacy VTK file"); return; }
+    vtk_legacy_line(p, end); // title
+    std::string format = vtk_legacy_token(p, end);
+    if(format!="ASCII" && format!="BINARY") { fail("unknown file format " + format); return; }
+    bool binary = (format=="BINARY");
+
+    std::vector<double>         vals, offsets, conn, types;
+    size_t                      n_cells   = 0;
+    bool                        has_cells = false;
+    bool                        split     = false; // OFFSETS/CONNECTIVITY (v5.1)
+    std::vector<VTKDataArray> * data      = nullptr;
+    size_t                      data_size = 0;
+
+    while(true)
     {
-        double pnt[3];
-        grid->GetPoint(i, pnt);
+        vtk_legacy_skip_metadata(p, end);
+        std::string kw = vtk_legacy_token(p, end);
+        if(kw.empty()) break;
 
-        xyz.push_back(pnt[0]);
-        xyz.push_back(pnt[1]);
-        xyz.push_back(pnt[2]);
+        if(kw=="DATASET")
+        {
+            std::string type = vtk_legacy_token(p, end);
+            if(type!="UNSTRUCTURED_GRID") { fail("unsupported dataset " + type); return; }
+        }
+        else if(kw=="POINTS")
+        {
+            size_t n;
+            if(!vtk_legacy_count(p, end, n) ||
+               !vtk_legacy_read(p, end, binary, vtk_value_type(vtk_legacy_token(p, end)), 3*n, vals)) { fail("bad POINTS"); return; }
+            verts.resize(n);
+            for(size_t vid=0; vid<n; ++vid) verts[vid] = vec3d(vals[3*vid], vals[3*vid+1], vals[3*vid+2]);
+        }
+        else if(kw=="CELLS")
+        {
+            size_t n, size;
+            if(!vtk_legacy_count(p, end, n) || !vtk_legacy_count(p, end, size)) { fail("bad CELLS"); return; }
+            const char *q = p;
+            if(vtk_legacy_token(q, end)=="OFFSETS")
+            {
+                p = q;
+                split   = true;
+                n_cells = (n>0) ? n-1 : 0;
+                if(!vtk_legacy_read(p, end, binary, vtk_value_type(vtk_legacy_token(p, end)), n, offsets) ||
+                   vtk_legacy_token(p, end)!="CONNECTIVITY" ||
+                   !vtk_legacy_read(p, end, binary, vtk_value_type(vtk_legacy_token(p, end)), size, conn)) { fail("bad CELLS"); return; }
+            }
+            else
+            {
+                n_cells = n;
+                if(!vtk_legacy_read(p, end, binary, VTK_VALUE_INT32, size, conn)) { fail("bad CELLS"); return; }
+            }
+            has_cells = true;
+        }
+        else if(kw=="CELL_TYPES")
+        {
+            size_t n;
+            if(!vtk_legacy_count(p, end, n) || !vtk_legacy_read(p, end, binary, VTK_VALUE_INT32, n, types)) { fail("bad CELL_TYPES"); return; }
+        }
+        else if(kw=="POINT_DATA" || kw=="CELL_DATA")
+        {
+            if(!vtk_legacy_count(p, end, data_size)) { fail("bad " + kw); return; }
+            data = (kw=="POINT_DATA") ? &point_data : &cell_data;
+        }
+        else if(kw=="SCALARS" || kw=="VECTORS" || kw=="NORMALS" || kw=="TENSORS" || kw=="TEXTURE_COORDINATES" || kw=="COLOR_SCALARS")
+        {
+            if(data==nullptr) { fail(kw + " outside of POINT_DATA/CELL_DATA"); return; }
+            VTKDataArray a;
+            a.name = vtk_legacy_token(p, end);
+            int type = VTK_VALUE_INVALID;
+            if(kw=="SCALARS")
+            {
+                type = vtk_value_type(vtk_legacy_token(p, end));
+                std::string rest = vtk_legacy_line(p, end); // optional number of components
+                a.components = std::max(1, std::atoi(rest.c_str()));
+                const char *q = p;
+                if(vtk_legacy_token(q, end)=="LOOKUP_TABLE") { p = q; vtk_legacy_token(p, end); }
+            }
+            else if(kw=="VECTORS" || kw=="NORMALS") { a.components = 3; type = vtk_value_type(vtk_legacy_token(p, end)); }
+            else if(kw=="TENSORS")                  { a.components = 9; type = vtk_value_type(vtk_legacy_token(p, end)); }
+            else
+            {
+                size_t n;
+                if(!vtk_legacy_count(p, end, n)) { fail("bad " + kw); return; }
+                a.components = n;
+                type = (kw=="COLOR_SCALARS") ? (binary ? VTK_VALUE_UINT8 : VTK_VALUE_FLOAT32)
+                                             : vtk_value_type(vtk_legacy_token(p, end));
+            }
+            if(!vtk_legacy_read(p, end, binary, type, data_size*a.components, a.values)) { fail("bad data array " + a.name); return; }
+            a.integer = vtk_is_integer_type(type);
+            data->push_back(a);
+        }
+        else if(kw=="FIELD")
+        {
+            size_t n_arrays;
+            vtk_legacy_token(p, end); // field name
+            if(!vtk_legacy_count(p, end, n_arrays)) { fail("bad FIELD"); return; }
+            for(size_t i=0; i<n_arrays; ++i)
+            {
+                vtk_legacy_skip_metadata(p, end);
+                VTKDataArray a;
+                size_t comps, tuples;
+                a.name = vtk_legacy_token(p, end);
+                if(!vtk_legacy_count(p, end, comps) || !vtk_legacy_count(p, end, tuples)) { fail("bad FIELD array " + a.name); return; }
+                int type = vtk_value_type(vtk_legacy_token(p, end));
+                if(!vtk_legacy_read(p, end, binary, type, comps*tuples, a.values)) { fail("bad FIELD array " + a.name); return; }
+                a.components = comps;
+                a.integer    = vtk_is_integer_type(type);
+                // field data attached to the whole dataset (e.g. TIME) is ignored
+                if(data!=nullptr && tuples==data_size) data->push_back(a);
+            }
+        }
+        else if(kw=="LOOKUP_TABLE")
+        {
+            size_t n;
+            vtk_legacy_token(p, end); // table name
+            if(!vtk_legacy_count(p, end, n) ||
+               !vtk_legacy_read(p, end, binary, binary ? VTK_VALUE_UINT8 : VTK_VALUE_FLOAT32, 4*n, vals)) { fail("bad LOOKUP_TABLE"); return; }
+        }
+        else { fail("unsupported keyword " + kw); return; }
     }
 
-    for(uint i=0; i<grid->GetNumberOfCells(); ++i)
-    {
-        vtkCell *c = grid->GetCell(i);
+    if(!has_cells || types.size()!=n_cells) { fail("missing or inconsistent cells"); return; }
+
+    auto to_uint = [](const double d) { return (d>=0) ? static_cast<uint>(d) : max_uint; };
 
-        switch (c->GetCellType())
+    cells.resize(n_cells);
+    cell_types.resize(n_cells);
+    size_t pos = 0;
+    for(size_t cid=0; cid<n_cells; ++cid)
+    {
+        size_t b, e;
+        if(split)
+        {
+            b = static_cast<size_t>(offsets[cid]);
+            e = static_cast<size_t>(offsets[cid+1]);
+        }
+        else
         {
-            case VTK_TETRA:      for(uint j=0; j<4; ++j) tets.push_back(c->GetPointId(j)); break;
-            case VTK_HEXAHEDRON: for(uint j=0; j<8; ++j) hexa.push_back(c->GetPointId(j)); break;
+            if(pos>=conn.size()) { fail("bad CELLS"); return; }
+            b   = pos+1;
+            e   = b + static_cast<size_t>(conn[pos]);
+            pos = e;
         }
+        if(b>e || e>conn.size()) { fail("bad CELLS"); return; }
+        cells[cid].resize(e-b);
+        for(size_t i=b; i<e; ++i) cells[cid][i-b] = to_uint(conn[i]);
+        cell_types[cid] = to_uint(types[cid]);
     }
 
+    if(!vtk_cells_are_valid(cells, cell_types, verts.size())) { fail("invalid cells"); return; }
 }
 
-#else
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_VTK(const char          *,
-               std::vector<double> &,
-               std::vector<uint>   &,
-               std::vector<uint>   &)
+void read_VTK(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & faces,
+              std::vector<std::vector<uint>> & polys,
+              std::vector<std::vector<bool>> & polys_face_winding)
 {
-    std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
+    std::vector<std::vector<uint>> cells;
+    std::vector<uint>              cell_types;
+    std::vector<VTKDataArray>      point_data, cell_data;
+    read_VTK(filename, verts, cells, cell_types, point_data, cell_data);
+    vtk_cells_to_polyhedra(cells, cell_types, faces, polys, polys_face_winding);
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 CINO_INLINE
-void read_VTK(const char                      *,
-               std::vector<double>            &,
-               std::vector<std::vector<uint>> &)
+void read_VTK(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & polys,
+              std::vector<int>               & vert_labels,
+              std::vector<int>               & poly_labels)
 {
-    std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
+    std::vector<std::vector<uint>> cells;
+    std::vector<uint>              cell_types, kept;
+    std::vector<VTKDataArray>      point_data, cell_data;
+    read_VTK(filename, verts, cells, cell_types, point_data, cell_data);
+    vtk_cells_to_polys(cells, cell_types, polys, &kept);
+    vtk_labels(point_data, "label", nullptr, vert_labels);
+    vtk_labels(cell_data,  "label", &kept,   poly_labels);
 }
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_VTK(const char                      *,
-               std::vector<vec3d>             &,
-               std::vector<std::vector<uint>> &)
+void read_VTK(const char                      * filename,
+               std::vector<vec3d>             & verts,
+               std::vector<std::vector<uint>> & poly)
+{
+    std::vector<std::vector<uint>> cells;
+    std::vector<uint>              cell_types;
+    std::vector<VTKDataArray>      point_data, cell_data;
+    read_VTK(filename, verts, cells, cell_types, point_data, cell_data);
+    vtk_cells_to_polys(cells, cell_types, poly);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void read_VTK(const char                      * filename,
+               std::vector<double>            & xyz,
+               std::vector<std::vector<uint>> & poly)
 {
-    std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
+    std::vector<vec3d> verts;
+    read_VTK(filename, verts, poly);
+    xyz.clear();
+    xyz.reserve(3*verts.size());
+    for(const vec3d & v : verts)
+    {
+        xyz.push_back(v.x());
+        xyz.push_back(v.y());
+        xyz.push_back(v.z());
+    }
 }
 
-#endif
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void read_VTK(const char          * filename,
+               std::vector<double> & xyz,
+               std::vector<uint>   & tet,
+               std::vector<uint>   & hexa)
+{
+    std::vector<std::vector<uint>> poly;
+    read_VTK(filename, xyz, poly);
+    tet.clear();
+    hexa.clear();
+    for(const std::vector<uint> & p : poly)
+    {
+        if(p.size()==4) tet.insert(tet.end(), p.begin(), p.end());
+        else            hexa.insert(hexa.end(), p.begin(), p.end());
+    }
+}
 
 }
@@ -40,11 +40,53 @@
 #include <vector>
 #include <cinolib/cino_inline.h>
 #include <cinolib/geometry/vec3.h>
+#include <cinolib/io/vtk_format.h>
 
 
 namespace cinolib
 {
 
+/* Native reader for legacy VTK unstructured grids (no dependency on VTK).
+ * Both ASCII and BINARY (big endian) files are supported, with cells in the
+ * classic layout (data version <= 4.2) or split into OFFSETS/CONNECTIVITY
+ * arrays (data version 5.1). The file is memory mapped and binary arrays are
+ * decoded in parallel. Cells are returned as explained in vtk_format.h.
+ * POINT_DATA and CELL_DATA arrays (SCALARS, VECTORS, NORMALS, TENSORS,
+ * TEXTURE_COORDINATES and FIELD arrays) are returned by name.
+*/
+
+CINO_INLINE
+void read_VTK(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & cells,
+              std::vector<uint>              & cell_types,
+              std::vector<VTKDataArray>      & point_data,
+              std::vector<VTKDataArray>      & cell_data);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// general polyhedra (tets and hexes are converted too)
+CINO_INLINE
+void read_VTK(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & faces,
+              std::vector<std::vector<uint>> & polys,
+              std::vector<std::vector<bool>> & polys_face_winding);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// the readers below keep tets and hexes only. Labels are read from the
+// point/cell arrays called "label", if any
+
+CINO_INLINE
+void read_VTK(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & polys,
+              std::vector<int>               & vert_labels,
+              std::vector<int>               & poly_labels);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 CINO_INLINE
 void read_VTK(const char          * filename,
                std::vector<double> & xyz,
@@ -34,161 +34,588 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_VTU.h>
-
-#ifdef CINOLIB_USES_VTK
-#include <vtkSmartPointer.h>
-#include <vtkCell.h>
-#include <vtkUnstructuredGrid.h>
-#include <vtkXMLUnstructuredGridReader.h>
-#endif
+#include <cinolib/io/mapped_file.h>
+#include <cinolib/io/fast_number_parsing.h>
+#include <cinolib/io/cino_format.h>
+#include <cinolib/min_max_inf.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdint.h>
+#include <string>
 
 namespace cinolib
 {
 
-#ifdef CINOLIB_USES_VTK
-
 CINO_INLINE
-void read_VTU(const char                      * filename,
-               std::vector<vec3d>             & verts,
-               std::vector<std::vector<uint>> & poly)
+const char * vtk_xml_find(const char * beg, const char * end, const char * str)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    const char *p = std::search(beg, end, str, str+strlen(str));
+    return (p==end) ? nullptr : p;
+}
 
-    vtkSmartPointer<vtkXMLUnstructuredGridReader> reader = vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
-    reader->SetFileName(filename);
-    reader->Update();
-    vtkSmartPointer<vtkUnstructuredGrid> grid(reader->GetOutput());
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    for(uint i=0; i<grid->GetNumberOfPoints(); ++i)
+CINO_INLINE
+std::string vtk_xml_unescape(const std::string & s)
+{
+    if(s.find('&')==std::string::npos) return s;
+    static const char *entities[5][2] = {{"&amp;","&"}, {"&lt;","<"}, {"&gt;",">"}, {"&quot;","\""}, {"&apos;","'"}};
+    std::string out;
+    for(size_t i=0; i<s.size();)
     {
-        double pnt[3];
-        grid->GetPoint(i, pnt);
-
-        verts.push_back(vec3d(pnt[0],pnt[1],pnt[2]));
+        bool found = false;
+        for(const auto & e : entities)
+        {
+            if(s.compare(i, strlen(e[0]), e[0])==0)
+            {
+                out   += e[1];
+                i     += strlen(e[0]);
+                found  = true;
+                break;
+            }
+        }
+        if(!found) out += s[i++];
     }
+    return out;
+}
 
-    for(uint i=0; i<grid->GetNumberOfCells(); ++i)
-    {
-        vtkCell *c = grid->GetCell(i);
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        std::vector<uint> polyhedron;
-        switch (c->GetCellType())
+// value of attribute key in tag (empty if missing)
+CINO_INLINE
+std::string vtk_xml_attr(const std::string & tag, const std::string & key)
+{
+    size_t pos = 0;
+    while((pos = tag.find(key, pos))!=std::string::npos)
+    {
+        size_t q = pos + key.size();
+        while(q<tag.size() && is_space(tag[q])) ++q;
+        if(pos>0 && is_space(tag[pos-1]) && q<tag.size() && tag[q]=='=')
         {
-            case VTK_TETRA:      for(uint j=0; j<4; ++j) polyhedron.push_back(c->GetPointId(j)); break;
-            case VTK_HEXAHEDRON: for(uint j=0; j<8; ++j) polyhedron.push_back(c->GetPointId(j)); break;
+            ++q;
+            while(q<tag.size() && is_space(tag[q])) ++q;
+            if(q<tag.size() && (tag[q]=='"' || tag[q]=='\''))
+            {
+                size_t e = tag.find(tag[q], q+1);
+                if(e!=std::string::npos) return vtk_xml_unescape(tag.substr(q+1, e-q-1));
+            }
+            return "";
         }
-
-        if(!polyhedron.empty()) poly.push_back(polyhedron);
+        pos = q;
     }
+    return "";
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// white spaces are skipped. Padding resets the decoder, hence blocks that
+// were encoded separately (e.g. header and data) can be decoded in one go
 CINO_INLINE
-void read_VTU(const char                      * filename,
-               std::vector<double>            & xyz,
-               std::vector<std::vector<uint>> & poly)
+bool vtk_base64_decode(const char * beg, const char * end, std::vector<char> & out)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    out.clear();
+    out.reserve((end-beg)/4*3);
+    uint32_t acc  = 0;
+    int      bits = 0;
+    for(const char *p=beg; p<end; ++p)
+    {
+        char c = *p;
+        uint32_t v;
+        if     (c>='A' && c<='Z') v = c-'A';
+        else if(c>='a' && c<='z') v = c-'a'+26;
+        else if(c>='0' && c<='9') v = c-'0'+52;
+        else if(c=='+')           v = 62;
+        else if(c=='/')           v = 63;
+        else if(c=='=')           { acc = 0; bits = 0; continue; }
+        else if(is_space(c))      continue;
+        else                      return false;
+        acc   = (acc<<6) | v;
+        bits += 6;
+        if(bits>=8)
+        {
+            bits -= 8;
+            out.push_back(static_cast<char>((acc>>bits) & 0xFF));
+        }
+    }
+    return true;
+}
 
-    vtkSmartPointer<vtkXMLUnstructuredGridReader> reader = vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
-    reader->SetFileName(filename);
-    reader->Update();
-    vtkSmartPointer<vtkUnstructuredGrid> grid(reader->GetOutput());
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    for(uint i=0; i<grid->GetNumberOfPoints(); ++i)
+CINO_INLINE
+uint64_t vtk_xml_header(const char * p, const uint header_size, const bool swap)
+{
+    if(header_size==4)
     {
-        double pnt[3];
-        grid->GetPoint(i, pnt);
-
-        xyz.push_back(pnt[0]);
-        xyz.push_back(pnt[1]);
-        xyz.push_back(pnt[2]);
+        uint32_t n;
+        memcpy(&n, p, 4);
+        if(swap) swap_byte_order(&n, 4, 1);
+        return n;
     }
+    uint64_t n;
+    memcpy(&n, p, 8);
+    if(swap) swap_byte_order(&n, 8, 1);
+    return n;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    for(uint i=0; i<grid->GetNumberOfCells(); ++i)
+// decodes a DataArray, given its tag and content (appended points to the
+// first byte after the underscore of the AppendedData section, if any)
+CINO_INLINE
+bool vtk_xml_read_array(const std::string         & tag,
+                        const char                * content_beg,
+                        const char                * content_end,
+                        const char                * appended,
+                        const char                * file_end,
+                        const bool                  appended_raw,
+                        const bool                  swap,
+                        const uint                  header_size,
+                              std::vector<double> & values)
+{
+    int         type   = vtk_value_type(vtk_xml_attr(tag, "type"));
+    std::string format = vtk_xml_attr(tag, "format");
+
+    if(format=="ascii")
     {
-        vtkCell *c = grid->GetCell(i);
+        values.clear();
+        const char *p = content_beg;
+        double v;
+        while(parse_double(p, content_end, v)) values.push_back(v);
+        return skip_spaces(p, content_end)==content_end;
+    }
+
+    if(type==VTK_VALUE_INVALID) return false;
 
-        std::vector<uint> polyhedron;
-        switch (c->GetCellType())
+    std::vector<char> buf;
+    const char *data    = nullptr;
+    uint64_t    n_bytes = 0;
+
+    if(format=="binary")
+    {
+        if(!vtk_base64_decode(content_beg, content_end, buf) || buf.size()<header_size) return false;
+        n_bytes = vtk_xml_header(buf.data(), header_size, swap);
+        if(buf.size()-header_size < n_bytes) return false;
+        data = buf.data() + header_size;
+    }
+    else if(format=="appended")
+    {
+        std::string offset = vtk_xml_attr(tag, "offset");
+        if(appended==nullptr || offset.empty()) return false;
+        uint64_t off = std::strtoull(offset.c_str(), nullptr, 10);
+        if(off >= static_cast<uint64_t>(file_end-appended)) return false;
+        const char *p     = appended + off;
+        uint64_t    avail = file_end - p;
+        if(appended_raw)
         {
-            case VTK_TETRA:      for(uint j=0; j<4; ++j) polyhedron.push_back(c->GetPointId(j)); break;
-            case VTK_HEXAHEDRON: for(uint j=0; j<8; ++j) polyhedron.push_back(c->GetPointId(j)); break;
+            if(avail<header_size) return false;
+            n_bytes = vtk_xml_header(p, header_size, swap);
+            if(avail-header_size < n_bytes) return false;
+            data = p + header_size;
         }
+        else
+        {
+            // the header is either encoded alone (hence padded) or together with the data
+            uint64_t hl = 4*((header_size+2)/3);
+            if(avail<hl || !vtk_base64_decode(p, p+hl, buf) || buf.size()<header_size) return false;
+            n_bytes = vtk_xml_header(buf.data(), header_size, swap);
+            uint64_t len = (p[hl-1]=='=') ? hl + 4*((n_bytes+2)/3) : 4*((header_size+n_bytes+2)/3);
+            if(avail<len || !vtk_base64_decode(p, p+len, buf) || buf.size()-header_size < n_bytes) return false;
+            data = buf.data() + header_size;
+        }
+    }
+    else return false;
+
+    vtk_decode(data, type, n_bytes/vtk_value_size(type), swap, values);
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        if(!polyhedron.empty()) poly.push_back(polyhedron);
+// range [beg,end) of item i in an offsets array, which may or may not have
+// a leading zero (i.e. n+1 or n entries)
+CINO_INLINE
+bool vtk_xml_range(const std::vector<double> & offsets,
+                   const size_t                i,
+                   const size_t                n,
+                         size_t              & beg,
+                         size_t              & end)
+{
+    if(offsets.size()==n+1)
+    {
+        beg = static_cast<size_t>(offsets[i]);
+        end = static_cast<size_t>(offsets[i+1]);
+    }
+    else if(offsets.size()==n)
+    {
+        beg = (i>0) ? static_cast<size_t>(offsets[i-1]) : 0;
+        end = static_cast<size_t>(offsets[i]);
     }
+    else return false;
+    return beg<=end;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// arrays of the current piece
+struct VTUPiece
+{
+    size_t                    n_points = 0;
+    size_t                    n_cells  = 0;
+    std::vector<double>       points;
+    std::vector<double>       connectivity, offsets, types;
+    std::vector<double>       faces, faceoffsets;                                               // VTK < 9.4
+    std::vector<double>       face_connectivity, face_offsets, poly_to_faces, poly_offsets;     // VTK >= 9.4
+    std::vector<VTKDataArray> point_data, cell_data;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 CINO_INLINE
-void read_VTU(const char           * filename,
-               std::vector<double> & xyz,
-               std::vector<uint>   & tets,
-               std::vector<uint>   & hexa)
+bool vtk_xml_merge_piece(const VTUPiece                       & piece,
+                               std::vector<vec3d>             & verts,
+                               std::vector<std::vector<uint>> & cells,
+                               std::vector<uint>              & cell_types,
+                               std::vector<VTKDataArray>      & point_data,
+                               std::vector<VTKDataArray>      & cell_data,
+                         const bool                             first_piece)
 {
+    const size_t nv = piece.n_points;
+    const size_t nc = piece.n_cells;
+    if(piece.points.size()!=3*nv || piece.types.size()!=nc) return false;
 
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    uint v_off = verts.size();
+    for(size_t vid=0; vid<nv; ++vid)
+    {
+        verts.push_back(vec3d(piece.points[3*vid], piece.points[3*vid+1], piece.points[3*vid+2]));
+    }
 
-    vtkSmartPointer<vtkXMLUnstructuredGridReader> reader = vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
-    reader->SetFileName(filename);
-    reader->Update();
-    vtkSmartPointer<vtkUnstructuredGrid> grid(reader->GetOutput());
+    auto vid = [&](const double d) { return (d>=0 && d<nv) ? v_off + static_cast<uint>(d) : max_uint; };
 
-    for(uint i=0; i<grid->GetNumberOfPoints(); ++i)
+    size_t face_beg = 0;
+    for(size_t cid=0; cid<nc; ++cid)
     {
-        double pnt[3];
-        grid->GetPoint(i, pnt);
+        uint type = static_cast<uint>(piece.types[cid]);
+        std::vector<uint> c;
+        size_t beg, end;
+        if(type==VTK_CELL_POLYHEDRON && !piece.faceoffsets.empty())
+        {
+            if(piece.faceoffsets.size()!=nc || piece.faceoffsets[cid]<0) return false;
+            size_t face_end = static_cast<size_t>(piece.faceoffsets[cid]);
+            if(face_end<face_beg || face_end>piece.faces.size()) return false;
+            // face stream: counts are kept, vertex ids are shifted
+            size_t pos = face_beg;
+            c.push_back(static_cast<uint>(piece.faces[pos++]));
+            while(pos<face_end)
+            {
+                size_t n = static_cast<size_t>(piece.faces[pos++]);
+                c.push_back(n);
+                for(size_t i=0; i<n && pos<face_end; ++i) c.push_back(vid(piece.faces[pos++]));
+            }
+            face_beg = face_end;
+        }
+        else if(type==VTK_CELL_POLYHEDRON && !piece.poly_offsets.empty())
+        {
+            size_t n_faces = piece.face_offsets.size() - ((piece.face_offsets.size()>0 && piece.face_offsets[0]==0) ? 1 : 0);
+            if(!vtk_xml_range(piece.poly_offsets, cid, nc, beg, end) || end>piece.poly_to_faces.size()) return false;
+            c.push_back(end-beg);
+            for(size_t i=beg; i<end; ++i)
+            {
+                size_t fid = static_cast<size_t>(piece.poly_to_faces[i]);
+                size_t fb, fe;
+                if(fid>=n_faces || !vtk_xml_range(piece.face_offsets, fid, n_faces, fb, fe) || fe>piece.face_connectivity.size()) return false;
+                c.push_back(fe-fb);
+                for(size_t j=fb; j<fe; ++j) c.push_back(vid(piece.face_connectivity[j]));
+            }
+        }
+        else
+        {
+            if(!vtk_xml_range(piece.offsets, cid, nc, beg, end) || end>piece.connectivity.size()) return false;
+            for(size_t i=beg; i<end; ++i) c.push_back(vid(piece.connectivity[i]));
+        }
+        cells.push_back(c);
+        cell_types.push_back(type);
+    }
 
-        xyz.push_back(pnt[0]);
-        xyz.push_back(pnt[1]);
-        xyz.push_back(pnt[2]);
+    // data arrays are concatenated by name
+    auto merge = [&](const std::vector<VTKDataArray> & src, std::vector<VTKDataArray> & dst)
+    {
+        for(const VTKDataArray & a : src)
+        {
+            if(first_piece) { dst.push_back(a); continue; }
+            for(VTKDataArray & b : dst)
+            {
+                if(b.name==a.name && b.components==a.components)
+                {
+                    b.values.insert(b.values.end(), a.values.begin(), a.values.end());
+                    break;
+                }
+            }
+        }
+    };
+    merge(piece.point_data, point_data);
+    merge(piece.cell_data,  cell_data);
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void read_VTU(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & cells,
+              std::vector<uint>              & cell_types,
+              std::vector<VTKDataArray>      & point_data,
+              std::vector<VTKDataArray>      & cell_data)
+{
+    verts.clear();
+    cells.clear();
+    cell_types.clear();
+    point_data.clear();
+    cell_data.clear();
+
+    MappedFile f(filename);
+    if(!f.is_open())
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_VTU() : couldn't open input file " << filename << std::endl;
+        exit(-1);
     }
 
-    for(uint i=0; i<grid->GetNumberOfCells(); ++i)
+    const char *beg = f.data();
+    const char *end = beg + f.size();
+
+    auto fail = [&](const std::string & msg)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_VTU() : " << msg << " (" << filename << ")" << std::endl;
+        verts.clear();
+        cells.clear();
+        cell_types.clear();
+        point_data.clear();
+        cell_data.clear();
+    };
+
+    // appended data is binary: tags are only searched before it
+    const char *xml_end      = end;
+    const char *appended     = nullptr;
+    bool        appended_raw = true;
+    if(const char *a = vtk_xml_find(beg, end, "<AppendedData"))
     {
-        vtkCell *c = grid->GetCell(i);
+        const char *q = std::find(a, end, '>');
+        const char *u = std::find(q, end, '_');
+        if(u==end) { fail("bad AppendedData"); return; }
+        appended_raw = (vtk_xml_attr(std::string(a, q), "encoding")!="base64");
+        appended     = u+1;
+        xml_end      = a;
+    }
+
+    bool        swap        = false;
+    uint        header_size = 4;
+    bool        in_grid     = false;
+    bool        first_piece = true;
+    std::string section;
+    VTUPiece    piece;
 
-        switch (c->GetCellType())
+    const char *p = beg;
+    while((p = std::find(p, xml_end, '<'))!=xml_end)
+    {
+        if(xml_end-p>=4 && strncmp(p, "<!--", 4)==0)
+        {
+            const char *q = vtk_xml_find(p, xml_end, "-->");
+            if(q==nullptr) break;
+            p = q+3;
+            continue;
+        }
+        const char *q = std::find(p, xml_end, '>');
+        if(q==xml_end) { fail("unterminated tag"); return; }
+        std::string tag(p, q);
+        bool        self_closing = (tag.back()=='/');
+        size_t      name_end     = tag.find_first_of(" \t\r\n/", 1);
+        if(name_end==1) name_end = tag.find_first_of(" \t\r\n", 2); // closing tags
+        std::string name         = tag.substr(1, name_end==std::string::npos ? std::string::npos : name_end-1);
+        p = q+1;
+
+        if(name=="VTKFile")
+        {
+            if(vtk_xml_attr(tag, "type")!="UnstructuredGrid")  { fail("not an unstructured grid"); return; }
+            if(!vtk_xml_attr(tag, "compressor").empty())       { fail("compressed files are not supported"); return; }
+            swap        = (vtk_xml_attr(tag, "byte_order")=="BigEndian") == host_is_little_endian();
+            header_size = (vtk_xml_attr(tag, "header_type")=="UInt64") ? 8 : 4;
+        }
+        else if(name=="UnstructuredGrid")  in_grid = true;
+        else if(name=="/UnstructuredGrid") in_grid = false;
+        else if(name=="Piece" && in_grid)
+        {
+            piece = VTUPiece();
+            piece.n_points = std::strtoull(vtk_xml_attr(tag, "NumberOfPoints").c_str(), nullptr, 10);
+            piece.n_cells  = std::strtoull(vtk_xml_attr(tag, "NumberOfCells" ).c_str(), nullptr, 10);
+            if(self_closing && !vtk_xml_merge_piece(piece, verts, cells, cell_types, point_data, cell_data, first_piece)) { fail("bad Piece"); return; }
+            if(self_closing) first_piece = false;
+        }
+        else if(name=="/Piece" && in_grid)
+        {
+            if(!vtk_xml_merge_piece(piece, verts, cells, cell_types, point_data, cell_data, first_piece)) { fail("bad Piece"); return; }
+            first_piece = false;
+        }
+        else if(name=="PointData" || name=="CellData" || name=="Points" || name=="Cells")
+        {
+            if(!self_closing) section = name;
+        }
+        else if(name=="/PointData" || name=="/CellData" || name=="/Points" || name=="/Cells")
+        {
+            section.clear();
+        }
+        else if(name=="DataArray")
         {
-            case VTK_TETRA:      for(uint j=0; j<4; ++j) tets.push_back(c->GetPointId(j)); break;
-            case VTK_HEXAHEDRON: for(uint j=0; j<8; ++j) hexa.push_back(c->GetPointId(j)); break;
+            const char *content_beg = p;
+            const char *content_end = p;
+            if(!self_closing)
+            {
+                content_end = vtk_xml_find(p, xml_end, "</DataArray>");
+                if(content_end==nullptr) { fail("unterminated DataArray"); return; }
+                p = content_end + 12;
+            }
+            if(!in_grid || section.empty()) continue; // e.g. FieldData
+
+            std::string array_name = vtk_xml_attr(tag, "Name");
+            std::vector<double> values;
+            if(!vtk_xml_read_array(tag, content_beg, content_end, appended, end, appended_raw, swap, header_size, values))
+            {
+                fail("bad DataArray " + array_name);
+                return;
+            }
+
+            if(section=="Points")
+            {
+                piece.points.swap(values);
+            }
+            else if(section=="Cells")
+            {
+                if     (array_name=="connectivity"       ) piece.connectivity.swap(values);
+                else if(array_name=="offsets"            ) piece.offsets.swap(values);
+                else if(array_name=="types"              ) piece.types.swap(values);
+                else if(array_name=="faces"              ) piece.faces.swap(values);
+                else if(array_name=="faceoffsets"        ) piece.faceoffsets.swap(values);
+                else if(array_name=="face_connectivity"  ) piece.face_connectivity.swap(values);
+                else if(array_name=="face_offsets"       ) piece.face_offsets.swap(values);
+                else if(array_name=="polyhedron_to_faces") piece.poly_to_faces.swap(values);
+                else if(array_name=="polyhedron_offsets" ) piece.poly_offsets.swap(values);
+            }
+            else
+            {
+                VTKDataArray a;
+                std::string comps = vtk_xml_attr(tag, "NumberOfComponents");
+                int         type  = vtk_value_type(vtk_xml_attr(tag, "type"));
+                a.name       = array_name;
+                a.components = comps.empty() ? 1 : std::max(1, std::atoi(comps.c_str()));
+                a.integer    = (type!=VTK_VALUE_FLOAT32 && type!=VTK_VALUE_FLOAT64);
+                a.values.swap(values);
+                if(section=="PointData") piece.point_data.push_back(a);
+                else                     piece.cell_data.push_back(a);
+            }
         }
     }
+
+    if(first_piece) { fail("no Piece found"); return; }
+
+    // arrays missing in some of the pieces are dropped
+    auto drop = [](std::vector<VTKDataArray> & arrays, const size_t n)
+    {
+        arrays.erase(std::remove_if(arrays.begin(), arrays.end(), [n](const VTKDataArray & a)
+        {
+            return a.values.size()!=n*a.components;
+        }), arrays.end());
+    };
+    drop(point_data, verts.size());
+    drop(cell_data,  cells.size());
+
+    if(!vtk_cells_are_valid(cells, cell_types, verts.size())) { fail("invalid cells"); return; }
 }
 
-#else
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_VTU(const char          *,
-               std::vector<double> &,
-               std::vector<uint>   &,
-               std::vector<uint>   &)
+void read_VTU(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & faces,
+              std::vector<std::vector<uint>> & polys,
+              std::vector<std::vector<bool>> & polys_face_winding)
 {
-    std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
+    std::vector<std::vector<uint>> cells;
+    std::vector<uint>              cell_types;
+    std::vector<VTKDataArray>      point_data, cell_data;
+    read_VTU(filename, verts, cells, cell_types, point_data, cell_data);
+    vtk_cells_to_polyhedra(cells, cell_types, faces, polys, polys_face_winding);
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 CINO_INLINE
-void read_VTU(const char                      *,
-               std::vector<double>            &,
-               std::vector<std::vector<uint>> &)
+void read_VTU(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & polys,
+              std::vector<int>               & vert_labels,
+              std::vector<int>               & poly_labels)
 {
-    std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
+    std::vector<std::vector<uint>> cells;
+    std::vector<uint>              cell_types, kept;
+    std::vector<VTKDataArray>      point_data, cell_data;
+    read_VTU(filename, verts, cells, cell_types, point_data, cell_data);
+    vtk_cells_to_polys(cells, cell_types, polys, &kept);
+    vtk_labels(point_data, "label", nullptr, vert_labels);
+    vtk_labels(cell_data,  "label", &kept,   poly_labels);
 }
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void read_VTU(const char                      *,
-               std::vector<vec3d>             &,
-               std::vector<std::vector<uint>> &)
+void read_VTU(const char                      * filename,
+               std::vector<vec3d>             & verts,
+               std::vector<std::vector<uint>> & poly)
 {
-    std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
+    std::vector<std::vector<uint>> cells;
+    std::vector<uint>              cell_types;
+    std::vector<VTKDataArray>      point_data, cell_data;
+    read_VTU(filename, verts, cells, cell_types, point_data, cell_data);
+    vtk_cells_to_polys(cells, cell_types, poly);
 }
 
-#endif
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void read_VTU(const char                      * filename,
+               std::vector<double>            & xyz,
+               std::vector<std::vector<uint>> & poly)
+{
+    std::vector<vec3d> verts;
+    read_VTU(filename, verts, poly);
+    xyz.clear();
+    xyz.reserve(3*verts.size());
+    for(const vec3d & v : verts)
+    {
+        xyz.push_back(v.x());
+        xyz.push_back(v.y());
+        xyz.push_back(v.z());
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void read_VTU(const char           * filename,
+               std::vector<double> & xyz,
+               std::vector<uint>   & tets,
+               std::vector<uint>   & hexa)
+{
+    std::vector<std::vector<uint>> poly;
+    read_VTU(filename, xyz, poly);
+    tets.clear();
+    hexa.clear();
+    for(const std::vector<uint> & p : poly)
+    {
+        if(p.size()==4) tets.insert(tets.end(), p.begin(), p.end());
+        else            hexa.insert(hexa.end(), p.begin(), p.end());
+    }
+}
 
 }
@@ -40,11 +40,55 @@
 #include <vector>
 #include <cinolib/cino_inline.h>
 #include <cinolib/geometry/vec3.h>
+#include <cinolib/io/vtk_format.h>
 
 
 namespace cinolib
 {
 
+/* Native reader for XML unstructured grids (no dependency on VTK). Arrays
+ * can be stored as ascii, inline base64 or appended data (either raw or
+ * base64), in any byte order and with 32 or 64 bit headers. Compressed
+ * files (i.e. with a compressor attribute) are not supported. Polyhedra
+ * are read both from faces/faceoffsets and from the newer layout of VTK
+ * 9.4 (face_connectivity, face_offsets, polyhedron_to_faces and
+ * polyhedron_offsets). Multiple pieces are merged. The file is memory
+ * mapped and binary arrays are decoded in parallel. Cells and data arrays
+ * are returned as explained in vtk_format.h.
+*/
+
+CINO_INLINE
+void read_VTU(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & cells,
+              std::vector<uint>              & cell_types,
+              std::vector<VTKDataArray>      & point_data,
+              std::vector<VTKDataArray>      & cell_data);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// general polyhedra (tets and hexes are converted too)
+CINO_INLINE
+void read_VTU(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & faces,
+              std::vector<std::vector<uint>> & polys,
+              std::vector<std::vector<bool>> & polys_face_winding);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// the readers below keep tets and hexes only. Labels are read from the
+// point/cell arrays called "label", if any
+
+CINO_INLINE
+void read_VTU(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<uint>> & polys,
+              std::vector<int>               & vert_labels,
+              std::vector<int>               & poly_labels);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 CINO_INLINE
 void read_VTU(const char          * filename,
                std::vector<double> & xyz,
@@ -40,10 +40,14 @@
 #include <cinolib/io/read_OBJ.h>
 #include <cinolib/io/read_OFF.h>
 #include <cinolib/io/read_IV.h>
+#include <cinolib/io/read_PLY.h>
+#include <cinolib/io/read_STL.h>
 // SURFACE WRITERS
 #include <cinolib/io/write_OBJ.h>
 #include <cinolib/io/write_OFF.h>
 #include <cinolib/io/write_NODE_ELE.h>
+#include <cinolib/io/write_PLY.h>
+#include <cinolib/io/write_STL.h>
 
 
 // VOLUME READERS
@@ -54,12 +58,14 @@
 #include <cinolib/io/read_VTU.h>
 #include <cinolib/io/read_VTK.h>
 #include <cinolib/io/read_HEXEX.h>
+#include <cinolib/io/read_MSH.h>
 // VOLUME WRITERS
 #include <cinolib/io/write_HEDRA.h>
 #include <cinolib/io/write_MESH.h>
 #include <cinolib/io/write_TET.h>
 #include <cinolib/io/write_VTU.h>
 #include <cinolib/io/write_VTK.h>
+#include <cinolib/io/write_MSH.h>
 
 
 // SKELETON READERS
@@ -70,4 +76,10 @@
 // SKELETON WRITERS
 #include <cinolib/io/write_LIVESU2012.h>
 
+
+// NATIVE BINARY FORMAT (ANY MESH)
+#include <cinolib/io/read_CINO.h>
+#include <cinolib/io/write_CINO.h>
+#include <cinolib/io/mesh_stream.h>
+
 #endif // CINO_READ_WRITE
@@ -0,0 +1,112 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/text_buffer.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <vector>
+#include <locale.h>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+namespace cinolib
+{
+
+CINO_INLINE
+void TextBuffer::put_int(const int v)
+{
+    char tmp[16];
+    char *end = tmp + sizeof(tmp);
+    char *p   = end;
+    unsigned int u = (v<0) ? 0u - (unsigned int)v : (unsigned int)v;
+    do { *--p = '0' + (u%10); u /= 10; } while(u>0);
+    if(v<0) *--p = '-';
+    buf.append(p, end);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void TextBuffer::put_double(const double x)
+{
+    char tmp[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    char *end = std::to_chars(tmp, tmp+sizeof(tmp), x, std::chars_format::general, 17).ptr;
+    buf.append(tmp, end);
+#else
+    int n = snprintf(tmp, sizeof(tmp), "%.17g", x);
+    // make sure "." is the decimal separator
+    char dp = localeconv()->decimal_point[0];
+    if(dp!='.') std::replace(tmp, tmp+n, dp, '.');
+    buf.append(tmp, n);
+#endif
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename Func>
+CINO_INLINE
+void write_parallel(      FILE   * fp,
+                    const size_t   n_items,
+                    const Func   & func)
+{
+    const size_t chunk_size = 1<<15;
+    size_t n_chunks = (n_items + chunk_size - 1) / chunk_size;
+    size_t batch    = std::max(1u, 2*n_threads());
+    std::vector<TextBuffer> buffers(std::min(batch, n_chunks));
+
+    for(size_t first=0; first<n_chunks; first+=batch)
+    {
+        size_t last = std::min(n_chunks, first+batch);
+        PARALLEL_FOR(first, last, 2, [&](const uint cid)
+        {
+            TextBuffer & b = buffers.at(cid-first);
+            b.clear();
+            size_t end = std::min(n_items, (cid+1)*chunk_size);
+            for(size_t i=cid*chunk_size; i<end; ++i) func(i,b);
+        });
+        for(size_t cid=first; cid<last; ++cid)
+        {
+            const TextBuffer & b = buffers.at(cid-first);
+            fwrite(b.data(), 1, b.size(), fp);
+        }
+    }
+}
+
+}
@@ -0,0 +1,94 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_TEXT_BUFFER_H
+#define CINO_TEXT_BUFFER_H
+
+#include <stdio.h>
+#include <string>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+
+namespace cinolib
+{
+
+/* Growable buffer for formatted text output, used by the ASCII writers in
+ * place of one fprintf per entry. Numbers are formatted exactly as printf
+ * would do in the "C" locale ("%d" and "%.17g"), hence files are identical
+ * to the ones written with fprintf, regardless of the current locale. With
+ * C++17, doubles are formatted with std::to_chars, which is much faster than
+ * printf (and still byte identical). Raw bytes can be appended as well,
+ * so that binary writers can use write_parallel too.
+*/
+
+class TextBuffer
+{
+    public:
+
+        void put(const char   c)     { buf.push_back(c); }
+        void put(const char * s)     { buf.append(s);    }
+        void put(const void * data, const size_t n) { buf.append(static_cast<const char*>(data), n); } // raw bytes
+        void put_int   (const int    v);
+        void put_double(const double x); // same as printf("%.17g",x)
+
+        const char * data()  const { return buf.data(); }
+        size_t       size()  const { return buf.size(); }
+        void         clear()       { buf.clear();       }
+
+    protected:
+
+        std::string buf;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Writes n_items entries to fp. Entries are split in chunks, which are
+ * formatted in parallel (func(i,buffer) appends entry i to the buffer of
+ * its chunk) and then written in order, one fwrite per chunk. Only a few
+ * chunks per thread are in memory at any time.
+*/
+
+template<typename Func>
+CINO_INLINE
+void write_parallel(      FILE   * fp,
+                    const size_t   n_items,
+                    const Func   & func);
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "text_buffer.cpp"
+#endif
+
+#endif // CINO_TEXT_BUFFER_H
@@ -0,0 +1,348 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/vtk_format.h>
+#include <cinolib/io/cino_format.h>
+#include <cinolib/standard_elements_tables.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <stdint.h>
+
+namespace cinolib
+{
+
+CINO_INLINE
+int vtk_value_type(const std::string & name)
+{
+    if(name=="Int8"    || name=="char"                                  ) return VTK_VALUE_INT8;
+    if(name=="UInt8"   || name=="unsigned_char"                         ) return VTK_VALUE_UINT8;
+    if(name=="Int16"   || name=="short"                                 ) return VTK_VALUE_INT16;
+    if(name=="UInt16"  || name=="unsigned_short"                        ) return VTK_VALUE_UINT16;
+    if(name=="Int32"   || name=="int"                                   ) return VTK_VALUE_INT32;
+    if(name=="UInt32"  || name=="unsigned_int"                          ) return VTK_VALUE_UINT32;
+    if(name=="Int64"   || name=="long"          || name=="vtktypeint64" ) return VTK_VALUE_INT64;
+    if(name=="UInt64"  || name=="unsigned_long" || name=="vtktypeuint64") return VTK_VALUE_UINT64;
+    if(name=="Float32" || name=="float"                                 ) return VTK_VALUE_FLOAT32;
+    if(name=="Float64" || name=="double"                                ) return VTK_VALUE_FLOAT64;
+    return VTK_VALUE_INVALID;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint vtk_value_size(const int type)
+{
+    switch(type)
+    {
+        case VTK_VALUE_INT8    :
+        case VTK_VALUE_UINT8   : return 1;
+        case VTK_VALUE_INT16   :
+        case VTK_VALUE_UINT16  : return 2;
+        case VTK_VALUE_INT32   :
+        case VTK_VALUE_UINT32  :
+        case VTK_VALUE_FLOAT32 : return 4;
+        case VTK_VALUE_INT64   :
+        case VTK_VALUE_UINT64  :
+        case VTK_VALUE_FLOAT64 : return 8;
+        default                : return 0;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void vtk_decode(const char                * data,
+                const int                   type,
+                const size_t                n,
+                const bool                  swap,
+                      std::vector<double> & values)
+{
+    uint size = vtk_value_size(type);
+    values.resize(n);
+    PARALLEL_FOR(0, n, 100000, [&](const size_t i)
+    {
+        char b[8];
+        memcpy(b, data + i*size, size);
+        if(swap) swap_byte_order(b, size, 1);
+        switch(type)
+        {
+            case VTK_VALUE_INT8    : { int8_t   v; memcpy(&v, b, 1); values[i] = v; break; }
+            case VTK_VALUE_UINT8   : { uint8_t  v; memcpy(&v, b, 1); values[i] = v; break; }
+            case VTK_VALUE_INT16   : { int16_t  v; memcpy(&v, b, 2); values[i] = v; break; }
+            case VTK_VALUE_UINT16  : { uint16_t v; memcpy(&v, b, 2); values[i] = v; break; }
+            case VTK_VALUE_INT32   : { int32_t  v; memcpy(&v, b, 4); values[i] = v; break; }
+            case VTK_VALUE_UINT32  : { uint32_t v; memcpy(&v, b, 4); values[i] = v; break; }
+            case VTK_VALUE_INT64   : { int64_t  v; memcpy(&v, b, 8); values[i] = static_cast<double>(v); break; }
+            case VTK_VALUE_UINT64  : { uint64_t v; memcpy(&v, b, 8); values[i] = static_cast<double>(v); break; }
+            case VTK_VALUE_FLOAT32 : { float    v; memcpy(&v, b, 4); values[i] = v; break; }
+            case VTK_VALUE_FLOAT64 : { double   v; memcpy(&v, b, 8); values[i] = v; break; }
+            default                : values[i] = 0;
+        }
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+const VTKDataArray * vtk_find_array(const std::vector<VTKDataArray> & arrays,
+                                    const std::string               & name)
+{
+    for(const VTKDataArray & a : arrays) if(a.name==name) return &a;
+    return nullptr;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void vtk_labels(const std::vector<VTKDataArray> & arrays,
+                const std::string               & name,
+                const std::vector<uint>         * items,
+                      std::vector<int>          & labels)
+{
+    labels.clear();
+    const VTKDataArray *a = vtk_find_array(arrays, name);
+    if(a==nullptr || a->components!=1) return;
+    if(items==nullptr)
+    {
+        for(double v : a->values) labels.push_back(static_cast<int>(v));
+        return;
+    }
+    for(uint i : *items) labels.push_back(static_cast<int>(a->values.at(i)));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void vtk_add_labels(const std::vector<int>          & labels,
+                    const std::string               & name,
+                          std::vector<VTKDataArray> & arrays)
+{
+    if(labels.empty()) return;
+    VTKDataArray a;
+    a.name    = name;
+    a.integer = true;
+    a.values.assign(labels.begin(), labels.end());
+    arrays.push_back(a);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool vtk_cells_are_valid(const std::vector<std::vector<uint>> & cells,
+                         const std::vector<uint>              & cell_types,
+                         const size_t                           num_verts)
+{
+    if(cells.size()!=cell_types.size()) return false;
+    for(size_t cid=0; cid<cells.size(); ++cid)
+    {
+        const std::vector<uint> & c = cells.at(cid);
+        if(cell_types.at(cid)!=VTK_CELL_POLYHEDRON)
+        {
+            for(uint vid : c) if(vid>=num_verts) return false;
+            continue;
+        }
+        if(c.empty()) return false;
+        size_t pos = 1;
+        for(uint i=0; i<c.front(); ++i)
+        {
+            if(pos>=c.size()) return false;
+            size_t n = c.at(pos++);
+            if(n<3 || pos+n>c.size()) return false;
+            for(size_t j=pos; j<pos+n; ++j) if(c.at(j)>=num_verts) return false;
+            pos += n;
+        }
+        if(pos!=c.size()) return false;
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void vtk_cells_from_polys(const std::vector<std::vector<uint>> & polys,
+                                std::vector<std::vector<uint>> & cells,
+                                std::vector<uint>              & cell_types)
+{
+    cells = polys;
+    cell_types.resize(polys.size());
+    for(size_t pid=0; pid<polys.size(); ++pid)
+    {
+        cell_types.at(pid) = (polys.at(pid).size()==4) ? VTK_CELL_TETRA : VTK_CELL_HEXAHEDRON;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void vtk_cells_from_polyhedra(const std::vector<std::vector<uint>> & faces,
+                              const std::vector<std::vector<uint>> & polys,
+                              const std::vector<std::vector<bool>> & polys_face_winding,
+                                    std::vector<std::vector<uint>> & cells,
+                                    std::vector<uint>              & cell_types)
+{
+    cells.resize(polys.size());
+    cell_types.assign(polys.size(), VTK_CELL_POLYHEDRON);
+    for(size_t pid=0; pid<polys.size(); ++pid)
+    {
+        std::vector<uint> & c = cells.at(pid);
+        c.clear();
+        c.push_back(polys.at(pid).size());
+        for(size_t i=0; i<polys.at(pid).size(); ++i)
+        {
+            const std::vector<uint> & f = faces.at(polys.at(pid).at(i));
+            c.push_back(f.size());
+            if(polys_face_winding.at(pid).at(i)) c.insert(c.end(), f.begin(),  f.end());
+            else                                 c.insert(c.end(), f.rbegin(), f.rend());
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void vtk_add_type_selectors(const std::vector<uint>         & cell_types,
+                                  std::vector<VTKDataArray> & cell_data)
+{
+    VTKDataArray tets, hexa;
+    tets.name    = "tet_selector";
+    hexa.name    = "hex_selector";
+    tets.integer = true;
+    hexa.integer = true;
+    for(uint t : cell_types)
+    {
+        tets.values.push_back(t==VTK_CELL_TETRA);
+        hexa.values.push_back(t==VTK_CELL_HEXAHEDRON);
+    }
+    bool has_tets = std::find(cell_types.begin(), cell_types.end(), (uint)VTK_CELL_TETRA     )!=cell_types.end();
+    bool has_hexa = std::find(cell_types.begin(), cell_types.end(), (uint)VTK_CELL_HEXAHEDRON)!=cell_types.end();
+    if(!has_tets || !has_hexa) return;
+    cell_data.push_back(tets);
+    cell_data.push_back(hexa);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void vtk_cells_to_polys(const std::vector<std::vector<uint>> & cells,
+                        const std::vector<uint>              & cell_types,
+                              std::vector<std::vector<uint>> & polys,
+                              std::vector<uint>              * kept)
+{
+    polys.clear();
+    if(kept) kept->clear();
+    for(size_t cid=0; cid<cells.size(); ++cid)
+    {
+        if((cell_types.at(cid)==VTK_CELL_TETRA      && cells.at(cid).size()==4) ||
+           (cell_types.at(cid)==VTK_CELL_HEXAHEDRON && cells.at(cid).size()==8))
+        {
+            polys.push_back(cells.at(cid));
+            if(kept) kept->push_back(cid);
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void vtk_cells_to_polyhedra(const std::vector<std::vector<uint>> & cells,
+                            const std::vector<uint>              & cell_types,
+                                  std::vector<std::vector<uint>> & faces,
+                                  std::vector<std::vector<uint>> & polys,
+                                  std::vector<std::vector<bool>> & polys_face_winding,
+                                  std::vector<uint>              * kept)
+{
+    faces.clear();
+    polys.clear();
+    polys_face_winding.clear();
+    if(kept) kept->clear();
+
+    std::map<std::vector<uint>,uint> f_map; // sorted vids => fid
+
+    auto add_face = [&](std::vector<uint> & p, std::vector<bool> & w, const std::vector<uint> & f)
+    {
+        std::vector<uint> key = f;
+        std::sort(key.begin(), key.end());
+        auto it = f_map.find(key);
+        if(it==f_map.end())
+        {
+            f_map[key] = faces.size();
+            p.push_back(faces.size());
+            w.push_back(true);
+            faces.push_back(f);
+            return;
+        }
+        // same orientation <=> same successor of the first vertex
+        const std::vector<uint> & g = faces.at(it->second);
+        size_t i = std::find(f.begin(), f.end(), g.front()) - f.begin();
+        p.push_back(it->second);
+        w.push_back(f.at((i+1)%f.size()) == g.at(1));
+    };
+
+    for(size_t cid=0; cid<cells.size(); ++cid)
+    {
+        const std::vector<uint> & c = cells.at(cid);
+        std::vector<uint> p;
+        std::vector<bool> w;
+
+        if(cell_types.at(cid)==VTK_CELL_TETRA && c.size()==4)
+        {
+            for(uint i=0; i<4; ++i) add_face(p, w, {c[TET_FACES[i][0]], c[TET_FACES[i][1]], c[TET_FACES[i][2]]});
+        }
+        else if(cell_types.at(cid)==VTK_CELL_HEXAHEDRON && c.size()==8)
+        {
+            for(uint i=0; i<6; ++i) add_face(p, w, {c[HEXA_FACES[i][0]], c[HEXA_FACES[i][1]], c[HEXA_FACES[i][2]], c[HEXA_FACES[i][3]]});
+        }
+        else if(cell_types.at(cid)==VTK_CELL_POLYHEDRON && !c.empty())
+        {
+            size_t pos = 1;
+            for(uint i=0; i<c.front() && pos<c.size(); ++i)
+            {
+                size_t n = c.at(pos++);
+                if(pos+n>c.size()) break;
+                add_face(p, w, std::vector<uint>(c.begin()+pos, c.begin()+pos+n));
+                pos += n;
+            }
+        }
+        else continue;
+
+        polys.push_back(p);
+        polys_face_winding.push_back(w);
+        if(kept) kept->push_back(cid);
+    }
+}
+
+}
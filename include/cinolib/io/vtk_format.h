@@ -0,0 +1,205 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_VTK_FORMAT_H
+#define CINO_VTK_FORMAT_H
+
+#include <sys/types.h>
+#include <string>
+#include <vector>
+#include <cinolib/cino_inline.h>
+
+namespace cinolib
+{
+
+/* Shared bits of the native readers/writers for legacy VTK (.vtk) and XML
+ * unstructured grids (.vtu). Cells are stored as in VTK: a list of vertex
+ * ids for tets and hexes, and a face stream for general polyhedra, i.e.
+ *
+ *     n_faces, n_verts(f0), f0 vids..., n_verts(f1), f1 vids..., ...
+ *
+ * with faces oriented outwards. Type ids are the VTK ones (they are
+ * prefixed here to avoid clashes with vtkCellType.h).
+*/
+
+enum
+{
+    VTK_CELL_TETRA      = 10,
+    VTK_CELL_HEXAHEDRON = 12,
+    VTK_CELL_POLYHEDRON = 42,
+};
+
+/* A point or cell data array. Values are interleaved by component. Integer
+ * arrays (e.g. labels) are written as Int32, all the others as Float64.
+ * A ScalarField maps to a single component array, in both directions:
+ *
+ *     VTKDataArray a = { "f", 1, false, std::vector<double>(f.data(), f.data()+f.size()) };
+ *     ScalarField  f(a.values);
+*/
+
+struct VTKDataArray
+{
+    std::string         name;
+    uint                components = 1;
+    bool                integer    = false;
+    std::vector<double> values;
+};
+
+// scalar types of binary data (both legacy and XML names are recognized)
+enum
+{
+    VTK_VALUE_INT8,
+    VTK_VALUE_UINT8,
+    VTK_VALUE_INT16,
+    VTK_VALUE_UINT16,
+    VTK_VALUE_INT32,
+    VTK_VALUE_UINT32,
+    VTK_VALUE_INT64,
+    VTK_VALUE_UINT64,
+    VTK_VALUE_FLOAT32,
+    VTK_VALUE_FLOAT64,
+    VTK_VALUE_INVALID
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+int vtk_value_type(const std::string & name);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint vtk_value_size(const int type);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// converts n binary values of the given type (swapping their byte order
+// if needed). Large arrays are decoded in parallel
+CINO_INLINE
+void vtk_decode(const char                * data,
+                const int                   type,
+                const size_t                n,
+                const bool                  swap,
+                      std::vector<double> & values);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+const VTKDataArray * vtk_find_array(const std::vector<VTKDataArray> & arrays,
+                                    const std::string               & name);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// labels stored in the single component array called name, for the given
+// subset of items (all, if null). Labels are cleared if there is no such array
+CINO_INLINE
+void vtk_labels(const std::vector<VTKDataArray> & arrays,
+                const std::string               & name,
+                const std::vector<uint>         * items,
+                      std::vector<int>          & labels);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// single component integer array called name (nothing, if labels is empty)
+CINO_INLINE
+void vtk_add_labels(const std::vector<int>          & labels,
+                    const std::string               & name,
+                          std::vector<VTKDataArray> & arrays);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// true if cells and cell_types match, and all cells reference existing
+// vertices (and are well formed, for polyhedra)
+CINO_INLINE
+bool vtk_cells_are_valid(const std::vector<std::vector<uint>> & cells,
+                         const std::vector<uint>              & cell_types,
+                         const size_t                           num_verts);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// tets (4 vids) and hexes (8 vids) to VTK cells
+CINO_INLINE
+void vtk_cells_from_polys(const std::vector<std::vector<uint>> & polys,
+                                std::vector<std::vector<uint>> & cells,
+                                std::vector<uint>              & cell_types);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// general polyhedra (face ids + winding) to VTK_POLYHEDRON cells
+CINO_INLINE
+void vtk_cells_from_polyhedra(const std::vector<std::vector<uint>> & faces,
+                              const std::vector<std::vector<uint>> & polys,
+                              const std::vector<std::vector<bool>> & polys_face_winding,
+                                    std::vector<std::vector<uint>> & cells,
+                                    std::vector<uint>              & cell_types);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// for meshes with both tets and hexes, appends the tet_selector/hex_selector
+// cell arrays, which allow to view each element type alone by thresholding
+CINO_INLINE
+void vtk_add_type_selectors(const std::vector<uint>         & cell_types,
+                                  std::vector<VTKDataArray> & cell_data);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// keeps tets and hexes only. If not null, kept receives the ids of the
+// cells that were not skipped (e.g. to filter cell data accordingly)
+CINO_INLINE
+void vtk_cells_to_polys(const std::vector<std::vector<uint>> & cells,
+                        const std::vector<uint>              & cell_types,
+                              std::vector<std::vector<uint>> & polys,
+                              std::vector<uint>              * kept = nullptr);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// any tet, hex or polyhedron to the face based representation used by
+// Polyhedralmesh. Faces shared by two cells are stored only once. Other
+// cell types are skipped (see kept above)
+CINO_INLINE
+void vtk_cells_to_polyhedra(const std::vector<std::vector<uint>> & cells,
+                            const std::vector<uint>              & cell_types,
+                                  std::vector<std::vector<uint>> & faces,
+                                  std::vector<std::vector<uint>> & polys,
+                                  std::vector<std::vector<bool>> & polys_face_winding,
+                                  std::vector<uint>              * kept = nullptr);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "vtk_format.cpp"
+#endif
+
+#endif // CINO_VTK_FORMAT_H
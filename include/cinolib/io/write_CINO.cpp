@@ -0,0 +1,154 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/write_CINO.h>
+#include <cinolib/parallel_for.h>
+#include <iostream>
+#include <cstring>
+#include <stdio.h>
+
+namespace cinolib
+{
+
+CINO_INLINE
+CinoWriter::CinoWriter(const uint32_t mesh_type, const uint64_t mesh_hash)
+    : type(mesh_type)
+    , hash(mesh_hash)
+{}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+void CinoWriter::add(const uint32_t id, const T * data, const size_t count)
+{
+    static_assert(sizeof(T)==1 || sizeof(T)==2 || sizeof(T)==4 || sizeof(T)==8, "CINO sections store scalars");
+    Section s;
+    s.id          = id;
+    s.scalar_size = sizeof(T);
+    s.count       = count;
+    s.data        = data;
+    sections.push_back(s);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+void CinoWriter::add(const uint32_t id, const std::vector<T> & data)
+{
+    add(id, data.data(), data.size());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void CinoWriter::add_csr(const uint32_t id, const std::vector<std::vector<uint>> & lists)
+{
+    std::vector<uint64_t> offsets(lists.size()+1);
+    offsets[0] = 0;
+    for(size_t i=0; i<lists.size(); ++i) offsets[i+1] = offsets[i] + lists[i].size();
+
+    std::vector<uint32_t> ids(offsets.back());
+    PARALLEL_FOR(0, lists.size(), 10000, [&](const size_t i)
+    {
+        std::copy(lists[i].begin(), lists[i].end(), ids.begin() + offsets[i]);
+    });
+
+    // vectors are moved into the owning containers, hence their data pointers stay valid
+    csr_offsets.push_back(std::move(offsets));
+    csr_ids.push_back(std::move(ids));
+    add(id,              csr_offsets.back().data(), csr_offsets.back().size());
+    add(id+CINO_CSR_IDS, csr_ids.back().data(),     csr_ids.back().size());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool CinoWriter::write(const char * filename) const
+{
+    auto align = [](const uint64_t off) { return (off + CINO_ALIGNMENT - 1) / CINO_ALIGNMENT * CINO_ALIGNMENT; };
+
+    std::vector<CinoSectionEntry> dir(sections.size());
+    uint64_t offset = align(sizeof(CinoHeader) + dir.size()*sizeof(CinoSectionEntry));
+    for(size_t i=0; i<sections.size(); ++i)
+    {
+        dir[i].id          = sections[i].id;
+        dir[i].scalar_size = sections[i].scalar_size;
+        dir[i].count       = sections[i].count;
+        dir[i].offset      = offset;
+        offset = align(offset + dir[i].count*dir[i].scalar_size);
+    }
+    PARALLEL_FOR(0, sections.size(), 2, [&](const size_t i)
+    {
+        dir[i].checksum = xxhash64(sections[i].data, dir[i].count*dir[i].scalar_size);
+    });
+
+    CinoHeader h;
+    memset(&h, 0, sizeof(CinoHeader));
+    memcpy(h.magic, CINO_MAGIC, 8);
+    h.version            = CINO_VERSION;
+    h.byte_order         = CINO_BYTE_ORDER;
+    h.mesh_type          = type;
+    h.num_sections       = dir.size();
+    h.mesh_hash          = hash;
+    h.directory_checksum = xxhash64(dir.data(), dir.size()*sizeof(CinoSectionEntry));
+
+    FILE *fp = fopen(filename, "wb");
+    if(!fp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_CINO() : couldn't write output file " << filename << std::endl;
+        return false;
+    }
+
+    static const char zeros[CINO_ALIGNMENT] = {};
+    bool ok = fwrite(&h, sizeof(CinoHeader), 1, fp) == 1;
+    if(!dir.empty()) ok = ok && fwrite(dir.data(), sizeof(CinoSectionEntry), dir.size(), fp) == dir.size();
+    uint64_t pos = sizeof(CinoHeader) + dir.size()*sizeof(CinoSectionEntry);
+    for(size_t i=0; i<sections.size() && ok; ++i)
+    {
+        size_t pad = dir[i].offset - pos;
+        size_t n   = dir[i].count*dir[i].scalar_size;
+        ok = ok && fwrite(zeros, 1, pad, fp) == pad;
+        if(n>0) ok = ok && fwrite(sections[i].data, 1, n, fp) == n;
+        pos = dir[i].offset + n;
+    }
+    ok = (fclose(fp)==0) && ok;
+
+    if(!ok) std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_CINO() : couldn't write output file " << filename << std::endl;
+    return ok;
+}
+
+}
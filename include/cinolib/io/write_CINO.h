@@ -0,0 +1,92 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_WRITE_CINO_H
+#define CINO_WRITE_CINO_H
+
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/io/cino_format.h>
+
+namespace cinolib
+{
+
+/* Collects the sections of a *.cino file (see cino_format.h) and writes
+ * them to disk. Arrays passed through add() are NOT copied, and must stay
+ * alive until write() is called. CSR lists are packed into buffers owned
+ * by the writer.
+*/
+
+class CinoWriter
+{
+    public:
+
+        explicit CinoWriter(const uint32_t mesh_type, const uint64_t mesh_hash = 0);
+
+        template<typename T>
+        void add(const uint32_t id, const T * data, const size_t count);
+
+        template<typename T>
+        void add(const uint32_t id, const std::vector<T> & data);
+
+        void add_csr(const uint32_t id, const std::vector<std::vector<uint>> & lists);
+
+        bool write(const char * filename) const;
+
+    protected:
+
+        struct Section
+        {
+            uint32_t     id;
+            uint32_t     scalar_size;
+            uint64_t     count;
+            const void * data;
+        };
+
+        uint32_t                           type;
+        uint64_t                           hash;
+        std::vector<Section>               sections;
+        std::vector<std::vector<uint64_t>> csr_offsets; // owned CSR buffers
+        std::vector<std::vector<uint32_t>> csr_ids;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "write_CINO.cpp"
+#endif
+
+#endif // CINO_WRITE_CINO_H
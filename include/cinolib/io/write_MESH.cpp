@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_MESH.h>
+#include <cinolib/io/text_buffer.h>
 
 #include <iostream>
 
@@ -50,8 +51,6 @@ void write_MESH(const char                           * filename,
     assert(vert_labels.size() == verts.size());
     assert(poly_labels.size() == polys.size());
 
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
     FILE *fp = fopen(filename, "w");
 
     if(!fp)
@@ -66,7 +65,7 @@ void write_MESH(const char                           * filename,
     uint nv = verts.size();
     uint nt = 0;
     uint nh = 0;
-    for(auto p : polys)
+    for(const auto & p : polys)
     {
         if (p.size() == 4) ++nt; else
         if (p.size() == 8) ++nh;
@@ -76,42 +75,47 @@ void write_MESH(const char                           * filename,
     {
         fprintf(fp, "Vertices\n" );
         fprintf(fp, "%d\n", nv);
-        for(uint vid=0; vid<nv; ++vid)
+        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
+        //
+        write_parallel(fp, nv, [&](const size_t vid, TextBuffer & b)
         {
-            // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-            //
-            fprintf( fp, "%.17g %.17g %.17g %d\n", verts.at(vid).x(), verts.at(vid).y(), verts.at(vid).z(), vert_labels.at(vid));
-        }
+            b.put_double(verts[vid].x()); b.put(' ');
+            b.put_double(verts[vid].y()); b.put(' ');
+            b.put_double(verts[vid].z()); b.put(' ');
+            b.put_int(vert_labels[vid]);  b.put('\n');
+        });
     }
 
     if (nt > 0)
     {
         fprintf(fp, "Tetrahedra\n" );
         fprintf(fp, "%d\n", nt );
-        for(uint pid=0; pid<polys.size(); ++pid)
+        write_parallel(fp, polys.size(), [&](const size_t pid, TextBuffer & b)
         {
-            const std::vector<uint> & tet = polys.at(pid);
+            const std::vector<uint> & tet = polys[pid];
             if (tet.size() == 4)
             {
-                fprintf(fp, "%d %d %d %d %d\n", tet.at(0)+1, tet.at(1)+1, tet.at(2)+1, tet.at(3)+1, poly_labels.at(pid));
+                for(uint vid : tet) { b.put_int(vid+1); b.put(' '); }
+                b.put_int(poly_labels[pid]);
+                b.put('\n');
             }
-        }
+        });
     }
 
     if (nh > 0)
     {
         fprintf(fp, "Hexahedra\n" );
         fprintf(fp, "%d\n", nh );
-        for(uint pid=0; pid<polys.size(); ++pid)
+        write_parallel(fp, polys.size(), [&](const size_t pid, TextBuffer & b)
         {
-            const std::vector<uint> & hex = polys.at(pid);
+            const std::vector<uint> & hex = polys[pid];
             if (hex.size() == 8)
             {
-                fprintf(fp, "%d %d %d %d %d %d %d %d %d\n", hex.at(0)+1, hex.at(1)+1, hex.at(2)+1, hex.at(3)+1,
-                                                            hex.at(4)+1, hex.at(5)+1, hex.at(6)+1, hex.at(7)+1,
-                                                            poly_labels.at(pid));
+                for(uint vid : hex) { b.put_int(vid+1); b.put(' '); }
+                b.put_int(poly_labels[pid]);
+                b.put('\n');
             }
-        }
+        });
     }
 
     fprintf(fp, "End\n\n");
@@ -0,0 +1,304 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/write_MSH.h>
+#include <cinolib/io/text_buffer.h>
+#include <iostream>
+#include <map>
+#include <stdint.h>
+#include <string>
+
+namespace cinolib
+{
+
+// appends a value, either as raw bytes (host order) or as text followed by sep
+CINO_INLINE
+void msh_put(TextBuffer & buf, const bool binary, const int v, const char sep)
+{
+    if(binary) { int32_t x = v; buf.put(&x, 4); return; }
+    buf.put_int(v);
+    buf.put(sep);
+}
+
+CINO_INLINE
+void msh_put(TextBuffer & buf, const bool binary, const size_t v, const char sep)
+{
+    if(binary) { uint64_t x = v; buf.put(&x, 8); return; }
+    char tmp[24];
+    int  n = 0;
+    size_t x = v;
+    do { tmp[n++] = '0' + x%10; x /= 10; } while(x>0);
+    while(n>0) buf.put(tmp[--n]);
+    buf.put(sep);
+}
+
+CINO_INLINE
+void msh_put(TextBuffer & buf, const bool binary, const double v, const char sep)
+{
+    if(binary) { buf.put(&v, 8); return; }
+    buf.put_double(v);
+    buf.put(sep);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_MSH(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & elems,
+               const std::vector<int>               & elem_types,
+               const std::vector<int>               & elem_labels,
+               const std::vector<MSHPhysicalName>   & physical_names,
+               const bool                             binary)
+{
+    size_t nv = verts.size();
+    size_t ne = elems.size();
+    if(elem_types.size()!=ne || (!elem_labels.empty() && elem_labels.size()!=ne))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_MSH() : bad size of element types or labels" << std::endl;
+        return;
+    }
+    if(ne==0)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_MSH() : no elements to write" << std::endl;
+        return;
+    }
+    for(size_t eid=0; eid<ne; ++eid)
+    {
+        bool ok = (msh_element_verts(elem_types[eid])>0 && elems[eid].size()==msh_element_verts(elem_types[eid]));
+        for(uint vid : elems[eid]) ok = ok && (vid<nv);
+        if(!ok)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_MSH() : invalid element " << eid << std::endl;
+            return;
+        }
+    }
+
+    // one entity for each dimension and label (tags are per dimension)
+    auto label = [&](const size_t eid) { return elem_labels.empty() ? -1 : elem_labels[eid]; };
+    struct Entity { int dim, tag, label; vec3d min, max; };
+    std::vector<Entity>              entities;
+    std::map<std::pair<int,int>,int> entity_id; // (dim,label) => entity
+    std::vector<int>                 elem_entity(ne);
+    int                              n_tags[4] = { 0, 0, 0, 0 };
+    for(size_t eid=0; eid<ne; ++eid)
+    {
+        int  dim = msh_element_dim(elem_types[eid]);
+        auto key = std::make_pair(dim, label(eid));
+        auto it  = entity_id.find(key);
+        if(it==entity_id.end())
+        {
+            it = entity_id.insert(std::make_pair(key, (int)entities.size())).first;
+            Entity e = { dim, ++n_tags[dim], key.second, verts[elems[eid][0]], verts[elems[eid][0]] };
+            entities.push_back(e);
+        }
+        Entity & e = entities[it->second];
+        for(uint vid : elems[eid])
+        {
+            e.min = e.min.min(verts[vid]);
+            e.max = e.max.max(verts[vid]);
+        }
+        elem_entity[eid] = it->second;
+    }
+
+    // one block for each run of elements with the same type and entity
+    std::vector<size_t> blocks;
+    for(size_t eid=0; eid<ne; ++eid)
+    {
+        if(eid==0 || elem_types[eid]!=elem_types[eid-1] || elem_entity[eid]!=elem_entity[eid-1]) blocks.push_back(eid);
+    }
+    blocks.push_back(ne);
+
+    FILE *fp = fopen(filename, "wb");
+    if(!fp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_MSH() : couldn't open output file " << filename << std::endl;
+        exit(-1);
+    }
+
+    TextBuffer buf;
+    auto flush = [&]()
+    {
+        fwrite(buf.data(), 1, buf.size(), fp);
+        buf.clear();
+    };
+    auto end_section = [&](const char * name)
+    {
+        if(binary) buf.put('\n');
+        buf.put("$End");
+        buf.put(name);
+        buf.put('\n');
+        flush();
+    };
+
+    buf.put("$MeshFormat\n");
+    buf.put(binary ? "4.1 1 8\n" : "4.1 0 8\n");
+    if(binary) msh_put(buf, true, 1, ' ');
+    end_section("MeshFormat");
+
+    // (always ASCII)
+    if(!physical_names.empty())
+    {
+        buf.put("$PhysicalNames\n");
+        msh_put(buf, false, physical_names.size(), '\n');
+        for(const MSHPhysicalName & pn : physical_names)
+        {
+            msh_put(buf, false, pn.dim, ' ');
+            msh_put(buf, false, pn.tag, ' ');
+            buf.put('"');
+            buf.put(pn.name.c_str());
+            buf.put("\"\n");
+        }
+        buf.put("$EndPhysicalNames\n");
+        flush();
+    }
+
+    buf.put("$Entities\n");
+    for(int d=0; d<4; ++d) msh_put(buf, binary, static_cast<size_t>(n_tags[d]), d<3 ? ' ' : '\n');
+    for(int d=0; d<4; ++d)
+    for(const Entity & e : entities)
+    {
+        if(e.dim!=d) continue;
+        msh_put(buf, binary, e.tag, ' ');
+        for(int i=0; i<3; ++i) msh_put(buf, binary, e.min[i], ' ');
+        for(int i=0; i<3; ++i) msh_put(buf, binary, e.max[i], ' ');
+        if(e.label>=0)
+        {
+            msh_put(buf, binary, static_cast<size_t>(1), ' ');
+            msh_put(buf, binary, e.label, ' ');
+        }
+        else msh_put(buf, binary, static_cast<size_t>(0), ' ');
+        msh_put(buf, binary, static_cast<size_t>(0), '\n'); // no bounding entities
+    }
+    end_section("Entities");
+
+    // a single block of nodes, classified on the first entity of highest dimension
+    const Entity * node_entity = &entities.front();
+    for(const Entity & e : entities) if(e.dim>node_entity->dim) node_entity = &e;
+    buf.put("$Nodes\n");
+    msh_put(buf, binary, static_cast<size_t>(1),  ' ');
+    msh_put(buf, binary, nv,                      ' ');
+    msh_put(buf, binary, static_cast<size_t>(1),  ' ');
+    msh_put(buf, binary, nv,                      '\n');
+    msh_put(buf, binary, node_entity->dim,        ' ');
+    msh_put(buf, binary, node_entity->tag,        ' ');
+    msh_put(buf, binary, 0,                       ' ');
+    msh_put(buf, binary, nv,                      '\n');
+    flush();
+    write_parallel(fp, nv, [&](const size_t vid, TextBuffer & b)
+    {
+        msh_put(b, binary, vid+1, '\n');
+    });
+    write_parallel(fp, nv, [&](const size_t vid, TextBuffer & b)
+    {
+        msh_put(b, binary, verts[vid].x(), ' ');
+        msh_put(b, binary, verts[vid].y(), ' ');
+        msh_put(b, binary, verts[vid].z(), '\n');
+    });
+    end_section("Nodes");
+
+    buf.put("$Elements\n");
+    msh_put(buf, binary, blocks.size()-1,        ' ');
+    msh_put(buf, binary, ne,                     ' ');
+    msh_put(buf, binary, static_cast<size_t>(1), ' ');
+    msh_put(buf, binary, ne,                     '\n');
+    flush();
+    for(size_t b=0; b+1<blocks.size(); ++b)
+    {
+        size_t         beg = blocks[b];
+        size_t         end = blocks[b+1];
+        const Entity & e   = entities[elem_entity[beg]];
+        msh_put(buf, binary, e.dim,            ' ');
+        msh_put(buf, binary, e.tag,            ' ');
+        msh_put(buf, binary, elem_types[beg],  ' ');
+        msh_put(buf, binary, end-beg,          '\n');
+        flush();
+        write_parallel(fp, end-beg, [&](const size_t i, TextBuffer & tb)
+        {
+            const std::vector<uint> & el = elems[beg+i];
+            msh_put(tb, binary, beg+i+1, ' ');
+            for(size_t j=0; j<el.size(); ++j) msh_put(tb, binary, static_cast<size_t>(el[j])+1, (j+1<el.size()) ? ' ' : '\n');
+        });
+    }
+    end_section("Elements");
+
+    fclose(fp);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_MSH(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & polys,
+               const std::vector<int>               & poly_labels,
+               const int                              dim,
+               const bool                             binary)
+{
+    std::vector<int> types(polys.size());
+    for(size_t pid=0; pid<polys.size(); ++pid)
+    {
+        types[pid] = msh_element_type(polys[pid].size(), dim);
+        if(types[pid]<0)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_MSH() : unsupported element with " << polys[pid].size() << " vertices" << std::endl;
+            return;
+        }
+    }
+    write_MSH(filename, verts, polys, types, poly_labels, std::vector<MSHPhysicalName>(), binary);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_MSH(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & faces,
+               const std::vector<std::vector<uint>> & polys,
+               const std::vector<std::vector<bool>> & polys_face_winding,
+               const std::vector<int>               & poly_labels,
+               const bool                             binary)
+{
+    std::vector<std::vector<uint>> elems;
+    std::vector<int>               types;
+    if(!msh_elements_from_polyhedra(faces, polys, polys_face_winding, elems, types))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_MSH() : only tets, hexes, prisms and pyramids can be written" << std::endl;
+        return;
+    }
+    write_MSH(filename, verts, elems, types, poly_labels, std::vector<MSHPhysicalName>(), binary);
+}
+
+}
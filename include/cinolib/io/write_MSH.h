@@ -0,0 +1,95 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_WRITE_MSH_H
+#define CINO_WRITE_MSH_H
+
+#include <sys/types.h>
+#include <vector>
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec3.h>
+#include <cinolib/io/msh_format.h>
+
+namespace cinolib
+{
+
+/* Native writer for Gmsh meshes (.msh, version 4.1), either ASCII or binary
+ * (in the byte order of the host). Elements are assigned to one entity for
+ * each dimension and label, and labels become physical tags (elements with
+ * a negative label do not belong to any physical group). Elements are written
+ * in the order they are given (and numbered from 1), hence read_MSH returns
+ * exactly the same mesh. Nodes and elements are formatted in parallel.
+*/
+
+CINO_INLINE
+void write_MSH(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & elems,
+               const std::vector<int>               & elem_types,
+               const std::vector<int>               & elem_labels,
+               const std::vector<MSHPhysicalName>   & physical_names,
+               const bool                             binary = true);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// surface (dim=2: triangles, quads) or volume (dim=3: tets, hexes, prisms,
+// pyramids) elements. Types are deduced from the number of vertices
+CINO_INLINE
+void write_MSH(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & polys,
+               const std::vector<int>               & poly_labels,
+               const int                              dim,
+               const bool                             binary = true);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// general polyhedra (only tets, hexes, prisms and pyramids can be written)
+CINO_INLINE
+void write_MSH(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & faces,
+               const std::vector<std::vector<uint>> & polys,
+               const std::vector<std::vector<bool>> & polys_face_winding,
+               const std::vector<int>               & poly_labels,
+               const bool                             binary = true);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "write_MSH.cpp"
+#endif
+
+#endif // CINO_WRITE_MSH
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_NODE_ELE.h>
+#include <cinolib/io/text_buffer.h>
 #include <iostream>
 
 namespace cinolib
@@ -44,8 +45,6 @@ void write_NODE_ELE(const char                           * basename,
                     const std::vector<vec3d>             & verts,
                     const std::vector<std::vector<uint>> & poly)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
     std::string node_filename = std::string(basename) + ".node";
     std::string ele_filename  = std::string(basename) + ".ele";
 
@@ -59,20 +58,23 @@ void write_NODE_ELE(const char                           * basename,
     }
 
     fprintf(f_node, "%d 0\n", (int)verts.size());
-    for(auto p : verts)
+    // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
+    //
+    write_parallel(f_node, verts.size(), [&](const size_t vid, TextBuffer & b)
     {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        //
-        fprintf(f_node, "%.17g %.17g %.17g\n", p.x(), p.y(), p.z());
-    }
+        b.put_double(verts[vid].x()); b.put(' ');
+        b.put_double(verts[vid].y()); b.put(' ');
+        b.put_double(verts[vid].z()); b.put('\n');
+    });
 
     fprintf(f_ele, "%d\n", (int)poly.size());
-    for(const std::vector<uint> & p : poly)
+    write_parallel(f_ele, poly.size(), [&](const size_t pid, TextBuffer & b)
     {
-        fprintf(f_ele, "%d ", (int)p.size());
-        for(uint vid : p) fprintf(f_ele, "%d ", vid+1);
-        fprintf(f_ele, "\n");
-    }
+        b.put_int((int)poly[pid].size());
+        b.put(' ');
+        for(uint vid : poly[pid]) { b.put_int(vid+1); b.put(' '); }
+        b.put('\n');
+    });
 
     fclose(f_node);
     fclose(f_ele);
@@ -86,8 +88,6 @@ void write_NODE_ELE_2D(const char                           * basename,
                        const std::vector<vec3d>             & verts,
                        const std::vector<std::vector<uint>> & poly)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
     std::string node_filename = std::string(basename) + ".node";
     std::string ele_filename  = std::string(basename) + ".ele";
 
@@ -101,20 +101,22 @@ void write_NODE_ELE_2D(const char                           * basename,
     }
 
     fprintf(f_node, "%d 0\n", (int)verts.size());
-    for(auto p : verts)
+    // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
+    //
+    write_parallel(f_node, verts.size(), [&](const size_t vid, TextBuffer & b)
     {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        //
-        fprintf(f_node, "%.17g %.17g\n", p.x(), p.y());
-    }
+        b.put_double(verts[vid].x()); b.put(' ');
+        b.put_double(verts[vid].y()); b.put('\n');
+    });
 
     fprintf(f_ele, "%d\n", (int)poly.size());
-    for(const std::vector<uint> & p : poly)
+    write_parallel(f_ele, poly.size(), [&](const size_t pid, TextBuffer & b)
     {
-        fprintf(f_ele, "%d ", (int)p.size());
-        for(uint vid : p) fprintf(f_ele, "%d ", vid+1);
-        fprintf(f_ele, "\n");
-    }
+        b.put_int((int)poly[pid].size());
+        b.put(' ');
+        for(uint vid : poly[pid]) { b.put_int(vid+1); b.put(' '); }
+        b.put('\n');
+    });
 
     fclose(f_node);
     fclose(f_ele);
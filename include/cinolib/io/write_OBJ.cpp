@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_OBJ.h>
+#include <cinolib/io/text_buffer.h>
 #include <cinolib/color.h>
 #include <cinolib/stl_container_utilities.h>
 #include <cinolib/string_utilities.h>
@@ -52,8 +53,6 @@ void write_OBJ(const char                * filename,
                const std::vector<uint>   & tri,
                const std::vector<uint>   & quad)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
     FILE *fp = fopen(filename, "w");
 
     if(!fp)
@@ -62,22 +61,32 @@ void write_OBJ(const char                * filename,
         exit(-1);
     }
 
-    for(size_t i=0; i<xyz.size(); i+=3)
+    // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
+    //
+    write_parallel(fp, xyz.size()/3, [&](const size_t i, TextBuffer & b)
     {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        //
-        fprintf(fp, "v %.17g %.17g %.17g\n", xyz[i], xyz[i+1], xyz[i+2]);
-    }
+        b.put("v ");
+        b.put_double(xyz[3*i  ]); b.put(' ');
+        b.put_double(xyz[3*i+1]); b.put(' ');
+        b.put_double(xyz[3*i+2]); b.put('\n');
+    });
 
-    for(size_t i=0; i<tri.size(); i+=3)
+    write_parallel(fp, tri.size()/3, [&](const size_t i, TextBuffer & b)
     {
-        fprintf(fp, "f %d %d %d\n", tri[i] + 1, tri[i+1] + 1, tri[i+2] + 1);
-    }
+        b.put("f ");
+        b.put_int(tri[3*i  ] + 1); b.put(' ');
+        b.put_int(tri[3*i+1] + 1); b.put(' ');
+        b.put_int(tri[3*i+2] + 1); b.put('\n');
+    });
 
-    for(size_t i=0; i<quad.size(); i+=4)
+    write_parallel(fp, quad.size()/4, [&](const size_t i, TextBuffer & b)
     {
-        fprintf(fp, "f %d %d %d %d\n", quad[i] + 1, quad[i+1] + 1, quad[i+2] + 1, quad[i+3] + 1);
-    }
+        b.put("f ");
+        b.put_int(quad[4*i  ] + 1); b.put(' ');
+        b.put_int(quad[4*i+1] + 1); b.put(' ');
+        b.put_int(quad[4*i+2] + 1); b.put(' ');
+        b.put_int(quad[4*i+3] + 1); b.put('\n');
+    });
 
     fclose(fp);
 }
@@ -89,8 +98,6 @@ void write_OBJ(const char                           * filename,
                const std::vector<double>            & xyz,
                const std::vector<std::vector<uint>> & poly)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
     FILE *fp = fopen(filename, "w");
 
     if(!fp)
@@ -99,19 +106,22 @@ void write_OBJ(const char                           * filename,
         exit(-1);
     }
 
-    for(uint i=0; i<xyz.size(); i+=3)
+    // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
+    //
+    write_parallel(fp, xyz.size()/3, [&](const size_t i, TextBuffer & b)
     {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        //
-        fprintf(fp, "v %.17g %.17g %.17g\n", xyz[i], xyz[i+1], xyz[i+2]);
-    }
+        b.put("v ");
+        b.put_double(xyz[3*i  ]); b.put(' ');
+        b.put_double(xyz[3*i+1]); b.put(' ');
+        b.put_double(xyz[3*i+2]); b.put('\n');
+    });
 
-    for(auto p : poly)
+    write_parallel(fp, poly.size(), [&](const size_t pid, TextBuffer & b)
     {
-        fprintf(fp, "f ");
-        for(uint vid : p) fprintf(fp, "%d ", vid+1);
-        fprintf(fp, "\n");
-    }
+        b.put("f ");
+        for(uint vid : poly[pid]) { b.put_int(vid+1); b.put(' '); }
+        b.put('\n');
+    });
 
     fclose(fp);
 }
@@ -156,24 +166,36 @@ void write_OBJ(const char                * filename,
 
     fprintf(f_obj, "mtllib %s\n", get_file_name(mtl_filename).c_str());
 
-    for(uint i=0; i<xyz.size(); i+=3)
+    // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
+    //
+    write_parallel(f_obj, xyz.size()/3, [&](const size_t i, TextBuffer & b)
     {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        //
-        fprintf(f_obj, "v %.17g %.17g %.17g\n", xyz[i], xyz[i+1], xyz[i+2]);
-    }
+        b.put("v ");
+        b.put_double(xyz[3*i  ]); b.put(' ');
+        b.put_double(xyz[3*i+1]); b.put(' ');
+        b.put_double(xyz[3*i+2]); b.put('\n');
+    });
 
-    for(uint i=0; i<tri.size(); i+=3)
+    write_parallel(f_obj, tri.size()/3, [&](const size_t i, TextBuffer & b)
     {
-        fprintf(f_obj, "usemtl color_%d\n", color_map[colors.at(i/3)]);
-        fprintf(f_obj, "f %d %d %d\n", tri[i] + 1, tri[i+1] + 1, tri[i+2] + 1);
-    }
-
-    for(uint i=0; i<quad.size(); i+=4)
+        b.put("usemtl color_");
+        b.put_int(color_map.at(colors.at(i)));
+        b.put("\nf ");
+        b.put_int(tri[3*i  ] + 1); b.put(' ');
+        b.put_int(tri[3*i+1] + 1); b.put(' ');
+        b.put_int(tri[3*i+2] + 1); b.put('\n');
+    });
+
+    write_parallel(f_obj, quad.size()/4, [&](const size_t i, TextBuffer & b)
     {
-        fprintf(f_obj, "usemtl color_%d\n", color_map[colors.at(i/4)]);
-        fprintf(f_obj, "f %d %d %d %d\n", quad[i] + 1, quad[i+1] + 1, quad[i+2] + 1, quad[i+3] + 1);
-    }
+        b.put("usemtl color_");
+        b.put_int(color_map.at(colors.at(i)));
+        b.put("\nf ");
+        b.put_int(quad[4*i  ] + 1); b.put(' ');
+        b.put_int(quad[4*i+1] + 1); b.put(' ');
+        b.put_int(quad[4*i+2] + 1); b.put(' ');
+        b.put_int(quad[4*i+3] + 1); b.put('\n');
+    });
 
     fclose(f_obj);
     fclose(f_mtl);
@@ -206,24 +228,32 @@ void write_OBJ(const char                * filename,
     fprintf(f_mtl, "newmtl color\nKd %f %f %f\n", color.r, color.g, color.b);
     fprintf(f_obj, "mtllib %s\n", get_file_name(mtl_filename).c_str());
 
-    for(uint i=0; i<xyz.size(); i+=3)
+    // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
+    //
+    write_parallel(f_obj, xyz.size()/3, [&](const size_t i, TextBuffer & b)
     {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        //
-        fprintf(f_obj, "v %.17g %.17g %.17g\n", xyz[i], xyz[i+1], xyz[i+2]);
-    }
+        b.put("v ");
+        b.put_double(xyz[3*i  ]); b.put(' ');
+        b.put_double(xyz[3*i+1]); b.put(' ');
+        b.put_double(xyz[3*i+2]); b.put('\n');
+    });
 
-    for(uint i=0; i<tri.size(); i+=3)
+    write_parallel(f_obj, tri.size()/3, [&](const size_t i, TextBuffer & b)
     {
-        fprintf(f_obj, "usemtl color\n");
-        fprintf(f_obj, "f %d %d %d\n", tri[i] + 1, tri[i+1] + 1, tri[i+2] + 1);
-    }
+        b.put("usemtl color\nf ");
+        b.put_int(tri[3*i  ] + 1); b.put(' ');
+        b.put_int(tri[3*i+1] + 1); b.put(' ');
+        b.put_int(tri[3*i+2] + 1); b.put('\n');
+    });
 
-    for(uint i=0; i<quad.size(); i+=4)
+    write_parallel(f_obj, quad.size()/4, [&](const size_t i, TextBuffer & b)
     {
-        fprintf(f_obj, "usemtl color\n");
-        fprintf(f_obj, "f %d %d %d %d\n", quad[i] + 1, quad[i+1] + 1, quad[i+2] + 1, quad[i+3] + 1);
-    }
+        b.put("usemtl color\nf ");
+        b.put_int(quad[4*i  ] + 1); b.put(' ');
+        b.put_int(quad[4*i+1] + 1); b.put(' ');
+        b.put_int(quad[4*i+2] + 1); b.put(' ');
+        b.put_int(quad[4*i+3] + 1); b.put('\n');
+    });
 
     fclose(f_obj);
     fclose(f_mtl);
@@ -268,20 +298,24 @@ void write_OBJ(const char                           * filename,
 
     fprintf(f_obj, "mtllib %s\n", get_file_name(mtl_filename).c_str());
 
-    for(uint i=0; i<xyz.size(); i+=3)
+    // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
+    //
+    write_parallel(f_obj, xyz.size()/3, [&](const size_t i, TextBuffer & b)
     {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        //
-        fprintf(f_obj, "v %.17g %.17g %.17g\n", xyz[i], xyz[i+1], xyz[i+2]);
-    }
+        b.put("v ");
+        b.put_double(xyz[3*i  ]); b.put(' ');
+        b.put_double(xyz[3*i+1]); b.put(' ');
+        b.put_double(xyz[3*i+2]); b.put('\n');
+    });
 
-    for(uint fid=0; fid<poly.size(); ++fid)
+    write_parallel(f_obj, poly.size(), [&](const size_t fid, TextBuffer & b)
     {
-        fprintf(f_obj, "usemtl color_%d\n", color_map.at(colors.at(fid)));
-        fprintf(f_obj, "f ");
-        for(uint vid : poly.at(fid)) fprintf(f_obj, "%d ", vid+1);
-        fprintf(f_obj, "\n");
-    }
+        b.put("usemtl color_");
+        b.put_int(color_map.at(colors.at(fid)));
+        b.put("\nf ");
+        for(uint vid : poly.at(fid)) { b.put_int(vid+1); b.put(' '); }
+        b.put('\n');
+    });
 
     fclose(f_obj);
     fclose(f_mtl);
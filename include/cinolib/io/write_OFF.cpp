@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_OFF.h>
+#include <cinolib/io/text_buffer.h>
 
 
 #include <iostream>
@@ -47,8 +48,6 @@ void write_OFF(const char                * filename,
               const std::vector<uint>  & tri,
               const std::vector<uint>  & quad)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
     FILE *fp = fopen(filename, "w");
 
     if(!fp)
@@ -60,22 +59,31 @@ void write_OFF(const char                * filename,
     int n_poly = tri.size()/3 + quad.size()/4;
     fprintf (fp, "OFF\n%zu %d 0\n", xyz.size()/3, n_poly);
 
-    for(size_t i=0; i<xyz.size(); i+=3)
+    // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
+    //
+    write_parallel(fp, xyz.size()/3, [&](const size_t i, TextBuffer & b)
     {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        //
-        fprintf(fp, "%.17g %.17g %.17g\n", xyz[i], xyz[i+1], xyz[i+2]);
-    }
+        b.put_double(xyz[3*i  ]); b.put(' ');
+        b.put_double(xyz[3*i+1]); b.put(' ');
+        b.put_double(xyz[3*i+2]); b.put('\n');
+    });
 
-    for(size_t i=0; i<tri.size(); i+=3)
+    write_parallel(fp, tri.size()/3, [&](const size_t i, TextBuffer & b)
     {
-        fprintf(fp, "3 %d %d %d\n", tri[i], tri[i+1], tri[i+2]);
-    }
+        b.put("3 ");
+        b.put_int(tri[3*i  ]); b.put(' ');
+        b.put_int(tri[3*i+1]); b.put(' ');
+        b.put_int(tri[3*i+2]); b.put('\n');
+    });
 
-    for(size_t i=0; i<quad.size(); i+=4)
+    write_parallel(fp, quad.size()/4, [&](const size_t i, TextBuffer & b)
     {
-        fprintf(fp, "4 %d %d %d %d\n", quad[i], quad[i+1], quad[i+2], quad[i+3]);
-    }
+        b.put("4 ");
+        b.put_int(quad[4*i  ]); b.put(' ');
+        b.put_int(quad[4*i+1]); b.put(' ');
+        b.put_int(quad[4*i+2]); b.put(' ');
+        b.put_int(quad[4*i+3]); b.put('\n');
+    });
 
     fclose(fp);
 }
@@ -87,8 +95,6 @@ void write_OFF(const char                           * filename,
                const std::vector<double>            & xyz,
                const std::vector<std::vector<uint>> & faces)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
     FILE *fp = fopen(filename, "w");
 
     if(!fp)
@@ -100,22 +106,22 @@ void write_OFF(const char                           * filename,
     uint n_faces = faces.size();
     fprintf (fp, "OFF\n%zu %d 0\n", xyz.size()/3, n_faces);
 
-    for(uint i=0; i<xyz.size(); i+=3)
+    // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
+    //
+    write_parallel(fp, xyz.size()/3, [&](const size_t i, TextBuffer & b)
     {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        //
-        fprintf(fp, "%.17g %.17g %.17g\n", xyz[i], xyz[i+1], xyz[i+2]);
-    }
+        b.put_double(xyz[3*i  ]); b.put(' ');
+        b.put_double(xyz[3*i+1]); b.put(' ');
+        b.put_double(xyz[3*i+2]); b.put('\n');
+    });
 
-    for(uint i=0; i<faces.size(); ++i)
+    write_parallel(fp, faces.size(), [&](const size_t i, TextBuffer & b)
     {
-        fprintf(fp, "%d ", static_cast<int>(faces.at(i).size()));
-        for(uint j=0; j<faces.at(i).size(); ++j)
-        {
-            fprintf(fp, "%d ", faces.at(i).at(j));
-        }
-        fprintf(fp, "\n");
-    }
+        b.put_int(static_cast<int>(faces.at(i).size()));
+        b.put(' ');
+        for(uint vid : faces.at(i)) { b.put_int(vid); b.put(' '); }
+        b.put('\n');
+    });
 
     fclose(fp);
 }
@@ -0,0 +1,192 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/write_PLY.h>
+#include <cinolib/io/text_buffer.h>
+#include <cinolib/io/cino_format.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace cinolib
+{
+
+CINO_INLINE
+void write_PLY(const char                           * filename,
+               const std::vector<double>            & xyz,
+               const std::vector<std::vector<uint>> & polys,
+               const bool                             binary)
+{
+    write_PLY(filename, xyz, polys, {}, {}, 0, 0, binary);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_PLY(const char                                * filename,
+               const std::vector<double>                 & xyz,
+               const std::vector<std::vector<uint>>      & polys,
+               const std::vector<Vert_std_attributes>    & vert_attr,
+               const std::vector<Polygon_std_attributes> & poly_attr,
+               const int                                   vert_props,
+               const int                                   poly_props,
+               const bool                                  binary)
+{
+    uint nv = xyz.size()/3;
+    uint np = polys.size();
+    assert(vert_props==0 || vert_attr.size()==nv);
+    assert(poly_props==0 || poly_attr.size()==np);
+
+    FILE *fp = fopen(filename, binary ? "wb" : "w");
+
+    if(!fp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_PLY() : couldn't write output file " << filename << std::endl;
+        exit(-1);
+    }
+
+    size_t max_poly = 0;
+    for(const auto & p : polys) max_poly = std::max(max_poly, p.size());
+    bool short_lists = (max_poly < 256);
+
+    fprintf(fp, "ply\n");
+    if(!binary) fprintf(fp, "format ascii 1.0\n"); else
+    fprintf(fp, host_is_little_endian() ? "format binary_little_endian 1.0\n" : "format binary_big_endian 1.0\n");
+    fprintf(fp, "comment written by cinolib\n");
+    fprintf(fp, "element vertex %u\n", nv);
+    fprintf(fp, "property double x\nproperty double y\nproperty double z\n");
+    if(vert_props & PLY_NORMALS) fprintf(fp, "property float nx\nproperty float ny\nproperty float nz\n");
+    if(vert_props & PLY_COLORS ) fprintf(fp, "property uchar red\nproperty uchar green\nproperty uchar blue\nproperty uchar alpha\n");
+    if(vert_props & PLY_UVW    ) fprintf(fp, "property float u\nproperty float v\n");
+    if(vert_props & PLY_LABELS ) fprintf(fp, "property int label\n");
+    if(vert_props & PLY_QUALITY) fprintf(fp, "property float quality\n");
+    fprintf(fp, "element face %u\n", np);
+    fprintf(fp, short_lists ? "property list uchar int vertex_indices\n" : "property list int int vertex_indices\n");
+    if(poly_props & PLY_COLORS ) fprintf(fp, "property uchar red\nproperty uchar green\nproperty uchar blue\nproperty uchar alpha\n");
+    if(poly_props & PLY_LABELS ) fprintf(fp, "property int label\n");
+    if(poly_props & PLY_QUALITY) fprintf(fp, "property float quality\n");
+    fprintf(fp, "end_header\n");
+
+    auto to_uchar = [](const float c) { return static_cast<uint8_t>(std::min(std::max(c,0.f),1.f)*255.f + 0.5f); };
+
+    if(binary)
+    {
+        write_parallel(fp, nv, [&](const size_t vid, TextBuffer & b)
+        {
+            b.put(&xyz[3*vid], 24);
+            if(vert_props & PLY_NORMALS)
+            {
+                const vec3d & n = vert_attr[vid].normal;
+                float nf[] = { float(n.x()), float(n.y()), float(n.z()) };
+                b.put(nf, 12);
+            }
+            if(vert_props & PLY_COLORS)
+            {
+                const Color & c = vert_attr[vid].color;
+                uint8_t rgba[] = { to_uchar(c.r), to_uchar(c.g), to_uchar(c.b), to_uchar(c.a) };
+                b.put(rgba, 4);
+            }
+            if(vert_props & PLY_UVW)
+            {
+                float uv[] = { float(vert_attr[vid].uvw.x()), float(vert_attr[vid].uvw.y()) };
+                b.put(uv, 8);
+            }
+            if(vert_props & PLY_LABELS ) { int32_t l = vert_attr[vid].label;   b.put(&l, 4); }
+            if(vert_props & PLY_QUALITY) { float   q = vert_attr[vid].quality; b.put(&q, 4); }
+        });
+
+        write_parallel(fp, np, [&](const size_t pid, TextBuffer & b)
+        {
+            if(short_lists) { uint8_t n = polys[pid].size(); b.put(&n, 1); }
+            else            { int32_t n = polys[pid].size(); b.put(&n, 4); }
+            for(uint vid : polys[pid]) { int32_t v = vid; b.put(&v, 4); }
+            if(poly_props & PLY_COLORS)
+            {
+                const Color & c = poly_attr[pid].color;
+                uint8_t rgba[] = { to_uchar(c.r), to_uchar(c.g), to_uchar(c.b), to_uchar(c.a) };
+                b.put(rgba, 4);
+            }
+            if(poly_props & PLY_LABELS ) { int32_t l = poly_attr[pid].label;   b.put(&l, 4); }
+            if(poly_props & PLY_QUALITY) { float   q = poly_attr[pid].quality; b.put(&q, 4); }
+        });
+    }
+    else
+    {
+        auto put_color = [&](TextBuffer & b, const Color & c)
+        {
+            b.put(' '); b.put_int(to_uchar(c.r));
+            b.put(' '); b.put_int(to_uchar(c.g));
+            b.put(' '); b.put_int(to_uchar(c.b));
+            b.put(' '); b.put_int(to_uchar(c.a));
+        };
+
+        write_parallel(fp, nv, [&](const size_t vid, TextBuffer & b)
+        {
+            b.put_double(xyz[3*vid  ]); b.put(' ');
+            b.put_double(xyz[3*vid+1]); b.put(' ');
+            b.put_double(xyz[3*vid+2]);
+            if(vert_props & PLY_NORMALS)
+            {
+                const vec3d & n = vert_attr[vid].normal;
+                b.put(' '); b.put_double(float(n.x()));
+                b.put(' '); b.put_double(float(n.y()));
+                b.put(' '); b.put_double(float(n.z()));
+            }
+            if(vert_props & PLY_COLORS) put_color(b, vert_attr[vid].color);
+            if(vert_props & PLY_UVW)
+            {
+                b.put(' '); b.put_double(float(vert_attr[vid].uvw.x()));
+                b.put(' '); b.put_double(float(vert_attr[vid].uvw.y()));
+            }
+            if(vert_props & PLY_LABELS ) { b.put(' '); b.put_int(vert_attr[vid].label);      }
+            if(vert_props & PLY_QUALITY) { b.put(' '); b.put_double(vert_attr[vid].quality); }
+            b.put('\n');
+        });
+
+        write_parallel(fp, np, [&](const size_t pid, TextBuffer & b)
+        {
+            b.put_int(polys[pid].size());
+            for(uint vid : polys[pid]) { b.put(' '); b.put_int(vid); }
+            if(poly_props & PLY_COLORS) put_color(b, poly_attr[pid].color);
+            if(poly_props & PLY_LABELS ) { b.put(' '); b.put_int(poly_attr[pid].label);      }
+            if(poly_props & PLY_QUALITY) { b.put(' '); b.put_double(poly_attr[pid].quality); }
+            b.put('\n');
+        });
+    }
+
+    fclose(fp);
+}
+
+}
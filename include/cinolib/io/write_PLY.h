@@ -0,0 +1,79 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_WRITE_PLY_H
+#define CINO_WRITE_PLY_H
+
+#include <sys/types.h>
+#include <vector>
+#include <cinolib/cino_inline.h>
+#include <cinolib/meshes/mesh_attributes.h>
+#include <cinolib/io/ply_format.h>
+
+namespace cinolib
+{
+
+/* PLY writer. Binary files are written in the byte order of the host.
+ * Coordinates are stored as doubles (so that binary files are lossless),
+ * normals, uv coordinates and quality as floats, colors as uchar and
+ * labels as int. vert_props and poly_props (PLY_* flags) select which of
+ * the attributes in vert_attr and poly_attr are written.
+*/
+
+CINO_INLINE
+void write_PLY(const char                                * filename,
+               const std::vector<double>                 & xyz,
+               const std::vector<std::vector<uint>>      & polys,
+               const std::vector<Vert_std_attributes>    & vert_attr,
+               const std::vector<Polygon_std_attributes> & poly_attr,
+               const int                                   vert_props,
+               const int                                   poly_props,
+               const bool                                  binary = true);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_PLY(const char                           * filename,
+               const std::vector<double>            & xyz,
+               const std::vector<std::vector<uint>> & polys,
+               const bool                             binary = true);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "write_PLY.cpp"
+#endif
+
+#endif // CINO_WRITE_PLY_H
@@ -0,0 +1,132 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/write_STL.h>
+#include <cinolib/io/text_buffer.h>
+#include <cinolib/io/cino_format.h>
+#include <cinolib/geometry/vec3.h>
+#include <cstring>
+#include <iostream>
+
+namespace cinolib
+{
+
+CINO_INLINE
+void write_STL(const char                           * filename,
+               const std::vector<double>            & xyz,
+               const std::vector<std::vector<uint>> & polys,
+               const bool                             binary)
+{
+    FILE *fp = fopen(filename, binary ? "wb" : "w");
+
+    if(!fp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_STL() : couldn't write output file " << filename << std::endl;
+        exit(-1);
+    }
+
+    // triangle fans
+    std::vector<uint> tris;
+    for(const auto & p : polys)
+    for(uint i=2; i<p.size(); ++i)
+    {
+        tris.push_back(p[0]);
+        tris.push_back(p[i-1]);
+        tris.push_back(p[i]);
+    }
+    uint32_t n_tris = tris.size()/3;
+
+    auto vert = [&](const uint vid) { return vec3d(xyz[3*vid], xyz[3*vid+1], xyz[3*vid+2]); };
+    auto normal = [&](const uint tid)
+    {
+        vec3d n = (vert(tris[3*tid+1]) - vert(tris[3*tid])).cross(vert(tris[3*tid+2]) - vert(tris[3*tid]));
+        n.normalize();
+        return n;
+    };
+
+    if(binary)
+    {
+        char header[80];
+        memset(header, 0, 80);
+        strcpy(header, "binary STL written by cinolib");
+        uint32_t n = n_tris;
+        if(!host_is_little_endian()) swap_byte_order(&n, 4, 1);
+        fwrite(header, 1, 80, fp);
+        fwrite(&n, 4, 1, fp);
+
+        write_parallel(fp, n_tris, [&](const size_t tid, TextBuffer & b)
+        {
+            vec3d n = normal(tid);
+            float v[12] = { float(n.x()), float(n.y()), float(n.z()) };
+            for(uint i=0; i<3; ++i)
+            {
+                vec3d p = vert(tris[3*tid+i]);
+                v[3+3*i] = p.x();
+                v[4+3*i] = p.y();
+                v[5+3*i] = p.z();
+            }
+            if(!host_is_little_endian()) swap_byte_order(v, 4, 12);
+            uint16_t attr = 0;
+            b.put(v, 48);
+            b.put(&attr, 2);
+        });
+    }
+    else
+    {
+        fprintf(fp, "solid cinolib\n");
+        write_parallel(fp, n_tris, [&](const size_t tid, TextBuffer & b)
+        {
+            vec3d n = normal(tid);
+            b.put("facet normal ");
+            b.put_double(n.x()); b.put(' ');
+            b.put_double(n.y()); b.put(' ');
+            b.put_double(n.z()); b.put("\nouter loop\n");
+            for(uint i=0; i<3; ++i)
+            {
+                vec3d p = vert(tris[3*tid+i]);
+                b.put("vertex ");
+                b.put_double(p.x()); b.put(' ');
+                b.put_double(p.y()); b.put(' ');
+                b.put_double(p.z()); b.put('\n');
+            }
+            b.put("endloop\nendfacet\n");
+        });
+        fprintf(fp, "endsolid cinolib\n");
+    }
+
+    fclose(fp);
+}
+
+}
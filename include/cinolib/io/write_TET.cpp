@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_TET.h>
+#include <cinolib/io/text_buffer.h>
 
 
 #include <iostream>
@@ -46,8 +47,6 @@ void write_TET(const char                           * filename,
                const std::vector<vec3d>             & verts,
                const std::vector<std::vector<uint>> & tets)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
     FILE *fp = fopen(filename, "w");
 
     if(!fp)
@@ -59,17 +58,24 @@ void write_TET(const char                           * filename,
     fprintf(fp, "%d vertices\n", (int)verts.size());
     fprintf(fp, "%d tets\n",     (int)tets.size());
 
-    for(const vec3d & v : verts)
+    // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
+    //
+    write_parallel(fp, verts.size(), [&](const size_t vid, TextBuffer & b)
     {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        //
-        fprintf(fp, "%.17g %.17g %.17g\n", v.x(), v.y(), v.z());
-    }
+        b.put_double(verts[vid].x()); b.put(' ');
+        b.put_double(verts[vid].y()); b.put(' ');
+        b.put_double(verts[vid].z()); b.put('\n');
+    });
 
-    for(const std::vector<uint> & tet : tets)
+    write_parallel(fp, tets.size(), [&](const size_t pid, TextBuffer & b)
     {
-        fprintf(fp, "4 %d %d %d %d\n", tet.at(0), tet.at(1), tet.at(2), tet.at(3));
-    }
+        const std::vector<uint> & tet = tets[pid];
+        b.put("4 ");
+        b.put_int(tet.at(0)); b.put(' ');
+        b.put_int(tet.at(1)); b.put(' ');
+        b.put_int(tet.at(2)); b.put(' ');
+        b.put_int(tet.at(3)); b.put('\n');
+    });
 
     fclose(fp);
 }
@@ -81,8 +87,6 @@ void write_TET(const char                * filename,
                const std::vector<double> & xyz,
                const std::vector<uint>   & tets)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
     FILE *fp = fopen(filename, "w");
 
     if(!fp)
@@ -99,20 +103,26 @@ void write_TET(const char                * filename,
 
     if (nv > 0)
     {
-        for(size_t i=0; i<xyz.size(); i+=3)
+        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
+        //
+        write_parallel(fp, nv, [&](const size_t i, TextBuffer & b)
         {
-            // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-            //
-            fprintf(fp, "%.17g %.17g %.17g\n", xyz[i], xyz[i+1], xyz[i+2]);
-        }
+            b.put_double(xyz[3*i  ]); b.put(' ');
+            b.put_double(xyz[3*i+1]); b.put(' ');
+            b.put_double(xyz[3*i+2]); b.put('\n');
+        });
     }
 
     if (nt > 0)
     {
-        for(size_t i=0; i<tets.size(); i+=4)
+        write_parallel(fp, nt, [&](const size_t i, TextBuffer & b)
         {
-            fprintf(fp, "4 %d %d %d %d\n", tets[i+0], tets[i+3], tets[i+2], tets[i+1]);
-        }
+            b.put("4 ");
+            b.put_int(tets[4*i  ]); b.put(' ');
+            b.put_int(tets[4*i+3]); b.put(' ');
+            b.put_int(tets[4*i+2]); b.put(' ');
+            b.put_int(tets[4*i+1]); b.put('\n');
+        });
     }
 
     fclose(fp);
@@ -34,165 +34,222 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_VTK.h>
-
-
-#ifdef CINOLIB_USES_VTK
-#include <vtkSmartPointer.h>
-#include <vtkCell.h>
-#include <vtkCellData.h>
-#include <vtkIntArray.h>
-#include <vtkUnstructuredGrid.h>
-#include <vtkUnstructuredGridWriter.h>
-#endif
+#include <cinolib/io/text_buffer.h>
+#include <cinolib/io/cino_format.h>
+#include <cinolib/io/fast_number_parsing.h>
+#include <iostream>
+#include <stdint.h>
+#include <string>
 
 namespace cinolib
 {
 
-#ifdef CINOLIB_USES_VTK
-
+// appends a value, either as big endian Int32/Float64 or as text followed by sep
 CINO_INLINE
-void write_VTK(const char                           * filename,
-               const std::vector<vec3d>             & verts,
-               const std::vector<std::vector<uint>> & polys)
+void vtk_legacy_put(      TextBuffer & buf,
+                    const bool         binary,
+                    const bool         integer,
+                    const double       value,
+                    const char         sep)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
-    vtkSmartPointer<vtkUnstructuredGridWriter> writer = vtkSmartPointer<vtkUnstructuredGridWriter>::New();
-    vtkSmartPointer<vtkUnstructuredGrid>       grid   = vtkSmartPointer<vtkUnstructuredGrid>::New();
-    vtkSmartPointer<vtkPoints>                 points = vtkSmartPointer<vtkPoints>::New();
-
-    // generate some arrays that allow each element type to be viewed alone by thresholding
-    //
-    vtkSmartPointer<vtkIntArray> tetselector = vtkSmartPointer<vtkIntArray>::New();
-    vtkSmartPointer<vtkIntArray> hexselector = vtkSmartPointer<vtkIntArray>::New();
-    tetselector->SetName("tet_selector");
-    hexselector->SetName("hex_selector");
-
-    for(const vec3d & v : verts)
+    if(binary)
     {
-        points->InsertNextPoint(v.x(), v.y(), v.z());
-    }
-
-    bool has_tets = false;
-    bool has_hexa = false;
-
-    for(auto p : polys)
-    {
-        switch (p.size())
+        bool swap = host_is_little_endian();
+        if(integer)
+        {
+            int32_t v = static_cast<int32_t>(value);
+            if(swap) swap_byte_order(&v, 4, 1);
+            buf.put(&v, 4);
+        }
+        else
         {
-            case 4:
-            {
-                vtkIdType pid[] = { p.at(0), p.at(1), p.at(2), p.at(3) };
-                grid->InsertNextCell(VTK_TETRA, 4, pid);
-                tetselector->InsertNextValue(1);
-                hexselector->InsertNextValue(0);
-                has_tets = true;
-                break;
-            }
-
-            case 8:
-            {
-                vtkIdType pid[] = { p.at(0), p.at(1), p.at(2), p.at(3),
-                                    p.at(4), p.at(5), p.at(6), p.at(7) };
-                grid->InsertNextCell(VTK_HEXAHEDRON, 8, pid);
-                tetselector->InsertNextValue(0);
-                hexselector->InsertNextValue(1);
-                has_hexa = true;
-                break;
-            }
-
-            default: assert(false && "Unsupported Polyhedron!");
+            double v = value;
+            if(swap) swap_byte_order(&v, 8, 1);
+            buf.put(&v, 8);
         }
+        return;
     }
-
-    grid->SetPoints(points);
-    if (has_tets) grid->GetCellData()->AddArray(tetselector);
-    if (has_hexa) grid->GetCellData()->AddArray(hexselector);
-
-#if VTK_MAJOR_VERSION < 6
-    writer->SetInput( grid );
-#else
-    writer->SetInputData(grid);
-#endif
-    writer->SetFileName(filename);
-    writer->Write();
+    if(integer) buf.put_int(static_cast<int>(value));
+    else        buf.put_double(value);
+    buf.put(sep);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// writes n values (value(i) for each i), per_line values per row in ASCII
+template<typename Func>
 CINO_INLINE
-void write_VTK(const char                * filename,
-               const std::vector<double> & xyz,
-               const std::vector<uint>   & tets,
-               const std::vector<uint>   & hexa)
+void vtk_legacy_write(      FILE   * fp,
+                      const bool     binary,
+                      const bool     integer,
+                      const size_t   n,
+                      const size_t   per_line,
+                      const Func   & value)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    write_parallel(fp, n, [&](const size_t i, TextBuffer & buf)
+    {
+        vtk_legacy_put(buf, binary, integer, value(i), ((i+1)%per_line==0 || i+1==n) ? '\n' : ' ');
+    });
+    if(binary) fputc('\n', fp);
+}
 
-    vtkSmartPointer<vtkUnstructuredGridWriter> writer = vtkSmartPointer<vtkUnstructuredGridWriter>::New();
-    vtkSmartPointer<vtkUnstructuredGrid>       grid   = vtkSmartPointer<vtkUnstructuredGrid>::New();
-    vtkSmartPointer<vtkPoints>                 points = vtkSmartPointer<vtkPoints>::New();
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    // write the vertex coordinates
-    //
-    for(size_t i=0; i<xyz.size(); i+=3)
+CINO_INLINE
+void vtk_legacy_write_arrays(      FILE                      * fp,
+                             const bool                        binary,
+                             const char                      * kw,
+                             const size_t                      n,
+                             const std::vector<VTKDataArray> & arrays)
+{
+    if(arrays.empty()) return;
+    fprintf(fp, "%s %zu\nFIELD FieldData %zu\n", kw, n, arrays.size());
+    for(const VTKDataArray & a : arrays)
     {
-        points->InsertNextPoint(xyz[i+0], xyz[i+1], xyz[i+2]);
+        std::string name = a.name.empty() ? "unnamed" : a.name;
+        for(char & c : name) if(is_space(c)) c = '_';
+        fprintf(fp, "%s %u %zu %s\n", name.c_str(), a.components, n, a.integer ? "int" : "double");
+        vtk_legacy_write(fp, binary, a.integer, a.values.size(), a.components, [&](const size_t i) { return a.values[i]; });
     }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    // write the tetrahedra
-    //
-    for(size_t i=0; i<tets.size(); i+=4)
+CINO_INLINE
+void write_VTK(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & cells,
+               const std::vector<uint>              & cell_types,
+               const std::vector<VTKDataArray>      & point_data,
+               const std::vector<VTKDataArray>      & cell_data,
+               const bool                             binary)
+{
+    for(const VTKDataArray & a : point_data)
     {
-        vtkIdType pid[] = { tets[i+0], tets[i+1], tets[i+2], tets[i+3] };
-        grid->InsertNextCell(VTK_TETRA, 4, pid);
+        if(a.values.size()!=verts.size()*a.components)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_VTK() : bad size of point data array " << a.name << std::endl;
+            return;
+        }
+    }
+    for(const VTKDataArray & a : cell_data)
+    {
+        if(a.values.size()!=cells.size()*a.components)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_VTK() : bad size of cell data array " << a.name << std::endl;
+            return;
+        }
+    }
+    if(!vtk_cells_are_valid(cells, cell_types, verts.size()))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_VTK() : invalid cells" << std::endl;
+        return;
     }
 
-    // write the hexahedra
-    //
-    for(size_t i=0; i<hexa.size(); i+=8 )
+    FILE *fp = fopen(filename, "wb");
+    if(!fp)
     {
-        vtkIdType pid[] = { hexa[i+0], hexa[i+1], hexa[i+2], hexa[i+3],
-                            hexa[i+4], hexa[i+5], hexa[i+6], hexa[i+7] };
-        grid->InsertNextCell(VTK_HEXAHEDRON, 8, pid);
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_VTK() : couldn't open output file " << filename << std::endl;
+        exit(-1);
     }
 
-    // create the output mesh
-    //
-    grid->SetPoints(points);
-
-#if VTK_MAJOR_VERSION < 6
-    writer->SetInput(grid);
-#else
-    writer->SetInputData(grid);
-#endif
-    writer->SetFileName(filename);
-    writer->Write();
+    fprintf(fp, "# vtk DataFile Version 3.0\n");
+    fprintf(fp, "written by cinolib\n");
+    fprintf(fp, "%s\n", binary ? "BINARY" : "ASCII");
+    fprintf(fp, "DATASET UNSTRUCTURED_GRID\n");
+
+    fprintf(fp, "POINTS %zu double\n", verts.size());
+    vtk_legacy_write(fp, binary, false, 3*verts.size(), 3, [&](const size_t i) { return verts[i/3][i%3]; });
+
+    // classic layout: each cell is preceded by its size
+    size_t size = 0;
+    for(const std::vector<uint> & c : cells) size += c.size()+1;
+    fprintf(fp, "CELLS %zu %zu\n", cells.size(), size);
+    write_parallel(fp, cells.size(), [&](const size_t cid, TextBuffer & buf)
+    {
+        const std::vector<uint> & c = cells[cid];
+        vtk_legacy_put(buf, binary, true, c.size(), c.empty() ? '\n' : ' ');
+        for(size_t i=0; i<c.size(); ++i) vtk_legacy_put(buf, binary, true, c[i], (i+1==c.size()) ? '\n' : ' ');
+    });
+    if(binary) fputc('\n', fp);
+
+    fprintf(fp, "CELL_TYPES %zu\n", cell_types.size());
+    vtk_legacy_write(fp, binary, true, cell_types.size(), 1, [&](const size_t i) { return cell_types[i]; });
+
+    vtk_legacy_write_arrays(fp, binary, "CELL_DATA",  cells.size(), cell_data);
+    vtk_legacy_write_arrays(fp, binary, "POINT_DATA", verts.size(), point_data);
+
+    fclose(fp);
 }
 
-#else
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void write_VTK(const char                *,
-               const std::vector<double> &,
-               const std::vector<uint>   &,
-               const std::vector<uint>   &)
+void write_VTK(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & faces,
+               const std::vector<std::vector<uint>> & polys,
+               const std::vector<std::vector<bool>> & polys_face_winding)
 {
-    std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
+    std::vector<std::vector<uint>> cells;
+    std::vector<uint>              cell_types;
+    vtk_cells_from_polyhedra(faces, polys, polys_face_winding, cells, cell_types);
+    write_VTK(filename, verts, cells, cell_types, {}, {});
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_VTK(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & polys,
+               const std::vector<int>               & vert_labels,
+               const std::vector<int>               & poly_labels)
+{
+    std::vector<std::vector<uint>> cells;
+    std::vector<uint>              cell_types;
+    std::vector<VTKDataArray>      point_data, cell_data;
+    vtk_cells_from_polys(polys, cells, cell_types);
+    vtk_add_labels(vert_labels, "label", point_data);
+    vtk_add_labels(poly_labels, "label", cell_data);
+    vtk_add_type_selectors(cell_types, cell_data);
+    write_VTK(filename, verts, cells, cell_types, point_data, cell_data);
+}
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void write_VTK(const char                           *,
-               const std::vector<vec3d>             &,
-               const std::vector<std::vector<uint>> &)
+void write_VTK(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & polys)
 {
-    std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
+    write_VTK(filename, verts, polys, std::vector<int>(), std::vector<int>());
 }
 
-#endif
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_VTK(const char                * filename,
+               const std::vector<double> & xyz,
+               const std::vector<uint>   & tets,
+               const std::vector<uint>   & hexa)
+{
+    std::vector<vec3d> verts(xyz.size()/3);
+    for(size_t vid=0; vid<verts.size(); ++vid) verts[vid] = vec3d(xyz[3*vid], xyz[3*vid+1], xyz[3*vid+2]);
+
+    std::vector<std::vector<uint>> cells;
+    std::vector<uint>              cell_types;
+    for(size_t i=0; i+3<tets.size(); i+=4)
+    {
+        cells.push_back(std::vector<uint>(tets.begin()+i, tets.begin()+i+4));
+        cell_types.push_back(VTK_CELL_TETRA);
+    }
+    for(size_t i=0; i+7<hexa.size(); i+=8)
+    {
+        cells.push_back(std::vector<uint>(hexa.begin()+i, hexa.begin()+i+8));
+        cell_types.push_back(VTK_CELL_HEXAHEDRON);
+    }
+    write_VTK(filename, verts, cells, cell_types, {}, {});
+}
 
 }
@@ -40,11 +40,29 @@
 #include <vector>
 #include <cinolib/cino_inline.h>
 #include <cinolib/geometry/vec3.h>
+#include <cinolib/io/vtk_format.h>
 
 
 namespace cinolib
 {
 
+/* Native writer for legacy VTK unstructured grids (no dependency on VTK).
+ * Cells are given as explained in vtk_format.h. Binary files (big endian,
+ * as mandated by the format) are the default. Data arrays are written as
+ * FIELD arrays, with names sanitized (white spaces are not allowed).
+*/
+
+CINO_INLINE
+void write_VTK(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & cells,
+               const std::vector<uint>              & cell_types,
+               const std::vector<VTKDataArray>      & point_data,
+               const std::vector<VTKDataArray>      & cell_data,
+               const bool                             binary = true);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 CINO_INLINE
 void write_VTK(const char                * filename,
                const std::vector<double> & xyz,
@@ -54,6 +72,27 @@ void write_VTK(const char                * filename,
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// general polyhedra
+CINO_INLINE
+void write_VTK(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & faces,
+               const std::vector<std::vector<uint>> & polys,
+               const std::vector<std::vector<bool>> & polys_face_winding);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// tets and hexes. Non empty labels are written as point/cell arrays called "label"
+CINO_INLINE
+void write_VTK(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & polys,
+               const std::vector<int>               & vert_labels,
+               const std::vector<int>               & poly_labels);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// tets and hexes
 CINO_INLINE
 void write_VTK(const char                           * filename,
                const std::vector<vec3d>             & verts,
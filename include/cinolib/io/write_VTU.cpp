@@ -34,179 +34,273 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_VTU.h>
-
-
-#ifdef CINOLIB_USES_VTK
-#include <vtkSmartPointer.h>
-#include <vtkCell.h>
-#include <vtkCellData.h>
-#include <vtkIntArray.h>
-#include <vtkUnstructuredGrid.h>
-#include <vtkXMLUnstructuredGridWriter.h>
-#endif
+#include <cinolib/io/text_buffer.h>
+#include <cinolib/io/cino_format.h>
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <stdint.h>
+#include <string>
 
 namespace cinolib
 {
 
-#ifdef CINOLIB_USES_VTK
+// an array to be written: n values, returned by value(i)
+struct VTUArray
+{
+    std::string                   tag;        // enclosing section
+    std::string                   name;
+    int                           type;       // VTK_VALUE_FLOAT64, INT64, INT32 or UINT8
+    uint                          components;
+    size_t                        n;
+    std::function<double(size_t)> value;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void write_VTU(const char                           * filename,
-               const std::vector<vec3d>             & verts,
-               const std::vector<std::vector<uint>> & polys)
+std::string vtk_xml_escape(const std::string & s)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
-    vtkSmartPointer<vtkXMLUnstructuredGridWriter> writer = vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
-    vtkSmartPointer<vtkUnstructuredGrid>          grid   = vtkSmartPointer<vtkUnstructuredGrid>::New();
-    vtkSmartPointer<vtkPoints>                    points = vtkSmartPointer<vtkPoints>::New();
+    std::string out;
+    for(char c : s)
+    {
+        switch(c)
+        {
+            case '&' : out += "&amp;";  break;
+            case '<' : out += "&lt;";   break;
+            case '>' : out += "&gt;";   break;
+            case '"' : out += "&quot;"; break;
+            default  : out += c;
+        }
+    }
+    return out;
+}
 
-    // generate some arrays that allow each element type to be viewed alone by thresholding
-    //
-    vtkSmartPointer<vtkIntArray> tetselector = vtkSmartPointer<vtkIntArray>::New();
-    vtkSmartPointer<vtkIntArray> hexselector = vtkSmartPointer<vtkIntArray>::New();
-    tetselector->SetName("tet_selector");
-    hexselector->SetName("hex_selector");
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    for(const vec3d & v : verts)
+CINO_INLINE
+void vtk_xml_put(TextBuffer & buf, const int type, const double value)
+{
+    switch(type)
     {
-        points->InsertNextPoint(v.x(), v.y(), v.z());
+        case VTK_VALUE_UINT8 : { uint8_t v = static_cast<uint8_t>(value); buf.put(&v, 1); break; }
+        case VTK_VALUE_INT32 : { int32_t v = static_cast<int32_t>(value); buf.put(&v, 4); break; }
+        case VTK_VALUE_INT64 : { int64_t v = static_cast<int64_t>(value); buf.put(&v, 8); break; }
+        default              : buf.put(&value, 8);
     }
+}
 
-    bool has_tets = false;
-    bool has_hexa = false;
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    for(auto p : polys)
+CINO_INLINE
+void write_VTU(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & cells,
+               const std::vector<uint>              & cell_types,
+               const std::vector<VTKDataArray>      & point_data,
+               const std::vector<VTKDataArray>      & cell_data,
+               const bool                             binary)
+{
+    for(const VTKDataArray & a : point_data)
     {
-        switch (p.size())
+        if(a.values.size()!=verts.size()*a.components)
         {
-            case 4:
-            {
-                vtkIdType pid[] = { p.at(0), p.at(1), p.at(2), p.at(3) };
-                grid->InsertNextCell(VTK_TETRA, 4, pid);
-                tetselector->InsertNextValue(1);
-                hexselector->InsertNextValue(0);
-                has_tets = true;
-                break;
-            }
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_VTU() : bad size of point data array " << a.name << std::endl;
+            return;
+        }
+    }
+    for(const VTKDataArray & a : cell_data)
+    {
+        if(a.values.size()!=cells.size()*a.components)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_VTU() : bad size of cell data array " << a.name << std::endl;
+            return;
+        }
+    }
+    if(!vtk_cells_are_valid(cells, cell_types, verts.size()))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_VTU() : invalid cells" << std::endl;
+        return;
+    }
 
-            case 8:
+    // the connectivity of a polyhedron lists its vertices (once), whereas
+    // its faces go to the faces/faceoffsets arrays
+    std::vector<int64_t> conn, offsets, faces, faceoffsets;
+    bool has_polyhedra = std::find(cell_types.begin(), cell_types.end(), (uint)VTK_CELL_POLYHEDRON)!=cell_types.end();
+    for(size_t cid=0; cid<cells.size(); ++cid)
+    {
+        const std::vector<uint> & c = cells.at(cid);
+        if(cell_types.at(cid)==VTK_CELL_POLYHEDRON)
+        {
+            std::vector<uint> vids;
+            size_t pos = 1;
+            for(uint i=0; i<c.front(); ++i)
             {
-                vtkIdType pid[] = { p.at(0), p.at(1), p.at(2), p.at(3),
-                                    p.at(4), p.at(5), p.at(6), p.at(7) };
-                grid->InsertNextCell(VTK_HEXAHEDRON, 8, pid);
-                tetselector->InsertNextValue(0);
-                hexselector->InsertNextValue(1);
-                has_hexa = true;
-                break;
+                size_t n = c.at(pos++);
+                for(size_t j=0; j<n; ++j, ++pos)
+                {
+                    if(std::find(vids.begin(), vids.end(), c.at(pos))==vids.end()) vids.push_back(c.at(pos));
+                }
             }
-
-            default: assert(false && "Unsupported Polyhedron!");
+            conn.insert(conn.end(), vids.begin(), vids.end());
+            faces.insert(faces.end(), c.begin(), c.end());
+            faceoffsets.push_back(faces.size());
         }
+        else
+        {
+            conn.insert(conn.end(), c.begin(), c.end());
+            if(has_polyhedra) faceoffsets.push_back(-1);
+        }
+        offsets.push_back(conn.size());
     }
 
-    grid->SetPoints(points);
-    if (has_tets) grid->GetCellData()->AddArray(tetselector);
-    if (has_hexa) grid->GetCellData()->AddArray(hexselector);
-
-#if VTK_MAJOR_VERSION < 6
-    writer->SetInput( grid );
-#else
-    writer->SetInputData(grid);
-#endif
-    writer->SetFileName(filename);
-    writer->Write();
-}
-
-//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+    std::vector<VTUArray> arrays;
+    for(const VTKDataArray & a : point_data)
+    {
+        arrays.push_back({"PointData", a.name, a.integer ? VTK_VALUE_INT32 : VTK_VALUE_FLOAT64, a.components, a.values.size(), [&a](const size_t i) { return a.values[i]; }});
+    }
+    for(const VTKDataArray & a : cell_data)
+    {
+        arrays.push_back({"CellData", a.name, a.integer ? VTK_VALUE_INT32 : VTK_VALUE_FLOAT64, a.components, a.values.size(), [&a](const size_t i) { return a.values[i]; }});
+    }
+    arrays.push_back({"Points", "Points",       VTK_VALUE_FLOAT64, 3, 3*verts.size(),    [&](const size_t i) { return verts[i/3][i%3]; }});
+    arrays.push_back({"Cells",  "connectivity", VTK_VALUE_INT64,   1, conn.size(),       [&](const size_t i) { return conn[i];         }});
+    arrays.push_back({"Cells",  "offsets",      VTK_VALUE_INT64,   1, offsets.size(),    [&](const size_t i) { return offsets[i];      }});
+    arrays.push_back({"Cells",  "types",        VTK_VALUE_UINT8,   1, cell_types.size(), [&](const size_t i) { return cell_types[i];   }});
+    if(has_polyhedra)
+    {
+        arrays.push_back({"Cells", "faces",       VTK_VALUE_INT64, 1, faces.size(),       [&](const size_t i) { return faces[i];       }});
+        arrays.push_back({"Cells", "faceoffsets", VTK_VALUE_INT64, 1, faceoffsets.size(), [&](const size_t i) { return faceoffsets[i]; }});
+    }
 
-CINO_INLINE
-void write_VTU(const char                * filename,
-               const std::vector<double> & xyz,
-               const std::vector<uint>   & tets,
-               const std::vector<uint>   & hexa)
-{
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
-    vtkSmartPointer<vtkXMLUnstructuredGridWriter> writer = vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
-    vtkSmartPointer<vtkUnstructuredGrid>          grid   = vtkSmartPointer<vtkUnstructuredGrid>::New();
-    vtkSmartPointer<vtkPoints>                    points = vtkSmartPointer<vtkPoints>::New();
-
-    // generate some arrays that allow each element type to be viewed alone by thresholding
-    //
-    vtkSmartPointer<vtkIntArray> tetselector = vtkSmartPointer<vtkIntArray>::New();
-    vtkSmartPointer<vtkIntArray> hexselector = vtkSmartPointer<vtkIntArray>::New();
-    tetselector->SetName("tet_selector");
-    hexselector->SetName("hex_selector");
-
-    // write the vertex coordinates
-    //
-    for(size_t i=0; i<xyz.size(); i+=3)
+    FILE *fp = fopen(filename, "wb");
+    if(!fp)
     {
-        points->InsertNextPoint(xyz[i+0], xyz[i+1], xyz[i+2]);
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_VTU() : couldn't open output file " << filename << std::endl;
+        exit(-1);
     }
 
-    // write the tetrahedra
-    //
-    for(size_t i=0; i<tets.size(); i+=4)
+    fprintf(fp, "<?xml version=\"1.0\"?>\n");
+    fprintf(fp, "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"%s\" header_type=\"UInt64\">\n", host_is_little_endian() ? "LittleEndian" : "BigEndian");
+    fprintf(fp, "  <UnstructuredGrid>\n");
+    fprintf(fp, "    <Piece NumberOfPoints=\"%zu\" NumberOfCells=\"%zu\">\n", verts.size(), cells.size());
+
+    static const char *sections[] = { "PointData", "CellData", "Points", "Cells" };
+    static const char *types[]    = { "", "UInt8", "", "", "Int32", "", "Int64", "", "", "Float64" };
+    uint64_t offset = 0;
+    for(const char *s : sections)
     {
-        vtkIdType pid[] = { tets[i+0], tets[i+1], tets[i+2], tets[i+3] };
-        grid->InsertNextCell(VTK_TETRA, 4, pid);
-        tetselector->InsertNextValue(1);
-        hexselector->InsertNextValue(0);
+        if(std::none_of(arrays.begin(), arrays.end(), [s](const VTUArray & a) { return a.tag==s; })) continue;
+        fprintf(fp, "      <%s>\n", s);
+        for(const VTUArray & a : arrays)
+        {
+            if(a.tag!=s) continue;
+            fprintf(fp, "        <DataArray type=\"%s\" Name=\"%s\" NumberOfComponents=\"%u\" format=\"%s\"",
+                    types[a.type], vtk_xml_escape(a.name).c_str(), a.components, binary ? "appended" : "ascii");
+            if(binary)
+            {
+                fprintf(fp, " offset=\"%llu\"/>\n", (unsigned long long)offset);
+                offset += sizeof(uint64_t) + a.n*vtk_value_size(a.type);
+                continue;
+            }
+            fprintf(fp, ">\n");
+            write_parallel(fp, a.n, [&](const size_t i, TextBuffer & buf)
+            {
+                buf.put_double(a.value(i));
+                buf.put(((i+1)%a.components==0 || i+1==a.n) ? '\n' : ' ');
+            });
+            fprintf(fp, "        </DataArray>\n");
+        }
+        fprintf(fp, "      </%s>\n", s);
     }
 
-    // write the hexahedra
-    //
-    for(size_t i=0; i<hexa.size(); i+=8 )
+    fprintf(fp, "    </Piece>\n");
+    fprintf(fp, "  </UnstructuredGrid>\n");
+
+    if(binary)
     {
-        vtkIdType pid[] = { hexa[i+0], hexa[i+1], hexa[i+2], hexa[i+3],
-                            hexa[i+4], hexa[i+5], hexa[i+6], hexa[i+7] };
-        grid->InsertNextCell(VTK_HEXAHEDRON, 8, pid);
-        tetselector->InsertNextValue(0);
-        hexselector->InsertNextValue(1);
+        fprintf(fp, "  <AppendedData encoding=\"raw\">\n   _");
+        for(const VTUArray & a : arrays)
+        {
+            uint64_t n_bytes = a.n*vtk_value_size(a.type);
+            fwrite(&n_bytes, sizeof(uint64_t), 1, fp);
+            write_parallel(fp, a.n, [&](const size_t i, TextBuffer & buf) { vtk_xml_put(buf, a.type, a.value(i)); });
+        }
+        fprintf(fp, "\n  </AppendedData>\n");
     }
 
-    // create the output mesh
-    //
-    grid->SetPoints(points);
+    fprintf(fp, "</VTKFile>\n");
+    fclose(fp);
+}
 
-    if (tets.size() > 0) grid->GetCellData()->AddArray(tetselector);
-    if (hexa.size() > 0) grid->GetCellData()->AddArray(hexselector);
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-#if VTK_MAJOR_VERSION < 6
-    writer->SetInput( grid );
-#else
-    writer->SetInputData(grid);
-#endif
-    writer->SetFileName(filename);
-    writer->Write();
+CINO_INLINE
+void write_VTU(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & faces,
+               const std::vector<std::vector<uint>> & polys,
+               const std::vector<std::vector<bool>> & polys_face_winding)
+{
+    std::vector<std::vector<uint>> cells;
+    std::vector<uint>              cell_types;
+    vtk_cells_from_polyhedra(faces, polys, polys_face_winding, cells, cell_types);
+    write_VTU(filename, verts, cells, cell_types, {}, {});
 }
 
-#else
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void write_VTU(const char                *,
-               const std::vector<double> &,
-               const std::vector<uint>   &,
-               const std::vector<uint>   &)
+void write_VTU(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & polys,
+               const std::vector<int>               & vert_labels,
+               const std::vector<int>               & poly_labels)
 {
-    std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
+    std::vector<std::vector<uint>> cells;
+    std::vector<uint>              cell_types;
+    std::vector<VTKDataArray>      point_data, cell_data;
+    vtk_cells_from_polys(polys, cells, cell_types);
+    vtk_add_labels(vert_labels, "label", point_data);
+    vtk_add_labels(poly_labels, "label", cell_data);
+    vtk_add_type_selectors(cell_types, cell_data);
+    write_VTU(filename, verts, cells, cell_types, point_data, cell_data);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void write_VTU(const char                           *,
-               const std::vector<vec3d>             &,
-               const std::vector<std::vector<uint>> &)
+void write_VTU(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & polys)
 {
-    std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
+    write_VTU(filename, verts, polys, std::vector<int>(), std::vector<int>());
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-#endif
+CINO_INLINE
+void write_VTU(const char                * filename,
+               const std::vector<double> & xyz,
+               const std::vector<uint>   & tets,
+               const std::vector<uint>   & hexa)
+{
+    std::vector<vec3d> verts(xyz.size()/3);
+    for(size_t vid=0; vid<verts.size(); ++vid) verts[vid] = vec3d(xyz[3*vid], xyz[3*vid+1], xyz[3*vid+2]);
+
+    std::vector<std::vector<uint>> cells;
+    std::vector<uint>              cell_types;
+    for(size_t i=0; i+3<tets.size(); i+=4)
+    {
+        cells.push_back(std::vector<uint>(tets.begin()+i, tets.begin()+i+4));
+        cell_types.push_back(VTK_CELL_TETRA);
+    }
+    for(size_t i=0; i+7<hexa.size(); i+=8)
+    {
+        cells.push_back(std::vector<uint>(hexa.begin()+i, hexa.begin()+i+8));
+        cell_types.push_back(VTK_CELL_HEXAHEDRON);
+    }
+    write_VTU(filename, verts, cells, cell_types, {}, {});
+}
 
 }
@@ -0,0 +1,257 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/iterative_solvers.h>
+#include <cinolib/parallel_linear_algebra.h>
+#include <cmath>
+#include <iostream>
+#include <assert.h>
+
+namespace cinolib
+{
+
+CINO_INLINE
+IterativeSolverStats conjugate_gradient(const LinearOperator  & A,
+                                        const Eigen::VectorXd & b,
+                                              Eigen::VectorXd & x,
+                                        const LinearOperator  & precond,
+                                        const double            tol,
+                                        const uint              max_iters)
+{
+    IterativeSolverStats stats;
+
+    if (x.rows() != b.rows()) x = Eigen::VectorXd::Zero(b.rows());
+
+    double b_norm = std::sqrt(parallel_dot(b,b));
+    if (b_norm == 0)
+    {
+        x.setZero();
+        stats.converged = true;
+        return stats;
+    }
+
+    Eigen::VectorXd r, z, p, Ap;
+    A(x, Ap);
+    r = b - Ap;
+
+    if (precond) precond(r, z); else z = r;
+    p = z;
+    double rz = parallel_dot(r,z);
+
+    stats.residual = std::sqrt(parallel_dot(r,r)) / b_norm;
+    while(stats.residual > tol && stats.iterations < max_iters)
+    {
+        A(p, Ap);
+        double pAp = parallel_dot(p,Ap);
+        if (pAp <= 0) break; // not positive definite (or breakdown)
+
+        double alpha = rz / pAp;
+        parallel_axpy( alpha, p,  x);
+        parallel_axpy(-alpha, Ap, r);
+        ++stats.iterations;
+
+        stats.residual = std::sqrt(parallel_dot(r,r)) / b_norm;
+        if (stats.residual <= tol) break;
+
+        if (precond) precond(r, z); else z = r;
+        double rz_new = parallel_dot(r,z);
+        double beta   = rz_new / rz;
+        rz = rz_new;
+        parallel_xpay(z, beta, p);
+    }
+
+    stats.converged = (stats.residual <= tol);
+    return stats;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+IterativeSolver::IterativeSolver(const int precond, const double tol, const uint max_iters)
+: precond(precond)
+, tol(tol)
+, max_iters(max_iters)
+{}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool IterativeSolver::compute(const Eigen::SparseMatrix<double> & A)
+{
+    assert(A.rows() == A.cols());
+    this->A = A;
+    this->A.makeCompressed();
+    A_op = nullptr;
+
+    active_precond = PRECOND_NONE;
+    switch(precond)
+    {
+        case PRECOND_NONE: break;
+
+        case PRECOND_JACOBI:
+        {
+            inv_diag = A.diagonal();
+            for(int i=0; i<inv_diag.rows(); ++i) inv_diag[i] = (inv_diag[i] != 0) ? 1.0/inv_diag[i] : 1.0;
+            break;
+        }
+
+        case PRECOND_INCOMPLETE_CHOLESKY:
+        {
+            ichol.compute(A);
+            if (ichol.info() != Eigen::Success)
+            {
+                std::cerr << "WARNING : Incomplete Cholesky failed" << std::endl;
+                return false;
+            }
+            break;
+        }
+
+        case PRECOND_AMG: mg.init_algebraic(A); break;
+
+        case PRECOND_GMG:
+        {
+            if (refinement_maps.empty())
+            {
+                std::cerr << "WARNING : no refinement maps for geometric multigrid" << std::endl;
+                return false;
+            }
+            mg.init_geometric(A, refinement_maps);
+            break;
+        }
+
+        default: assert(false && "Unknown preconditioner");
+    }
+    active_precond = precond;
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool IterativeSolver::compute(const Eigen::SparseMatrix<double>              & A,
+                              const std::vector<Eigen::SparseMatrix<double>> & refinement_maps)
+{
+    this->refinement_maps = refinement_maps;
+    int p = precond;
+    precond = PRECOND_GMG;
+    bool ok = compute(A);
+    precond = p;
+    return ok;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool IterativeSolver::compute(const LinearOperator  & A,
+                              const uint              n,
+                              const Eigen::VectorXd & diag)
+{
+    assert(A);
+    assert(diag.rows() == 0 || diag.rows() == n);
+    this->A.resize(0,0);
+    A_op = A;
+    n_op = n;
+
+    // the fallback only applies to this system: precond is left untouched,
+    // so that a later compute() with an assembled matrix gets what was asked
+    int pc = precond;
+    if (pc != PRECOND_NONE && pc != PRECOND_JACOBI)
+    {
+        pc = (diag.rows() > 0) ? PRECOND_JACOBI : PRECOND_NONE;
+        std::cerr << "WARNING : matrix-free CG only supports Jacobi preconditioning ("
+                  << ((pc == PRECOND_JACOBI) ? "using Jacobi" : "no preconditioner") << ")" << std::endl;
+    }
+
+    active_precond = PRECOND_NONE;
+    if (pc == PRECOND_JACOBI)
+    {
+        if (diag.rows() == 0)
+        {
+            std::cerr << "WARNING : Jacobi preconditioner requires the diagonal of the operator" << std::endl;
+            return false;
+        }
+        inv_diag = diag;
+        for(int i=0; i<inv_diag.rows(); ++i) inv_diag[i] = (inv_diag[i] != 0) ? 1.0/inv_diag[i] : 1.0;
+    }
+    active_precond = pc;
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+IterativeSolverStats IterativeSolver::solve(const Eigen::VectorXd & b,
+                                                  Eigen::VectorXd & x,
+                                            const bool              warm_start) const
+{
+    assert(b.rows() == (A_op ? (int)n_op : A.rows()));
+    if (!warm_start || x.rows() != b.rows()) x = Eigen::VectorXd::Zero(b.rows());
+
+    LinearOperator op = A_op;
+    if (!op) op = [this](const Eigen::VectorXd & v, Eigen::VectorXd & Av)
+    {
+        parallel_spmv_symmetric(A, v, Av);
+    };
+
+    LinearOperator pc = nullptr;
+    switch(active_precond)
+    {
+        case PRECOND_JACOBI:
+            pc = [this](const Eigen::VectorXd & r, Eigen::VectorXd & z) { z = inv_diag.cwiseProduct(r); };
+            break;
+
+        case PRECOND_INCOMPLETE_CHOLESKY:
+            pc = [this](const Eigen::VectorXd & r, Eigen::VectorXd & z) { z = ichol.solve(r); };
+            break;
+
+        case PRECOND_AMG:
+        case PRECOND_GMG:
+            pc = [this](const Eigen::VectorXd & r, Eigen::VectorXd & z) { z.setZero(r.rows()); mg.v_cycle(r, z); };
+            break;
+
+        default: break;
+    }
+
+    IterativeSolverStats stats = conjugate_gradient(op, b, x, pc, tol, max_iters);
+    if (!stats.converged)
+    {
+        std::cerr << "WARNING : CG did not converge (" << stats.iterations
+                  << " iterations, residual " << stats.residual << ")" << std::endl;
+    }
+    return stats;
+}
+
+}
@@ -0,0 +1,169 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_ITERATIVE_SOLVERS_H
+#define CINO_ITERATIVE_SOLVERS_H
+
+#include <functional>
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/multigrid.h>
+#include <Eigen/Sparse>
+#include <Eigen/Dense>
+
+namespace cinolib
+{
+
+/* Preconditioned Conjugate Gradient for symmetric positive definite systems.
+ * Iterative solvers need far less memory than sparse factorizations (which
+ * suffer from fill-in), and they scale to meshes with millions of elements,
+ * especially when a good initial guess is available (e.g. the solution of the
+ * previous time step, or of the previous frame in interactive applications).
+ *
+ * The system matrix can also be provided implicitly, as a function computing
+ * the product A*x (matrix-free). Available preconditioners are:
+ *
+ *  - Jacobi (diagonal scaling)
+ *  - Incomplete Cholesky (Eigen's IncompleteCholesky)
+ *  - Algebraic Multigrid (one V-cycle of smoothed aggregation AMG, see multigrid.h),
+ *    which makes the number of iterations nearly independent from mesh size
+ *  - Geometric Multigrid (one V-cycle on the hierarchy defined by the refinement
+ *    maps of a regularly refined mesh, see multigrid.h). Hierarchies are set with
+ *    compute(A, refinement_maps), and reused by subsequent calls to compute(A)
+ *
+ * Sparse matrix-vector products and vector updates are multi-threaded (see
+ * parallel_linear_algebra.h).
+*/
+
+enum
+{
+    PRECOND_NONE,
+    PRECOND_JACOBI,
+    PRECOND_INCOMPLETE_CHOLESKY,
+    PRECOND_AMG,
+    PRECOND_GMG,
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+typedef struct
+{
+    uint   iterations = 0;
+    double residual   = 0; // relative, i.e. |b - A x| / |b|
+    bool   converged  = false;
+}
+IterativeSolverStats;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+typedef std::function<void(const Eigen::VectorXd & x, Eigen::VectorXd & y)> LinearOperator; // y = op(x)
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Matrix-free PCG. If x has the right size it is used as initial guess.
+// The preconditioner (if any) must approximate y = A^-1 x
+CINO_INLINE
+IterativeSolverStats conjugate_gradient(const LinearOperator  & A,
+                                        const Eigen::VectorXd & b,
+                                              Eigen::VectorXd & x,
+                                        const LinearOperator  & precond   = nullptr,
+                                        const double            tol       = 1e-8,
+                                        const uint              max_iters = 1000);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class IterativeSolver
+{
+    public:
+
+        explicit IterativeSolver(const int    precond   = PRECOND_AMG,
+                                 const double tol       = 1e-8,
+                                 const uint   max_iters = 1000);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void set_preconditioner(const int    p) { precond   = p; }
+        void set_tolerance     (const double t) { tol       = t; }
+        void set_max_iterations(const uint   n) { max_iters = n; }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // stores A and sets up the preconditioner
+        bool compute(const Eigen::SparseMatrix<double> & A);
+
+        // matrix-free: stores the operator y = A*x (A is n x n) and sets up the
+        // preconditioner. Only PRECOND_NONE and PRECOND_JACOBI (which needs the
+        // diagonal of A) do not need an assembled matrix. For the others the
+        // solver falls back to Jacobi if the diagonal is given, or to no
+        // preconditioner at all otherwise (see laplacian_operator in laplacian.h)
+        bool compute(const LinearOperator  & A,
+                     const uint              n,
+                     const Eigen::VectorXd & diag = Eigen::VectorXd());
+
+        // stores A and sets up a geometric multigrid preconditioner (PRECOND_GMG)
+        bool compute(const Eigen::SparseMatrix<double>              & A,
+                     const std::vector<Eigen::SparseMatrix<double>> & refinement_maps);
+
+        // if warm_start is true, x is used as initial guess
+        IterativeSolverStats solve(const Eigen::VectorXd & b,
+                                         Eigen::VectorXd & x,
+                                   const bool              warm_start = false) const;
+
+        const Multigrid & multigrid() const { return mg; }
+
+    protected:
+
+        int    precond;
+        int    active_precond = PRECOND_NONE; // what the last compute() actually set up
+        double tol;
+        uint   max_iters;
+
+        Eigen::SparseMatrix<double>                   A;
+        LinearOperator                                A_op;    // matrix-free mode (if set, A is unused)
+        uint                                          n_op = 0;
+        Eigen::VectorXd                               inv_diag;
+        Eigen::IncompleteCholesky<double>             ichol;
+        Multigrid                                     mg;
+        std::vector<Eigen::SparseMatrix<double>>      refinement_maps;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "iterative_solvers.cpp"
+#endif
+
+#endif // CINO_ITERATIVE_SOLVERS_H
@@ -35,7 +35,9 @@
 *********************************************************************************/
 #include <cinolib/laplacian.h>
 #include <cinolib/symbols.h>
+#include <cinolib/parallel_for.h>
 #include <Eigen/Sparse>
+#include <memory>
 
 namespace cinolib
 {
@@ -134,4 +136,57 @@ Eigen::SparseMatrix<double> laplacian_3d(const AbstractMesh<M,V,E,P> & m, const
     return L;
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+LinearOperator laplacian_operator(const Trimesh<M,V,E,P> & m,
+                                 const int                mode,
+                                       Eigen::VectorXd  * diag)
+{
+    assert(mode == COTANGENT || mode == UNIFORM);
+
+    // shared, so that copies of the operator do not copy the weights
+    auto w = std::make_shared<std::vector<double>>(m.num_edges(), 1.0);
+    if (mode == COTANGENT)
+    {
+        PARALLEL_FOR(0, m.num_edges(), 1000, [&](const uint eid)
+        {
+            (*w)[eid] = m.edge_cotangent_weight(eid);
+        });
+    }
+
+    // same diagonal as laplacian(): minus the sum of the weights, or
+    // one for vertices with no (or null) incident weights
+    auto d = std::make_shared<std::vector<double>>(m.num_verts());
+    PARALLEL_FOR(0, m.num_verts(), 1000, [&](const uint vid)
+    {
+        double sum = 0.0;
+        for(uint eid : m.adj_v2e(vid)) sum -= (*w)[eid];
+        (*d)[vid] = (sum == 0.0) ? 1.0 : sum;
+    });
+
+    if (diag != nullptr)
+    {
+        diag->resize(m.num_verts());
+        for(uint vid=0; vid<m.num_verts(); ++vid) (*diag)[vid] = (*d)[vid];
+    }
+
+    const Trimesh<M,V,E,P> * mesh = &m;
+    return [mesh,w,d](const Eigen::VectorXd & x, Eigen::VectorXd & y)
+    {
+        assert(x.rows() == (int)mesh->num_verts());
+        y.resize(x.rows());
+        PARALLEL_FOR(0, mesh->num_verts(), 1000, [&](const uint vid)
+        {
+            double sum = (*d)[vid] * x[vid];
+            for(uint eid : mesh->adj_v2e(vid))
+            {
+                sum += (*w)[eid] * x[mesh->vert_opposite_to(eid,vid)];
+            }
+            y[vid] = sum;
+        });
+    };
+}
+
 }
@@ -37,6 +37,8 @@
 #define CINO_LAPLACIAN_H
 
 #include <cinolib/meshes/abstract_mesh.h>
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/iterative_solvers.h>
 #include <Eigen/Sparse>
 #include <vector>
 
@@ -71,6 +73,21 @@ std::vector<Eigen::Triplet<double>> laplacian_3d_matrix_entries(const AbstractMe
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// Matrix-free counterpart of laplacian(m,mode): returns an operator computing
+// y = L*x without assembling L. Only one weight per edge is stored, and the
+// product is computed in parallel by visiting the edges incident to each
+// vertex. The operator refers to the connectivity of m, which must therefore
+// outlive it and not change. If diag is not null it is filled with the
+// diagonal of L, e.g. for Jacobi preconditioning (see IterativeSolver). NOTE:
+// L is negative semi-definite: use -L (plus a mass term) with CG
+template<class M, class V, class E, class P>
+CINO_INLINE
+LinearOperator laplacian_operator(const Trimesh<M,V,E,P> & m,
+                                 const int                mode = COTANGENT,
+                                       Eigen::VectorXd  * diag = nullptr);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 }
 
 #ifndef  CINO_STATIC_LIB
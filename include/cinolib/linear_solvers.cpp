@@ -44,133 +44,323 @@ typedef Eigen::Triplet<double> Entry;
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void solve_square_system(const Eigen::SparseMatrix<double> & A,
-                         const Eigen::VectorXd             & b,
-                               Eigen::VectorXd             & x,
-                         int   solver)
+LinearSolver::LinearSolver(const int solver)
+{
+    set_solver(solver);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+LinearSolver::LinearSolver(const Eigen::SparseMatrix<double> & A, const int solver)
+{
+    set_solver(solver);
+    compute(A);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void LinearSolver::set_solver(const int solver)
+{
+    assert(solver == SIMPLICIAL_LLT || solver == SIMPLICIAL_LDLT || solver == SparseLU || solver == BiCGSTAB || solver == CG);
+    type       = solver;
+    analyzed   = false;
+    factorized = false;
+    if (type == BiCGSTAB) bicgstab.setTolerance(1e-5);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool LinearSolver::analyze_pattern(const Eigen::SparseMatrix<double> & A)
 {
     assert(A.rows() == A.cols());
 
-    switch (solver)
+    factorized = false;
+    switch (type)
     {
-        case SIMPLICIAL_LLT:
+        // NOTE: Eigen solvers only report errors at factorization time
+        case SIMPLICIAL_LLT:  llt.analyzePattern(A);      break;
+        case SIMPLICIAL_LDLT: ldlt.analyzePattern(A);     break;
+        case BiCGSTAB:        bicgstab_A = A; bicgstab.analyzePattern(bicgstab_A); break;
+        case CG:              break; // nothing to analyze
+        case SparseLU:
         {
-            Eigen::SimplicialLLT< Eigen::SparseMatrix<double> > solver(A);
-            assert(solver.info() == Eigen::Success);
-            x = solver.solve(b).eval();
+            // SparseLU only accepts matrices in compressed form
+            if (A.isCompressed()) lu.analyzePattern(A);
+            else
+            {
+                Eigen::SparseMatrix<double> Ac = A;
+                Ac.makeCompressed();
+                lu.analyzePattern(Ac);
+            }
             break;
         }
+        default: assert(false && "Unknown Solver");
+    }
+    analyzed = true;
+    return analyzed;
+}
 
-        case SIMPLICIAL_LDLT:
-        {
-            Eigen::SimplicialLDLT< Eigen::SparseMatrix<double> > solver(A);
-            assert(solver.info() == Eigen::Success);
-            x = solver.solve(b).eval();
-            break;
-        }
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+CINO_INLINE
+bool LinearSolver::factorize(const Eigen::SparseMatrix<double> & A)
+{
+    if (!analyzed) analyze_pattern(A);
+
+    switch (type)
+    {
+        case SIMPLICIAL_LLT:  llt.factorize(A);  factorized = (llt.info()  == Eigen::Success); break;
+        case SIMPLICIAL_LDLT: ldlt.factorize(A); factorized = (ldlt.info() == Eigen::Success); break;
         case BiCGSTAB:
         {
-            Eigen::BiCGSTAB< Eigen::SparseMatrix<double> , Eigen::IncompleteLUT<double> > solver;
-            //solver.setMaxIterations(100);
-            solver.setTolerance(1e-5);
-            solver.compute(A);
-            assert(solver.info() == Eigen::Success);
-            x = solver.solve(b).eval();
+            bicgstab_A = A; // bicgstab keeps a reference to the matrix
+            bicgstab.factorize(bicgstab_A);
+            factorized = (bicgstab.info() == Eigen::Success);
             break;
         }
-
+        case CG:              factorized = cg.compute(A); break;
         case SparseLU:
         {
-            Eigen::SparseMatrix<double> Ac = A;
-            Ac.makeCompressed();
-            Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int> > solver;
-            solver.analyzePattern(Ac);
-            solver.factorize(Ac);
-            x = solver.solve(b);
+            if (A.isCompressed()) lu.factorize(A);
+            else
+            {
+                Eigen::SparseMatrix<double> Ac = A;
+                Ac.makeCompressed();
+                lu.factorize(Ac);
+            }
+            factorized = (lu.info() == Eigen::Success);
             break;
         }
+        default: assert(false && "Unknown Solver");
+    }
+    return factorized;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+CINO_INLINE
+bool LinearSolver::compute(const Eigen::SparseMatrix<double> & A)
+{
+    return analyze_pattern(A) && factorize(A);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool LinearSolver::solve(const Eigen::VectorXd & b, Eigen::VectorXd & x) const
+{
+    assert(factorized);
+    switch (type)
+    {
+        case SIMPLICIAL_LLT:  x = llt.solve(b);      return llt.info()      == Eigen::Success;
+        case SIMPLICIAL_LDLT: x = ldlt.solve(b);     return ldlt.info()     == Eigen::Success;
+        case SparseLU:        x = lu.solve(b);       return lu.info()       == Eigen::Success;
+        case BiCGSTAB:        x = bicgstab.solve(b); return bicgstab.info() == Eigen::Success;
+        case CG:              return cg.solve(b,x).converged;
         default: assert(false && "Unknown Solver");
     }
+    return false;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void solve_square_system_with_bc(const Eigen::SparseMatrix<double> & A,
-                                 const Eigen::VectorXd             & b,
-                                       Eigen::VectorXd             & x,
-                                 const std::map<uint,double>       & bc, // Dirichlet boundary conditions
-                                 int   solver)
+bool LinearSolver::solve(const Eigen::MatrixXd & B, Eigen::MatrixXd & X) const
 {
-    std::vector<int> col_map(A.rows(), -1);
-    uint fresh_id = 0;
-    for(uint col=0; col<A.cols(); ++col)
+    assert(factorized);
+    switch (type)
     {
-        if (DOES_NOT_CONTAIN(bc, col))
+        case SIMPLICIAL_LLT:  X = llt.solve(B);      return llt.info()      == Eigen::Success;
+        case SIMPLICIAL_LDLT: X = ldlt.solve(B);     return ldlt.info()     == Eigen::Success;
+        case SparseLU:        X = lu.solve(B);       return lu.info()       == Eigen::Success;
+        case BiCGSTAB:        X = bicgstab.solve(B); return bicgstab.info() == Eigen::Success;
+        case CG:
         {
-            col_map[col] = fresh_id++;
+            bool converged = true;
+            X.resize(B.rows(), B.cols());
+            for(int i=0; i<B.cols(); ++i)
+            {
+                Eigen::VectorXd x;
+                converged &= cg.solve(B.col(i), x).converged;
+                X.col(i) = x;
+            }
+            return converged;
         }
+        default: assert(false && "Unknown Solver");
     }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+DirichletSolver::DirichletSolver(const Eigen::SparseMatrix<double> & A,
+                                 const std::vector<uint>           & constrained_ids,
+                                 const int                           solver)
+{
+    init(A, constrained_ids, solver);
+}
 
-    uint size = A.rows() - bc.size();
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool DirichletSolver::init(const Eigen::SparseMatrix<double> & A,
+                           const std::vector<uint>           & constrained_ids,
+                           const int                           solver)
+{
+    assert(A.rows() == A.cols());
 
-    std::vector<Entry> Aprime_entries;
-    Eigen::VectorXd    bprime(size);
+    col_map.assign(A.rows(), 0);
+    for(uint col : constrained_ids)
+    {
+        assert(col < A.cols());
+        col_map[col] = -1;
+    }
 
-    for(uint row=0; row<A.rows(); ++row)
+    bc_ids.clear();
+    free_var.clear();
+    for(uint col=0; col<A.cols(); ++col)
     {
-        if (col_map[row] >= 0)
+        if (col_map[col] < 0) bc_ids.push_back(col);
+        else
         {
-            bprime[ col_map[row] ] = b[row];
+            col_map[col] = free_var.size();
+            free_var.push_back(col);
         }
     }
 
-    //
-    // iterate over the non-zero entries
-    // of sparse matrix A
-    //
-    for (uint i=0; i<A.outerSize(); ++i)
+    split(A);
+    ls.set_solver(solver);
+    return ls.compute(A_ff);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool DirichletSolver::refactorize(const Eigen::SparseMatrix<double> & A)
+{
+    assert(A.rows() == (int)col_map.size() && A.cols() == (int)col_map.size());
+    split(A);
+    return ls.factorize(A_ff);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void DirichletSolver::split(const Eigen::SparseMatrix<double> & A)
+{
+    // position of each constrained variable in bc_ids
+    std::vector<int> bc_map(A.cols(), -1);
+    for(uint i=0; i<bc_ids.size(); ++i) bc_map[bc_ids[i]] = i;
+
+    std::vector<Entry> ff_entries, fc_entries;
+    ff_entries.reserve(A.nonZeros());
+    for (int i=0; i<A.outerSize(); ++i)
     {
         for (Eigen::SparseMatrix<double>::InnerIterator it(A,i); it; ++it)
         {
-            uint    row = it.row();
-            uint    col = it.col();
-            double val = it.value();
-
-            if (col_map[row] < 0) continue;
+            int row = col_map[it.row()];
+            if (row < 0) continue;
 
-            if (col_map[col] < 0)
-            {
-                bprime[ col_map[row] ] -= bc.at(col) * val;
-            }
-            else
-            {
-                Aprime_entries.push_back(Entry(col_map[row], col_map[col], val));
-            }
+            int col = col_map[it.col()];
+            if (col >= 0) ff_entries.push_back(Entry(row, col, it.value()));
+            else          fc_entries.push_back(Entry(row, bc_map[it.col()], it.value()));
         }
     }
 
-    Eigen::SparseMatrix<double> Aprime(size, size);
-    Aprime.setFromTriplets(Aprime_entries.begin(), Aprime_entries.end());
+    A_ff.resize(free_var.size(), free_var.size());
+    A_fc.resize(free_var.size(), bc_ids.size());
+    A_ff.setFromTriplets(ff_entries.begin(), ff_entries.end());
+    A_fc.setFromTriplets(fc_entries.begin(), fc_entries.end());
+}
 
-    Eigen::VectorXd tmp_x(size);
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    solve_square_system(Aprime, bprime, tmp_x, solver);
+CINO_INLINE
+bool DirichletSolver::solve(const Eigen::VectorXd       & b,
+                            const std::map<uint,double> & bc,
+                                  Eigen::VectorXd       & x) const
+{
+    assert(bc.size() == bc_ids.size());
+    Eigen::VectorXd bc_val(bc_ids.size());
+    for(uint i=0; i<bc_ids.size(); ++i) bc_val[i] = bc.at(bc_ids[i]);
+    return solve(b, bc_val, x);
+}
 
-    x.resize(A.cols());
-    for(uint col=0; col<A.cols(); ++col)
-    {
-        if (col_map[col] >= 0)
-        {
-            x[col] = tmp_x[ col_map[col] ];
-        }
-        else
-        {
-            x[col] = bc.at(col);
-        }
-    }
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool DirichletSolver::solve(const Eigen::VectorXd & b,
+                            const Eigen::VectorXd & bc_val,
+                                  Eigen::VectorXd & x) const
+{
+    assert(b.rows() == (int)col_map.size());
+    assert(bc_val.rows() == (int)bc_ids.size());
+
+    Eigen::VectorXd b_f(free_var.size());
+    for(uint i=0; i<free_var.size(); ++i) b_f[i] = b[free_var[i]];
+    if (bc_ids.size() > 0) b_f -= A_fc * bc_val;
+
+    Eigen::VectorXd x_f;
+    bool ok = (free_var.empty()) ? true : ls.solve(b_f, x_f);
+
+    x.resize(col_map.size());
+    for(uint i=0; i<free_var.size(); ++i) x[free_var[i]] = x_f[i];
+    for(uint i=0; i<bc_ids.size();   ++i) x[bc_ids[i]]   = bc_val[i];
+    return ok;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool DirichletSolver::solve(const Eigen::MatrixXd & B,
+                            const Eigen::MatrixXd & bc_val,
+                                  Eigen::MatrixXd & X) const
+{
+    assert(B.rows() == (int)col_map.size());
+    assert(bc_val.rows() == (int)bc_ids.size() && bc_val.cols() == B.cols());
+
+    Eigen::MatrixXd B_f(free_var.size(), B.cols());
+    for(uint i=0; i<free_var.size(); ++i) B_f.row(i) = B.row(free_var[i]);
+    if (bc_ids.size() > 0) B_f -= A_fc * bc_val;
+
+    Eigen::MatrixXd X_f;
+    bool ok = (free_var.empty()) ? true : ls.solve(B_f, X_f);
+
+    X.resize(col_map.size(), B.cols());
+    for(uint i=0; i<free_var.size(); ++i) X.row(free_var[i]) = X_f.row(i);
+    for(uint i=0; i<bc_ids.size();   ++i) X.row(bc_ids[i])   = bc_val.row(i);
+    return ok;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void solve_square_system(const Eigen::SparseMatrix<double> & A,
+                         const Eigen::VectorXd             & b,
+                               Eigen::VectorXd             & x,
+                         int   solver)
+{
+    LinearSolver(A, solver).solve(b, x);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void solve_square_system_with_bc(const Eigen::SparseMatrix<double> & A,
+                                 const Eigen::VectorXd             & b,
+                                       Eigen::VectorXd             & x,
+                                 const std::map<uint,double>       & bc, // Dirichlet boundary conditions
+                                 int   solver)
+{
+    std::vector<uint> bc_ids;
+    bc_ids.reserve(bc.size());
+    for(const auto & obj : bc) bc_ids.push_back(obj.first);
+
+    DirichletSolver(A, bc_ids, solver).solve(b, bc, x);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
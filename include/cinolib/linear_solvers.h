@@ -38,9 +38,12 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <sys/types.h>
 #include <cinolib/cino_inline.h>
+#include <cinolib/iterative_solvers.h>
 #include <Eigen/Sparse>
+#include <Eigen/Dense>
 
 namespace cinolib
 {
@@ -56,6 +59,10 @@ namespace cinolib
  * --------------------------------------------------------------
  * BiCGSTAB     none
  * (iterative)
+ * --------------------------------------------------------------
+ * CG           positive definite
+ * (iterative,  (symmetric)
+ *  AMG precond)
  */
 
 enum
@@ -64,16 +71,153 @@ enum
     SIMPLICIAL_LDLT,
     SparseLU,
     BiCGSTAB,
+    CG,
 };
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-static const std::string txt[4] =
+static const std::string txt[5] =
 {
     "SIMPLICIAL_LLT"  ,
     "SIMPLICIAL_LDLT" ,
     "SparseLU",
     "BiCGSTAB",
+    "CG",
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Reusable solver for square sparse systems. Symbolic analysis (fill
+ * reducing ordering, elimination tree) and numeric factorization are kept
+ * separate, so that:
+ *
+ *  - a matrix can be factorized once and used to solve for many right hand
+ *    sides (either one at a time, or all together as columns of a matrix);
+ *
+ *  - if only the values of the matrix change (and not its sparsity pattern)
+ *    factorize() can be called again, skipping the symbolic analysis.
+ *
+ * For BiCGSTAB, analysis and factorization refer to the ILUT preconditioner.
+ * Since the Eigen solver keeps referring to the matrix it was factorized with,
+ * LinearSolver stores an internal copy of it (i.e. the input matrix can be
+ * modified or destroyed after factorize).
+ * For CG, factorization builds the AMG preconditioner (see iterative_solvers.h).
+ * With direct solvers and CG, solve() can be safely called concurrently from
+ * multiple threads (BiCGSTAB updates its internal status at each solve, hence
+ * it cannot).
+*/
+
+class LinearSolver
+{
+    public:
+
+        explicit LinearSolver(const int solver = SIMPLICIAL_LLT);
+        explicit LinearSolver(const Eigen::SparseMatrix<double> & A,
+                              const int                           solver = SIMPLICIAL_LLT); // analyze + factorize
+
+        // Eigen factorizations cannot be copied, and BiCGSTAB holds a reference
+        // to bicgstab_A, which would dangle in a copied or moved solver
+        LinearSolver(const LinearSolver &) = delete;
+        LinearSolver(LinearSolver &&) = delete;
+        LinearSolver & operator=(const LinearSolver &) = delete;
+        LinearSolver & operator=(LinearSolver &&) = delete;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void set_solver(const int solver); // discards any previous factorization
+        int  solver_type() const { return type; }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        bool analyze_pattern(const Eigen::SparseMatrix<double> & A);
+        bool factorize      (const Eigen::SparseMatrix<double> & A); // A must have the pattern of the last analyzed matrix
+        bool compute        (const Eigen::SparseMatrix<double> & A); // analyze_pattern + factorize
+
+        bool is_analyzed()   const { return analyzed;   }
+        bool is_factorized() const { return factorized; }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        bool solve(const Eigen::VectorXd & b, Eigen::VectorXd & x) const;
+        bool solve(const Eigen::MatrixXd & B, Eigen::MatrixXd & X) const; // one rhs per column
+
+    protected:
+
+        int  type;
+        bool analyzed   = false;
+        bool factorized = false;
+
+        Eigen::SimplicialLLT <Eigen::SparseMatrix<double>>                                  llt;
+        Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>                                  ldlt;
+        Eigen::SparseLU      <Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>>      lu;
+        Eigen::BiCGSTAB      <Eigen::SparseMatrix<double>, Eigen::IncompleteLUT<double>>    bicgstab;
+        IterativeSolver                                                                     cg;
+        Eigen::SparseMatrix<double>                                                         bicgstab_A; // referenced by bicgstab
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Square system with Dirichlet boundary conditions, prepared for repeated
+ * solves. Given the set of constrained variables, A is split into
+ *
+ *     | A_ff  A_fc | | x_f |   | b_f |
+ *     | A_cf  A_cc | | x_c | = | b_c |
+ *
+ * and the reduced system A_ff x_f = b_f - A_fc x_c is factorized once. Any
+ * new set of boundary values (x_c) and right hand side (b) then costs one
+ * sparse matrix-vector product and a back-substitution. If the values of A
+ * change (but neither its sparsity pattern nor the constrained set do) use
+ * refactorize(), which skips both the splitting setup and the symbolic analysis.
+ *
+ * Boundary values can be given either as a map (whose keys must coincide
+ * with the constrained set), or as a vector ordered as constrained_ids().
+ * The solver cannot be copied: build it in place, or hold it by pointer.
+*/
+
+class DirichletSolver
+{
+    public:
+
+        explicit DirichletSolver() {}
+        explicit DirichletSolver(const Eigen::SparseMatrix<double> & A,
+                                 const std::vector<uint>           & constrained_ids,
+                                 const int                           solver = SIMPLICIAL_LLT);
+
+        // not copyable nor movable, as the LinearSolver it contains
+        DirichletSolver(const DirichletSolver &) = delete;
+        DirichletSolver(DirichletSolver &&) = delete;
+        DirichletSolver & operator=(const DirichletSolver &) = delete;
+        DirichletSolver & operator=(DirichletSolver &&) = delete;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        bool init       (const Eigen::SparseMatrix<double> & A,
+                         const std::vector<uint>           & constrained_ids,
+                         const int                           solver = SIMPLICIAL_LLT);
+        bool refactorize(const Eigen::SparseMatrix<double> & A);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        bool solve(const Eigen::VectorXd & b, const std::map<uint,double> & bc,     Eigen::VectorXd & x) const;
+        bool solve(const Eigen::VectorXd & b, const Eigen::VectorXd       & bc_val, Eigen::VectorXd & x) const;
+        bool solve(const Eigen::MatrixXd & B, const Eigen::MatrixXd       & bc_val, Eigen::MatrixXd & X) const; // one rhs per column
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        const std::vector<uint> & constrained_ids() const { return bc_ids;   }
+        const std::vector<uint> & free_ids()        const { return free_var; }
+        const LinearSolver      & solver()          const { return ls;       }
+
+    protected:
+
+        std::vector<int>            col_map;  // free variable id (or -1 for constrained variables)
+        std::vector<uint>           bc_ids;   // constrained variables (sorted)
+        std::vector<uint>           free_var; // free variables (sorted)
+        Eigen::SparseMatrix<double> A_ff;
+        Eigen::SparseMatrix<double> A_fc;
+        LinearSolver                ls;
+
+        void split(const Eigen::SparseMatrix<double> & A);
 };
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
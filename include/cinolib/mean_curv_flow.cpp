@@ -47,7 +47,8 @@ CINO_INLINE
 void MCF(AbstractPolygonMesh<M,V,E,P> & m,
          const uint                     n_iters,
          const double                   time_scalar,
-         const bool                     conformalized)
+         const bool                     conformalized,
+         const bool                     iterative)
 {
     // use the squared avg edge length as time step, as suggested in:
     // Geodesics in Heat: A New Approach to Computing Distance Based on Heat Flow
@@ -57,8 +58,24 @@ void MCF(AbstractPolygonMesh<M,V,E,P> & m,
     time *= time;
     time *= time_scalar;
 
+    uint nv = m.num_verts();
+
     Eigen::SparseMatrix<double> L  = laplacian(m, COTANGENT);
     Eigen::SparseMatrix<double> MM = mass_matrix(m);
+    Eigen::SparseMatrix<double> A  = MM - time_scalar * L; // the pattern never changes
+
+    LinearSolver LLT(SIMPLICIAL_LLT);
+    Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower|Eigen::Upper, Eigen::IncompleteCholesky<double>> pcg;
+    if (iterative)
+    {
+        pcg.setTolerance(1e-10);
+        pcg.setMaxIterations(1000);
+        pcg.analyzePattern(A);
+    }
+    else LLT.analyze_pattern(A);
+
+    Eigen::MatrixXd xyz(nv,3);
+    Eigen::MatrixXd new_xyz;
 
     for(uint i=1; i<=n_iters; ++i)
     {
@@ -66,30 +83,32 @@ void MCF(AbstractPolygonMesh<M,V,E,P> & m,
         m.normalize_bbox();
         m.center_bbox();        
 
-        // backward euler time integration of heat flow equation
-        Eigen::SimplicialLLT<Eigen::SparseMatrix<double>> LLT(MM - time_scalar * L);
-
-        uint nv = m.num_verts();
-        Eigen::VectorXd x(nv);
-        Eigen::VectorXd y(nv);
-        Eigen::VectorXd z(nv);
-
         for(uint vid=0; vid<nv; ++vid)
         {
             vec3d pos = m.vert(vid);
-            x[vid] = pos.x();
-            y[vid] = pos.y();
-            z[vid] = pos.z();
+            xyz.row(vid) << pos.x(), pos.y(), pos.z();
         }
 
-        x = LLT.solve(MM * x);
-        y = LLT.solve(MM * y);
-        z = LLT.solve(MM * z);
+        // backward euler time integration of heat flow equation
+        bool solved = false;
+        if (iterative)
+        {
+            pcg.factorize(A);
+            new_xyz = pcg.solveWithGuess(MM * xyz, xyz);
+            solved  = (pcg.info() == Eigen::Success);
+            // badly shaped meshes (e.g. after many iterations of non
+            // conformalized MCF) may not converge: use the direct solver
+        }
+        if (!solved)
+        {
+            LLT.factorize(A);
+            LLT.solve(MM * xyz, new_xyz);
+        }
 
         double residual = 0.0;
-        for(uint vid=0; vid<m.num_verts(); ++vid)
+        for(uint vid=0; vid<nv; ++vid)
         {
-            vec3d new_pos(x[vid], y[vid], z[vid]);
+            vec3d new_pos(new_xyz(vid,0), new_xyz(vid,1), new_xyz(vid,2));
             residual += (m.vert(vid) - new_pos).length();
             m.vert(vid) = new_pos;
         }
@@ -98,8 +117,22 @@ void MCF(AbstractPolygonMesh<M,V,E,P> & m,
 
         if (i<n_iters) // update matrices for the next iteration
         {
-            MM = mass_matrix(m);
-            if (!conformalized) L = laplacian(m, COTANGENT);
+            if (conformalized)
+            {
+                // L is fixed: only the diagonal changes, update it in place
+                for(uint vid=0; vid<nv; ++vid)
+                {
+                    double mass = m.vert_mass(vid);
+                    A.coeffRef(vid,vid)  += mass - MM.coeffRef(vid,vid);
+                    MM.coeffRef(vid,vid)  = mass;
+                }
+            }
+            else
+            {
+                for(uint vid=0; vid<nv; ++vid) MM.coeffRef(vid,vid) = m.vert_mass(vid);
+                L = laplacian(m, COTANGENT);
+                A = MM - time_scalar * L;
+            }
         }
     }
 
@@ -49,6 +49,14 @@ namespace cinolib
  * Can Mean-Curvature Flow be Modified to be Non-singular?
  * Michael Kazhdan, Jake Solomon and Mirela Ben-Chen
  * Computer Graphics Forum, 31(5), 2012.
+ *
+ * The sparsity pattern of the system does not change across iterations,
+ * hence the symbolic analysis of the Cholesky factorization is done only
+ * once, and each iteration only refactorizes numerically. The x,y,z
+ * coordinates are solved for all at once, as a multiple right hand side.
+ * For very large meshes, set iterative to true to replace the Cholesky
+ * factorization with a conjugate gradient solver (preconditioned with an
+ * incomplete Cholesky factorization), warm started from current positions.
 */
 
 template<class M, class V, class E, class P>
@@ -56,7 +64,8 @@ CINO_INLINE
 void MCF(AbstractPolygonMesh<M,V,E,P> & m,
          const uint                     n_iters,
          const double                   time_scalar = 0.01, // I suggest very small steps for the conformalized version
-         const bool                     conformalized = true);
+         const bool                     conformalized = true,
+         const bool                     iterative = false);
 
 }
 
@@ -271,6 +271,19 @@ void AbstractDrawablePolygonMesh<Mesh>::updateGL_mesh()
                     drawlist.tri_v_colors.push_back(c.b);
                     drawlist.tri_v_colors.push_back(c.a);
                 }
+
+                // colors are pushed only in the three modes above
+                bool has_colors = drawlist.draw_mode & (DRAW_TRI_FACECOLOR | DRAW_TRI_VERTCOLOR | DRAW_TRI_QUALITY);
+                if (drawlist.draw_mode & DRAW_TRI_AO && has_colors)
+                {
+                    float * rgba = &drawlist.tri_v_colors[drawlist.tri_v_colors.size()-12];
+                    uint    vids[3] = { vid0, vid1, vid2 };
+                    for(uint j=0; j<3; ++j)
+                    for(uint k=0; k<3; ++k)
+                    {
+                        rgba[4*j+k] *= this->vert_data(vids[j]).AO;
+                    }
+                }
             }
         }
 
@@ -404,6 +417,17 @@ void AbstractDrawablePolygonMesh<Mesh>::show_poly_color()
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolygonMesh<Mesh>::show_AO(const bool b)
+{
+    if (b) drawlist.draw_mode |=  DRAW_TRI_AO;
+    else   drawlist.draw_mode &= ~DRAW_TRI_AO;
+    updateGL();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class Mesh>
 CINO_INLINE
 void AbstractDrawablePolygonMesh<Mesh>::show_texture1D(const int tex_type)
@@ -98,6 +98,7 @@ class AbstractDrawablePolygonMesh : public virtual Mesh, public DrawableObject
         void show_mesh_points();
         void show_vert_color();
         void show_poly_color();
+        void show_AO(const bool b); // darkens colors according to vert_data().AO
         void show_texture1D(const int tex_type);
         void show_texture2D(const int tex_type, const double tex_unit_scalar, const char *bitmap = NULL);
         void show_wireframe(const bool b);
@@ -188,6 +188,21 @@ int AbstractMesh<M,V,E,P>::genus() const
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+std::vector<int> AbstractMesh<M,V,E,P>::vector_vert_labels() const
+{
+    std::vector<int> labels;
+    labels.reserve(num_verts());
+    for(uint vid=0; vid<num_verts(); ++vid)
+    {
+        labels.push_back(vert_data(vid).label);
+    }
+    return labels;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 std::vector<Color> AbstractMesh<M,V,E,P>::vector_poly_colors() const
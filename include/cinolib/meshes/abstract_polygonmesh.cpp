@@ -36,9 +36,12 @@
 #include <cinolib/meshes/abstract_polygonmesh.h>
 #include <cinolib/cut_along_seams.h>
 #include <cinolib/io/read_write.h>
+#include <cinolib/mesh_hash.h>
 #include <cinolib/quality.h>
 #include <cinolib/stl_container_utilities.h>
 #include <cinolib/geometry/polygon.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/io/load_monitor.h>
 #include <unordered_set>
 
 namespace cinolib
@@ -75,6 +78,62 @@ void AbstractPolygonMesh<M,V,E,P>::load(const char * filename)
         //read_OBJ(filename, pos, poly_pos);
         read_OBJ(filename, pos, tex, nor, poly_pos, poly_tex, poly_nor, poly_col);
     }
+    else if (filetype.compare(".stl") == 0 ||
+             filetype.compare(".STL") == 0)
+    {
+        read_STL(filename, pos, poly_pos);
+    }
+    else if (filetype.compare(".ply") == 0 ||
+             filetype.compare(".PLY") == 0)
+    {
+        std::vector<Vert_std_attributes>    vert_attr;
+        std::vector<Polygon_std_attributes> poly_attr;
+        int vert_props, poly_props;
+        read_PLY(filename, pos, poly_pos, vert_attr, poly_attr, vert_props, poly_props);
+
+        for(const auto & a : vert_attr)
+        {
+            if(vert_props & PLY_UVW    ) tex.push_back(a.uvw);
+            if(vert_props & PLY_NORMALS) nor.push_back(a.normal);
+        }
+        if(poly_props & PLY_COLORS) for(const auto & a : poly_attr) poly_col.push_back(a.color);
+
+        init(pos, tex, nor, poly_pos, poly_tex, poly_nor, poly_col);
+
+        for(uint vid=0; vid<this->num_verts(); ++vid)
+        {
+            if(vert_props & PLY_COLORS ) this->vert_data(vid).color   = vert_attr.at(vid).color;
+            if(vert_props & PLY_LABELS ) this->vert_data(vid).label   = vert_attr.at(vid).label;
+            if(vert_props & PLY_QUALITY) this->vert_data(vid).quality = vert_attr.at(vid).quality;
+        }
+        for(uint pid=0; pid<this->num_polys(); ++pid)
+        {
+            if(poly_props & PLY_LABELS ) this->poly_data(pid).label   = poly_attr.at(pid).label;
+            if(poly_props & PLY_QUALITY) this->poly_data(pid).quality = poly_attr.at(pid).quality;
+        }
+        return;
+    }
+    else if (filetype.compare(".msh") == 0 ||
+             filetype.compare(".MSH") == 0)
+    {
+        std::vector<int> types = { MSH_TRIANGLE, MSH_QUADRANGLE };
+        if(this->mesh_type()==TRIMESH ) types = { MSH_TRIANGLE   };
+        if(this->mesh_type()==QUADMESH) types = { MSH_QUADRANGLE };
+        std::vector<int> poly_labels;
+        read_MSH(filename, pos, poly_pos, poly_labels, types);
+        init(pos, tex, nor, poly_pos, poly_tex, poly_nor, poly_col);
+        if(poly_labels.size()==this->num_polys())
+        {
+            for(uint pid=0; pid<this->num_polys(); ++pid) this->poly_data(pid).label = poly_labels.at(pid);
+        }
+        return;
+    }
+    else if (str.substr(str.size()-5,5).compare(".cino") == 0 ||
+             str.substr(str.size()-5,5).compare(".CINO") == 0)
+    {
+        load_CINO(filename);
+        return;
+    }
     else
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load() : file format not supported yet " << std::endl;
@@ -108,6 +167,36 @@ void AbstractPolygonMesh<M,V,E,P>::save(const char * filename) const
         }
         else write_OBJ(filename, coords, this->polys);
     }
+    else if (filetype.compare("stl") == 0 ||
+             filetype.compare("STL") == 0)
+    {
+        write_STL(filename, coords, this->polys);
+    }
+    else if (filetype.compare("ply") == 0 ||
+             filetype.compare("PLY") == 0)
+    {
+        std::vector<Vert_std_attributes>    vert_attr(this->num_verts());
+        std::vector<Polygon_std_attributes> poly_attr(this->num_polys());
+        for(uint vid=0; vid<this->num_verts(); ++vid) vert_attr.at(vid).normal = this->vert_data(vid).normal;
+        for(uint pid=0; pid<this->num_polys(); ++pid)
+        {
+            poly_attr.at(pid).color = this->poly_data(pid).color;
+            poly_attr.at(pid).label = this->poly_data(pid).label;
+        }
+        int poly_props = PLY_LABELS;
+        if(this->polys_are_colored()) poly_props |= PLY_COLORS;
+        write_PLY(filename, coords, this->polys, vert_attr, poly_attr, PLY_NORMALS, poly_props);
+    }
+    else if (filetype.compare("msh") == 0 ||
+             filetype.compare("MSH") == 0)
+    {
+        write_MSH(filename, this->verts, this->polys, this->vector_poly_labels(), 2);
+    }
+    else if (str.substr(str.size()-5,5).compare(".cino") == 0 ||
+             str.substr(str.size()-5,5).compare(".CINO") == 0)
+    {
+        save_CINO(filename);
+    }
     else
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write() : file format not supported yet " << std::endl;
@@ -116,6 +205,172 @@ void AbstractPolygonMesh<M,V,E,P>::save(const char * filename) const
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::load_CINO(const char * filename)
+{
+    this->clear();
+    this->mesh_data().filename = std::string(filename);
+
+    CinoReader cino(filename);
+    if(!cino.is_open()) return;
+
+    MeshType type = static_cast<MeshType>(cino.mesh_type());
+    if(type!=this->mesh_type() && !(this->mesh_type()==POLYGONMESH && (type==TRIMESH || type==QUADMESH)))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_CINO() : incompatible mesh type" << std::endl;
+        return;
+    }
+
+    static_assert(sizeof(vec3d)==3*sizeof(double), "vec3d is expected to be tightly packed");
+    size_t n_xyz;
+    const double * xyz = cino.view<double>(CINO_VERTS, n_xyz);
+    std::vector<vec3d> verts(n_xyz/3);
+    std::vector<std::vector<uint>> polys;
+    if(xyz==nullptr || !cino.read_csr(CINO_POLYS, polys, verts.size()))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_CINO() : missing or corrupted vertices or polygons" << std::endl;
+        return;
+    }
+    for(uint vid=0; vid<verts.size(); ++vid) verts[vid] = vec3d(xyz[3*vid], xyz[3*vid+1], xyz[3*vid+2]);
+
+    // restore the stored adjacency (if any) instead of recomputing it.
+    // All ids are range checked, so that a corrupted file cannot produce
+    // a mesh with out of bounds references
+    bool restored = false;
+    if(cino.has(CINO_EDGES))
+    {
+        uint nv = verts.size();
+        uint np = polys.size();
+        this->verts = std::move(verts);
+        this->polys = std::move(polys);
+        restored = cino.read(CINO_EDGES, this->edges) && this->edges.size()%2==0;
+        for(uint i=0; i<this->edges.size() && restored; ++i) restored = this->edges[i]<nv;
+        uint ne = this->edges.size()/2;
+        restored = restored                                       &&
+                   cino.read_csr(CINO_V2V, this->v2v, nv)         &&
+                   cino.read_csr(CINO_V2E, this->v2e, ne)         &&
+                   cino.read_csr(CINO_V2P, this->v2p, np)         &&
+                   cino.read_csr(CINO_E2P, this->e2p, np)         &&
+                   cino.read_csr(CINO_P2E, this->p2e, ne)         &&
+                   cino.read_csr(CINO_P2P, this->p2p, np)         &&
+                   cino.read_csr(CINO_POLY_TRIS, poly_triangles, nv);
+        restored = restored &&
+                   this->v2v.size()==nv && this->v2e.size()==nv && this->v2p.size()==nv &&
+                   this->e2p.size()==ne && this->p2e.size()==np && this->p2p.size()==np &&
+                   poly_triangles.size()==np;
+        if(!restored)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_CINO() : corrupted adjacency" << std::endl;
+            this->clear();
+            return;
+        }
+        this->v_data.resize(nv);
+        this->e_data.resize(ne);
+        this->p_data.resize(np);
+        this->update_bbox();
+        this->update_normals();
+    }
+    else
+    {
+        init_connectivity(verts, polys);
+    }
+
+    std::vector<double> uvw;
+    std::vector<int>    vert_labels, poly_labels;
+    std::vector<float>  poly_colors, poly_quality;
+    if(cino.read(CINO_VERT_UVW, uvw) && uvw.size()==3*this->num_verts())
+    {
+        for(uint vid=0; vid<this->num_verts(); ++vid)
+        {
+            this->vert_data(vid).uvw = vec3d(uvw.at(3*vid), uvw.at(3*vid+1), uvw.at(3*vid+2));
+        }
+    }
+    else this->copy_xyz_to_uvw(UVW_param);
+
+    if(cino.read(CINO_VERT_LABELS, vert_labels) && vert_labels.size()==this->num_verts())
+    {
+        for(uint vid=0; vid<this->num_verts(); ++vid) this->vert_data(vid).label = vert_labels.at(vid);
+    }
+    if(cino.read(CINO_POLY_LABELS, poly_labels) && poly_labels.size()==this->num_polys())
+    {
+        for(uint pid=0; pid<this->num_polys(); ++pid) this->poly_data(pid).label = poly_labels.at(pid);
+    }
+    if(cino.read(CINO_POLY_COLORS, poly_colors) && poly_colors.size()==4*this->num_polys())
+    {
+        for(uint pid=0; pid<this->num_polys(); ++pid)
+        {
+            this->poly_data(pid).color = Color(poly_colors.at(4*pid  ), poly_colors.at(4*pid+1),
+                                               poly_colors.at(4*pid+2), poly_colors.at(4*pid+3));
+        }
+    }
+    if(cino.read(CINO_POLY_QUALITY, poly_quality) && poly_quality.size()==this->num_polys())
+    {
+        for(uint pid=0; pid<this->num_polys(); ++pid) this->poly_data(pid).quality = poly_quality.at(pid);
+    }
+
+    for(uint eid=0; eid<this->num_edges(); ++eid)
+    {
+        this->edge_data(eid).marked = (this->edge_is_boundary(eid) || !this->edge_is_manifold(eid));
+    }
+
+    std::cout << "new mesh\t"      <<
+                 this->num_verts() << "V / " <<
+                 this->num_edges() << "E / " <<
+                 this->num_polys() << "P   " <<
+                 (restored ? "(stored adjacency)" : "") << std::endl;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::save_CINO(const char * filename, const bool with_adjacency) const
+{
+    uint nv = this->num_verts();
+    uint np = this->num_polys();
+
+    std::vector<double> uvw(3*nv);
+    for(uint vid=0; vid<nv; ++vid)
+    {
+        const vec3d & t = this->vert_data(vid).uvw;
+        uvw[3*vid  ] = t.x();
+        uvw[3*vid+1] = t.y();
+        uvw[3*vid+2] = t.z();
+    }
+    std::vector<int>   vert_labels = this->vector_vert_labels();
+    std::vector<int>   poly_labels = this->vector_poly_labels();
+    std::vector<float> poly_colors(4*np), poly_quality(np);
+    for(uint pid=0; pid<np; ++pid)
+    {
+        for(uint i=0; i<4; ++i) poly_colors[4*pid+i] = this->poly_data(pid).color.rgba[i];
+        poly_quality[pid] = this->poly_data(pid).quality;
+    }
+
+    CinoWriter cino(this->mesh_type(), mesh_hash(*this));
+    cino.add(CINO_VERTS, reinterpret_cast<const double*>(this->verts.data()), 3*nv);
+    cino.add_csr(CINO_POLYS, this->polys);
+    cino.add(CINO_VERT_UVW,     uvw);
+    cino.add(CINO_VERT_LABELS,  vert_labels);
+    cino.add(CINO_POLY_LABELS,  poly_labels);
+    cino.add(CINO_POLY_COLORS,  poly_colors);
+    cino.add(CINO_POLY_QUALITY, poly_quality);
+    if(with_adjacency)
+    {
+        cino.add(CINO_EDGES, this->edges);
+        cino.add_csr(CINO_V2V, this->v2v);
+        cino.add_csr(CINO_V2E, this->v2e);
+        cino.add_csr(CINO_V2P, this->v2p);
+        cino.add_csr(CINO_E2P, this->e2p);
+        cino.add_csr(CINO_P2E, this->p2e);
+        cino.add_csr(CINO_P2P, this->p2p);
+        cino.add_csr(CINO_POLY_TRIS, poly_triangles);
+    }
+    cino.write(filename);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::clear()
@@ -132,8 +387,7 @@ void AbstractPolygonMesh<M,V,E,P>::init(const std::vector<vec3d>             & v
                                         const std::vector<std::vector<uint>> & polys)
 {
     // initialize mesh connectivity (and normals)
-    for(auto v : verts) this->vert_add(v);
-    for(auto p : polys) this->poly_add(p);
+    init_connectivity(verts, polys);
 
     this->copy_xyz_to_uvw(UVW_param);
 
@@ -195,8 +449,7 @@ void AbstractPolygonMesh<M,V,E,P>::init(      std::vector<vec3d>             & p
     }
 
     // initialize mesh connectivity (and normals)
-    for(auto v : pos     ) this->vert_add(v);
-    for(auto p : poly_pos) this->poly_add(p);
+    init_connectivity(pos, poly_pos);
 
     // customize uv(w) coordinates
     if (pos.size()==tex.size())
@@ -242,6 +495,114 @@ void AbstractPolygonMesh<M,V,E,P>::init(      std::vector<vec3d>             & p
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::init_connectivity(const std::vector<vec3d>             & verts,
+                                                     const std::vector<std::vector<uint>> & polys)
+{
+    // new elements are appended to the existing ones (if any). New
+    // polygons may also refer to existing vertices
+    uint nv0 = this->num_verts();
+    uint np0 = this->num_polys();
+    uint nv  = nv0 + verts.size();
+    uint np  = np0 + polys.size();
+    this->verts.insert(this->verts.end(), verts.begin(), verts.end());
+    this->polys.insert(this->polys.end(), polys.begin(), polys.end());
+    this->v2v.resize(nv);
+    this->v2e.resize(nv);
+    this->v2p.resize(nv);
+    this->p2e.resize(np);
+    this->p2p.resize(np);
+
+    size_t n_corners = 0;
+    for(const auto & p : polys) n_corners += p.size();
+    this->edges.reserve(this->edges.size() + n_corners); // each (manifold) edge is shared by two polys
+    this->e2p.reserve(this->e2p.size() + n_corners/2);
+
+    LoadMonitor *monitor = current_load_monitor();
+    if(monitor) monitor->add_elems_total(polys.size());
+
+    // same visiting order of poly_add, so that edges are numbered by first
+    // appearance and adjacency lists are sorted the same way
+    std::vector<uint> old_verts; // existing vertices touched by the new polys
+    for(uint pid=np0; pid<np; ++pid)
+    {
+        if(monitor && ((pid-np0) & 4095)==4095)
+        {
+            monitor->add_elems(4096);
+            if(monitor->is_cancelled()) { this->clear(); return; }
+        }
+
+        const std::vector<uint> & p = this->polys.at(pid);
+        this->p2e.at(pid).reserve(p.size());
+
+        for(uint vid : p)
+        {
+            assert(vid < nv);
+            this->v2p.at(vid).push_back(pid);
+            if(vid < nv0) old_verts.push_back(vid);
+        }
+
+        for(uint i=0; i<p.size(); ++i)
+        {
+            uint vid0 = p.at(i);
+            uint vid1 = p.at((i+1)%p.size());
+            int  eid  = this->edge_id(vid0, vid1);
+            if (eid == -1)
+            {
+                eid = this->num_edges();
+                this->edges.push_back(vid0);
+                this->edges.push_back(vid1);
+                this->e2p.push_back(std::vector<uint>());
+                this->v2v.at(vid1).push_back(vid0);
+                this->v2v.at(vid0).push_back(vid1);
+                this->v2e.at(vid0).push_back(eid);
+                this->v2e.at(vid1).push_back(eid);
+            }
+
+            for(uint nbr : this->e2p.at(eid))
+            {
+                if (nbr==pid || CONTAINS_VEC(this->p2p.at(pid),nbr)) continue;
+                this->p2p.at(nbr).push_back(pid);
+                this->p2p.at(pid).push_back(nbr);
+            }
+
+            this->e2p.at(eid).push_back(pid);
+            this->p2e.at(pid).push_back(eid);
+        }
+    }
+    if(monitor) monitor->add_elems(polys.size() & 4095);
+
+    this->v_data.resize(nv);
+    this->e_data.resize(this->num_edges());
+    this->p_data.resize(np);
+    if(nv0==0) this->bb.reset();
+    for(const vec3d & v : verts)
+    {
+        this->bb.min = this->bb.min.min(v);
+        this->bb.max = this->bb.max.max(v);
+    }
+
+    // normals and tessellations are computed once per element (and in parallel)
+    poly_triangles.resize(np);
+    PARALLEL_FOR(np0, np, 1000, [this](const uint pid)
+    {
+        this->update_p_normal(pid);
+        this->update_p_tessellation(pid);
+    });
+    PARALLEL_FOR(nv0, nv, 1000, [this](const uint vid)
+    {
+        this->update_v_normal(vid);
+    });
+    REMOVE_DUPLICATES_FROM_VEC(old_verts);
+    PARALLEL_FOR(0, old_verts.size(), 1000, [this,&old_verts](const uint i)
+    {
+        this->update_v_normal(old_verts[i]);
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::update_p_tessellation(const uint pid)
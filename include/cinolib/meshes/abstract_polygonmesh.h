@@ -64,6 +64,10 @@ class AbstractPolygonMesh : public AbstractMesh<M,V,E,P>
         void load(const char * filename);
         void save(const char * filename) const;
 
+        // native binary format (see io/cino_format.h)
+        void load_CINO(const char * filename);
+        void save_CINO(const char * filename, const bool with_adjacency = true) const;
+
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
         void clear();
@@ -77,6 +81,14 @@ class AbstractPolygonMesh : public AbstractMesh<M,V,E,P>
                   const std::vector<std::vector<uint>> & poly_nor,  // polygons with references to nor
                   const std::vector<Color>             & poly_col); // per polygon colors
 
+        // builds the whole connectivity at once. Element ids and adjacency
+        // lists are the same one would get with a sequence of vert_add and
+        // poly_add calls, but without their per element overhead. If the
+        // mesh is not empty, verts and polys are appended to it (polys may
+        // refer to both existing and new vertices, new ones come after nv)
+        void init_connectivity(const std::vector<vec3d>             & verts,
+                               const std::vector<std::vector<uint>> & polys);
+
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
                 void update_p_tessellation(const uint pid);
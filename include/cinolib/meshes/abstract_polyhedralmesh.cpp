@@ -36,6 +36,13 @@
 #include <cinolib/meshes/abstract_polyhedralmesh.h>
 #include <cinolib/geometry/triangle.h>
 #include <cinolib/geometry/polygon.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/io/load_monitor.h>
+#include <cinolib/io/read_CINO.h>
+#include <cinolib/io/write_CINO.h>
+#include <cinolib/mesh_hash.h>
+#include <iostream>
+#include <algorithm>
 #include <unordered_set>
 #include <unordered_map>
 #include <queue>
@@ -76,9 +83,7 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::init(const std::vector<vec3d>
                                              const std::vector<std::vector<uint>> & polys,
                                              const std::vector<std::vector<bool>> & polys_face_winding)
 {
-    for(auto v : verts) this->vert_add(v);
-    for(auto f : faces) this->face_add(f);
-    for(uint pid=0; pid<polys.size(); ++pid) this->poly_add(polys.at(pid), polys_face_winding.at(pid));
+    init_connectivity(verts, faces, polys, polys_face_winding);
 
     this->copy_xyz_to_uvw(UVW_param);
 
@@ -91,6 +96,450 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::init(const std::vector<vec3d>
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void AbstractPolyhedralMesh<M,V,E,F,P>::init_connectivity(const std::vector<vec3d>             & verts,
+                                                          const std::vector<std::vector<uint>> & faces,
+                                                          const std::vector<std::vector<uint>> & polys,
+                                                          const std::vector<std::vector<bool>> & polys_face_winding)
+{
+    assert(polys.size() == polys_face_winding.size());
+
+    if(this->num_verts()>0)
+    {
+        // appending to an existing mesh: go the incremental way
+        for(const auto & v : verts) this->vert_add(v);
+        for(const auto & f : faces) this->face_add(f);
+        for(uint pid=0; pid<polys.size(); ++pid) this->poly_add(polys.at(pid), polys_face_winding.at(pid));
+        return;
+    }
+
+    uint nv = verts.size();
+    uint nf = faces.size();
+    uint np = polys.size();
+    this->verts              = verts;
+    this->faces              = faces;
+    this->polys              = polys;
+    this->polys_face_winding = polys_face_winding;
+    this->v2v.resize(nv);
+    this->v2e.resize(nv);
+    this->v2f.resize(nv);
+    this->v2p.resize(nv);
+    this->f2e.resize(nf);
+    this->f2f.resize(nf);
+    this->f2p.resize(nf);
+    this->p2v.resize(np);
+    this->p2e.resize(np);
+    this->p2p.resize(np);
+
+    LoadMonitor *monitor = current_load_monitor();
+    if(monitor) monitor->add_elems_total(nf+np);
+
+    // faces (same visiting order of face_add, so that edges are numbered by
+    // first appearance and adjacency lists are sorted the same way)
+    for(uint fid=0; fid<nf; ++fid)
+    {
+        if(monitor && (fid & 4095)==4095)
+        {
+            monitor->add_elems(4096);
+            if(monitor->is_cancelled()) { this->clear(); return; }
+        }
+
+        const std::vector<uint> & f = this->faces.at(fid);
+        this->f2e.at(fid).reserve(f.size());
+
+        for(uint vid : f)
+        {
+            assert(vid < nv);
+            this->v2f.at(vid).push_back(fid);
+        }
+
+        for(uint i=0; i<f.size(); ++i)
+        {
+            uint vid0 = f.at(i);
+            uint vid1 = f.at((i+1)%f.size());
+            int  eid  = this->edge_id(vid0, vid1);
+            if (eid == -1)
+            {
+                eid = this->num_edges();
+                this->edges.push_back(vid0);
+                this->edges.push_back(vid1);
+                this->e2f.push_back(std::vector<uint>());
+                this->e2p.push_back(std::vector<uint>());
+                this->v2v.at(vid1).push_back(vid0);
+                this->v2v.at(vid0).push_back(vid1);
+                this->v2e.at(vid0).push_back(eid);
+                this->v2e.at(vid1).push_back(eid);
+            }
+
+            for(uint nbr : this->e2f.at(eid))
+            {
+                if (nbr==fid || CONTAINS_VEC(this->f2f.at(fid),nbr)) continue;
+                this->f2f.at(nbr).push_back(fid);
+                this->f2f.at(fid).push_back(nbr);
+            }
+
+            this->e2f.at(eid).push_back(fid);
+            this->f2e.at(fid).push_back(eid);
+        }
+    }
+
+    if(monitor) monitor->add_elems(nf & 4095);
+
+    // polyhedra (same visiting order of poly_add)
+    for(uint pid=0; pid<np; ++pid)
+    {
+        if(monitor && (pid & 4095)==4095)
+        {
+            monitor->add_elems(4096);
+            if(monitor->is_cancelled()) { this->clear(); return; }
+        }
+
+        assert(polys.at(pid).size() == polys_face_winding.at(pid).size());
+        for(uint fid : this->polys.at(pid))
+        {
+            assert(fid < nf);
+            const std::vector<uint> & f = this->faces.at(fid);
+            for(uint i=0; i<f.size(); ++i)
+            {
+                uint vid = f.at(i);
+                uint eid = this->f2e.at(fid).at(i); // edge (f[i],f[i+1])
+
+                if (DOES_NOT_CONTAIN_VEC(this->p2e.at(pid),eid))
+                {
+                    this->e2p.at(eid).push_back(pid);
+                    this->p2e.at(pid).push_back(eid);
+                }
+
+                if (DOES_NOT_CONTAIN_VEC(this->p2v.at(pid),vid))
+                {
+                    this->p2v.at(pid).push_back(vid);
+                    this->v2p.at(vid).push_back(pid);
+                }
+            }
+
+            for(uint nbr : this->f2p.at(fid))
+            {
+                if (pid!=nbr && DOES_NOT_CONTAIN_VEC(this->p2p.at(pid),nbr))
+                {
+                    this->p2p.at(pid).push_back(nbr);
+                    this->p2p.at(nbr).push_back(pid);
+                }
+            }
+
+            this->f2p.at(fid).push_back(pid);
+        }
+    }
+    if(monitor) monitor->add_elems(np & 4095);
+
+    uint ne = this->num_edges();
+    this->v_data.resize(nv);
+    this->e_data.resize(ne);
+    this->f_data.resize(nf);
+    this->p_data.resize(np);
+
+    this->f_on_srf.resize(nf);
+    this->e_on_srf.assign(ne, false);
+    this->v_on_srf.assign(nv, false);
+    for(uint fid=0; fid<nf; ++fid)
+    {
+        this->f_on_srf[fid] = (this->f2p[fid].size()==1); // unreferenced faces are not on the surface
+        if(!this->f_on_srf[fid]) continue;
+        for(uint eid : this->f2e[fid])   this->e_on_srf[eid] = true;
+        for(uint vid : this->faces[fid]) this->v_on_srf[vid] = true;
+    }
+    this->update_bbox();
+
+    // normals and tessellations are computed once per element (and in parallel)
+    face_triangles.resize(nf);
+    PARALLEL_FOR(0, nf, 1000, [this](const uint fid)
+    {
+        this->update_f_normal(fid);
+        this->update_f_tessellation(fid);
+    });
+    PARALLEL_FOR(0, nv, 1000, [this](const uint vid)
+    {
+        this->update_v_normal(vid);
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void AbstractPolyhedralMesh<M,V,E,F,P>::init_connectivity(const std::vector<vec3d>             & verts,
+                                                          const std::vector<std::vector<uint>> & cells,
+                                                          const std::vector<std::vector<uint>> & cell_faces)
+{
+    uint nv = verts.size();
+    uint np = cells.size();
+
+    std::vector<std::vector<uint>> faces;
+    std::vector<std::vector<uint>> sorted_faces;      // face vertices, sorted (for lookup)
+    std::vector<std::vector<uint>> faces_by_vert(nv); // face ids, bucketed by their smallest vertex
+    std::vector<std::vector<uint>> polys(np);
+    std::vector<std::vector<bool>> winding(np);
+    faces.reserve(np*cell_faces.size()/2+1);
+    sorted_faces.reserve(np*cell_faces.size()/2+1);
+
+    for(uint pid=0; pid<np; ++pid)
+    {
+        if((pid & 4095)==4095 && load_cancelled()) return;
+
+        const std::vector<uint> & c = cells.at(pid);
+        polys.at(pid).reserve(cell_faces.size());
+        winding.at(pid).reserve(cell_faces.size());
+
+        for(const auto & lf : cell_faces)
+        {
+            std::vector<uint> f(lf.size());
+            for(uint i=0; i<lf.size(); ++i) f[i] = c.at(lf[i]);
+            std::vector<uint> key = f;
+            SORT_VEC(key);
+            assert(key.front() < nv);
+
+            int fid = -1;
+            for(uint cand : faces_by_vert.at(key.front()))
+            {
+                if(sorted_faces.at(cand)==key) { fid = cand; break; }
+            }
+
+            bool w = true; // new faces are stored as seen from the current cell (CCW)
+            if(fid == -1)
+            {
+                fid = faces.size();
+                faces.push_back(f);
+                sorted_faces.push_back(key);
+                faces_by_vert.at(key.front()).push_back(fid);
+            }
+            else
+            {
+                // CCW iff the stored face traverses f[0] -> f[1] as well
+                const std::vector<uint> & sf = faces.at(fid);
+                uint off = std::find(sf.begin(), sf.end(), f.at(0)) - sf.begin();
+                w = (sf.at((off+1)%sf.size()) == f.at(1));
+            }
+            polys.at(pid).push_back(fid);
+            winding.at(pid).push_back(w);
+        }
+    }
+    sorted_faces.clear();
+    faces_by_vert.clear();
+
+    init_connectivity(verts, faces, polys, winding);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void AbstractPolyhedralMesh<M,V,E,F,P>::load_CINO(const char * filename)
+{
+    this->clear();
+    this->mesh_data().filename = std::string(filename);
+
+    CinoReader cino(filename);
+    if(!cino.is_open()) return;
+
+    MeshType type = static_cast<MeshType>(cino.mesh_type());
+    if(type!=this->mesh_type() && !(this->mesh_type()==POLYHEDRALMESH && (type==TETMESH || type==HEXMESH)))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_CINO() : incompatible mesh type" << std::endl;
+        return;
+    }
+
+    static_assert(sizeof(vec3d)==3*sizeof(double), "vec3d is expected to be tightly packed");
+    size_t n_xyz, n_winding;
+    const double  * xyz     = cino.view<double>(CINO_VERTS, n_xyz);
+    const uint8_t * winding = cino.view<uint8_t>(CINO_POLY_WINDING, n_winding);
+    std::vector<vec3d> verts(n_xyz/3);
+    std::vector<std::vector<uint>> faces, polys, p2v;
+    bool ok = xyz!=nullptr && winding!=nullptr &&
+              cino.read_csr(CINO_FACES, faces, verts.size()) &&
+              cino.read_csr(CINO_POLYS, polys, faces.size()) &&
+              cino.read_csr(CINO_P2V,   p2v,   verts.size()) &&
+              p2v.size()==polys.size();
+    std::vector<std::vector<bool>> polys_winding(polys.size());
+    size_t off = 0;
+    for(uint pid=0; pid<polys.size() && ok; ++pid)
+    {
+        if(off+polys[pid].size()>n_winding) { ok = false; break; }
+        polys_winding[pid].assign(winding+off, winding+off+polys[pid].size());
+        off += polys[pid].size();
+    }
+    if(!ok)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_CINO() : missing or corrupted vertices, faces or polyhedra" << std::endl;
+        return;
+    }
+    for(uint vid=0; vid<verts.size(); ++vid) verts[vid] = vec3d(xyz[3*vid], xyz[3*vid+1], xyz[3*vid+2]);
+
+    // restore the stored adjacency (if any) instead of recomputing it.
+    // All ids are range checked, so that a corrupted file cannot produce
+    // a mesh with out of bounds references
+    bool restored = false;
+    if(cino.has(CINO_EDGES))
+    {
+        uint nv = verts.size();
+        uint nf = faces.size();
+        uint np = polys.size();
+        this->verts              = std::move(verts);
+        this->faces              = std::move(faces);
+        this->polys              = std::move(polys);
+        this->polys_face_winding = std::move(polys_winding);
+        this->p2v                = std::move(p2v);
+        restored = cino.read(CINO_EDGES, this->edges) && this->edges.size()%2==0;
+        for(uint i=0; i<this->edges.size() && restored; ++i) restored = this->edges[i]<nv;
+        uint ne = this->edges.size()/2;
+        restored = restored                                       &&
+                   cino.read_csr(CINO_V2V, this->v2v, nv)         &&
+                   cino.read_csr(CINO_V2E, this->v2e, ne)         &&
+                   cino.read_csr(CINO_V2F, this->v2f, nf)         &&
+                   cino.read_csr(CINO_V2P, this->v2p, np)         &&
+                   cino.read_csr(CINO_E2F, this->e2f, nf)         &&
+                   cino.read_csr(CINO_E2P, this->e2p, np)         &&
+                   cino.read_csr(CINO_F2E, this->f2e, ne)         &&
+                   cino.read_csr(CINO_F2F, this->f2f, nf)         &&
+                   cino.read_csr(CINO_F2P, this->f2p, np)         &&
+                   cino.read_csr(CINO_P2E, this->p2e, ne)         &&
+                   cino.read_csr(CINO_P2P, this->p2p, np)         &&
+                   cino.read_csr(CINO_FACE_TRIS, face_triangles, nv);
+        restored = restored &&
+                   this->v2v.size()==nv && this->v2e.size()==nv && this->v2f.size()==nv && this->v2p.size()==nv &&
+                   this->e2f.size()==ne && this->e2p.size()==ne &&
+                   this->f2e.size()==nf && this->f2f.size()==nf && this->f2p.size()==nf && face_triangles.size()==nf &&
+                   this->p2e.size()==np && this->p2p.size()==np;
+        if(!restored)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_CINO() : corrupted adjacency" << std::endl;
+            this->clear();
+            return;
+        }
+        this->v_data.resize(nv);
+        this->e_data.resize(ne);
+        this->f_data.resize(nf);
+        this->p_data.resize(np);
+
+        this->f_on_srf.resize(nf);
+        this->e_on_srf.assign(ne, false);
+        this->v_on_srf.assign(nv, false);
+        for(uint fid=0; fid<nf; ++fid)
+        {
+            this->f_on_srf[fid] = (this->f2p[fid].size()<2);
+            if(!this->f_on_srf[fid]) continue;
+            for(uint eid : this->f2e[fid])   this->e_on_srf[eid] = true;
+            for(uint vid : this->faces[fid]) this->v_on_srf[vid] = true;
+        }
+        this->update_bbox();
+    }
+    else
+    {
+        init_connectivity(verts, faces, polys, polys_winding);
+        this->p2v = std::move(p2v); // keeps the canonical vertex ordering of tets and hexes
+    }
+    this->update_normals();
+
+    std::vector<double> uvw;
+    std::vector<int>    vert_labels, poly_labels;
+    std::vector<float>  poly_colors, poly_quality;
+    if(cino.read(CINO_VERT_UVW, uvw) && uvw.size()==3*this->num_verts())
+    {
+        for(uint vid=0; vid<this->num_verts(); ++vid)
+        {
+            this->vert_data(vid).uvw = vec3d(uvw.at(3*vid), uvw.at(3*vid+1), uvw.at(3*vid+2));
+        }
+    }
+    else this->copy_xyz_to_uvw(UVW_param);
+
+    if(cino.read(CINO_VERT_LABELS, vert_labels) && vert_labels.size()==this->num_verts())
+    {
+        for(uint vid=0; vid<this->num_verts(); ++vid) this->vert_data(vid).label = vert_labels.at(vid);
+    }
+    if(cino.read(CINO_POLY_LABELS, poly_labels) && poly_labels.size()==this->num_polys())
+    {
+        for(uint pid=0; pid<this->num_polys(); ++pid) this->poly_data(pid).label = poly_labels.at(pid);
+    }
+    if(cino.read(CINO_POLY_COLORS, poly_colors) && poly_colors.size()==4*this->num_polys())
+    {
+        for(uint pid=0; pid<this->num_polys(); ++pid)
+        {
+            this->poly_data(pid).color = Color(poly_colors.at(4*pid  ), poly_colors.at(4*pid+1),
+                                               poly_colors.at(4*pid+2), poly_colors.at(4*pid+3));
+        }
+    }
+    if(cino.read(CINO_POLY_QUALITY, poly_quality) && poly_quality.size()==this->num_polys())
+    {
+        for(uint pid=0; pid<this->num_polys(); ++pid) this->poly_data(pid).quality = poly_quality.at(pid);
+    }
+
+    std::cout << "new mesh\t"      <<
+                 this->num_verts() << "V / " <<
+                 this->num_edges() << "E / " <<
+                 this->num_faces() << "F / " <<
+                 this->num_polys() << "P   " <<
+                 (restored ? "(stored adjacency)" : "") << std::endl;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void AbstractPolyhedralMesh<M,V,E,F,P>::save_CINO(const char * filename, const bool with_adjacency) const
+{
+    uint nv = this->num_verts();
+    uint np = this->num_polys();
+
+    std::vector<double> uvw(3*nv);
+    for(uint vid=0; vid<nv; ++vid)
+    {
+        const vec3d & t = this->vert_data(vid).uvw;
+        uvw[3*vid  ] = t.x();
+        uvw[3*vid+1] = t.y();
+        uvw[3*vid+2] = t.z();
+    }
+    std::vector<uint8_t> winding;
+    for(const auto & w : polys_face_winding) winding.insert(winding.end(), w.begin(), w.end());
+    std::vector<int>   vert_labels = this->vector_vert_labels();
+    std::vector<int>   poly_labels = this->vector_poly_labels();
+    std::vector<float> poly_colors(4*np), poly_quality(np);
+    for(uint pid=0; pid<np; ++pid)
+    {
+        for(uint i=0; i<4; ++i) poly_colors[4*pid+i] = this->poly_data(pid).color.rgba[i];
+        poly_quality[pid] = this->poly_data(pid).quality;
+    }
+
+    CinoWriter cino(this->mesh_type(), mesh_hash(*this));
+    cino.add(CINO_VERTS, reinterpret_cast<const double*>(this->verts.data()), 3*nv);
+    cino.add_csr(CINO_FACES, this->faces);
+    cino.add_csr(CINO_POLYS, this->polys);
+    cino.add(CINO_POLY_WINDING, winding);
+    cino.add_csr(CINO_P2V, this->p2v);
+    cino.add(CINO_VERT_UVW,     uvw);
+    cino.add(CINO_VERT_LABELS,  vert_labels);
+    cino.add(CINO_POLY_LABELS,  poly_labels);
+    cino.add(CINO_POLY_COLORS,  poly_colors);
+    cino.add(CINO_POLY_QUALITY, poly_quality);
+    if(with_adjacency)
+    {
+        cino.add(CINO_EDGES, this->edges);
+        cino.add_csr(CINO_V2V, this->v2v);
+        cino.add_csr(CINO_V2E, this->v2e);
+        cino.add_csr(CINO_V2F, this->v2f);
+        cino.add_csr(CINO_V2P, this->v2p);
+        cino.add_csr(CINO_E2F, this->e2f);
+        cino.add_csr(CINO_E2P, this->e2p);
+        cino.add_csr(CINO_F2E, this->f2e);
+        cino.add_csr(CINO_F2F, this->f2f);
+        cino.add_csr(CINO_F2P, this->f2p);
+        cino.add_csr(CINO_P2E, this->p2e);
+        cino.add_csr(CINO_P2P, this->p2p);
+        cino.add_csr(CINO_FACE_TRIS, face_triangles);
+    }
+    cino.write(filename);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class F, class P>
 CINO_INLINE
 int AbstractPolyhedralMesh<M,V,E,F,P>::Euler_characteristic() const
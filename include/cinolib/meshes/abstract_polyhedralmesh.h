@@ -84,6 +84,26 @@ class AbstractPolyhedralMesh : public AbstractMesh<M,V,E,P>
                    const std::vector<std::vector<uint>> & polys,
                    const std::vector<std::vector<bool>> & polys_face_winding);
 
+        // builds the whole connectivity at once. Element ids and adjacency
+        // lists are the same one would get with a sequence of vert_add,
+        // face_add and poly_add calls, but without their per element overhead
+        void init_connectivity(const std::vector<vec3d>             & verts,
+                               const std::vector<std::vector<uint>> & faces,
+                               const std::vector<std::vector<uint>> & polys,
+                               const std::vector<std::vector<bool>> & polys_face_winding);
+
+        // same as above, for elements defined as lists of vertices (e.g. tets
+        // or hexa). cell_faces lists the faces of each element (local vertex
+        // offsets, CCW when seen from outside). Shared faces are detected and
+        // stored once, with the winding of the first element referencing them
+        void init_connectivity(const std::vector<vec3d>             & verts,
+                               const std::vector<std::vector<uint>> & cells,
+                               const std::vector<std::vector<uint>> & cell_faces);
+
+        // native binary format (see io/cino_format.h)
+        void load_CINO(const char * filename);
+        void save_CINO(const char * filename, const bool with_adjacency = true) const;
+
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
         int Euler_characteristic() const;
@@ -41,6 +41,8 @@
 #include <cinolib/standard_elements_tables.h>
 #include <cinolib/subdivision_schemas.h>
 #include <cinolib/vector_serialization.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/io/load_monitor.h>
 
 #include <queue>
 #include <float.h>
@@ -114,12 +116,23 @@ void Hexmesh<M,V,E,F,P>::load(const char * filename)
     else if (filetype.compare(".vtu") == 0 ||
              filetype.compare(".VTU") == 0)
     {
-        read_VTU(filename, tmp_verts, tmp_polys);
+        read_VTU(filename, tmp_verts, tmp_polys, vert_labels, poly_labels);
     }
     else if (filetype.compare(".vtk") == 0 ||
              filetype.compare(".VTK") == 0)
     {
-        read_VTK(filename, tmp_verts, tmp_polys);
+        read_VTK(filename, tmp_verts, tmp_polys, vert_labels, poly_labels);
+    }
+    else if (filetype.compare(".msh") == 0 ||
+             filetype.compare(".MSH") == 0)
+    {
+        read_MSH(filename, tmp_verts, tmp_polys, poly_labels, {MSH_HEXAHEDRON});
+    }
+    else if (str.substr(str.size()-5,5).compare(".cino") == 0 ||
+             str.substr(str.size()-5,5).compare(".CINO") == 0)
+    {
+        this->load_CINO(filename);
+        return;
     }
     else
     {
@@ -150,12 +163,22 @@ void Hexmesh<M,V,E,F,P>::save(const char * filename) const
     else if (filetype.compare(".vtu") == 0 ||
              filetype.compare(".VTU") == 0)
     {
-        write_VTU(filename, this->verts, this->p2v);
+        write_VTU(filename, this->verts, this->p2v, {}, this->polys_are_labeled() ? this->vector_poly_labels() : std::vector<int>());
     }
     else if (filetype.compare(".vtk") == 0 ||
              filetype.compare(".VTK") == 0)
     {
-        write_VTK(filename, this->verts, this->p2v);
+        write_VTK(filename, this->verts, this->p2v, {}, this->polys_are_labeled() ? this->vector_poly_labels() : std::vector<int>());
+    }
+    else if (filetype.compare(".msh") == 0 ||
+             filetype.compare(".MSH") == 0)
+    {
+        write_MSH(filename, this->verts, this->p2v, this->vector_poly_labels(), 3);
+    }
+    else if (str.substr(str.size()-5,5).compare(".cino") == 0 ||
+             str.substr(str.size()-5,5).compare(".CINO") == 0)
+    {
+        this->save_CINO(filename);
     }
     else
     {
@@ -170,10 +193,20 @@ CINO_INLINE
 void Hexmesh<M,V,E,F,P>::init_hexmesh(const std::vector<vec3d>             & verts,
                                       const std::vector<std::vector<uint>> & polys)
 {
-     for(auto v : verts) this->vert_add(v);
-     for(auto p : polys) this->poly_add(p);
+     std::vector<std::vector<uint>> cell_faces(6);
+     for(uint i=0; i<6; ++i) cell_faces[i].assign(HEXA_FACES[i], HEXA_FACES[i]+4);
+     this->init_connectivity(verts, polys, cell_faces);
+     if(load_cancelled()) { this->clear(); return; } // a cancelled load leaves the mesh empty
+
+     // make sure p2v stores hex vertices in the standard way
+     PARALLEL_FOR(0, this->num_polys(), 1000, [this](const uint pid)
+     {
+         reorder_p2v(pid);
+         update_hex_quality(pid);
+     });
 
      this->copy_xyz_to_uvw(UVW_param);
+     if(this->num_polys()==0) return; // nothing to report
 
      std::cout << "new mesh\t"      <<
                   this->num_verts() << "V / " <<
@@ -194,6 +227,7 @@ void Hexmesh<M,V,E,F,P>::init_hexmesh(const std::vector<vec3d>             & ver
                                       const std::vector<int>               & poly_labels)
 {
     init_hexmesh(verts, polys);
+    if(this->num_polys()==0) return;
 
     if(vert_labels.size()==this->num_verts())
     {
@@ -86,6 +86,7 @@ typedef struct
     vec3d  uvw     = vec3d(0,0,0);
     int    label   = -1;
     float  quality = 0.0;
+    float  AO      = 1.0; // ambient occlusion (1: fully visible, 0: fully occluded)
     bool   marked  = false;
 }
 Vert_std_attributes;
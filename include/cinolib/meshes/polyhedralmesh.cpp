@@ -82,6 +82,7 @@ void Polyhedralmesh<M,V,E,F,P>::load(const char * filename)
     std::vector<std::vector<uint>> tmp_faces;
     std::vector<std::vector<uint>> tmp_polys;
     std::vector<std::vector<bool>> tmp_polys_face_winding;
+    std::vector<int>               poly_labels;
 
     std::string str(filename);
     std::string filetype = str.substr(str.size()-6,6);
@@ -96,12 +97,38 @@ void Polyhedralmesh<M,V,E,F,P>::load(const char * filename)
     {
         read_HEDRA(filename, tmp_verts, tmp_faces, tmp_polys, tmp_polys_face_winding);
     }
+    else if (str.substr(str.size()-4,4).compare(".vtu") == 0 ||
+             str.substr(str.size()-4,4).compare(".VTU") == 0)
+    {
+        read_VTU(filename, tmp_verts, tmp_faces, tmp_polys, tmp_polys_face_winding);
+    }
+    else if (str.substr(str.size()-4,4).compare(".vtk") == 0 ||
+             str.substr(str.size()-4,4).compare(".VTK") == 0)
+    {
+        read_VTK(filename, tmp_verts, tmp_faces, tmp_polys, tmp_polys_face_winding);
+    }
+    else if (str.substr(str.size()-4,4).compare(".msh") == 0 ||
+             str.substr(str.size()-4,4).compare(".MSH") == 0)
+    {
+        read_MSH(filename, tmp_verts, tmp_faces, tmp_polys, tmp_polys_face_winding, poly_labels);
+    }
+    else if (str.substr(str.size()-5,5).compare(".cino") == 0 ||
+             str.substr(str.size()-5,5).compare(".CINO") == 0)
+    {
+        this->load_CINO(filename);
+        return;
+    }
     else
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load() : file format not supported yet " << std::endl;
     }
 
     this->init(tmp_verts, tmp_faces, tmp_polys, tmp_polys_face_winding);
+
+    if(poly_labels.size()==this->num_polys())
+    {
+        for(uint pid=0; pid<this->num_polys(); ++pid) this->poly_data(pid).label = poly_labels.at(pid);
+    }
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -118,6 +145,26 @@ void Polyhedralmesh<M,V,E,F,P>::save(const char * filename) const
     {
         write_HEDRA(filename, this->verts, this->faces, this->polys, this->polys_face_winding);
     }
+    else if (str.substr(str.size()-4,4).compare(".vtu") == 0 ||
+             str.substr(str.size()-4,4).compare(".VTU") == 0)
+    {
+        write_VTU(filename, this->verts, this->faces, this->polys, this->polys_face_winding);
+    }
+    else if (str.substr(str.size()-4,4).compare(".vtk") == 0 ||
+             str.substr(str.size()-4,4).compare(".VTK") == 0)
+    {
+        write_VTK(filename, this->verts, this->faces, this->polys, this->polys_face_winding);
+    }
+    else if (str.substr(str.size()-4,4).compare(".msh") == 0 ||
+             str.substr(str.size()-4,4).compare(".MSH") == 0)
+    {
+        write_MSH(filename, this->verts, this->faces, this->polys, this->polys_face_winding, this->vector_poly_labels());
+    }
+    else if (str.substr(str.size()-5,5).compare(".cino") == 0 ||
+             str.substr(str.size()-5,5).compare(".CINO") == 0)
+    {
+        this->save_CINO(filename);
+    }
     else
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write() : file format not supported yet " << std::endl;
@@ -41,6 +41,8 @@
 #include <cinolib/quality.h>
 #include <cinolib/cot.h>
 #include <cinolib/symbols.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/io/load_monitor.h>
 
 namespace cinolib
 {
@@ -109,12 +111,23 @@ void Tetmesh<M,V,E,F,P>::load(const char * filename)
     else if (filetype.compare(".vtu") == 0 ||
              filetype.compare(".VTU") == 0)
     {
-        read_VTU(filename, tmp_verts, tmp_polys);
+        read_VTU(filename, tmp_verts, tmp_polys, vert_labels, poly_labels);
     }
     else if (filetype.compare(".vtk") == 0 ||
              filetype.compare(".VTK") == 0)
     {
-        read_VTK(filename, tmp_verts, tmp_polys);
+        read_VTK(filename, tmp_verts, tmp_polys, vert_labels, poly_labels);
+    }
+    else if (filetype.compare(".msh") == 0 ||
+             filetype.compare(".MSH") == 0)
+    {
+        read_MSH(filename, tmp_verts, tmp_polys, poly_labels, {MSH_TETRAHEDRON});
+    }
+    else if (str.substr(str.size()-5,5).compare(".cino") == 0 ||
+             str.substr(str.size()-5,5).compare(".CINO") == 0)
+    {
+        this->load_CINO(filename);
+        return;
     }
     else
     {
@@ -150,12 +163,22 @@ void Tetmesh<M,V,E,F,P>::save(const char * filename) const
     else if (filetype.compare(".vtu") == 0 ||
              filetype.compare(".VTU") == 0)
     {
-        write_VTU(filename, this->verts, this->p2v);
+        write_VTU(filename, this->verts, this->p2v, {}, this->polys_are_labeled() ? this->vector_poly_labels() : std::vector<int>());
     }
     else if (filetype.compare(".vtk") == 0 ||
              filetype.compare(".VTK") == 0)
     {
-        write_VTK(filename, this->verts, this->p2v);
+        write_VTK(filename, this->verts, this->p2v, {}, this->polys_are_labeled() ? this->vector_poly_labels() : std::vector<int>());
+    }
+    else if (filetype.compare(".msh") == 0 ||
+             filetype.compare(".MSH") == 0)
+    {
+        write_MSH(filename, this->verts, this->p2v, this->vector_poly_labels(), 3);
+    }
+    else if (str.substr(str.size()-5,5).compare(".cino") == 0 ||
+             str.substr(str.size()-5,5).compare(".CINO") == 0)
+    {
+        this->save_CINO(filename);
     }
     else
     {
@@ -170,10 +193,20 @@ CINO_INLINE
 void Tetmesh<M,V,E,F,P>::init_tetmesh(const std::vector<vec3d>             & verts,
                                       const std::vector<std::vector<uint>> & polys)
 {
-    for(auto v : verts) this->vert_add(v);
-    for(auto p : polys) this->poly_add(p);
+    std::vector<std::vector<uint>> cell_faces(4);
+    for(uint i=0; i<4; ++i) cell_faces[i].assign(TET_FACES[i], TET_FACES[i]+3);
+    this->init_connectivity(verts, polys, cell_faces);
+    if(load_cancelled()) { this->clear(); return; } // a cancelled load leaves the mesh empty
+
+    // make sure p2v stores tet vertices in the standard way
+    PARALLEL_FOR(0, this->num_polys(), 1000, [this](const uint pid)
+    {
+        reorder_p2v(pid);
+        update_tet_quality(pid);
+    });
 
     this->copy_xyz_to_uvw(UVW_param);
+    if(this->num_polys()==0) return; // nothing to report
 
     std::cout << "new mesh\t"      <<
                  this->num_verts() << "V / " <<
@@ -192,6 +225,7 @@ void Tetmesh<M,V,E,F,P>::init_tetmesh(const std::vector<vec3d>             & ver
                                       const std::vector<int>               & poly_labels)
 {
     init_tetmesh(verts, polys);
+    if(this->num_polys()==0) return;
 
     if(vert_labels.size()==this->num_verts())
     {
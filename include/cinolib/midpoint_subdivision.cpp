@@ -140,4 +140,42 @@ void midpoint_subdivision(const AbstractPolyhedralMesh<M,V,E,F,P> & m_in,
     }
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void midpoint_subdivision(const AbstractPolyhedralMesh<M,V,E,F,P> & m_in,
+                                AbstractPolyhedralMesh<M,V,E,F,P> & m_out,
+                                Eigen::SparseMatrix<double>       & refinement_map)
+{
+    midpoint_subdivision(m_in, m_out);
+
+    // new vertices are ordered as: old verts, edge midpoints, face centroids, poly centroids
+    std::vector<Eigen::Triplet<double>> entries;
+    uint row = 0;
+    for(uint vid=0; vid<m_in.num_verts(); ++vid, ++row)
+    {
+        entries.push_back(Eigen::Triplet<double>(row, vid, 1.0));
+    }
+    for(uint eid=0; eid<m_in.num_edges(); ++eid, ++row)
+    {
+        entries.push_back(Eigen::Triplet<double>(row, m_in.edge_vert_id(eid,0), 0.5));
+        entries.push_back(Eigen::Triplet<double>(row, m_in.edge_vert_id(eid,1), 0.5));
+    }
+    for(uint fid=0; fid<m_in.num_faces(); ++fid, ++row)
+    {
+        double w = 1.0/static_cast<double>(m_in.verts_per_face(fid));
+        for(uint vid : m_in.adj_f2v(fid)) entries.push_back(Eigen::Triplet<double>(row, vid, w));
+    }
+    for(uint pid=0; pid<m_in.num_polys(); ++pid, ++row)
+    {
+        double w = 1.0/static_cast<double>(m_in.verts_per_poly(pid));
+        for(uint vid : m_in.adj_p2v(pid)) entries.push_back(Eigen::Triplet<double>(row, vid, w));
+    }
+    assert(row == m_out.num_verts());
+
+    refinement_map.resize(m_out.num_verts(), m_in.num_verts());
+    refinement_map.setFromTriplets(entries.begin(), entries.end());
+}
+
 }
@@ -37,6 +37,7 @@
 #define CINO_MIDPOINT_SUBDIVISION_H
 
 #include <cinolib/meshes/meshes.h>
+#include <Eigen/Sparse>
 
 namespace cinolib
 {
@@ -46,6 +47,11 @@ namespace cinolib
  * Hexahedral Meshing Using Midpoint Subdivision and Integer Programming
  * T.S. Li, R.M. McKeag, C.G. Armstrong
  * Computer Methods in Applied Mechanics and Engineering, 1995
+ *
+ * The second version also outputs the refinement map, that is, the sparse
+ * matrix R such that the vertices of m_out are R * (vertices of m_in). The
+ * same matrix interpolates any per vertex field from m_in to m_out, and can
+ * be used as prolongation operator for geometric multigrid (see multigrid.h)
 */
 
 template<class M, class V, class E, class F, class P>
@@ -53,6 +59,12 @@ CINO_INLINE
 void midpoint_subdivision(const AbstractPolyhedralMesh<M,V,E,F,P> & m_in,
                                 AbstractPolyhedralMesh<M,V,E,F,P> & m_out);
 
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void midpoint_subdivision(const AbstractPolyhedralMesh<M,V,E,F,P> & m_in,
+                                AbstractPolyhedralMesh<M,V,E,F,P> & m_out,
+                                Eigen::SparseMatrix<double>       & refinement_map);
+
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -0,0 +1,308 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/multigrid.h>
+#include <cinolib/parallel_linear_algebra.h>
+#include <cinolib/parallel_for.h>
+#include <cmath>
+#include <assert.h>
+
+namespace cinolib
+{
+
+CINO_INLINE
+void Multigrid::init_algebraic(const Eigen::SparseMatrix<double> & A,
+                               const uint                          coarsest_size,
+                               const uint                          max_levels)
+{
+    assert(A.rows() == A.cols());
+
+    this->A.clear();
+    this->P.clear();
+    this->R.clear();
+    this->omega_D.clear();
+
+    this->A.push_back(A);
+    coarsen_algebraic(coarsest_size, max_levels);
+
+    for(uint l=0; l+1<this->A.size(); ++l) setup_level_smoother(l);
+    setup_coarse_solver();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Multigrid::init(const Eigen::SparseMatrix<double>              & A,
+                     const std::vector<Eigen::SparseMatrix<double>> & P,
+                     const uint                                       coarsest_size)
+{
+    assert(A.rows() == A.cols());
+
+    this->A.clear();
+    this->P.clear();
+    this->R.clear();
+    this->omega_D.clear();
+
+    this->A.push_back(A);
+    for(const auto & Pl : P) add_level(Pl);
+    coarsen_algebraic(coarsest_size, 20);
+
+    for(uint l=0; l+1<this->A.size(); ++l) setup_level_smoother(l);
+    setup_coarse_solver();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Multigrid::init_geometric(const Eigen::SparseMatrix<double>              & A,
+                               const std::vector<Eigen::SparseMatrix<double>> & refinement_maps,
+                               const uint                                       coarsest_size)
+{
+    // the hierarchy goes from fine to coarse
+    std::vector<Eigen::SparseMatrix<double>> P(refinement_maps.rbegin(), refinement_maps.rend());
+    init(A, P, coarsest_size);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Multigrid::add_level(const Eigen::SparseMatrix<double> & P)
+{
+    assert(P.rows() == A.back().rows());
+    Eigen::SparseMatrix<double> R  = P.transpose();
+    Eigen::SparseMatrix<double> Ac = R * A.back() * P; // Galerkin coarse operator
+    this->P.push_back(P);
+    this->R.push_back(R);
+    this->A.push_back(Ac);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Multigrid::coarsen_algebraic(const uint coarsest_size, const uint max_levels)
+{
+    while(A.size() < max_levels && A.back().rows() > coarsest_size)
+    {
+        Eigen::SparseMatrix<double> Pl = smoothed_aggregation_prolongator(A.back());
+        if (Pl.cols() == 0 || Pl.cols() > 0.9 * A.back().rows()) break; // stagnation
+        add_level(Pl);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Multigrid::setup_level_smoother(const uint l)
+{
+    // damped Jacobi, with weight 4/(3 rho(D^-1 A)) (optimal smoothing for
+    // the upper half of the spectrum of Laplacian-like operators)
+    const Eigen::SparseMatrix<double> & Al = A.at(l);
+    double omega = 4.0 / (3.0 * spectral_radius_jacobi(Al));
+
+    if (omega_D.size() <= l) omega_D.resize(l+1);
+    Eigen::VectorXd d = Al.diagonal();
+    omega_D[l].resize(d.rows());
+    for(int i=0; i<d.rows(); ++i) omega_D[l][i] = (d[i] != 0) ? omega / d[i] : 0.0;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Multigrid::setup_coarse_solver()
+{
+    // tiny regularization: systems arising from pure Neumann problems (e.g.
+    // the Laplacian alone) are singular, and so is their coarsest level
+    Eigen::SparseMatrix<double> Ac = A.back();
+    double eps = 1e-10 * Ac.diagonal().cwiseAbs().maxCoeff();
+    for(int i=0; i<Ac.rows(); ++i) Ac.coeffRef(i,i) += eps;
+    coarse_solver.compute(Ac);
+    assert(coarse_solver.info() == Eigen::Success);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Multigrid::v_cycle(const Eigen::VectorXd & b, Eigen::VectorXd & x) const
+{
+    assert(!A.empty());
+    assert(b.rows() == A.front().rows());
+    if (x.rows() != b.rows()) x = Eigen::VectorXd::Zero(b.rows());
+    v_cycle(0, b, x);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Multigrid::v_cycle(const uint l, const Eigen::VectorXd & b, Eigen::VectorXd & x) const
+{
+    if (l+1 == A.size())
+    {
+        x = coarse_solver.solve(b);
+        return;
+    }
+
+    smooth(l, b, x);
+
+    // restrict the residual, solve for the coarse correction, prolong it back
+    Eigen::VectorXd Ax, r, rc, ec, e;
+    parallel_spmv_symmetric(A[l], x, Ax);
+    r = b - Ax;
+    parallel_spmv(R[l], r, rc);
+    ec = Eigen::VectorXd::Zero(rc.rows());
+    v_cycle(l+1, rc, ec);
+    parallel_spmv(P[l], ec, e);
+    x += e;
+
+    smooth(l, b, x);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Multigrid::smooth(const uint l, const Eigen::VectorXd & b, Eigen::VectorXd & x) const
+{
+    Eigen::VectorXd Ax;
+    for(uint i=0; i<n_smooth; ++i)
+    {
+        parallel_spmv_symmetric(A[l], x, Ax);
+        uint n_chunks = (x.rows() < PARALLEL_LA_MIN_SIZE) ? 1 : 0;
+        PARALLEL_FOR_CHUNKS(0, x.rows(), n_chunks, [&](const uint beg, const uint end, const uint)
+        {
+            for(uint j=beg; j<end; ++j) x[j] += omega_D[l][j] * (b[j] - Ax[j]);
+        });
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double spectral_radius_jacobi(const Eigen::SparseMatrix<double> & A,
+                              const uint                          n_iters)
+{
+    Eigen::VectorXd d = A.diagonal();
+    Eigen::VectorXd x = Eigen::VectorXd::Ones(A.rows());
+    for(int i=0; i<x.rows(); i+=2) x[i] = -0.5; // avoid starting from the null space of Neumann problems
+    x.normalize();
+
+    double rho = 1.0;
+    Eigen::VectorXd y;
+    for(uint it=0; it<n_iters; ++it)
+    {
+        parallel_spmv_symmetric(A, x, y);
+        for(int i=0; i<y.rows(); ++i) if (d[i] != 0) y[i] /= d[i];
+        rho = y.norm();
+        if (rho == 0) return 1.0;
+        x = y / rho;
+    }
+    return rho;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Eigen::SparseMatrix<double> smoothed_aggregation_prolongator(const Eigen::SparseMatrix<double> & A,
+                                                             const double                        strength_threshold)
+{
+    uint n = A.rows();
+    Eigen::VectorXd d = A.diagonal();
+
+    // strength of connection graph: j is a strong neighbor of i if |a_ij| >= theta * sqrt(|a_ii a_jj|)
+    std::vector<std::vector<uint>> strong(n);
+    double theta2 = strength_threshold * strength_threshold;
+    for(int col=0; col<A.outerSize(); ++col)
+    {
+        for(Eigen::SparseMatrix<double>::InnerIterator it(A,col); it; ++it)
+        {
+            uint i = it.row();
+            uint j = it.col();
+            if (i == j) continue;
+            if (it.value()*it.value() >= theta2 * std::fabs(d[i]*d[j])) strong[i].push_back(j);
+        }
+    }
+
+    // greedy aggregation
+    std::vector<int> agg(n, -1);
+    int n_aggs = 0;
+
+    // phase 1: nodes whose strong neighbors are all free seed a new aggregate
+    for(uint i=0; i<n; ++i)
+    {
+        if (agg[i] >= 0 || strong[i].empty()) continue;
+        bool free = true;
+        for(uint j : strong[i]) if (agg[j] >= 0) { free = false; break; }
+        if (!free) continue;
+        agg[i] = n_aggs;
+        for(uint j : strong[i]) agg[j] = n_aggs;
+        ++n_aggs;
+    }
+
+    // phase 2: remaining nodes join a neighboring aggregate
+    std::vector<int> agg_p1 = agg;
+    for(uint i=0; i<n; ++i)
+    {
+        if (agg[i] >= 0) continue;
+        for(uint j : strong[i])
+        {
+            if (agg_p1[j] >= 0) { agg[i] = agg_p1[j]; break; }
+        }
+    }
+
+    // phase 3: leftovers (e.g. isolated nodes) form aggregates with their free neighbors
+    for(uint i=0; i<n; ++i)
+    {
+        if (agg[i] >= 0) continue;
+        agg[i] = n_aggs;
+        for(uint j : strong[i]) if (agg[j] < 0) agg[j] = n_aggs;
+        ++n_aggs;
+    }
+
+    // tentative (piecewise constant) prolongator
+    std::vector<Eigen::Triplet<double>> entries;
+    entries.reserve(n);
+    for(uint i=0; i<n; ++i) entries.push_back(Eigen::Triplet<double>(i, agg[i], 1.0));
+    Eigen::SparseMatrix<double> P0(n, n_aggs);
+    P0.setFromTriplets(entries.begin(), entries.end());
+
+    // smoothing: P = (I - omega D^-1 A) P0
+    double omega = 4.0 / (3.0 * spectral_radius_jacobi(A));
+    Eigen::VectorXd inv_d(n);
+    for(uint i=0; i<n; ++i) inv_d[i] = (d[i] != 0) ? omega / d[i] : 0.0;
+    Eigen::SparseMatrix<double> DA = inv_d.asDiagonal() * A;
+    Eigen::SparseMatrix<double> P  = P0 - DA * P0;
+    P.prune(0.0);
+    return P;
+}
+
+}
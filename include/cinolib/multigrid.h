@@ -0,0 +1,149 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_MULTIGRID_H
+#define CINO_MULTIGRID_H
+
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <Eigen/Sparse>
+#include <Eigen/Dense>
+
+namespace cinolib
+{
+
+/* Multigrid hierarchy for symmetric positive (semi)definite systems. Level
+ * zero is the input (fine) system, and each level l+1 is obtained with the
+ * Galerkin product A_{l+1} = P_l^T A_l P_l, where P_l is the prolongation
+ * operator that maps level l+1 to level l. Prolongators can either be given
+ * by the caller (e.g. from a known refinement hierarchy) or computed from
+ * the matrix alone with smoothed aggregation:
+ *
+ *     Algebraic Multigrid by Smoothed Aggregation for
+ *     Second and Fourth Order Elliptic Problems
+ *     P. Vanek, J. Mandel and M. Brezina
+ *     Computing, 1996
+ *
+ * For meshes obtained by regular refinement of a coarse mesh, init_geometric()
+ * builds the hierarchy from the refinement maps (i.e. the matrices expressing
+ * the vertices of each refined mesh as linear combinations of the vertices of
+ * its parent, see midpoint_subdivision.h and hex_subdivision.h). This avoids
+ * the setup cost of the algebraic coarsening, and uses the refinement
+ * interpolation as prolongation operator (geometric multigrid).
+ *
+ * v_cycle() performs one V-cycle with damped Jacobi smoothing (with the same
+ * number of pre and post smoothing steps, so that the cycle is symmetric and
+ * can be used as a preconditioner for CG). The coarsest level is solved with
+ * a direct solver. Smoothers and transfer operators run in parallel.
+*/
+
+class Multigrid
+{
+    public:
+
+        explicit Multigrid() {}
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // smoothed aggregation hierarchy, coarsened until the system has less
+        // than coarsest_size rows (or coarsening stagnates)
+        void init_algebraic(const Eigen::SparseMatrix<double> & A,
+                            const uint                          coarsest_size = 500,
+                            const uint                          max_levels    = 20);
+
+        // hierarchy defined by user provided prolongators (P[l] maps level l+1 to level l).
+        // If the last level is still bigger than coarsest_size, the hierarchy is
+        // completed with smoothed aggregation
+        void init(const Eigen::SparseMatrix<double>              & A,
+                  const std::vector<Eigen::SparseMatrix<double>> & P,
+                  const uint                                       coarsest_size = 500);
+
+        // hierarchy defined by a sequence of refinements, from the coarsest mesh
+        // to the finest (refinement_maps[i] maps the vertices of mesh i to mesh i+1)
+        void init_geometric(const Eigen::SparseMatrix<double>              & A,
+                            const std::vector<Eigen::SparseMatrix<double>> & refinement_maps,
+                            const uint                                       coarsest_size = 500);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void set_smoothing_steps(const uint n) { n_smooth = n; }
+        uint num_levels() const { return A.size(); }
+        uint level_size(const uint l) const { return A.at(l).rows(); }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // one V-cycle for A x = b. x is used as initial guess (if it has the
+        // right size, zero otherwise) and is overwritten with the result
+        void v_cycle(const Eigen::VectorXd & b, Eigen::VectorXd & x) const;
+
+    protected:
+
+        std::vector<Eigen::SparseMatrix<double>>                 A;        // per level systems
+        std::vector<Eigen::SparseMatrix<double,Eigen::RowMajor>> P;        // prolongation (level l+1 -> l)
+        std::vector<Eigen::SparseMatrix<double,Eigen::RowMajor>> R;        // restriction  (level l -> l+1)
+        std::vector<Eigen::VectorXd>                             omega_D;  // damped inverse diagonals
+        Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>       coarse_solver;
+        uint                                                     n_smooth = 2;
+
+        void add_level(const Eigen::SparseMatrix<double> & P);
+        void coarsen_algebraic(const uint coarsest_size, const uint max_levels);
+        void setup_level_smoother(const uint l);
+        void setup_coarse_solver();
+        void v_cycle(const uint l, const Eigen::VectorXd & b, Eigen::VectorXd & x) const;
+        void smooth (const uint l, const Eigen::VectorXd & b, Eigen::VectorXd & x) const;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Largest eigenvalue of D^-1 A, estimated with a few power iterations
+CINO_INLINE
+double spectral_radius_jacobi(const Eigen::SparseMatrix<double> & A,
+                              const uint                          n_iters = 15);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Smoothed aggregation prolongator for A (see above)
+CINO_INLINE
+Eigen::SparseMatrix<double> smoothed_aggregation_prolongator(const Eigen::SparseMatrix<double> & A,
+                                                             const double                        strength_threshold = 0.08);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "multigrid.cpp"
+#endif
+
+#endif // CINO_MULTIGRID_H
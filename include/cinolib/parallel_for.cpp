@@ -0,0 +1,262 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace cinolib
+{
+
+CINO_INLINE
+uint n_threads()
+{
+    // hardware_concurrency() may return 0 if the value is not computable
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+namespace detail
+{
+
+CINO_INLINE
+ThreadPool & ThreadPool::instance()
+{
+    // the calling thread always takes part in the work, hence one less
+    static ThreadPool pool(n_threads()-1);
+    return pool;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+ThreadPool::ThreadPool(const uint n_workers)
+{
+    workers.reserve(n_workers);
+    for(uint i=0; i<n_workers; ++i)
+    {
+        workers.emplace_back([this]()
+        {
+            in_worker() = true;
+            for(;;)
+            {
+                std::function<void()> job;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [this]() { return stop || !queue.empty(); });
+                    if (stop && queue.empty()) return;
+                    job = std::move(queue.front());
+                    queue.pop_front();
+                }
+                job();
+            }
+        });
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    cv.notify_all();
+    for(auto & t : workers) t.join();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool & ThreadPool::in_worker()
+{
+    static thread_local bool flag = false;
+    return flag;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void ThreadPool::run(const uint                        n_tasks,
+                     const std::function<void(uint)> & task,
+                     const std::function<void()>     & cancel)
+{
+    std::exception_ptr      error;
+    std::mutex              error_mutex;
+    uint                    pending = n_tasks; // guarded by done_mutex
+    std::mutex              done_mutex;
+    std::condition_variable done_cv;
+
+    auto exec = [&](const uint tid)
+    {
+        try
+        {
+            task(tid);
+        }
+        catch(...)
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+            cancel();
+        }
+        // decrement and notify while holding the lock: the caller cannot see
+        // pending==0 (and destroy these locals) before the lock is released,
+        // and nothing is touched after that
+        std::lock_guard<std::mutex> lock(done_mutex);
+        if (--pending == 0) done_cv.notify_one();
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for(uint tid=1; tid<n_tasks; ++tid) queue.emplace_back([&exec,tid]() { exec(tid); });
+    }
+    cv.notify_all();
+
+    exec(0); // the calling thread does its share too
+
+    std::unique_lock<std::mutex> lock(done_mutex);
+    done_cv.wait(lock, [&pending]() { return pending == 0; });
+    lock.unlock();
+
+    if (error) std::rethrow_exception(error);
+}
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename Func>
+CINO_INLINE
+void PARALLEL_FOR(const uint   beg,
+                  const uint   end,
+                  const uint   serial_if_less_than,
+                  const Func & func)
+{
+    if (end <= beg) return;
+
+    uint n_items   = end - beg;
+    uint n_workers = std::min(n_threads(), n_items);
+
+    if (n_items < serial_if_less_than || n_workers < 2 || detail::ThreadPool::in_worker())
+    {
+        for(uint i=beg; i<end; ++i) func(i);
+        return;
+    }
+
+    detail::ThreadPool & pool = detail::ThreadPool::instance();
+    n_workers = std::min(n_workers, pool.size()+1);
+
+    // blocks small enough to balance the load, but large
+    // enough to make the atomic counter cost negligible
+    uint block_size = std::max(1u, n_items / (8*n_workers));
+
+    std::atomic<uint> next_block(beg);
+    pool.run(n_workers, [&](const uint)
+    {
+        for(;;)
+        {
+            uint block_beg = next_block.fetch_add(block_size);
+            if (block_beg >= end || block_beg < beg) break; // also catches wrap arounds
+            uint block_end = std::min(end, block_beg + block_size);
+            for(uint i=block_beg; i<block_end; ++i) func(i);
+        }
+    },
+    [&]() { next_block = end; });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename Func>
+CINO_INLINE
+void PARALLEL_FOR_CHUNKS(const uint   beg,
+                         const uint   end,
+                         const uint   n_chunks,
+                         const Func & func)
+{
+    if (end <= beg) return;
+
+    uint n_items    = end - beg;
+    uint n          = std::min(n_items, (n_chunks>0) ? n_chunks : n_threads());
+    uint chunk_size = (n_items + n - 1) / n;
+    n = (n_items + chunk_size - 1) / chunk_size; // drop empty chunks
+
+    if (n < 2 || detail::ThreadPool::in_worker())
+    {
+        for(uint cid=0; cid<n; ++cid)
+        {
+            uint chunk_beg = beg + cid*chunk_size;
+            func(chunk_beg, std::min(end, chunk_beg + chunk_size), cid);
+        }
+        return;
+    }
+
+    // there may be more chunks than threads in the pool,
+    // hence tasks pick chunks from a shared counter
+    detail::ThreadPool & pool = detail::ThreadPool::instance();
+    std::atomic<uint> next_chunk(0);
+    pool.run(std::min(n, pool.size()+1), [&](const uint)
+    {
+        for(;;)
+        {
+            uint cid = next_chunk.fetch_add(1);
+            if (cid >= n) break;
+            uint chunk_beg = beg + cid*chunk_size;
+            func(chunk_beg, std::min(end, chunk_beg + chunk_size), cid);
+        }
+    },
+    [&]() { next_chunk = n; });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Barrier::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    uint gen = generation;
+    if (++count == n)
+    {
+        count = 0;
+        ++generation;
+        cv.notify_all();
+    }
+    else cv.wait(lock, [this,gen]() { return gen != generation; });
+}
+
+}
@@ -0,0 +1,171 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_PARALLEL_FOR_H
+#define CINO_PARALLEL_FOR_H
+
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cinolib
+{
+
+/* Minimal multi-threading facilities built on top of std::thread (C++11).
+ * Remember to link against pthreads (-pthread) on unix systems.
+ *
+ * PARALLEL_FOR executes func(i) for each i in [beg,end). Iterations are
+ * distributed among threads in small blocks of contiguous indices, which
+ * are dynamically assigned to workers (i.e. uneven loads are balanced).
+ * Loops with less than serial_if_less_than iterations are executed serially
+ * in the calling thread, because spawning threads would cost more than the
+ * loop itself. func must be safe to call concurrently on different indices.
+ * If func throws, the remaining iterations are skipped and the (first)
+ * exception is rethrown in the calling thread once all workers are done.
+ *
+ * PARALLEL_FOR_CHUNKS splits [beg,end) into (at most) n_chunks contiguous
+ * chunks of the same size and executes func(chunk_beg, chunk_end, chunk_id)
+ * on each of them. Chunk ids are consecutive and follow the order of the
+ * range, which is handy when each chunk produces data that must be merged
+ * (or written to file) in order. If n_chunks is zero, the number of
+ * hardware threads is used. Exceptions are handled as in PARALLEL_FOR.
+ *
+ * Both routines run on a pool of worker threads that is created on first
+ * use and lives until the program terminates, so that loops executed many
+ * times (e.g. once per query or per sweep) do not pay for thread creation.
+ * Parallel loops issued from within a worker run serially in that worker.
+*/
+
+CINO_INLINE
+uint n_threads();
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+namespace detail
+{
+
+class ThreadPool
+{
+    public:
+
+        static ThreadPool & instance();
+
+        ~ThreadPool();
+
+        uint size() const { return workers.size(); }
+
+        // true if the current thread is one of the workers of the pool
+        static bool & in_worker();
+
+        // executes task(0) in the calling thread and task(1..n_tasks-1) in the
+        // pool, then waits for all of them to complete. The first exception
+        // thrown by a task is rethrown here; cancel is invoked as soon as it
+        // is caught, so that the other tasks can bail out early
+        void run(const uint                        n_tasks,
+                 const std::function<void(uint)> & task,
+                 const std::function<void()>     & cancel);
+
+    private:
+
+        explicit ThreadPool(const uint n_workers);
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool & operator=(const ThreadPool &) = delete;
+
+        std::vector<std::thread>           workers;
+        std::deque<std::function<void()>>  queue;
+        std::mutex                         mutex;
+        std::condition_variable            cv;
+        bool                               stop = false;
+};
+
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename Func>
+CINO_INLINE
+void PARALLEL_FOR(const uint   beg,
+                  const uint   end,
+                  const uint   serial_if_less_than,
+                  const Func & func);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename Func>
+CINO_INLINE
+void PARALLEL_FOR_CHUNKS(const uint   beg,
+                         const uint   end,
+                         const uint   n_chunks,
+                         const Func & func);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Reusable barrier for a fixed set of n threads: wait() blocks until all
+ * of them have called it, then releases them all. Meant to be used with
+ * threads that run concurrently for sure (i.e. std::thread, not the pool
+ * above, whose tasks may be queued), to synchronize successive phases of
+ * an algorithm without respawning threads for each phase.
+*/
+
+class Barrier
+{
+    public:
+
+        explicit Barrier(const uint n) : n(n) {}
+
+        CINO_INLINE
+        void wait();
+
+    private:
+
+        const uint              n;
+        uint                    count      = 0;
+        uint                    generation = 0;
+        std::mutex              mutex;
+        std::condition_variable cv;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "parallel_for.cpp"
+#endif
+
+#endif // CINO_PARALLEL_FOR_H
@@ -0,0 +1,190 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/parallel_linear_algebra.h>
+#include <cinolib/parallel_for.h>
+#include <vector>
+#include <assert.h>
+
+namespace cinolib
+{
+
+CINO_INLINE
+void parallel_spmv(const Eigen::SparseMatrix<double,Eigen::RowMajor> & A,
+                   const Eigen::VectorXd                             & x,
+                         Eigen::VectorXd                             & y)
+{
+    assert(A.cols() == x.rows());
+    assert(&x != &y);
+    y.resize(A.rows());
+
+    uint n_chunks = (A.rows() < PARALLEL_LA_MIN_SIZE) ? 1 : 0;
+    PARALLEL_FOR_CHUNKS(0, A.rows(), n_chunks, [&](const uint beg, const uint end, const uint)
+    {
+        for(uint row=beg; row<end; ++row)
+        {
+            double sum = 0.0;
+            for(Eigen::SparseMatrix<double,Eigen::RowMajor>::InnerIterator it(A,row); it; ++it)
+            {
+                sum += it.value() * x[it.col()];
+            }
+            y[row] = sum;
+        }
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void parallel_spmv_symmetric(const Eigen::SparseMatrix<double> & A,
+                             const Eigen::VectorXd             & x,
+                                   Eigen::VectorXd             & y)
+{
+    assert(A.rows() == A.cols() && A.cols() == x.rows());
+    assert(&x != &y);
+    y.resize(A.cols());
+
+    uint n_chunks = (A.cols() < PARALLEL_LA_MIN_SIZE) ? 1 : 0;
+    PARALLEL_FOR_CHUNKS(0, A.cols(), n_chunks, [&](const uint beg, const uint end, const uint)
+    {
+        for(uint col=beg; col<end; ++col)
+        {
+            double sum = 0.0;
+            for(Eigen::SparseMatrix<double>::InnerIterator it(A,col); it; ++it)
+            {
+                sum += it.value() * x[it.row()];
+            }
+            y[col] = sum;
+        }
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double parallel_dot(const Eigen::VectorXd & a,
+                    const Eigen::VectorXd & b)
+{
+    assert(a.rows() == b.rows());
+    if (a.rows() < PARALLEL_LA_MIN_SIZE) return a.dot(b);
+
+    // fixed size blocks, summed in order: the result does not depend on the number of threads
+    uint n_blocks = (a.rows() + PARALLEL_LA_BLOCK_SIZE - 1) / PARALLEL_LA_BLOCK_SIZE;
+    std::vector<double> partial(n_blocks, 0.0);
+    PARALLEL_FOR_CHUNKS(0, a.rows(), n_blocks, [&](const uint beg, const uint end, const uint cid)
+    {
+        partial[cid] = a.segment(beg, end-beg).dot(b.segment(beg, end-beg));
+    });
+    double sum = 0.0;
+    for(double s : partial) sum += s;
+    return sum;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void parallel_axpy(const double            alpha,
+                   const Eigen::VectorXd & x,
+                         Eigen::VectorXd & y)
+{
+    assert(x.rows() == y.rows());
+    if (x.rows() < PARALLEL_LA_MIN_SIZE)
+    {
+        y += alpha * x;
+        return;
+    }
+    PARALLEL_FOR_CHUNKS(0, x.rows(), 0, [&](const uint beg, const uint end, const uint)
+    {
+        y.segment(beg, end-beg) += alpha * x.segment(beg, end-beg);
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void parallel_xpay(const Eigen::VectorXd & x,
+                   const double            alpha,
+                         Eigen::VectorXd & y)
+{
+    assert(x.rows() == y.rows());
+    if (x.rows() < PARALLEL_LA_MIN_SIZE)
+    {
+        y = x + alpha * y;
+        return;
+    }
+    PARALLEL_FOR_CHUNKS(0, x.rows(), 0, [&](const uint beg, const uint end, const uint)
+    {
+        y.segment(beg, end-beg) = x.segment(beg, end-beg) + alpha * y.segment(beg, end-beg);
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Eigen::MatrixXd parallel_gemm(const Eigen::Ref<const Eigen::MatrixXd> & X,
+                              const Eigen::Ref<const Eigen::MatrixXd> & C)
+{
+    assert(X.cols() == C.rows());
+    uint n = X.rows();
+    Eigen::MatrixXd res(n, C.cols());
+    uint n_chunks = (n < PARALLEL_LA_MIN_SIZE) ? 1 : 0;
+    PARALLEL_FOR_CHUNKS(0, n, n_chunks, [&](const uint beg, const uint end, const uint)
+    {
+        res.middleRows(beg,end-beg).noalias() = X.middleRows(beg,end-beg) * C;
+    });
+    return res;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Eigen::MatrixXd parallel_gemm_tn(const Eigen::Ref<const Eigen::MatrixXd> & X,
+                                 const Eigen::Ref<const Eigen::MatrixXd> & Y)
+{
+    assert(X.rows() == Y.rows());
+    uint n        = X.rows();
+    // fixed size blocks, summed in order: the result does not depend on the number of threads
+    uint n_blocks = (n < PARALLEL_LA_MIN_SIZE) ? 1 : (n + PARALLEL_LA_BLOCK_SIZE - 1) / PARALLEL_LA_BLOCK_SIZE;
+    std::vector<Eigen::MatrixXd> partial(n_blocks);
+    PARALLEL_FOR_CHUNKS(0, n, n_blocks, [&](const uint beg, const uint end, const uint cid)
+    {
+        partial[cid].noalias() = X.middleRows(beg,end-beg).transpose() * Y.middleRows(beg,end-beg);
+    });
+    Eigen::MatrixXd res = Eigen::MatrixXd::Zero(X.cols(), Y.cols());
+    for(const auto & p : partial) if (p.size() > 0) res += p;
+    return res;
+}
+
+}
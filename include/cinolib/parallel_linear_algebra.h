@@ -0,0 +1,107 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_PARALLEL_LINEAR_ALGEBRA_H
+#define CINO_PARALLEL_LINEAR_ALGEBRA_H
+
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <Eigen/Sparse>
+#include <Eigen/Dense>
+
+namespace cinolib
+{
+
+/* Multi-threaded versions of the basic kernels used by iterative solvers
+ * (sparse matrix-vector products, dot products, vector updates and products
+ * of tall dense matrices, such as Krylov or spectral bases). Each
+ * thread processes a contiguous range of entries, and vectors shorter than
+ * PARALLEL_LA_MIN_SIZE are processed serially. Results do not depend on the
+ * number of threads: reductions (parallel_dot, parallel_gemm_tn) add up the
+ * partial results of blocks of PARALLEL_LA_BLOCK_SIZE entries, in order.
+ *
+ * Eigen sparse matrices are stored by column by default: for those, the
+ * product is computed as A^T x, which can be split by columns without write
+ * conflicts, hence A must be symmetric.
+*/
+
+static const uint PARALLEL_LA_MIN_SIZE   = 20000;
+static const uint PARALLEL_LA_BLOCK_SIZE = 5000;
+
+CINO_INLINE
+void parallel_spmv(const Eigen::SparseMatrix<double,Eigen::RowMajor> & A,
+                   const Eigen::VectorXd                             & x,
+                         Eigen::VectorXd                             & y); // y = A x
+
+CINO_INLINE
+void parallel_spmv_symmetric(const Eigen::SparseMatrix<double> & A,
+                             const Eigen::VectorXd             & x,
+                                   Eigen::VectorXd             & y); // y = A x (A symmetric)
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double parallel_dot(const Eigen::VectorXd & a,
+                    const Eigen::VectorXd & b);
+
+CINO_INLINE
+void parallel_axpy(const double            alpha,
+                   const Eigen::VectorXd & x,
+                         Eigen::VectorXd & y); // y += alpha * x
+
+CINO_INLINE
+void parallel_xpay(const Eigen::VectorXd & x,
+                   const double            alpha,
+                         Eigen::VectorXd & y); // y = x + alpha * y
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// products between tall (n x k, with n >> k) dense matrices, split by rows
+
+CINO_INLINE
+Eigen::MatrixXd parallel_gemm(const Eigen::Ref<const Eigen::MatrixXd> & X,
+                              const Eigen::Ref<const Eigen::MatrixXd> & C); // X * C
+
+CINO_INLINE
+Eigen::MatrixXd parallel_gemm_tn(const Eigen::Ref<const Eigen::MatrixXd> & X,
+                                 const Eigen::Ref<const Eigen::MatrixXd> & Y); // X^T * Y
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "parallel_linear_algebra.cpp"
+#endif
+
+#endif // CINO_PARALLEL_LINEAR_ALGEBRA_H
@@ -0,0 +1,273 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/ray_caster.h>
+#include <assert.h>
+
+namespace cinolib
+{
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+RayCaster::RayCaster(const AbstractPolygonMesh<M,V,E,P> & m,
+                     const uint                           max_tris_per_leaf)
+{
+    std::vector<uint> tris;
+    std::vector<uint> tri2poly;
+    for(uint pid=0; pid<m.num_polys(); ++pid)
+    {
+        const std::vector<uint> & tess = m.poly_tessellation(pid);
+        tris.insert(tris.end(), tess.begin(), tess.end());
+        for(uint i=0; i<tess.size()/3; ++i) tri2poly.push_back(pid);
+    }
+    init(m.vector_verts(), tris, max_tris_per_leaf);
+
+    // report poly ids rather than triangle ids
+    for(uint & id : tri_ids) id = tri2poly.at(id);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+RayCaster::RayCaster(const std::vector<vec3d> & verts,
+                     const std::vector<uint>  & tris,
+                     const uint                 max_tris_per_leaf)
+{
+    init(verts, tris, max_tris_per_leaf);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void RayCaster::init(const std::vector<vec3d> & verts,
+                     const std::vector<uint>  & tris,
+                     const uint                 max_tris_per_leaf)
+{
+    assert(tris.size()%3==0);
+    uint n_tris = tris.size()/3;
+
+    std::vector<Bbox> boxes(n_tris);
+    for(uint tid=0; tid<n_tris; ++tid)
+    {
+        for(uint i=0; i<3; ++i) boxes[tid].add(verts.at(tris[3*tid+i]));
+    }
+    bvh.build(boxes, max_tris_per_leaf);
+
+    std::vector<uint> sorted_tris(tris.size());
+    tri_ids.resize(n_tris);
+    for(uint pos=0; pos<n_tris; ++pos)
+    {
+        uint tid = bvh.item(pos);
+        tri_ids[pos] = tid;
+        for(uint i=0; i<3; ++i) sorted_tris[3*pos+i] = tris[3*tid+i];
+    }
+    this->tris.init(verts, sorted_tris);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool RayCaster::closest_hit(const vec3d  & orig,
+                            const vec3d  & dir,
+                                  double & t,
+                                  uint   & id,
+                            const double   t_min,
+                            const double   t_max) const
+{
+    if (bvh.empty()) return false;
+
+    vec3d inv_dir(1.0/dir.x(), 1.0/dir.y(), 1.0/dir.z());
+    bool  found = false;
+    t = t_max;
+
+    std::vector<std::pair<uint,double>> stack; // node id, entry distance
+    stack.reserve(64);
+    double t0 = t_min, t1 = t_max;
+    if (bvh.bbox().intersects_ray(orig, inv_dir, t0, t1)) stack.push_back(std::make_pair(0,t0));
+
+    while(!stack.empty())
+    {
+        uint   nid   = stack.back().first;
+        double t_box = stack.back().second;
+        stack.pop_back();
+        if (t_box >= t) continue; // a closer hit was found meanwhile
+
+        const BVHNode & n = bvh.node(nid);
+        if (n.is_leaf)
+        {
+            uint pos;
+            if (tris.closest_hit(orig, dir, n.beg, n.end, t, pos, t_min))
+            {
+                id    = tri_ids[pos];
+                found = true;
+            }
+            continue;
+        }
+
+        // visit the closest child first (i.e. push it last)
+        double tc[2];
+        bool   hit[2];
+        for(uint i=0; i<2; ++i)
+        {
+            double tmin = t_min, tmax = t;
+            hit[i] = bvh.node(n.children[i]).bbox.intersects_ray(orig, inv_dir, tmin, tmax);
+            tc[i]  = tmin;
+        }
+        uint first = (tc[0] <= tc[1]) ? 0 : 1;
+        if (hit[1-first]) stack.push_back(std::make_pair(n.children[1-first], tc[1-first]));
+        if (hit[  first]) stack.push_back(std::make_pair(n.children[  first], tc[  first]));
+    }
+    return found;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool RayCaster::any_hit(const vec3d  & orig,
+                        const vec3d  & dir,
+                        const double   t_min,
+                        const double   t_max) const
+{
+    if (bvh.empty()) return false;
+
+    vec3d inv_dir(1.0/dir.x(), 1.0/dir.y(), 1.0/dir.z());
+
+    std::vector<uint> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+
+    while(!stack.empty())
+    {
+        const BVHNode & n = bvh.node(stack.back());
+        stack.pop_back();
+
+        double t0 = t_min, t1 = t_max;
+        if (!n.bbox.intersects_ray(orig, inv_dir, t0, t1)) continue;
+
+        if (n.is_leaf)
+        {
+            if (tris.any_hit(orig, dir, n.beg, n.end, t_max, t_min)) return true;
+        }
+        else
+        {
+            stack.push_back(n.children[1]);
+            stack.push_back(n.children[0]);
+        }
+    }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint RayCaster::closest_hit(RayPacket & rays, uint ids[RAY_PACKET_SIZE]) const
+{
+    return packet_traversal<false>(rays, ids);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint RayCaster::any_hit(RayPacket & rays) const
+{
+    uint ids[RAY_PACKET_SIZE];
+    return packet_traversal<true>(rays, ids);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// The whole packet traverses the tree together: a node is visited if at
+// least one of the active rays hits its box. In any hit mode rays are
+// deactivated as soon as they hit something
+template<bool any>
+CINO_INLINE
+uint RayCaster::packet_traversal(RayPacket & rays, uint ids[RAY_PACKET_SIZE]) const
+{
+    if (bvh.empty()) return 0;
+
+    vec3d orig[RAY_PACKET_SIZE], inv_dir[RAY_PACKET_SIZE];
+    for(uint i=0; i<RAY_PACKET_SIZE; ++i)
+    {
+        orig[i]    = vec3d(rays.ox[i], rays.oy[i], rays.oz[i]);
+        inv_dir[i] = vec3d(1.0/rays.dx[i], 1.0/rays.dy[i], 1.0/rays.dz[i]);
+    }
+
+    const uint all  = (1u << RAY_PACKET_SIZE) - 1;
+    uint       hits = 0;
+
+    std::vector<uint> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+
+    while(!stack.empty())
+    {
+        const BVHNode & n = bvh.node(stack.back());
+        stack.pop_back();
+
+        uint active = any ? (all & ~hits) : all;
+        uint box_hits = 0;
+        for(uint i=0; i<RAY_PACKET_SIZE; ++i)
+        {
+            if (!(active & (1u << i))) continue;
+            double t0 = rays.t_min[i], t1 = rays.t_max[i];
+            if (n.bbox.intersects_ray(orig[i], inv_dir[i], t0, t1)) box_hits |= (1u << i);
+        }
+        if (!box_hits) continue;
+
+        if (n.is_leaf)
+        {
+            for(uint pos=n.beg; pos<n.end; ++pos)
+            {
+                uint mask = tris.packet_hit(rays, pos);
+                if (any) mask &= active;
+                if (!mask) continue;
+                hits |= mask;
+                for(uint i=0; i<RAY_PACKET_SIZE; ++i)
+                {
+                    if (mask & (1u << i)) ids[i] = tri_ids[pos];
+                }
+                if (any && hits == all) return hits;
+            }
+        }
+        else
+        {
+            stack.push_back(n.children[1]);
+            stack.push_back(n.children[0]);
+        }
+    }
+    return hits;
+}
+
+}
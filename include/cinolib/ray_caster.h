@@ -0,0 +1,123 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_RAY_CASTER_H
+#define CINO_RAY_CASTER_H
+
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/bvh.h>
+#include <cinolib/ray_triangle_simd.h>
+#include <cinolib/meshes/abstract_polygonmesh.h>
+
+namespace cinolib
+{
+
+/* Ray queries against a static triangle soup (or the triangulation of a
+ * surface mesh), accelerated with a BVH. Triangles are stored following
+ * the BVH order, so that each leaf refers to a contiguous block of packed
+ * triangles, which is tested with the SIMD kernels in ray_triangle_simd.h.
+ * Hits refer to the ids of the input triangles (or of the mesh polygons).
+ * Intersections are computed in single precision (see ray_triangle_simd.h).
+ *
+ * Use it for picking (closest hit), visibility/occlusion queries (any hit)
+ * and coherent groups of rays (packets), e.g. for ambient occlusion.
+*/
+
+class RayCaster
+{
+    public:
+
+        explicit RayCaster() {}
+
+        template<class M, class V, class E, class P>
+        explicit RayCaster(const AbstractPolygonMesh<M,V,E,P> & m,
+                           const uint                           max_tris_per_leaf = 8);
+
+        explicit RayCaster(const std::vector<vec3d> & verts,
+                           const std::vector<uint>  & tris,
+                           const uint                 max_tris_per_leaf = 8);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void init(const std::vector<vec3d> & verts,
+                  const std::vector<uint>  & tris, // serialized triangles (3 vids per triangle)
+                  const uint                 max_tris_per_leaf = 8);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // closest hit along the ray (within [t_min,t_max)). Returns the distance
+        // (in units of |dir|) and the id of the triangle (poly) that was hit
+        bool closest_hit(const vec3d  & orig,
+                         const vec3d  & dir,
+                               double & t,
+                               uint   & id,
+                         const double   t_min = 0.0,
+                         const double   t_max = inf_double) const;
+
+        // true if anything is hit within [t_min,t_max). Faster than closest_hit,
+        // as the traversal terminates at the first hit
+        bool any_hit(const vec3d  & orig,
+                     const vec3d  & dir,
+                     const double   t_min = 0.0,
+                     const double   t_max = inf_double) const;
+
+        // packet versions: bit i of the returned mask is set if the i-th ray
+        // hits something. For closest hits, rays.t_max and ids are updated
+        uint closest_hit(RayPacket & rays, uint ids[RAY_PACKET_SIZE]) const;
+        uint any_hit    (RayPacket & rays) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        const BVH & tree() const { return bvh; }
+
+    protected:
+
+        BVH               bvh;
+        PackedTriangles   tris;    // triangles, in BVH order
+        std::vector<uint> tri_ids; // maps packed triangles to user ids
+
+        template<bool any>
+        uint packet_traversal(RayPacket & rays, uint ids[RAY_PACKET_SIZE]) const;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "ray_caster.cpp"
+#endif
+
+#endif // CINO_RAY_CASTER_H
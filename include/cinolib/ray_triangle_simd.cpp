@@ -0,0 +1,307 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/ray_triangle_simd.h>
+#include <assert.h>
+
+// SSE2 is part of the x86-64 baseline, hence always available there. AVX kernels
+// are compiled regardless of the compiler flags (with GCC/Clang, which allow to
+// enable an instruction set on a per function basis), and used only if the CPU
+// supports them (see simd_has_avx). Other targets use a plain C++ fallback
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+#include <immintrin.h>
+#define CINO_RAY_TRIANGLE_SSE
+#if defined(__GNUC__)
+#define CINO_RAY_TRIANGLE_AVX
+#endif
+#endif
+
+namespace cinolib
+{
+
+/* Minimal wrappers around SIMD registers, so that the same intersection
+ * kernels (ray_triangle_simd_kernels.h) can be instantiated for every
+ * instruction set. Each instruction set lives in its own namespace, and all
+ * of them are defined the same way in every translation unit, regardless of
+ * the compiler flags. Comparisons return lane masks, which can be combined
+ * with & and | and turned into a bit mask with movemask
+*/
+
+#if defined(CINO_RAY_TRIANGLE_SSE)
+
+namespace simd_sse
+{
+
+struct simd_float
+{
+    static const uint W = 4;
+    __m128 v;
+    simd_float() {}
+    simd_float(const __m128 x) : v(x) {}
+    explicit simd_float(const float x) : v(_mm_set1_ps(x)) {}
+    static simd_float load(const float * p) { return _mm_loadu_ps(p); }
+};
+inline simd_float operator+ (const simd_float a, const simd_float b) { return _mm_add_ps(a.v, b.v);   }
+inline simd_float operator- (const simd_float a, const simd_float b) { return _mm_sub_ps(a.v, b.v);   }
+inline simd_float operator* (const simd_float a, const simd_float b) { return _mm_mul_ps(a.v, b.v);   }
+inline simd_float operator/ (const simd_float a, const simd_float b) { return _mm_div_ps(a.v, b.v);   }
+inline simd_float operator< (const simd_float a, const simd_float b) { return _mm_cmplt_ps(a.v, b.v); }
+inline simd_float operator> (const simd_float a, const simd_float b) { return _mm_cmpgt_ps(a.v, b.v); }
+inline simd_float operator>=(const simd_float a, const simd_float b) { return _mm_cmpge_ps(a.v, b.v); }
+inline simd_float operator<=(const simd_float a, const simd_float b) { return _mm_cmple_ps(a.v, b.v); }
+inline simd_float operator& (const simd_float a, const simd_float b) { return _mm_and_ps(a.v, b.v);   }
+inline simd_float operator| (const simd_float a, const simd_float b) { return _mm_or_ps (a.v, b.v);   }
+inline uint       movemask  (const simd_float a)                     { return _mm_movemask_ps(a.v);   }
+inline void       store     (float * p, const simd_float a)          { _mm_storeu_ps(p, a.v);         }
+
+#include <cinolib/ray_triangle_simd_kernels.h>
+}
+
+#else
+
+namespace simd_scalar
+{
+
+// portable fallback: masks are stored as 0/1 floats
+struct simd_float
+{
+    static const uint W = 4;
+    float v[4];
+    simd_float() {}
+    explicit simd_float(const float x) { for(uint i=0; i<W; ++i) v[i] = x; }
+    static simd_float load(const float * p) { simd_float r; for(uint i=0; i<W; ++i) r.v[i] = p[i]; return r; }
+};
+#define CINO_SIMD_FLOAT_OP(op, expr) \
+inline simd_float op(const simd_float a, const simd_float b) { simd_float r; for(uint i=0; i<simd_float::W; ++i) r.v[i] = (expr); return r; }
+CINO_SIMD_FLOAT_OP(operator+,  a.v[i] +  b.v[i])
+CINO_SIMD_FLOAT_OP(operator-,  a.v[i] -  b.v[i])
+CINO_SIMD_FLOAT_OP(operator*,  a.v[i] *  b.v[i])
+CINO_SIMD_FLOAT_OP(operator/,  a.v[i] /  b.v[i])
+CINO_SIMD_FLOAT_OP(operator<,  a.v[i] <  b.v[i])
+CINO_SIMD_FLOAT_OP(operator>,  a.v[i] >  b.v[i])
+CINO_SIMD_FLOAT_OP(operator>=, a.v[i] >= b.v[i])
+CINO_SIMD_FLOAT_OP(operator<=, a.v[i] <= b.v[i])
+CINO_SIMD_FLOAT_OP(operator&,  a.v[i] != 0 && b.v[i] != 0)
+CINO_SIMD_FLOAT_OP(operator|,  a.v[i] != 0 || b.v[i] != 0)
+#undef CINO_SIMD_FLOAT_OP
+inline uint movemask(const simd_float a)            { uint m = 0; for(uint i=0; i<simd_float::W; ++i) if (a.v[i] != 0) m |= (1u << i); return m; }
+inline void store   (float * p, const simd_float a) { for(uint i=0; i<simd_float::W; ++i) p[i] = a.v[i]; }
+
+#include <cinolib/ray_triangle_simd_kernels.h>
+}
+
+#endif
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+#if defined(CINO_RAY_TRIANGLE_AVX)
+
+// everything up to the matching pop is compiled for AVX capable CPUs
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx")
+#endif
+
+namespace simd_avx
+{
+
+struct simd_float
+{
+    static const uint W = 8;
+    __m256 v;
+    simd_float() {}
+    simd_float(const __m256 x) : v(x) {}
+    explicit simd_float(const float x) : v(_mm256_set1_ps(x)) {}
+    static simd_float load(const float * p) { return _mm256_loadu_ps(p); }
+};
+inline simd_float operator+ (const simd_float a, const simd_float b) { return _mm256_add_ps(a.v, b.v); }
+inline simd_float operator- (const simd_float a, const simd_float b) { return _mm256_sub_ps(a.v, b.v); }
+inline simd_float operator* (const simd_float a, const simd_float b) { return _mm256_mul_ps(a.v, b.v); }
+inline simd_float operator/ (const simd_float a, const simd_float b) { return _mm256_div_ps(a.v, b.v); }
+inline simd_float operator< (const simd_float a, const simd_float b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); }
+inline simd_float operator> (const simd_float a, const simd_float b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ); }
+inline simd_float operator>=(const simd_float a, const simd_float b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ); }
+inline simd_float operator<=(const simd_float a, const simd_float b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ); }
+inline simd_float operator& (const simd_float a, const simd_float b) { return _mm256_and_ps(a.v, b.v); }
+inline simd_float operator| (const simd_float a, const simd_float b) { return _mm256_or_ps (a.v, b.v); }
+inline uint       movemask  (const simd_float a)                     { return _mm256_movemask_ps(a.v);   }
+inline void       store     (float * p, const simd_float a)          { _mm256_storeu_ps(p, a.v);         }
+
+#include <cinolib/ray_triangle_simd_kernels.h>
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// AVX kernels may only run on CPUs (and OSes) that support them
+CINO_INLINE
+bool simd_has_avx()
+{
+#if defined(CINO_RAY_TRIANGLE_AVX)
+    static const bool avx = __builtin_cpu_supports("avx");
+    return avx;
+#else
+    return false;
+#endif
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+#if defined(CINO_RAY_TRIANGLE_SSE)
+#define CINO_SIMD_DEFAULT simd_sse
+#else
+#define CINO_SIMD_DEFAULT simd_scalar
+#endif
+
+#if defined(CINO_RAY_TRIANGLE_AVX)
+#define CINO_SIMD_DISPATCH(call) (simd_has_avx() ? simd_avx::call : CINO_SIMD_DEFAULT::call)
+#else
+#define CINO_SIMD_DISPATCH(call) (CINO_SIMD_DEFAULT::call)
+#endif
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void ray_packet_set(RayPacket    & rays,
+                    const uint     i,
+                    const vec3d  & orig,
+                    const vec3d  & dir,
+                    const double   t_min,
+                    const double   t_max)
+{
+    assert(i < RAY_PACKET_SIZE);
+    rays.ox[i]    = orig.x();
+    rays.oy[i]    = orig.y();
+    rays.oz[i]    = orig.z();
+    rays.dx[i]    = dir.x();
+    rays.dy[i]    = dir.y();
+    rays.dz[i]    = dir.z();
+    rays.t_min[i] = t_min;
+    rays.t_max[i] = t_max;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+PackedTriangles::PackedTriangles(const std::vector<vec3d> & verts,
+                                 const std::vector<uint>  & tris)
+{
+    init(verts, tris);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void PackedTriangles::init(const std::vector<vec3d> & verts,
+                           const std::vector<uint>  & tris)
+{
+    assert(tris.size()%3==0);
+    n_tris = tris.size()/3;
+
+    // padding: loads starting at any valid triangle never exceed the arrays,
+    // whatever the width of the kernels in use (8 lanes at most, with AVX)
+    uint size = n_tris + 8;
+    for(auto arr : { &v0x, &v0y, &v0z, &e1x, &e1y, &e1z, &e2x, &e2y, &e2z })
+    {
+        arr->assign(size, 0.f); // degenerate triangles never hit
+    }
+
+    for(uint tid=0; tid<n_tris; ++tid)
+    {
+        const vec3d & v0 = verts.at(tris[3*tid  ]);
+        const vec3d & v1 = verts.at(tris[3*tid+1]);
+        const vec3d & v2 = verts.at(tris[3*tid+2]);
+        vec3d e1 = v1 - v0;
+        vec3d e2 = v2 - v0;
+        v0x[tid] = v0.x(); v0y[tid] = v0.y(); v0z[tid] = v0.z();
+        e1x[tid] = e1.x(); e1y[tid] = e1.y(); e1z[tid] = e1.z();
+        e2x[tid] = e2.x(); e2y[tid] = e2.y(); e2z[tid] = e2.z();
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool PackedTriangles::closest_hit(const vec3d  & orig,
+                                  const vec3d  & dir,
+                                  const uint     beg,
+                                  const uint     end,
+                                        double & t,
+                                        uint   & tid,
+                                  const double   t_min) const
+{
+    assert(beg <= end && end <= n_tris);
+    const float * tris[9] = { v0x.data(), v0y.data(), v0z.data(), e1x.data(), e1y.data(), e1z.data(), e2x.data(), e2y.data(), e2z.data() };
+    return CINO_SIMD_DISPATCH(closest_hit(tris, orig, dir, beg, end, t, tid, t_min));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool PackedTriangles::any_hit(const vec3d  & orig,
+                              const vec3d  & dir,
+                              const uint     beg,
+                              const uint     end,
+                              const double   t_max,
+                              const double   t_min) const
+{
+    assert(beg <= end && end <= n_tris);
+    const float * tris[9] = { v0x.data(), v0y.data(), v0z.data(), e1x.data(), e1y.data(), e1z.data(), e2x.data(), e2y.data(), e2z.data() };
+    return CINO_SIMD_DISPATCH(any_hit(tris, orig, dir, beg, end, t_max, t_min));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint PackedTriangles::packet_hit(RayPacket & rays, const uint tid) const
+{
+    assert(tid < n_tris);
+    const float * tris[9] = { v0x.data(), v0y.data(), v0z.data(), e1x.data(), e1y.data(), e1z.data(), e2x.data(), e2y.data(), e2z.data() };
+    return CINO_SIMD_DISPATCH(packet_hit(tris, rays, tid));
+}
+
+#undef CINO_SIMD_DISPATCH
+#undef CINO_SIMD_DEFAULT
+
+}
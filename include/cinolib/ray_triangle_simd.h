@@ -0,0 +1,149 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_RAY_TRIANGLE_SIMD_H
+#define CINO_RAY_TRIANGLE_SIMD_H
+
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec3.h>
+
+namespace cinolib
+{
+
+/* Packet variants of the Moller-Trumbore ray/triangle intersection test,
+ * which test one ray against several triangles (or several rays against
+ * one triangle) at once. Triangles are stored in a precomputed structure
+ * of arrays layout (first vertex and the two edges emanating from it, in
+ * single precision), padded with degenerate triangles so that kernels can
+ * always load full SIMD registers.
+ *
+ * The instruction set is chosen at run time: 8 wide AVX kernels are used on
+ * CPUs that support them (with GCC/Clang, regardless of the compiler flags),
+ * 4 wide SSE kernels on any other x86-64 CPU, and a plain C++ version (which
+ * compilers can still auto-vectorize) elsewhere. Types and data layout do not
+ * depend on the instruction set, so translation units compiled with different
+ * flags can be freely mixed.
+ *
+ * PRECISION: vertices, rays and distances are stored and processed in single
+ * precision (float), to double the number of lanes per register. Hit distances
+ * are therefore accurate to about 1e-7 relative to the magnitude of the input
+ * coordinates, and rays that graze an edge or a vertex may be reported as a
+ * hit for both or neither of the incident triangles. Callers that need exact
+ * answers should use these kernels as a filter and validate candidates in
+ * double precision (e.g. with Moller_Trumbore_intersection.h).
+ *
+ * Triangles are double sided, and hits are reported for t in [t_min,t_max).
+*/
+
+static const uint RAY_PACKET_SIZE = 8;
+
+typedef struct
+{
+    // ray origins and directions (structure of arrays)
+    float ox[RAY_PACKET_SIZE], oy[RAY_PACKET_SIZE], oz[RAY_PACKET_SIZE];
+    float dx[RAY_PACKET_SIZE], dy[RAY_PACKET_SIZE], dz[RAY_PACKET_SIZE];
+    // per ray valid range. t_max is updated with the closest hit found so far
+    float t_min[RAY_PACKET_SIZE];
+    float t_max[RAY_PACKET_SIZE];
+}
+RayPacket;
+
+CINO_INLINE
+void ray_packet_set(RayPacket    & rays,
+                    const uint     i,
+                    const vec3d  & orig,
+                    const vec3d  & dir,
+                    const double   t_min = 0.0,
+                    const double   t_max = 1e30);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class PackedTriangles
+{
+    public:
+
+        explicit PackedTriangles() {}
+        explicit PackedTriangles(const std::vector<vec3d> & verts,
+                                 const std::vector<uint>  & tris); // serialized triangles (3 vids per triangle)
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void init(const std::vector<vec3d> & verts,
+                  const std::vector<uint>  & tris);
+
+        uint num_tris() const { return n_tris; }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // closest hit between a ray and triangles in [beg,end). On input t is
+        // the maximum distance, on output the distance of the closest hit (if any)
+        bool closest_hit(const vec3d  & orig,
+                         const vec3d  & dir,
+                         const uint     beg,
+                         const uint     end,
+                               double & t,
+                               uint   & tid,
+                         const double   t_min = 0.0) const;
+
+        // true if the ray hits any of the triangles in [beg,end) (e.g. shadow rays)
+        bool any_hit(const vec3d  & orig,
+                     const vec3d  & dir,
+                     const uint     beg,
+                     const uint     end,
+                     const double   t_max,
+                     const double   t_min = 0.0) const;
+
+        // tests all the rays in the packet against triangle tid. Rays that
+        // hit the triangle closer than their t_max are updated, and flagged
+        // in the returned bit mask (bit i refers to the i-th ray)
+        uint packet_hit(RayPacket & rays, const uint tid) const;
+
+    protected:
+
+        uint               n_tris = 0;
+        std::vector<float> v0x, v0y, v0z; // first vertex
+        std::vector<float> e1x, e1y, e1z; // v1 - v0
+        std::vector<float> e2x, e2y, e2z; // v2 - v0
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "ray_triangle_simd.cpp"
+#endif
+
+#endif // CINO_RAY_TRIANGLE_SIMD_H
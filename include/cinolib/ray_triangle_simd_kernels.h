@@ -0,0 +1,202 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+
+// NOTE: no include guards on purpose. This file is included by ray_triangle_simd.cpp
+// once per instruction set, within a namespace that defines the simd_float wrapper
+// (and, for instruction sets that are not enabled by default, within a region where
+// the compiler is told to target them). Do not include it anywhere else.
+
+/* Moller-Trumbore test, on all SIMD lanes at once. Each lane either carries
+ * a different triangle (one ray vs many triangles) or a different ray (many
+ * rays vs one triangle). Returns the bit mask of the lanes with a hit in
+ * [t_min,t_max), and the hit distances in t. Reference:
+ *
+ *     Fast, Minimum Storage Ray/Triangle Intersection
+ *     T. Moller and B. Trumbore
+ *     Journal of Graphics Tools, 1997
+*/
+CINO_INLINE
+uint moller_trumbore_simd(const simd_float   ox, const simd_float oy, const simd_float oz,
+                          const simd_float   dx, const simd_float dy, const simd_float dz,
+                          const simd_float v0x, const simd_float v0y, const simd_float v0z,
+                          const simd_float e1x, const simd_float e1y, const simd_float e1z,
+                          const simd_float e2x, const simd_float e2y, const simd_float e2z,
+                          const simd_float t_min,
+                          const simd_float t_max,
+                                simd_float & t)
+{
+    simd_float zero(0.f);
+    simd_float one (1.f);
+
+    simd_float px  = dy*e2z - dz*e2y;
+    simd_float py  = dz*e2x - dx*e2z;
+    simd_float pz  = dx*e2y - dy*e2x;
+    simd_float det = e1x*px + e1y*py + e1z*pz;
+    simd_float inv = one / det;
+
+    simd_float tx  = ox - v0x;
+    simd_float ty  = oy - v0y;
+    simd_float tz  = oz - v0z;
+    simd_float u   = (tx*px + ty*py + tz*pz) * inv;
+
+    simd_float qx  = ty*e1z - tz*e1y;
+    simd_float qy  = tz*e1x - tx*e1z;
+    simd_float qz  = tx*e1y - ty*e1x;
+    simd_float v   = (dx*qx + dy*qy + dz*qz) * inv;
+
+    t = (e2x*qx + e2y*qy + e2z*qz) * inv;
+
+    simd_float hit = ((det > zero) | (det < zero)) &
+                     (u >= zero) & (v >= zero) & ((u+v) <= one) &
+                     (t >= t_min) & (t < t_max);
+    return movemask(hit);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// tris points to the 9 arrays of PackedTriangles (v0x,v0y,v0z,e1x,...,e2z)
+CINO_INLINE
+bool closest_hit(const float * const * tris,
+                 const vec3d         & orig,
+                 const vec3d         & dir,
+                 const uint            beg,
+                 const uint            end,
+                       double        & t,
+                       uint          & tid,
+                 const double          t_min)
+{
+    const uint W = simd_float::W;
+
+    simd_float ox(float(orig.x())), oy(float(orig.y())), oz(float(orig.z()));
+    simd_float dx(float(dir.x())),  dy(float(dir.y())),  dz(float(dir.z()));
+    simd_float tmin(static_cast<float>(t_min));
+
+    bool  found  = false;
+    float best_t = float(t);
+    float lane_t[W];
+
+    for(uint i=beg; i<end; i+=W)
+    {
+        simd_float ti;
+        uint mask = moller_trumbore_simd(ox, oy, oz, dx, dy, dz,
+                                         simd_float::load(&tris[0][i]), simd_float::load(&tris[1][i]), simd_float::load(&tris[2][i]),
+                                         simd_float::load(&tris[3][i]), simd_float::load(&tris[4][i]), simd_float::load(&tris[5][i]),
+                                         simd_float::load(&tris[6][i]), simd_float::load(&tris[7][i]), simd_float::load(&tris[8][i]),
+                                         tmin, simd_float(best_t), ti);
+        if (end-i < W) mask &= (1u << (end-i)) - 1; // lanes beyond the range
+        if (!mask) continue;
+
+        store(lane_t, ti);
+        for(uint j=0; j<W; ++j)
+        {
+            if ((mask & (1u << j)) && lane_t[j] < best_t)
+            {
+                best_t = lane_t[j];
+                tid    = i+j;
+                found  = true;
+            }
+        }
+    }
+    if (found) t = best_t;
+    return found;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool any_hit(const float * const * tris,
+             const vec3d         & orig,
+             const vec3d         & dir,
+             const uint            beg,
+             const uint            end,
+             const double          t_max,
+             const double          t_min)
+{
+    const uint W = simd_float::W;
+
+    simd_float ox(float(orig.x())), oy(float(orig.y())), oz(float(orig.z()));
+    simd_float dx(float(dir.x())),  dy(float(dir.y())),  dz(float(dir.z()));
+    simd_float tmin(static_cast<float>(t_min));
+    simd_float tmax(static_cast<float>(t_max));
+
+    for(uint i=beg; i<end; i+=W)
+    {
+        simd_float ti;
+        uint mask = moller_trumbore_simd(ox, oy, oz, dx, dy, dz,
+                                         simd_float::load(&tris[0][i]), simd_float::load(&tris[1][i]), simd_float::load(&tris[2][i]),
+                                         simd_float::load(&tris[3][i]), simd_float::load(&tris[4][i]), simd_float::load(&tris[5][i]),
+                                         simd_float::load(&tris[6][i]), simd_float::load(&tris[7][i]), simd_float::load(&tris[8][i]),
+                                         tmin, tmax, ti);
+        if (end-i < W) mask &= (1u << (end-i)) - 1;
+        if (mask) return true;
+    }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint packet_hit(const float * const * tris,
+                      RayPacket     & rays,
+                const uint            tid)
+{
+    const uint W = simd_float::W;
+
+    simd_float v0x(tris[0][tid]), v0y(tris[1][tid]), v0z(tris[2][tid]);
+    simd_float e1x(tris[3][tid]), e1y(tris[4][tid]), e1z(tris[5][tid]);
+    simd_float e2x(tris[6][tid]), e2y(tris[7][tid]), e2z(tris[8][tid]);
+
+    uint hits = 0;
+    float lane_t[W];
+    for(uint i=0; i<RAY_PACKET_SIZE; i+=W)
+    {
+        simd_float ti;
+        uint mask = moller_trumbore_simd(simd_float::load(&rays.ox[i]), simd_float::load(&rays.oy[i]), simd_float::load(&rays.oz[i]),
+                                         simd_float::load(&rays.dx[i]), simd_float::load(&rays.dy[i]), simd_float::load(&rays.dz[i]),
+                                         v0x, v0y, v0z, e1x, e1y, e1z, e2x, e2y, e2z,
+                                         simd_float::load(&rays.t_min[i]),
+                                         simd_float::load(&rays.t_max[i]), ti);
+        if (!mask) continue;
+
+        store(lane_t, ti);
+        for(uint j=0; j<W; ++j)
+        {
+            if (mask & (1u << j)) rays.t_max[i+j] = lane_t[j];
+        }
+        hits |= mask << i;
+    }
+    return hits;
+}
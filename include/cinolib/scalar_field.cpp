@@ -36,7 +36,9 @@
 #include <cinolib/scalar_field.h>
 #include <cinolib/cino_inline.h>
 #include <cinolib/min_max_inf.h>
+#include <cinolib/io/field_file.h>
 #include <fstream>
+#include <limits>
 
 namespace cinolib
 {
@@ -145,7 +147,7 @@ CINO_INLINE
 void ScalarField::serialize(const char *filename) const
 {
     std::ofstream f;
-    f.precision(std::numeric_limits<double>::digits10+1);
+    f.precision(std::numeric_limits<double>::max_digits10);
     f.open(filename);
     assert(f.is_open());
     f << "SCALAR_FIELD " << size() << "\n";
@@ -161,8 +163,14 @@ void ScalarField::serialize(const char *filename) const
 CINO_INLINE
 void ScalarField::deserialize(const char *filename)
 {
+    if(is_field_file(filename))
+    {
+        deserialize_frame(filename, 0);
+        return;
+    }
+
     std::ifstream f;
-    f.precision(std::numeric_limits<double>::digits10+1);
+    f.precision(std::numeric_limits<double>::max_digits10);
     f.open(filename);
     assert(f.is_open());
     uint size;
@@ -175,6 +183,39 @@ void ScalarField::deserialize(const char *filename)
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+CINO_INLINE
+bool ScalarField::serialize_binary(const char *filename, const bool compress) const
+{
+    FieldFileWriter f(filename, 1);
+    return f.write(data(), rows(), 0, compress) && f.close();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool ScalarField::append_frame(const char *filename, const double time, const bool compress) const
+{
+    FieldFileWriter f(filename, 1, true);
+    return f.write(data(), rows(), time, compress) && f.close();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool ScalarField::deserialize_frame(const char *filename, const uint frame)
+{
+    FieldFileReader f(filename);
+    if(!f.is_open() || f.components()!=1 || frame>=f.num_frames())
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : deserialize_frame() : frame " << frame << " not found in " << filename << std::endl;
+        return false;
+    }
+    resize(f.frame_size(frame));
+    return f.read(frame, data());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 // for more info, see:
 // http://eigen.tuxfamily.org/dox/TopicCustomizingEigen.html
 //
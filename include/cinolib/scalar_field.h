@@ -73,7 +73,13 @@ class ScalarField : public Eigen::VectorXd, public Serializable
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
         void serialize  (const char *filename) const;
-        void deserialize(const char *filename);
+        void deserialize(const char *filename); // text or binary (first frame)
+
+        // binary format (see io/field_file.h). Frames can be appended to the same
+        // file (e.g. one per timestep) and read back individually
+        bool serialize_binary  (const char *filename, const bool compress = true) const;
+        bool append_frame      (const char *filename, const double time = 0, const bool compress = true) const;
+        bool deserialize_frame (const char *filename, const uint frame);
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
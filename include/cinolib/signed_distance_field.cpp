@@ -0,0 +1,310 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/signed_distance_field.h>
+#include <cinolib/bvh.h>
+#include <cinolib/winding_number.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/min_max_inf.h>
+#include <cinolib/geometry/triangle.h>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+namespace cinolib
+{
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void signed_distance_field(const AbstractPolygonMesh<M,V,E,P> & m,
+                           const double                         spacing,
+                                 RegularGrid                  & grid,
+                           const uint                           padding,
+                           const uint                           narrow_band)
+{
+    assert(spacing > 0);
+
+    Bbox bb = m.bbox();
+    grid.spacing = spacing;
+    grid.origin  = bb.min - vec3d(padding,padding,padding) * spacing;
+    grid.nx      = uint(std::ceil(bb.delta_x()/spacing)) + 2*padding + 1;
+    grid.ny      = uint(std::ceil(bb.delta_y()/spacing)) + 2*padding + 1;
+    grid.nz      = uint(std::ceil(bb.delta_z()/spacing)) + 2*padding + 1;
+
+    signed_distance_field(m, grid, narrow_band);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void signed_distance_field(const AbstractPolygonMesh<M,V,E,P> & m,
+                                 RegularGrid                  & grid,
+                           const uint                           narrow_band)
+{
+    assert(grid.nx>0 && grid.ny>0 && grid.nz>0);
+    assert(grid.spacing > 0);
+    assert(narrow_band > 0); // the band must separate inside from outside
+
+    // triangulate (if necessary) and build the BVH
+    std::vector<vec3d> tris;
+    std::vector<Bbox>  boxes;
+    for(uint pid=0; pid<m.num_polys(); ++pid)
+    {
+        const std::vector<uint> & tess = m.poly_tessellation(pid);
+        for(uint i=0; i<tess.size(); i+=3)
+        {
+            Bbox bb;
+            for(uint j=0; j<3; ++j)
+            {
+                tris.push_back(m.vert(tess[i+j]));
+                bb.add(tris.back());
+            }
+            boxes.push_back(bb);
+        }
+    }
+    BVH bvh(boxes);
+
+    uint   n_samples = grid.nx * grid.ny * grid.nz;
+    uint   slab      = grid.nx * grid.ny;
+    double band      = narrow_band * grid.spacing;
+
+    grid.values.assign(n_samples, inf_double);
+    std::vector<char> known(n_samples, false); // std::vector<bool> is not thread safe
+
+    // step 1: exact distances within the narrow band
+    PARALLEL_FOR(0, grid.nz, 0, [&](const uint k)
+    {
+        for(uint j=0; j<grid.ny; ++j)
+        for(uint i=0; i<grid.nx; ++i)
+        {
+            vec3d  p = grid.origin + vec3d(i,j,k) * grid.spacing;
+            uint   tid;
+            double d2;
+            auto   tri_dist = [&](const uint id) { return p.dist_squared(triangle_closest_point(p, tris[3*id], tris[3*id+1], tris[3*id+2])); };
+            if (bvh.closest_item(p, tri_dist, tid, d2, band*band))
+            {
+                uint vid = i + grid.nx*j + slab*k;
+                grid.values[vid] = std::sqrt(d2);
+                known[vid]       = true;
+            }
+        }
+    });
+
+    // step 2: propagate distances to the rest of the grid
+    fast_sweeping(grid, std::vector<bool>(known.begin(), known.end()));
+
+    // step 3: fix the sign
+    FastWindingNumber fwn(m);
+
+    PARALLEL_FOR(0, grid.nz, 0, [&](const uint k)
+    {
+        for(uint j=0; j<grid.ny; ++j)
+        for(uint i=0; i<grid.nx; ++i)
+        {
+            vec3d p = grid.origin + vec3d(i,j,k) * grid.spacing;
+            if (fwn.is_inside(p)) grid.values[i + grid.nx*j + slab*k] *= -1.0;
+        }
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void fast_sweeping(      RegularGrid       & grid,
+                   const std::vector<bool> & known,
+                   const uint                max_iters)
+{
+    assert(known.size() == grid.values.size());
+
+    int    nx   = grid.nx;
+    int    ny   = grid.ny;
+    int    nz   = grid.nz;
+    int    slab = nx*ny;
+    double h    = grid.spacing;
+    double eps  = 1e-12 * h;
+
+    // upwind (Godunov) solution of the discretized Eikonal equation
+    auto update = [&](const int i, const int j, const int k)
+    {
+        int vid = i + nx*j + slab*k;
+        if (known[vid]) return false;
+
+        double a[3] =
+        {
+            std::min((i>0) ? grid.values[vid-1]    : inf_double, (i<nx-1) ? grid.values[vid+1]    : inf_double),
+            std::min((j>0) ? grid.values[vid-nx]   : inf_double, (j<ny-1) ? grid.values[vid+nx]   : inf_double),
+            std::min((k>0) ? grid.values[vid-slab] : inf_double, (k<nz-1) ? grid.values[vid+slab] : inf_double),
+        };
+        std::sort(a, a+3);
+        if (a[0] == inf_double) return false;
+
+        double x = a[0] + h;
+        if (x > a[1])
+        {
+            double d = 2*h*h - (a[0]-a[1])*(a[0]-a[1]);
+            x = 0.5 * (a[0] + a[1] + std::sqrt(std::max(0.0,d)));
+            if (x > a[2])
+            {
+                double s  = a[0] + a[1] + a[2];
+                double s2 = a[0]*a[0] + a[1]*a[1] + a[2]*a[2];
+                x = (s + std::sqrt(std::max(0.0, s*s - 3*(s2 - h*h)))) / 3.0;
+            }
+        }
+        if (x < grid.values[vid] - eps)
+        {
+            grid.values[vid] = x;
+            return true;
+        }
+        return false;
+    };
+
+    // samples on the same hyperplane i+j+k = level are independent, hence
+    // each level is split among threads, which synchronize before moving to
+    // the next one. Threads are spawned once and live for all the sweeps,
+    // as the number of levels is too high to afford a spawn per level
+    uint n_workers = (nz < 16) ? 1 : std::min(n_threads(), uint(nz));
+    Barrier barrier(n_workers);
+    std::atomic<bool> changed[2]; // one per iteration (parity), see below
+    changed[0] = false;
+    changed[1] = false;
+
+    auto worker = [&](const uint tid)
+    {
+        for(uint iter=0; iter<max_iters; ++iter)
+        {
+            std::atomic<bool> & iter_changed = changed[iter&1];
+            bool local_change = false;
+
+            // 8 sweeping directions
+            for(int dir=0; dir<8; ++dir)
+            {
+                bool flip_i = dir & 1;
+                bool flip_j = dir & 2;
+                bool flip_k = dir & 4;
+
+                for(int level=0; level<=(nx-1)+(ny-1)+(nz-1); ++level)
+                {
+                    int k_min = std::max(0, level-(nx-1)-(ny-1));
+                    int k_max = std::min(nz-1, level);
+                    for(int kk=k_min+int(tid); kk<=k_max; kk+=n_workers)
+                    {
+                        int j_min = std::max(0, level-kk-(nx-1));
+                        int j_max = std::min(ny-1, level-kk);
+                        for(int jj=j_min; jj<=j_max; ++jj)
+                        {
+                            int ii = level - kk - jj;
+                            int i  = flip_i ? nx-1-ii : ii;
+                            int j  = flip_j ? ny-1-jj : jj;
+                            int k  = flip_k ? nz-1-kk : kk;
+                            if (update(i,j,k)) local_change = true;
+                        }
+                    }
+                    barrier.wait();
+
+                    // all threads have read the flag of the previous iteration
+                    // (the one with the other parity): reset it for the next one
+                    if (tid==0 && dir==0 && level==0) changed[(iter+1)&1] = false;
+                }
+            }
+            if (local_change) iter_changed = true;
+            barrier.wait();
+
+            if (!iter_changed) break;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(n_workers-1);
+    for(uint tid=1; tid<n_workers; ++tid) threads.emplace_back(worker, tid);
+    worker(0); // the calling thread does its share too
+    for(auto & t : threads) t.join();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void grid_to_tetmesh(const RegularGrid              & grid,
+                           Tetmesh<M,V,E,F,P>       & m)
+{
+    assert(grid.values.size() == grid.nx*grid.ny*grid.nz);
+
+    uint nx   = grid.nx;
+    uint ny   = grid.ny;
+    uint nz   = grid.nz;
+    uint slab = nx*ny;
+
+    std::vector<vec3d> verts(grid.values.size());
+    for(uint k=0; k<nz; ++k)
+    for(uint j=0; j<ny; ++j)
+    for(uint i=0; i<nx; ++i)
+    {
+        verts[i + nx*j + slab*k] = grid.origin + vec3d(i,j,k) * grid.spacing;
+    }
+
+    // Freudenthal (Kuhn) split of each cell into six tets, all sharing the
+    // diagonal between corners 0 and 7. The split is the same for all cells,
+    // hence tets of adjacent cells match conformingly along shared faces
+    static const uint axis_perm[6][3] = { {0,1,2}, {0,2,1}, {1,0,2}, {1,2,0}, {2,0,1}, {2,1,0} };
+    static const bool odd_perm [6]    = { false,   true,    true,    false,   false,   true    };
+
+    std::vector<std::vector<uint>> tets;
+    tets.reserve(6*(nx-1)*(ny-1)*(nz-1));
+    for(uint k=0; k+1<nz; ++k)
+    for(uint j=0; j+1<ny; ++j)
+    for(uint i=0; i+1<nx; ++i)
+    {
+        uint offset[3] = { 1, nx, slab };
+        uint v0 = i + nx*j + slab*k;
+        for(uint t=0; t<6; ++t)
+        {
+            uint v1 = v0 + offset[axis_perm[t][0]];
+            uint v2 = v1 + offset[axis_perm[t][1]];
+            uint v3 = v2 + offset[axis_perm[t][2]];
+            if (odd_perm[t]) tets.push_back({v0, v2, v1, v3});
+            else             tets.push_back({v0, v1, v2, v3});
+        }
+    }
+
+    m.clear();
+    m.init_tetmesh(verts, tets);
+    for(uint vid=0; vid<m.num_verts(); ++vid)
+    {
+        m.vert_data(vid).uvw[0] = grid.values[vid];
+    }
+}
+
+}
@@ -0,0 +1,144 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_SIGNED_DISTANCE_FIELD_H
+#define CINO_SIGNED_DISTANCE_FIELD_H
+
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec3.h>
+#include <cinolib/meshes/abstract_polygonmesh.h>
+#include <cinolib/meshes/tetmesh.h>
+
+namespace cinolib
+{
+
+/* Regular grid of nx * ny * nz samples. Sample (i,j,k) is located at
+ * origin + spacing * (i,j,k), and its value is stored in position
+ * i + nx * (j + ny * k) of the values array (i.e. z slabs are contiguous)
+*/
+
+typedef struct
+{
+    vec3d               origin  = vec3d(0,0,0);
+    double              spacing = 1.0;
+    uint                nx      = 0;
+    uint                ny      = 0;
+    uint                nz      = 0;
+    std::vector<double> values;
+}
+RegularGrid;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Computes the signed distance from a surface mesh at the samples of a
+ * regular grid (negative inside, positive outside). The field is computed
+ * in three steps:
+ *
+ *  1) samples within narrow_band * spacing from the surface get their
+ *     exact (unsigned) distance, by means of closest point queries on a BVH;
+ *
+ *  2) the distance is propagated to the rest of the grid by solving the
+ *     Eikonal equation |grad(d)| = 1 with the fast sweeping method:
+ *
+ *         A Fast Sweeping Method for Eikonal Equations
+ *         H. Zhao
+ *         Mathematics of Computation, 2005
+ *
+ *     Each sweep visits the grid along the hyperplanes i+j+k = const,
+ *     whose samples do not depend on each other and are updated in parallel:
+ *
+ *         A Parallel Fast Sweeping Method for the Eikonal Equation
+ *         M. Detrixhe, F. Gibou and C. Min
+ *         Journal of Computational Physics, 2013
+ *
+ *  3) the sign is determined with generalized winding numbers (see
+ *     winding_number.h), which are robust to small holes and cracks.
+ *
+ * Step (1) and (3) run in parallel over z slabs of the grid. In the first
+ * version of the function the grid is automatically fitted around the mesh
+ * bounding box (plus padding samples per side), in the second one origin,
+ * spacing and size of the grid must be set by the caller.
+ *
+ * The result can be turned into a tetmesh with grid_to_tetmesh(), and iso
+ * surfaces (e.g. offsets of the input mesh) can be extracted with marching_tets.
+*/
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void signed_distance_field(const AbstractPolygonMesh<M,V,E,P> & m,
+                           const double                         spacing,
+                                 RegularGrid                  & grid,
+                           const uint                           padding     = 2,
+                           const uint                           narrow_band = 2);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void signed_distance_field(const AbstractPolygonMesh<M,V,E,P> & m,
+                                 RegularGrid                  & grid, // origin, spacing, nx, ny, nz must be set
+                           const uint                           narrow_band = 2);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Fast sweeping: values with known[i] = true are kept fixed, all the others
+// are (re)computed as distances from the known ones. Unknown values must be
+// initialized to inf_double
+//
+CINO_INLINE
+void fast_sweeping(      RegularGrid       & grid,
+                   const std::vector<bool> & known,
+                   const uint                max_iters = 3);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Converts the grid into a tetmesh (each cell is split into six tetrahedra
+// sharing the cell diagonal). Grid values are copied into the U coordinate
+// of the vertices, which is what marching_tets uses as scalar field
+//
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void grid_to_tetmesh(const RegularGrid              & grid,
+                           Tetmesh<M,V,E,F,P>       & m);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "signed_distance_field.cpp"
+#endif
+
+#endif // CINO_SIGNED_DISTANCE_FIELD_H
@@ -38,6 +38,7 @@
 #include <cinolib/triangle_wrap.h>
 #include <cinolib/vector_serialization.h>
 #include <cinolib/ANSI_color_codes.h>
+#include <cinolib/parallel_for.h>
 
 namespace cinolib
 {
@@ -73,81 +74,178 @@ SlicedObj<M,V,E,P>::SlicedObj(const std::vector<std::vector<std::vector<vec3d>>>
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+SlicedObj<M,V,E,P>::SlicedObj(CLIReader & reader, const uint max_layers, const double thick_radius)
+    : Trimesh<M,V,E,P>()
+    , thick_radius(thick_radius)
+{
+    append_slices(reader, max_layers);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+uint SlicedObj<M,V,E,P>::append_slices(CLIReader & reader, const uint max_layers)
+{
+    std::vector<std::vector<std::vector<vec3d>>> slice_polys;
+    std::vector<std::vector<std::vector<vec3d>>> slice_holes;
+    std::vector<std::vector<std::vector<vec3d>>> supports;
+
+    CLILayer layer;
+    uint n_layers = 0;
+    bool eof      = false;
+    while(n_layers<max_layers)
+    {
+        if(!reader.next_layer(layer)) { eof = true; break; }
+        slice_polys.push_back(std::move(layer.internal_polylines));
+        slice_holes.push_back(std::move(layer.external_polylines));
+        supports.push_back(std::move(layer.open_polylines));
+        hatches.push_back(std::move(layer.hatches));
+        ++n_layers;
+    }
+    if(n_layers>0) init(slice_polys, slice_holes, supports);
+
+    // texture coordinates of previous batches depend on the
+    // number of slices: fix them once, when the file is over
+    if(eof) update_slice_uvw();
+    return n_layers;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 void SlicedObj<M,V,E,P>::init(const std::vector<std::vector<std::vector<vec3d>>> & slice_polys,
                               const std::vector<std::vector<std::vector<vec3d>>> & slice_holes,
                               const std::vector<std::vector<std::vector<vec3d>>> & supports)
 {
-    uint num_slices = slice_polys.size();
+    uint num_slices  = slice_polys.size();
+    uint first_slice = slices.size();
 
-    for(uint sid=0; sid<num_slices; ++sid)
+    // slices are independent: thicken supports and compute
+    // polygons in parallel, and append them in order
+    std::vector<float>             slice_z(num_slices);
+    std::vector<BoostMultiPolygon> slice_mp(num_slices);
+    std::vector<char>              is_empty(num_slices, false);
+
+    PARALLEL_FOR(0, num_slices, 2, [&](const uint sid)
     {
         uint np = slice_holes.at(sid).size();
-        uint nh = slice_polys.at(sid).size();
         uint ns = (thick_radius>0) ? supports.at(sid).size() : 0;
 
-        std::cout << "processing slice " << sid << " out of " << num_slices << "\t(" << np << " polys / " << nh << " holes / "  << ns << " supports)" << std::endl;
-
-        if(np>0) z.push_back(slice_holes.at(sid).front().front().z()); else
-        if(ns>0) z.push_back(supports.at(sid).front().front().z());    else
-        continue; // empty slice, skip it
+        if(np>0) slice_z.at(sid) = slice_holes.at(sid).front().front().z(); else
+        if(ns>0) slice_z.at(sid) = supports.at(sid).front().front().z();    else
+        {
+            is_empty.at(sid) = true; // empty slice, skip it
+            return;
+        }
 
         std::vector<BoostPolygon> polys;
         std::vector<BoostPolygon> holes;
-        for(auto p : slice_holes.at(sid)) polys.push_back(make_polygon(p));
-        for(auto h : slice_polys.at(sid)) holes.push_back(make_polygon(h));
+        for(const auto & p : slice_holes.at(sid)) polys.push_back(make_polygon(p));
+        for(const auto & h : slice_polys.at(sid)) holes.push_back(make_polygon(h));
         if(thick_radius>0)
         {
-            for(auto s : supports.at(sid)) polys.push_back(make_polygon(s, thick_radius));
+            for(const auto & s : supports.at(sid)) polys.push_back(make_polygon(s, thick_radius));
         }
 
         BoostMultiPolygon mp;
-        for(auto p : polys) mp = polygon_union(mp, p);
-        for(auto p : holes) mp = polygon_difference(mp, p);
+        for(const auto & p : polys) mp = polygon_union(mp, p);
+        for(const auto & p : holes) mp = polygon_difference(mp, p);
         mp = polygon_simplify(mp, 0.1*thick_radius);
 
         assert(mp.size()>0);
-        slices.push_back(mp);
+        slice_mp.at(sid) = mp;
+    });
+
+    for(uint sid=0; sid<num_slices; ++sid)
+    {
+        if(is_empty.at(sid)) continue;
+        z.push_back(slice_z.at(sid));
+        slices.push_back(std::move(slice_mp.at(sid)));
     }
+    std::cout << "processed " << num_slices << " slices (" << slices.size()-first_slice << " non empty)" << std::endl;
 
-    triangulate_slices();
+    triangulate_slices(first_slice);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 template<class M, class V, class E, class P>
 CINO_INLINE
-void SlicedObj<M,V,E,P>::triangulate_slices()
+void SlicedObj<M,V,E,P>::triangulate_slices(const uint first_slice)
 {
-    for(uint sid=0; sid<slices.size(); ++sid)
-    {
-        const BoostMultiPolygon & mp = slices.at(sid);
+    uint n = (first_slice < num_slices()) ? num_slices() - first_slice : 0;
 
-        std::vector<vec3d> verts;
-        std::vector<uint>  tris;
-        triangulate_polygon(mp, "Q", z.at(sid), verts, tris);
+    std::vector<std::vector<vec3d>> slice_verts(n);
+    std::vector<std::vector<uint>>  slice_tris(n);
+    PARALLEL_FOR(0, n, 2, [&](const uint i)
+    {
+        uint sid = first_slice + i;
+        triangulate_polygon(slices.at(sid), "Q", z.at(sid), slice_verts.at(i), slice_tris.at(i));
+    });
 
-        uint base_addr = this->num_verts();
-        uint n_tris = tris.size()/3;
+    // merge all slices, and build the connectivity in one go. Slices do not share
+    // vertices, hence previous slices are not affected by the new ones
+    uint nv0 = this->num_verts();
+    uint ne0 = this->num_edges();
+    uint np0 = this->num_polys();
 
-        for(auto p : verts)
+    std::vector<vec3d>             verts;
+    std::vector<std::vector<uint>> tris;
+    std::vector<int>               vert_slice, tri_slice;
+    for(uint i=0; i<n; ++i)
+    {
+        uint base_addr = nv0 + verts.size();
+        uint n_tris    = slice_tris.at(i).size()/3;
+        for(auto p : slice_verts.at(i))
         {
-            uint vid = this->vert_add(p);
-            this->vert_data(vid).uvw[0] = static_cast<double>(sid)/static_cast<double>(num_slices());
-            this->vert_data(vid).label  = sid;
+            verts.push_back(p);
+            vert_slice.push_back(first_slice + i);
         }
-        for(uint i=0; i<n_tris; ++i)
+        for(uint j=0; j<n_tris; ++j)
         {
-            uint pid = this->poly_add(base_addr + tris.at(3*i+0),
-                                      base_addr + tris.at(3*i+1),
-                                      base_addr + tris.at(3*i+2));
-            this->poly_data(pid).label = sid;
-            for(uint eid : this->adj_p2e(pid)) this->edge_data(eid).label = sid;
+            tris.push_back({ base_addr + slice_tris.at(i).at(3*j+0),
+                             base_addr + slice_tris.at(i).at(3*j+1),
+                             base_addr + slice_tris.at(i).at(3*j+2) });
+            tri_slice.push_back(first_slice + i);
         }
+        slice_verts.at(i).clear();
+        slice_tris.at(i).clear();
+    }
+    this->init_connectivity(verts, tris);
+
+    for(uint vid=nv0; vid<this->num_verts(); ++vid) this->vert_data(vid).label = vert_slice.at(vid-nv0);
+    for(uint pid=np0; pid<this->num_polys(); ++pid)
+    {
+        int sid = tri_slice.at(pid-np0);
+        this->poly_data(pid).label = sid;
+        for(uint eid : this->adj_p2e(pid)) this->edge_data(eid).label = sid;
+    }
+    for(uint eid=ne0; eid<this->num_edges(); ++eid)
+    {
+        this->edge_data(eid).marked = this->edge_is_boundary(eid);
+    }
+    // previous batches are not updated here (see append_slices)
+    for(uint vid=nv0; vid<this->num_verts(); ++vid)
+    {
+        this->vert_data(vid).uvw[0] = static_cast<double>(this->vert_data(vid).label)/static_cast<double>(num_slices());
     }
     std::cout << "new sliced object (" << num_slices() << " slices)" << std::endl;
-    this->edge_mark_boundaries();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void SlicedObj<M,V,E,P>::update_slice_uvw()
+{
+    for(uint vid=0; vid<this->num_verts(); ++vid)
+    {
+        this->vert_data(vid).uvw[0] = static_cast<double>(this->vert_data(vid).label)/static_cast<double>(num_slices());
+    }
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
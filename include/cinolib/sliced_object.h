@@ -38,9 +38,20 @@
 
 #include <cinolib/meshes/trimesh.h>
 #include <cinolib/boost_polygon_wrap.h>
+#include <cinolib/io/read_CLI.h>
 
 /* This class represents a sliced object as a stack of polygons.
  * Silces are also triangulated for ease of processing, IO and rendering.
+ * Slices are independent, hence they are processed in parallel (supports
+ * are thickened, polygons are merged with Boost and prepared for the
+ * triangulation), and appended to the mesh at the end. Notice that the
+ * Triangle kernel is not reentrant: triangle_wrap serializes the calls to
+ * triangulate(), hence that step runs serially, one slice at a time.
+ * Large print jobs can also be built incrementally from a CLIReader,
+ * appending a batch of layers at a time (e.g. to show the first layers
+ * while the rest of the file is still loading). The texture coordinate
+ * of each vertex is its slice id over the number of slices. Vertices of
+ * previous batches are updated only once the end of the file is reached.
 */
 
 namespace cinolib
@@ -70,6 +81,16 @@ class SlicedObj : public Trimesh<M,V,E,P>
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+        // reads (at most) the first max_layers layers. Use append_slices for the others
+        explicit SlicedObj(CLIReader & reader, const uint max_layers, const double thick_radius = 0.01);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // reads (at most) max_layers more layers, and returns how many were read (0 at the end of the file)
+        uint append_slices(CLIReader & reader, const uint max_layers);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
         uint num_slices() const { return slices.size(); }
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -90,7 +111,11 @@ class SlicedObj : public Trimesh<M,V,E,P>
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        void triangulate_slices();
+        void triangulate_slices(const uint first_slice = 0); // triangulates (and adds to the mesh) slices from first_slice on
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void update_slice_uvw(); // uvw[0] = slice id / number of slices, for all vertices
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -0,0 +1,429 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/spectral_basis.h>
+#include <cinolib/linear_solvers.h>
+#include <cinolib/laplacian.h>
+#include <cinolib/vertex_mass.h>
+#include <cinolib/mesh_hash.h>
+#include <cinolib/parallel_linear_algebra.h>
+#include <cinolib/io/cino_format.h>
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+
+namespace cinolib
+{
+
+CINO_INLINE
+bool sparse_generalized_eigs(const Eigen::SparseMatrix<double> & A,
+                             const Eigen::SparseMatrix<double> & B,
+                             const uint                          k,
+                             const double                        sigma,
+                                   Eigen::VectorXd             & eigenvalues,
+                                   Eigen::MatrixXd             & eigenvectors,
+                             const double                        tol,
+                             const uint                          max_restarts)
+{
+    assert(A.rows() == A.cols() && B.rows() == B.cols() && A.rows() == B.rows());
+    assert(k > 0 && k < (uint)A.rows());
+
+    uint n   = A.rows();
+    uint ncv = std::min(n, std::max(2*k+1, k+20)); // size of the Krylov space
+
+    // one factorization, reused at each application of the operator (A - sigma B)^-1 B
+    Eigen::SparseMatrix<double> K = A - sigma * B;
+    LinearSolver ls(SIMPLICIAL_LDLT);
+    if (!ls.compute(K))
+    {
+        std::cerr << "WARNING : sparse_generalized_eigs: factorization failed" << std::endl;
+        return false;
+    }
+
+    Eigen::MatrixXd V (n, ncv); // Krylov basis (B-orthonormal)
+    Eigen::MatrixXd BV(n, ncv); // B * V
+    Eigen::MatrixXd W (n, ncv); // OP * V
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> rnd(-1.0, 1.0);
+
+    // B-orthogonalize v against the first j basis vectors (twice is enough), and normalize it
+    auto orthonormalize = [&](Eigen::VectorXd & v, const uint j) -> bool
+    {
+        double norm0 = std::sqrt(v.dot(B*v));
+        for(uint pass=0; pass<2 && j>0; ++pass)
+        {
+            Eigen::VectorXd c = parallel_gemm_tn(BV.leftCols(j), v);
+            v -= parallel_gemm(V.leftCols(j), c);
+        }
+        double norm = std::sqrt(std::max(0.0, v.dot(B*v)));
+        if (norm <= 1e-12 * norm0 || norm == 0) return false;
+        v /= norm;
+        return true;
+    };
+
+    auto random_vector = [&](const uint j)
+    {
+        Eigen::VectorXd v(n);
+        do { for(uint i=0; i<n; ++i) v[i] = rnd(rng); }
+        while(!orthonormalize(v, j));
+        return v;
+    };
+
+    Eigen::VectorXd v = random_vector(0);
+    V.col(0)  = v;
+    BV.col(0) = B * v;
+
+    uint            j = 0;
+    Eigen::VectorXd theta;
+    Eigen::MatrixXd Y;
+    bool            converged = false;
+
+    for(uint restart=0; restart<=max_restarts; ++restart)
+    {
+        // Lanczos expansion
+        while(j < ncv)
+        {
+            Eigen::VectorXd w;
+            ls.solve(Eigen::VectorXd(BV.col(j)), w);
+            W.col(j) = w;
+            if (++j == ncv) break;
+
+            if (!orthonormalize(w, j)) w = random_vector(j); // invariant subspace found
+            V.col(j)  = w;
+            BV.col(j) = B * w;
+        }
+
+        // Rayleigh-Ritz: T = V^T B OP V, symmetric w.r.t. the B inner product
+        Eigen::MatrixXd T = parallel_gemm_tn(BV, W);
+        T = 0.5 * (T + T.transpose());
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(T);
+
+        // sort Ritz values by magnitude (the largest map to the eigenvalues closest to sigma)
+        std::vector<uint> ord(ncv);
+        std::iota(ord.begin(), ord.end(), 0);
+        std::sort(ord.begin(), ord.end(), [&](uint a, uint b)
+        {
+            return std::fabs(es.eigenvalues()[a]) > std::fabs(es.eigenvalues()[b]);
+        });
+        theta.resize(ncv);
+        Y.resize(ncv, ncv);
+        for(uint i=0; i<ncv; ++i)
+        {
+            theta[i] = es.eigenvalues()[ord[i]];
+            Y.col(i) = es.eigenvectors().col(ord[i]);
+        }
+
+        // residuals of the kept Ritz pairs: r_i = OP x_i - theta_i x_i
+        uint p = std::min(ncv-1, k + (ncv-k)/2);
+        Eigen::MatrixXd X  = parallel_gemm(V, Y.leftCols(p));
+        Eigen::MatrixXd R  = parallel_gemm(W, Y.leftCols(p)) - X * theta.head(p).asDiagonal();
+        Eigen::VectorXd rn(p);
+        for(uint i=0; i<p; ++i) rn[i] = std::sqrt(std::max(0.0, R.col(i).dot(B * R.col(i))));
+
+        converged = true;
+        for(uint i=0; i<k; ++i) if (rn[i] > tol * std::fabs(theta[i])) converged = false;
+        if (converged || restart == max_restarts) break;
+
+        // thick restart: keep the best p Ritz vectors, and continue
+        // the expansion along the direction of the residuals
+        uint best = 0;
+        for(uint i=1; i<p; ++i) if (rn[i] > rn[best]) best = i;
+        Eigen::MatrixXd Wp  = parallel_gemm(W,  Y.leftCols(p));
+        Eigen::MatrixXd BVp = parallel_gemm(BV, Y.leftCols(p));
+        V.leftCols(p)  = X;
+        W.leftCols(p)  = Wp;
+        BV.leftCols(p) = BVp;
+
+        Eigen::VectorXd r = R.col(best);
+        if (!orthonormalize(r, p)) r = random_vector(p);
+        V.col(p)  = r;
+        BV.col(p) = B * r;
+        j = p;
+    }
+
+    eigenvalues.resize(k);
+    for(uint i=0; i<k; ++i) eigenvalues[i] = sigma + 1.0/theta[i];
+    eigenvectors = parallel_gemm(V, Y.leftCols(k));
+
+    if (!converged) std::cerr << "WARNING : sparse_generalized_eigs: not all eigenpairs converged" << std::endl;
+    return converged;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+SpectralBasis::SpectralBasis(const AbstractMesh<M,V,E,P> & m,
+                             const uint                    k,
+                             const int                     laplacian_mode)
+{
+    compute(m, k, laplacian_mode);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+bool SpectralBasis::compute(const AbstractMesh<M,V,E,P> & m,
+                            const uint                    k,
+                            const int                     laplacian_mode)
+{
+    Eigen::SparseMatrix<double> L  = laplacian(m, laplacian_mode);
+    Eigen::SparseMatrix<double> MM = mass_matrix(m);
+
+    // -L is only semi definite (constant functions are in its kernel): shift slightly
+    // below zero, so that the factorized matrix is positive definite
+    double sigma = -1e-8 * (-L.diagonal().sum()) / MM.diagonal().sum();
+
+    m_hash = mesh_hash(m);
+    mode   = laplacian_mode;
+    mass_diag = MM.diagonal();
+    return sparse_generalized_eigs(-L, MM, k, sigma, evals, evecs);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+bool SpectralBasis::compute_cached(const AbstractMesh<M,V,E,P> & m,
+                                   const uint                    k,
+                                   const std::string           & cache_dir,
+                                   const int                     laplacian_mode)
+{
+    uint64_t h = mesh_hash(m);
+    std::stringstream ss;
+    ss << cache_dir << "/spectral_basis_" << std::hex << std::setw(16) << std::setfill('0') << h << "_" << std::dec << laplacian_mode << ".bin";
+    std::string filename = ss.str();
+
+    if (read(filename.c_str()) && m_hash == h && mode == laplacian_mode && size() >= k && num_verts() == m.num_verts())
+    {
+        if (size() > k)
+        {
+            evals.conservativeResize(k);
+            evecs.conservativeResize(Eigen::NoChange, k);
+        }
+        return true;
+    }
+
+    if (!compute(m, k, laplacian_mode)) return false;
+    serialize(filename.c_str());
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+ScalarField SpectralBasis::eigenfunction(const uint i) const
+{
+    assert(i < size());
+    return ScalarField(evecs.col(i));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Eigen::VectorXd SpectralBasis::project(const ScalarField & f, const uint n) const
+{
+    return project(Eigen::MatrixXd(f), n).col(0);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Eigen::MatrixXd SpectralBasis::project(const Eigen::MatrixXd & F, const uint n) const
+{
+    assert(F.rows() == evecs.rows());
+    uint nb = (n == 0) ? size() : std::min(n, size());
+    Eigen::MatrixXd MF = mass_diag.asDiagonal() * F;
+    return parallel_gemm_tn(evecs.leftCols(nb), MF);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+ScalarField SpectralBasis::reconstruct(const Eigen::VectorXd & coeffs) const
+{
+    return ScalarField(reconstruct(Eigen::MatrixXd(coeffs)).col(0));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Eigen::MatrixXd SpectralBasis::reconstruct(const Eigen::MatrixXd & C) const
+{
+    assert(C.rows() <= evecs.cols());
+    return parallel_gemm(evecs.leftCols(C.rows()), C);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+ScalarField SpectralBasis::low_pass(const ScalarField & f, const uint n) const
+{
+    return reconstruct(project(f,n));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// binary layout: "CINOSPEC" | version (uint32) | byte order mark (uint32) | hash (uint64)
+//                | laplacian mode (int32) | #verts (uint32) | #eigenpairs (uint32)
+//                | mass | eigenvalues | eigenvectors (column major)
+//
+// Data is stored in the byte order of the writer. As for .cino files, readers
+// detect the opposite endianness from the byte order mark and swap each scalar.
+// Version 1 files have no byte order mark, and are read in native order
+//
+static const char     SPECTRAL_BASIS_MAGIC[8] = {'C','I','N','O','S','P','E','C'};
+static const uint32_t SPECTRAL_BASIS_VERSION  = 2;
+
+CINO_INLINE
+void SpectralBasis::serialize(const char *filename) const
+{
+    std::ofstream f(filename, std::ios::binary);
+    if (!f.is_open())
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : serialize() : couldn't open output file " << filename << std::endl;
+        return;
+    }
+
+    uint32_t version = SPECTRAL_BASIS_VERSION;
+    uint32_t bom     = CINO_BYTE_ORDER;
+    int32_t  md      = mode;
+    uint32_t nv      = num_verts();
+    uint32_t k       = size();
+    f.write(SPECTRAL_BASIS_MAGIC, 8);
+    f.write(reinterpret_cast<const char*>(&version), sizeof(uint32_t));
+    f.write(reinterpret_cast<const char*>(&bom),     sizeof(uint32_t));
+    f.write(reinterpret_cast<const char*>(&m_hash),  sizeof(uint64_t));
+    f.write(reinterpret_cast<const char*>(&md),      sizeof(int32_t));
+    f.write(reinterpret_cast<const char*>(&nv),      sizeof(uint32_t));
+    f.write(reinterpret_cast<const char*>(&k),       sizeof(uint32_t));
+    f.write(reinterpret_cast<const char*>(mass_diag.data()),     nv*sizeof(double));
+    f.write(reinterpret_cast<const char*>(evals.data()), k*sizeof(double));
+    f.write(reinterpret_cast<const char*>(evecs.data()), size_t(nv)*k*sizeof(double));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void SpectralBasis::deserialize(const char *filename)
+{
+    if (!read(filename))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : deserialize() : couldn't read spectral basis from " << filename << std::endl;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool SpectralBasis::read(const char *filename)
+{
+    std::ifstream f(filename, std::ios::binary);
+    if (!f.is_open()) return false;
+
+    f.seekg(0, std::ios::end);
+    uint64_t file_size = f.tellg();
+    f.seekg(0, std::ios::beg);
+
+    char     magic[8];
+    uint32_t version, bom = CINO_BYTE_ORDER, nv, k;
+    int32_t  md;
+    uint64_t h;
+    f.read(magic, 8);
+    f.read(reinterpret_cast<char*>(&version), sizeof(uint32_t));
+    if (!f || std::memcmp(magic, SPECTRAL_BASIS_MAGIC, 8) != 0) return false;
+
+    // the version itself may be byte swapped
+    bool swap = false;
+    if (version != 1 && version != SPECTRAL_BASIS_VERSION)
+    {
+        swap_byte_order(&version, sizeof(uint32_t), 1);
+        if (version != SPECTRAL_BASIS_VERSION) return false;
+        swap = true;
+    }
+    if (version >= 2)
+    {
+        f.read(reinterpret_cast<char*>(&bom), sizeof(uint32_t));
+        if (swap) swap_byte_order(&bom, sizeof(uint32_t), 1);
+        if (!f || bom != CINO_BYTE_ORDER) return false;
+    }
+    f.read(reinterpret_cast<char*>(&h),  sizeof(uint64_t));
+    f.read(reinterpret_cast<char*>(&md), sizeof(int32_t));
+    f.read(reinterpret_cast<char*>(&nv), sizeof(uint32_t));
+    f.read(reinterpret_cast<char*>(&k),  sizeof(uint32_t));
+    if (!f) return false;
+    if (swap)
+    {
+        swap_byte_order(&h,  sizeof(uint64_t), 1);
+        swap_byte_order(&md, sizeof(int32_t),  1);
+        swap_byte_order(&nv, sizeof(uint32_t), 1);
+        swap_byte_order(&k,  sizeof(uint32_t), 1);
+    }
+
+    // validate the sizes before allocating anything: a corrupted header could
+    // otherwise trigger huge allocations, or reads past the end of the file
+    uint64_t header_size = f.tellg();
+    uint64_t payload     = (uint64_t(nv) + uint64_t(k) + uint64_t(nv)*uint64_t(k)) * sizeof(double);
+    if (k > nv || file_size < header_size || file_size - header_size != payload) return false;
+
+    Eigen::VectorXd mass(nv), ev(k);
+    Eigen::MatrixXd ef(nv, k);
+    f.read(reinterpret_cast<char*>(mass.data()), nv*sizeof(double));
+    f.read(reinterpret_cast<char*>(ev.data()),   k*sizeof(double));
+    f.read(reinterpret_cast<char*>(ef.data()),   size_t(nv)*k*sizeof(double));
+    if (!f) return false;
+    if (swap)
+    {
+        swap_byte_order(mass.data(), sizeof(double), nv);
+        swap_byte_order(ev.data(),   sizeof(double), k);
+        swap_byte_order(ef.data(),   sizeof(double), size_t(nv)*k);
+    }
+
+    m_hash = h;
+    mode   = md;
+    mass_diag = mass;
+    evals  = ev;
+    evecs  = ef;
+    return true;
+}
+
+}
@@ -0,0 +1,172 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_SPECTRAL_BASIS_H
+#define CINO_SPECTRAL_BASIS_H
+
+#include <string>
+#include <cstdint>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/scalar_field.h>
+#include <cinolib/serializable.h>
+#include <cinolib/symbols.h>
+#include <cinolib/meshes/abstract_mesh.h>
+#include <Eigen/Sparse>
+#include <Eigen/Dense>
+
+namespace cinolib
+{
+
+/* Solves the generalized symmetric eigenproblem A x = lambda B x (A symmetric,
+ * B symmetric positive definite) for the k eigenvalues closest to sigma, using
+ * the shift-invert spectral transformation
+ *
+ *     (A - sigma B)^-1 B x = theta x,    lambda = sigma + 1/theta
+ *
+ * which maps the wanted eigenvalues to the largest (and well separated) ones
+ * of an operator that is self-adjoint w.r.t. the B inner product. A - sigma B
+ * is factorized once, and each iteration costs a back-substitution. The
+ * Krylov space is expanded with Lanczos, with full B-reorthogonalization, and
+ * restarted keeping the best Ritz vectors (thick restart), see:
+ *
+ *     Thick-Restart Lanczos Method for Large Symmetric Eigenvalue Problems
+ *     K. Wu and H. Simon
+ *     SIAM Journal on Matrix Analysis and Applications, 2000
+ *
+ * Eigenvalues are sorted by distance from sigma, and eigenvectors are
+ * B-orthonormal (X^T B X = I). Returns false if the factorization fails or
+ * not all the eigenpairs converged within max_restarts.
+*/
+
+CINO_INLINE
+bool sparse_generalized_eigs(const Eigen::SparseMatrix<double> & A,
+                             const Eigen::SparseMatrix<double> & B,
+                             const uint                          k,
+                             const double                        sigma,
+                                   Eigen::VectorXd             & eigenvalues,
+                                   Eigen::MatrixXd             & eigenvectors,
+                             const double                        tol          = 1e-10,
+                             const uint                          max_restarts = 100);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* First k eigenpairs of the Laplace-Beltrami operator, i.e. the solutions of
+ *
+ *     -L phi = lambda M phi
+ *
+ * where L is the (cotangent) laplacian and M the (lumped) mass matrix of the
+ * mesh. Eigenfunctions are M-orthonormal, hence any scalar field f can be
+ * projected onto the basis as c = Phi^T M f, and reconstructed as f = Phi c.
+ * Truncated reconstructions act as low pass filters, and the eigenfunctions
+ * are the building blocks of many shape descriptors (e.g. HKS, WKS), spectral
+ * distances and spectral clustering.
+ *
+ * Computing the basis is expensive: compute_cached() stores it in a binary
+ * file named after the hash of the mesh (see mesh_hash.h), and loads it (if
+ * valid, and with at least k eigenpairs) instead of recomputing it. The same
+ * binary format is used by serialize() and deserialize().
+*/
+
+class SpectralBasis : public Serializable
+{
+    public:
+
+        explicit SpectralBasis() {}
+
+        template<class M, class V, class E, class P>
+        explicit SpectralBasis(const AbstractMesh<M,V,E,P> & m,
+                               const uint                    k,
+                               const int                     laplacian_mode = COTANGENT);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        template<class M, class V, class E, class P>
+        bool compute(const AbstractMesh<M,V,E,P> & m,
+                     const uint                    k,
+                     const int                     laplacian_mode = COTANGENT);
+
+        template<class M, class V, class E, class P>
+        bool compute_cached(const AbstractMesh<M,V,E,P> & m,
+                            const uint                    k,
+                            const std::string           & cache_dir,
+                            const int                     laplacian_mode = COTANGENT);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        uint size()      const { return evals.rows(); }
+        uint num_verts() const { return evecs.rows(); }
+        uint64_t hash()  const { return m_hash;       }
+
+        const Eigen::VectorXd & eigenvalues()  const { return evals;     }
+        const Eigen::MatrixXd & eigenvectors() const { return evecs;     }
+        const Eigen::VectorXd & mass()         const { return mass_diag; }
+
+        ScalarField eigenfunction(const uint i) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // spectral coefficients of f w.r.t. the first n eigenfunctions (n=0 => all)
+        Eigen::VectorXd project(const ScalarField     & f, const uint n = 0) const;
+        Eigen::MatrixXd project(const Eigen::MatrixXd & F, const uint n = 0) const; // one field per column
+
+        ScalarField     reconstruct(const Eigen::VectorXd & coeffs) const;
+        Eigen::MatrixXd reconstruct(const Eigen::MatrixXd & C)      const; // one field per column
+
+        ScalarField     low_pass(const ScalarField & f, const uint n) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void serialize  (const char *filename) const;
+        void deserialize(const char *filename);
+
+    protected:
+
+        uint64_t        m_hash = 0;
+        int             mode   = COTANGENT;
+        Eigen::VectorXd evals;
+        Eigen::MatrixXd evecs;     // one eigenfunction per column
+        Eigen::VectorXd mass_diag; // lumped mass
+
+        bool read(const char *filename);
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "spectral_basis.cpp"
+#endif
+
+#endif // CINO_SPECTRAL_BASIS_H
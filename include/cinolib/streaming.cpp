@@ -0,0 +1,369 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/streaming.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/min_max_inf.h>
+#include <cinolib/quality_tet.h>
+#include <cinolib/quality_hex.h>
+#include <cinolib/standard_elements_tables.h>
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/meshes/quadmesh.h>
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+
+namespace cinolib
+{
+
+template<class Func>
+CINO_INLINE
+uint stream_polys(MeshStreamReader & in, const Func & func)
+{
+    uint count = 0;
+    MeshChunk chunk;
+    in.rewind();
+    while(in.next_chunk(chunk))
+    {
+        func(chunk);
+        count += chunk.num_polys();
+    }
+    return count;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Metric>
+CINO_INLINE
+bool stream_quality(MeshStreamReader & in,
+                    const Metric     & metric,
+                    double           & min,
+                    double           & avg,
+                    uint             & n_inverted)
+{
+    min        = inf_double;
+    avg        = 0;
+    n_inverted = 0;
+
+    std::vector<double> q;
+    uint count = stream_polys(in, [&](const MeshChunk & chunk)
+    {
+        uint np  = chunk.num_polys();
+        uint vpp = chunk.verts_per_poly;
+        q.resize(np);
+        PARALLEL_FOR(0, np, 1000, [&](const uint pid)
+        {
+            vec3d p[8];
+            for(uint off=0; off<vpp; ++off) p[off] = chunk.poly_vert(pid,off);
+            q[pid] = metric(p);
+        });
+        for(double qi : q)
+        {
+            min  = std::min(min, qi);
+            avg += qi;
+            if(qi<=0) ++n_inverted;
+        }
+    });
+
+    if(count>0) avg /= static_cast<double>(count);
+    return count==in.num_polys();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool stream_quality(MeshStreamReader & in,
+                    double           & min,
+                    double           & avg,
+                    uint             & n_inverted)
+{
+    if(in.mesh_type()==TETMESH)
+    {
+        return stream_quality(in, [](const vec3d * p)
+        {
+            return tet_scaled_jacobian(p[0], p[1], p[2], p[3]);
+        },
+        min, avg, n_inverted);
+    }
+    return stream_quality(in, [](const vec3d * p)
+    {
+        return hex_scaled_jacobian(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]);
+    },
+    min, avg, n_inverted);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool stream_export_surface(MeshStreamReader               & in,
+                           std::vector<vec3d>             & verts,
+                           std::vector<std::vector<uint>> & polys,
+                           std::vector<uint>              & srf2m_vmap,
+                           const uint                       max_faces)
+{
+    verts.clear();
+    polys.clear();
+    srf2m_vmap.clear();
+    if(!in.is_open()) return false;
+
+    bool tets = (in.mesh_type()==TETMESH);
+    uint fpp  = tets ? 4 : 6;
+    uint vpf  = tets ? 3 : 4;
+
+    // faces are assigned to the bucket containing their smallest vertex id,
+    // so that a face and its twin always end up in the same bucket
+    uint64_t n_faces   = static_cast<uint64_t>(in.num_polys())*fpp;
+    uint     n_buckets = std::max<uint64_t>(1, (n_faces + max_faces - 1) / std::max(max_faces,1u));
+    uint     nv        = in.num_verts();
+
+    typedef std::array<uint,4> Face; // pad triangles with max_uint
+    std::vector<std::pair<Face,Face>> faces; // (sorted ids, oriented ids)
+    std::vector<Face> srf;
+
+    for(uint b=0; b<n_buckets; ++b)
+    {
+        uint vbeg = static_cast<uint64_t>(nv)* b   /n_buckets;
+        uint vend = static_cast<uint64_t>(nv)*(b+1)/n_buckets;
+
+        faces.clear();
+        uint count = stream_polys(in, [&](const MeshChunk & chunk)
+        {
+            for(uint pid=0; pid<chunk.num_polys(); ++pid)
+            for(uint fid=0; fid<fpp; ++fid)
+            {
+                Face f = {{ max_uint, max_uint, max_uint, max_uint }};
+                for(uint off=0; off<vpf; ++off)
+                {
+                    f[off] = chunk.poly_vert_id(pid, tets ? TET_FACES[fid][off] : HEXA_FACES[fid][off]);
+                }
+                Face key = f;
+                std::sort(key.begin(), key.end());
+                if(key[0]>=vbeg && key[0]<vend) faces.push_back(std::make_pair(key,f));
+            }
+        });
+        if(count!=in.num_polys()) return false;
+
+        // faces that appear only once are on the boundary
+        std::sort(faces.begin(), faces.end());
+        for(size_t i=0; i<faces.size();)
+        {
+            size_t j = i+1;
+            while(j<faces.size() && faces[j].first==faces[i].first) ++j;
+            if(j-i==1) srf.push_back(faces[i].second);
+            i = j;
+        }
+    }
+
+    // fetch surface vertices (by increasing global id) and switch to surface ids
+    for(const Face & f : srf)
+    for(uint off=0; off<vpf; ++off) srf2m_vmap.push_back(f[off]);
+    std::sort(srf2m_vmap.begin(), srf2m_vmap.end());
+    srf2m_vmap.erase(std::unique(srf2m_vmap.begin(), srf2m_vmap.end()), srf2m_vmap.end());
+    if(!in.read_verts(srf2m_vmap, verts)) return false;
+
+    polys.reserve(srf.size());
+    for(const Face & f : srf)
+    {
+        std::vector<uint> p(vpf);
+        for(uint off=0; off<vpf; ++off)
+        {
+            p[off] = std::lower_bound(srf2m_vmap.begin(), srf2m_vmap.end(), f[off]) - srf2m_vmap.begin();
+        }
+        polys.push_back(p);
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F>
+CINO_INLINE
+bool stream_export_surface(MeshStreamReader             & in,
+                           AbstractPolygonMesh<M,V,E,F> & srf,
+                           std::vector<uint>            & srf2m_vmap,
+                           const uint                     max_faces)
+{
+    std::vector<vec3d>             verts;
+    std::vector<std::vector<uint>> polys;
+    if(!stream_export_surface(in, verts, polys, srf2m_vmap, max_faces)) return false;
+
+    switch (in.mesh_type())
+    {
+        case TETMESH : srf = Trimesh<M,V,E,F>(verts, polys);  break;
+        case HEXMESH : srf = Quadmesh<M,V,E,F>(verts, polys); break;
+        default      : assert(false);
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Field>
+CINO_INLINE
+bool stream_marching_tets(MeshStreamReader   & in,
+                          const Field        & field,
+                          const double         isovalue,
+                          std::vector<vec3d> & verts,
+                          std::vector<uint>  & tris,
+                          std::vector<vec3d> & norms)
+{
+    verts.clear();
+    tris.clear();
+    norms.clear();
+    if(!in.is_open() || in.mesh_type()!=TETMESH) return false;
+
+    // Vertices are classified as above (f >= isovalue) or below (f < isovalue).
+    // Iso-vertices are keyed by the global ids of their edge, or by the global
+    // id of the mesh vertex they coincide with, if f is exactly the isovalue.
+    // In the latter case some triangles collapse, and are discarded
+    std::unordered_map<uint64_t,uint> iso_vmap;
+    std::vector<double> f;
+
+    auto iso_vert = [&](const MeshChunk & chunk, uint a, uint b) -> uint // a below, b above
+    {
+        uint     va  = chunk.vids[a];
+        uint     vb  = chunk.vids[b];
+        bool     on  = (f[b]==isovalue);
+        uint64_t key = on ? (static_cast<uint64_t>(vb)<<32 | vb)
+                          : (static_cast<uint64_t>(std::min(va,vb))<<32 | std::max(va,vb));
+        auto query = iso_vmap.find(key);
+        if(query!=iso_vmap.end()) return query->second;
+
+        double alpha = (isovalue - f[a]) / (f[b] - f[a]);
+        verts.push_back(on ? chunk.verts[b] : (1.0-alpha)*chunk.verts[a] + alpha*chunk.verts[b]);
+        iso_vmap[key] = verts.size()-1;
+        return verts.size()-1;
+    };
+
+    auto add_tri = [&](const uint v0, const uint v1, const uint v2, const vec3d & dir)
+    {
+        if(v0==v1 || v1==v2 || v2==v0) return;
+        vec3d n = (verts.at(v1)-verts.at(v0)).cross(verts.at(v2)-verts.at(v0));
+        if(n.dot(dir)<0)
+        {
+            tris.push_back(v0); tris.push_back(v2); tris.push_back(v1);
+            n = -n;
+        }
+        else
+        {
+            tris.push_back(v0); tris.push_back(v1); tris.push_back(v2);
+        }
+        n.normalize();
+        norms.push_back(n);
+    };
+
+    uint count = stream_polys(in, [&](const MeshChunk & chunk)
+    {
+        f.resize(chunk.vids.size());
+        for(uint vid=0; vid<chunk.vids.size(); ++vid) f[vid] = field(chunk.vids[vid], chunk.verts[vid]);
+
+        for(uint pid=0; pid<chunk.num_polys(); ++pid)
+        {
+            const uint * v = chunk.polys.data() + 4*pid;
+            uint below[4], above[4], nb = 0, na = 0;
+            for(uint off=0; off<4; ++off)
+            {
+                if(f[v[off]]>=isovalue) above[na++] = v[off];
+                else                    below[nb++] = v[off];
+            }
+            if(na==0 || nb==0) continue;
+
+            // triangles are oriented along the gradient, i.e. from below to above
+            vec3d cb(0,0,0), ca(0,0,0);
+            for(uint i=0; i<nb; ++i) cb += chunk.verts[below[i]];
+            for(uint i=0; i<na; ++i) ca += chunk.verts[above[i]];
+            vec3d dir = ca/static_cast<double>(na) - cb/static_cast<double>(nb);
+
+            if(nb==1)
+            {
+                add_tri(iso_vert(chunk, below[0], above[0]),
+                        iso_vert(chunk, below[0], above[1]),
+                        iso_vert(chunk, below[0], above[2]), dir);
+            }
+            else if(na==1)
+            {
+                add_tri(iso_vert(chunk, below[0], above[0]),
+                        iso_vert(chunk, below[1], above[0]),
+                        iso_vert(chunk, below[2], above[0]), dir);
+            }
+            else // quad
+            {
+                uint q0 = iso_vert(chunk, below[0], above[0]);
+                uint q1 = iso_vert(chunk, below[0], above[1]);
+                uint q2 = iso_vert(chunk, below[1], above[1]);
+                uint q3 = iso_vert(chunk, below[1], above[0]);
+                add_tri(q0, q1, q2, dir);
+                add_tri(q0, q2, q3, dir);
+            }
+        }
+    });
+    return count==in.num_polys();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Label>
+CINO_INLINE
+bool stream_label_polys(MeshStreamReader & in,
+                        const char       * filename,
+                        const Label      & label)
+{
+    if(!in.is_open()) return false;
+    MeshStreamWriter out(filename, in.mesh_type());
+    if(!out.is_open()) return false;
+
+    std::vector<vec3d> verts;
+    std::vector<int>   vert_labels;
+    for(uint vbeg=0; vbeg<in.num_verts(); vbeg+=in.chunk_size())
+    {
+        uint vend = std::min(vbeg+in.chunk_size(), in.num_verts());
+        if(!in.read_verts(vbeg, vend, verts, &vert_labels)) return false;
+        out.write_verts(verts, vert_labels);
+    }
+
+    std::vector<uint> polys;
+    std::vector<int>  poly_labels;
+    uint count = stream_polys(in, [&](const MeshChunk & chunk)
+    {
+        polys.resize(chunk.polys.size());
+        poly_labels.resize(chunk.num_polys());
+        for(size_t i=0; i<polys.size(); ++i) polys[i] = chunk.vids[chunk.polys[i]];
+        for(uint pid=0; pid<chunk.num_polys(); ++pid) poly_labels[pid] = label(chunk, pid);
+        out.write_polys(polys, poly_labels);
+    });
+    return out.close() && count==in.num_polys();
+}
+
+}
@@ -0,0 +1,134 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_STREAMING_H
+#define CINO_STREAMING_H
+
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/io/mesh_stream.h>
+#include <cinolib/meshes/abstract_polygonmesh.h>
+
+namespace cinolib
+{
+
+/* Per-element passes over tetrahedral and hexahedral meshes that are read
+ * chunk by chunk with a MeshStreamReader (see io/mesh_stream.h), hence in
+ * memory bounded by the chunk size rather than by the size of the mesh.
+ *
+ * Data that crosses chunk boundaries is always addressed by global vertex
+ * id: iso-vertices are shared through the (global) ids of the edge they
+ * sit on, and boundary faces are detected by splitting the vertex id range
+ * in buckets and matching, one bucket at a time, all faces whose smallest
+ * vertex id falls in it (max_faces bounds the number of faces kept in
+ * memory at any time, so big meshes may require multiple passes).
+*/
+
+// calls func(chunk) for each chunk and returns the number of streamed polys
+template<class Func>
+CINO_INLINE
+uint stream_polys(MeshStreamReader & in, const Func & func);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// metric(const vec3d * p) receives the 4 (tets) or 8 (hexes) poly vertices.
+// Elements with non positive quality are counted as inverted
+template<class Metric>
+CINO_INLINE
+bool stream_quality(MeshStreamReader & in,
+                    const Metric     & metric,
+                    double           & min,
+                    double           & avg,
+                    uint             & n_inverted);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// scaled jacobian (tet_scaled_jacobian / hex_scaled_jacobian)
+CINO_INLINE
+bool stream_quality(MeshStreamReader & in,
+                    double           & min,
+                    double           & avg,
+                    uint             & n_inverted);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// boundary faces with outgoing normals. srf2m_vmap[vid] is the global id of surface vertex vid
+CINO_INLINE
+bool stream_export_surface(MeshStreamReader               & in,
+                           std::vector<vec3d>             & verts,
+                           std::vector<std::vector<uint>> & polys,
+                           std::vector<uint>              & srf2m_vmap,
+                           const uint                       max_faces = 1<<24);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F>
+CINO_INLINE
+bool stream_export_surface(MeshStreamReader             & in,
+                           AbstractPolygonMesh<M,V,E,F> & srf,
+                           std::vector<uint>            & srf2m_vmap,
+                           const uint                     max_faces = 1<<24);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// iso-surface of field(vid,pos), a scalar function evaluated at each vertex
+// (vid is the global vertex id). Tets only. Triangle normals point towards
+// increasing values of the field
+template<class Field>
+CINO_INLINE
+bool stream_marching_tets(MeshStreamReader   & in,
+                          const Field        & field,
+                          const double         isovalue,
+                          std::vector<vec3d> & verts,
+                          std::vector<uint>  & tris,
+                          std::vector<vec3d> & norms);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// copies the mesh to a MESH file, assigning to each element the label
+// returned by label(chunk,pid), where pid is a chunk-local poly id
+template<class Label>
+CINO_INLINE
+bool stream_label_polys(MeshStreamReader & in,
+                        const char       * filename,
+                        const Label      & label);
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "streaming.cpp"
+#endif
+
+#endif // CINO_STREAMING_H
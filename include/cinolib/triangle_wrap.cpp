@@ -36,6 +36,7 @@
 #include <cinolib/triangle_wrap.h>
 #include <cinolib/geometry/vec3.h>
 #include <cinolib/vector_serialization.h>
+#include <mutex>
 
 #ifdef CINOLIB_USES_TRIANGLE
     /*
@@ -124,7 +125,15 @@ void triangle_wrap(const std::vector<double> & coords_in,
 
     std::string s = flags + "pzB";
 
-    triangulate(const_cast<char*>(s.c_str()), &in, &out, NULL);
+    // Triangle keeps part of its state in global variables (the error bounds of
+    // its exact predicates, and the seed of its random generator), hence it is not
+    // reentrant. Concurrent calls (e.g. from SlicedObj) are serialized here, while
+    // the rest of the wrapper runs in parallel
+    static std::mutex triangle_mutex;
+    {
+        std::lock_guard<std::mutex> lock(triangle_mutex);
+        triangulate(const_cast<char*>(s.c_str()), &in, &out, NULL);
+    }
 
     coords_out.reserve(out.numberofpoints*2);
     for(int vid=0; vid<out.numberofpoints; ++vid)
@@ -34,7 +34,9 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/vector_field.h>
+#include <cinolib/io/field_file.h>
 #include <fstream>
+#include <limits>
 
 namespace cinolib
 {
@@ -111,7 +113,7 @@ CINO_INLINE
 void VectorField::serialize(const char *filename) const
 {
     std::ofstream f;
-    f.precision(std::numeric_limits<double>::digits10+1);
+    f.precision(std::numeric_limits<double>::max_digits10);
     f.open(filename);
     assert(f.is_open());
     f << "VECTOR_FIELD " << size()/3 << "\n";
@@ -127,8 +129,14 @@ void VectorField::serialize(const char *filename) const
 CINO_INLINE
 void VectorField::deserialize(const char *filename)
 {
+    if(is_field_file(filename))
+    {
+        deserialize_frame(filename, 0);
+        return;
+    }
+
     std::ifstream f;
-    f.precision(std::numeric_limits<double>::digits10+1);
+    f.precision(std::numeric_limits<double>::max_digits10);
     f.open(filename);
     assert(f.is_open());
     uint size;
@@ -141,6 +149,39 @@ void VectorField::deserialize(const char *filename)
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+CINO_INLINE
+bool VectorField::serialize_binary(const char *filename, const bool compress) const
+{
+    FieldFileWriter f(filename, 3);
+    return f.write(data(), rows(), 0, compress) && f.close();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool VectorField::append_frame(const char *filename, const double time, const bool compress) const
+{
+    FieldFileWriter f(filename, 3, true);
+    return f.write(data(), rows(), time, compress) && f.close();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool VectorField::deserialize_frame(const char *filename, const uint frame)
+{
+    FieldFileReader f(filename);
+    if(!f.is_open() || f.components()!=3 || frame>=f.num_frames())
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : deserialize_frame() : frame " << frame << " not found in " << filename << std::endl;
+        return false;
+    }
+    resize(f.frame_size(frame));
+    return f.read(frame, data());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 // for more info, see:
 // http://eigen.tuxfamily.org/dox/TopicCustomizingEigen.html
 //
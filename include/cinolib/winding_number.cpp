@@ -0,0 +1,288 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/winding_number.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/pi.h>
+#include <cmath>
+
+namespace cinolib
+{
+
+CINO_INLINE
+double triangle_solid_angle(const vec3d & p,
+                            const vec3d & v0,
+                            const vec3d & v1,
+                            const vec3d & v2)
+{
+    vec3d  a  = v0 - p;
+    vec3d  b  = v1 - p;
+    vec3d  c  = v2 - p;
+    double la = a.length();
+    double lb = b.length();
+    double lc = c.length();
+
+    double num = a.dot(b.cross(c));
+    double den = la*lb*lc + a.dot(b)*lc + b.dot(c)*la + c.dot(a)*lb;
+
+    return 2.0 * atan2(num, den);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+FastWindingNumber::FastWindingNumber(const AbstractPolygonMesh<M,V,E,P> & m,
+                                     const double                         beta,
+                                     const uint                           max_tris_per_leaf)
+{
+    std::vector<uint> tris;
+    for(uint pid=0; pid<m.num_polys(); ++pid)
+    {
+        const std::vector<uint> & tess = m.poly_tessellation(pid);
+        tris.insert(tris.end(), tess.begin(), tess.end());
+    }
+    init(m.vector_verts(), tris, beta, max_tris_per_leaf);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+FastWindingNumber::FastWindingNumber(const std::vector<vec3d> & verts,
+                                     const std::vector<uint>  & tris,
+                                     const double               beta,
+                                     const uint                 max_tris_per_leaf)
+{
+    init(verts, tris, beta, max_tris_per_leaf);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void FastWindingNumber::init(const std::vector<vec3d> & verts,
+                             const std::vector<uint>  & t,
+                             const double               beta,
+                             const uint                 max_tris_per_leaf)
+{
+    assert(t.size()%3==0);
+    assert(beta > 0);
+
+    this->beta = beta;
+
+    uint n_tris = t.size()/3;
+    std::vector<Bbox> boxes(n_tris);
+    for(uint i=0; i<n_tris; ++i)
+    {
+        boxes[i].add(verts.at(t[3*i  ]));
+        boxes[i].add(verts.at(t[3*i+1]));
+        boxes[i].add(verts.at(t[3*i+2]));
+    }
+    bvh.build(boxes, max_tris_per_leaf);
+
+    // the traversal pops a node and pushes its two children, therefore the
+    // stack never holds more than one node per level plus one extra child
+    stack_size = bvh.depth() + 1;
+
+    tris.resize(3*n_tris);
+    for(uint i=0; i<n_tris; ++i)
+    {
+        uint tid = bvh.item(i);
+        tris[3*i  ] = verts[t[3*tid  ]];
+        tris[3*i+1] = verts[t[3*tid+1]];
+        tris[3*i+2] = verts[t[3*tid+2]];
+    }
+
+    // compute dipoles bottom up. Children are always stored after
+    // their father, hence visiting nodes backwards is enough
+    uint n_nodes = bvh.num_nodes();
+    node_center.assign(n_nodes, vec3d(0,0,0));
+    node_normal.assign(n_nodes, vec3d(0,0,0));
+    node_moment.assign(3*n_nodes, vec3d(0,0,0));
+    node_radius.assign(n_nodes, 0.0);
+    std::vector<double> node_area(n_nodes, 0.0);
+
+    for(int nid=n_nodes-1; nid>=0; --nid)
+    {
+        const BVHNode & n = bvh.node(nid);
+        if (n.is_leaf)
+        {
+            for(uint i=n.beg; i<n.end; ++i)
+            {
+                const vec3d & v0 = tris[3*i  ];
+                const vec3d & v1 = tris[3*i+1];
+                const vec3d & v2 = tris[3*i+2];
+                vec3d  an = 0.5 * (v1-v0).cross(v2-v0);
+                double a  = an.length();
+                node_normal[nid] += an;
+                node_center[nid] += a * (v0+v1+v2)/3.0;
+                node_area[nid]   += a;
+            }
+        }
+        else
+        {
+            for(uint c : n.children)
+            {
+                node_normal[nid] += node_normal[c];
+                node_center[nid] += node_area[c] * node_center[c];
+                node_area[nid]   += node_area[c];
+            }
+        }
+
+        if (node_area[nid] > 0) node_center[nid] /= node_area[nid];
+        else                    node_center[nid]  = n.bbox.center();
+
+        // now that the center is known, compute the first order moments.
+        // For internal nodes the moments of the children are translated
+        // from their centers to the center of the father
+        vec3d * S = &node_moment[3*nid];
+        if (n.is_leaf)
+        {
+            for(uint i=n.beg; i<n.end; ++i)
+            {
+                const vec3d & v0 = tris[3*i  ];
+                const vec3d & v1 = tris[3*i+1];
+                const vec3d & v2 = tris[3*i+2];
+                vec3d an = 0.5 * (v1-v0).cross(v2-v0);
+                vec3d d  = (v0+v1+v2)/3.0 - node_center[nid];
+                for(uint j=0; j<3; ++j) S[j] += an[j] * d;
+            }
+        }
+        else
+        {
+            for(uint c : n.children)
+            {
+                vec3d d = node_center[c] - node_center[nid];
+                for(uint j=0; j<3; ++j) S[j] += node_moment[3*c+j] + node_normal[c][j] * d;
+            }
+        }
+
+        for(const vec3d & c : n.bbox.corners())
+        {
+            node_radius[nid] = std::max(node_radius[nid], c.dist(node_center[nid]));
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double FastWindingNumber::winding_number(const vec3d & p) const
+{
+    if (bvh.empty()) return 0.0;
+
+    // use a small buffer on the stack for all reasonable trees, and
+    // fall back to the heap for deep (i.e. very unbalanced) ones
+    uint              local_stack[128];
+    std::vector<uint> heap_stack;
+    uint *            stack = local_stack;
+    if (stack_size > 128)
+    {
+        heap_stack.resize(stack_size);
+        stack = heap_stack.data();
+    }
+
+    double omega = 0.0;
+    uint   top   = 0;
+    stack[top++] = 0;
+
+    while(top>0)
+    {
+        uint nid = stack[--top];
+        const BVHNode & n = bvh.node(nid);
+
+        vec3d  d    = node_center[nid] - p;
+        double dist = d.length();
+
+        if (dist > beta * node_radius[nid]) // far field: use the expansion
+        {
+            // kernel: K(x) = (x-p)/|x-p|^3, J(x) = I/|x-p|^3 - 3(x-p)(x-p)^T/|x-p|^5
+            const vec3d * S = &node_moment[3*nid];
+            double d3  = dist*dist*dist;
+            double d5  = d3*dist*dist;
+            double tr  = S[0][0] + S[1][1] + S[2][2];
+            double dSd = d[0]*S[0].dot(d) + d[1]*S[1].dot(d) + d[2]*S[2].dot(d);
+            omega += node_normal[nid].dot(d)/d3 + tr/d3 - 3.0*dSd/d5;
+        }
+        else if (n.is_leaf) // near field: exact evaluation
+        {
+            for(uint i=n.beg; i<n.end; ++i)
+            {
+                omega += triangle_solid_angle(p, tris[3*i], tris[3*i+1], tris[3*i+2]);
+            }
+        }
+        else
+        {
+            assert(top+2 <= stack_size);
+            stack[top++] = n.children[0];
+            stack[top++] = n.children[1];
+        }
+    }
+
+    return omega / (4.0*M_PI);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool FastWindingNumber::is_inside(const vec3d & p) const
+{
+    return winding_number(p) > 0.5;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void FastWindingNumber::winding_number(const std::vector<vec3d> & points, std::vector<double> & w) const
+{
+    w.resize(points.size());
+    PARALLEL_FOR(0, points.size(), 1000, [&](const uint i)
+    {
+        w[i] = winding_number(points[i]);
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void FastWindingNumber::is_inside(const std::vector<vec3d> & points, std::vector<bool> & inside) const
+{
+    std::vector<double> w;
+    winding_number(points, w);
+
+    inside.resize(points.size());
+    for(uint i=0; i<points.size(); ++i) inside[i] = (w[i] > 0.5);
+}
+
+}
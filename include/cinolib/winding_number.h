@@ -0,0 +1,147 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_WINDING_NUMBER_H
+#define CINO_WINDING_NUMBER_H
+
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/bvh.h>
+#include <cinolib/meshes/abstract_polygonmesh.h>
+
+namespace cinolib
+{
+
+/* Generalized winding numbers for inside/outside classification of points
+ * w.r.t. a surface mesh. For a closed, consistently oriented mesh (outward
+ * normals) the winding number is 1 inside and 0 outside. For meshes with
+ * small holes, cracks or self intersections it varies smoothly, and it can
+ * still be robustly thresholded at 0.5. References:
+ *
+ *     Robust Inside-Outside Segmentation using Generalized Winding Numbers
+ *     A. Jacobson, L. Kavan and O. Sorkine-Hornung
+ *     ACM Transactions on Graphics (SIGGRAPH 2013)
+ *
+ *     Fast Winding Numbers for Soups and Clouds
+ *     G. Barill, N. Dickson, R. Schmidt, D.I.W. Levin and A. Jacobson
+ *     ACM Transactions on Graphics (SIGGRAPH 2018)
+ *
+ * The evaluator builds a BVH on top of the mesh triangles, and stores for each
+ * node a far field approximation of the triangles it contains (the dipole term
+ * plus the first order correction of the Taylor expansion of the kernel). A
+ * query traverses the tree, and uses the approximation of a node in place of its
+ * triangles as soon as the query point is far enough from it, that is when
+ * |q - node_center| > beta * node_radius. Larger values of beta yield more
+ * accurate (but slower) queries. Leaves close to the query point are evaluated
+ * exactly, summing the solid angles subtended by their triangles.
+ *
+ * Queries are read only, hence the same evaluator can be safely shared among
+ * threads. Batched queries are multi-threaded.
+ *
+ * NOTE: polygonal meshes are supported through their triangulation
+*/
+
+class FastWindingNumber
+{
+    protected:
+
+        BVH                 bvh;
+        std::vector<vec3d>  tris;        // triangle vertices, sorted as the BVH items (3 vec3d per triangle)
+        std::vector<vec3d>  node_center; // area weighted centroid of the triangles within each node
+        std::vector<vec3d>  node_normal; // sum of the area weighted normals of the triangles within each node
+        std::vector<vec3d>  node_moment; // 3x3 matrix (by rows) sum_t a_t * (c_t - node_center)^T, with a_t area weighted normal, c_t centroid
+        std::vector<double> node_radius; // radius of the sphere centered at node_center enclosing the node
+        double              beta;        // accuracy parameter
+        uint                stack_size = 0; // max size of the traversal stack (depends on the BVH depth)
+
+    public:
+
+        explicit FastWindingNumber() {}
+
+        template<class M, class V, class E, class P>
+        explicit FastWindingNumber(const AbstractPolygonMesh<M,V,E,P> & m,
+                                   const double                         beta = 2.0,
+                                   const uint                           max_tris_per_leaf = 8);
+
+        explicit FastWindingNumber(const std::vector<vec3d> & verts,
+                                   const std::vector<uint>  & tris,
+                                   const double               beta = 2.0,
+                                   const uint                 max_tris_per_leaf = 8);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void init(const std::vector<vec3d> & verts,
+                  const std::vector<uint>  & tris, // serialized triangles (3 vids per triangle)
+                  const double               beta = 2.0,
+                  const uint                 max_tris_per_leaf = 8);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        double winding_number(const vec3d & p) const;
+        bool   is_inside     (const vec3d & p) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // batched (multi-threaded) queries
+        void winding_number(const std::vector<vec3d> & points, std::vector<double> & w) const;
+        void is_inside     (const std::vector<vec3d> & points, std::vector<bool>   & inside) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        const BVH & tree() const { return bvh; }
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Solid angle subtended by triangle v0,v1,v2 at point p. See:
+//
+//     The Solid Angle of a Plane Triangle
+//     A. Van Oosterom and J. Strackee
+//     IEEE Transactions on Biomedical Engineering (1983)
+//
+CINO_INLINE
+double triangle_solid_angle(const vec3d & p,
+                            const vec3d & v0,
+                            const vec3d & v1,
+                            const vec3d & v2);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "winding_number.cpp"
+#endif
+
+#endif // CINO_WINDING_NUMBER_H
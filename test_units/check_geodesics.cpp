@@ -0,0 +1,71 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/geodesics.h>
+#include <assert.h>
+
+namespace cinolib
+{
+
+template<class Mesh>
+CINO_INLINE
+void check_geodesics(Mesh & m, const uint source)
+{
+    std::cout << "GEODESICS CHECK...";
+
+    assert(source < m.num_verts());
+
+    ScalarField f = compute_geodesics(m, {source});
+
+    GeodesicsCache cache;
+    ScalarField g = compute_geodesics_amortized(m, cache, {source});
+    ScalarField h = compute_geodesics_amortized(m, cache, {source}); // prefactored
+
+    assert(f.size() == m.num_verts());
+    assert(g.size() == m.num_verts());
+    assert(std::fabs(f[source] - 1.0) < 1e-10);
+    assert(std::fabs(g[source] - 1.0) < 1e-10);
+    assert(std::fabs(h[source] - 1.0) < 1e-10);
+
+    for(uint vid=0; vid<m.num_verts(); ++vid)
+    {
+        assert(g[vid] >= 0.0 && g[vid] <= 1.0);
+        assert(g[vid] == h[vid]);
+    }
+
+    std::cout << "OK" << std::endl;
+}
+
+}